@@ -77,6 +77,36 @@
 /*Align the start address of draw_buf addresses to this bytes*/
 #define LV_DRAW_BUF_ALIGN                       4
 
+/*Index the draw tasks of a layer in a grid of LV_DRAW_TASK_GRID_SIZE x LV_DRAW_TASK_GRID_SIZE cells
+ *to find the independent draw tasks faster if there are a lot of draw tasks on a layer.
+ *0: disable the grid and always compare the draw tasks with all the older draw tasks*/
+#define LV_DRAW_TASK_GRID_SIZE                  8
+
+/*Keep at most this many bytes of freed draw tasks and draw descriptors to reuse them
+ *for the next draw tasks instead of allocating them again.
+ *0: allocate and free all draw tasks with `lv_malloc` and `lv_free`*/
+#define LV_DRAW_TASK_POOL_SIZE                  (4 * 1024)    /*[bytes]*/
+
+/*Keep at most this many bytes of freed layer buffers to reuse them for the next layers
+ *with the same color format and stride instead of allocating them again.
+ *0: allocate and free all layer buffers with `lv_draw_buf_malloc` and `lv_draw_buf_free`*/
+#define LV_DRAW_LAYER_BUF_POOL_SIZE             0     /*[bytes]*/
+
+/*1: Drop or clip the draw tasks which are hidden by a newer opaque draw task on the same layer
+ *(e.g. a full opacity rectangle without radius or an opaque RGB image) before they are rendered.*/
+#define LV_DRAW_OCCLUSION_CULLING               0
+
+/*Merge at most this many consecutive, similar small draw tasks (fills and borders without radius
+ *and labels with the same color, opacity and font) into one draw task which is rendered in one go.
+ *It saves the evaluation and dispatching of each draw task.
+ *0: don't merge the draw tasks*/
+#define LV_DRAW_TASK_BATCH_MAX                  0
+
+/*1: Collect rendering statistics: the number of created, dispatched and stalled draw tasks,
+ *the blended pixels and rendering time by draw task type, the busy time of the draw units and
+ *the peak layer memory. Get them with `lv_draw_stat_get()`. Also shown by the performance monitor in log mode.*/
+#define LV_USE_DRAW_STAT                        0
+
 #define LV_USE_DRAW_SW 1
 #if LV_USE_DRAW_SW == 1
     /* Set the number of draw unit.
@@ -84,6 +114,12 @@
      * > 1 means multiply threads will render the screen in parallel */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /* Cut large fill, image, layer and box shadow (if its corner is cached) draw tasks into
+     * horizontal stripes which are rendered in parallel by all the idle draw units.
+     * Tasks drawing on a smaller area than this are rendered by a single draw unit.
+     * 0: disable. Requires `LV_USE_OS` and a GCC compatible compiler (for the atomic operations) */
+    #define LV_DRAW_SW_STRIPE_MIN_AREA  0   /*[px]*/
+
     /* If a widget has `style_opa < 255` (not `bg_opa`, `text_opa` etc) or not NORMAL blend mode
      * it is buffered into a "simple" layer before rendering. The widget can be buffered in smaller chunks.
      * "Transformed layers" (if `transform_angle/zoom` are set) use larger buffers
@@ -102,13 +138,44 @@
         *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
         #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
 
+        /* Number of shadow corners to cache if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0.
+         * The shadows with the same width, radius and similar size share a corner. */
+        #define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
         * radius * 4 bytes are used per circle (the most often used radiuses are saved)
         * 0: to disable caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /* Max. memory used by the cached circles [bytes].
+         * If a new circle doesn't fit the least recently used unused ones are dropped.
+         * 0: limit only the number of circles */
+        #define LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE 0
+
+        /* Number of gradients to keep between the frames.
+         * The gradients with the same stops, direction and size share their color maps.
+         * 0: to disable caching */
+        #define LV_DRAW_SW_GRADIENT_CACHE_CNT 4
+
+        /* Max. memory used by the cached gradients [bytes].
+         * A gradient needs about 4 bytes per pixel of its width or height.
+         * 0: limit only the number of gradients */
+        #define LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE 0
     #endif
 
+    /* 1: Dither the pixels drawn on I1 (1 bit per pixel) layers and displays with a 4x4 ordered pattern.
+     * 0: Pixels brighter than 50% are white, the others are black */
+    #define LV_DRAW_SW_I1_DITHER        0
+
+    /* 1: Render the simple layers (e.g. widgets with `opa < 255`) to premultiplied ARGB8888
+     * and premultiply the ARGB8888 images when they are decoded.
+     * Blending such pixels needs only multiplications and additions. */
+    #define LV_DRAW_SW_PREMULTIPLY      0
+
+    /* Use SIMD optimized blending functions.
+     * LV_DRAW_SW_ASM_SSE2 and LV_DRAW_SW_ASM_AVX2 can be used on x86 targets.
+     * LV_DRAW_SW_ASM_AUTO probes the CPU in `lv_init()` and selects the best available functions at runtime */
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -379,6 +446,16 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the cache of decoded glyph bitmaps of the built-in (lv_font_fmt_txt) fonts [bytes].
+ *Saves converting the 1/2/4 bpp and compressed glyphs to A8 every time they are drawn.
+ *0: to disable caching*/
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 0
+
+/*Enable building lookup tables for the built-in (lv_font_fmt_txt) fonts to find the glyphs and
+ *kerning values in constant time. Useful for fonts with a lot of characters (e.g. CJK).
+ *See lv_font_fmt_txt_lookup_create(). The fonts loaded by lv_binfont_load() get them automatically.*/
+#define LV_USE_FONT_FMT_TXT_LOOKUP 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -409,6 +486,11 @@
  *Depends on LV_TXT_LINE_BREAK_LONG_LEN.*/
 #define LV_TXT_LINE_BREAK_LONG_POST_MIN_LEN 3
 
+/*Size of the cache of the line breaks and line widths of the measured and drawn texts [bytes].
+ *Measuring and drawing unchanged texts (e.g. in tables and labels) needs only a lookup then.
+ *0: to disable caching*/
+#define LV_TEXT_LAYOUT_CACHE_SIZE 0
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -475,6 +557,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_LINE_INDEX 0     /*Store the start of each wrapped line of long texts to draw, edit and click them in O(log n)*/
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /*The count of wait chart*/
 #endif
 
@@ -711,6 +794,9 @@
     #if LV_USE_PROFILER_BUILTIN
         /*Default profiler trace buffer size*/
         #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /*[bytes]*/
+
+        /*Maximum number of threads which can be profiled. Each thread has its own buffer.*/
+        #define LV_PROFILER_BUILTIN_THREAD_CNT 8
     #endif
 
     /*Header to include for the profiler*/
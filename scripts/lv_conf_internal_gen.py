@@ -48,6 +48,9 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_MVE          2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
+#define LV_DRAW_SW_ASM_AUTO         5
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
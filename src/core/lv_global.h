@@ -34,7 +34,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE || LV_USE_FONT_FMT_TXT_LOOKUP
 #include "../font/lv_font_fmt_txt.h"
 #endif
 
@@ -113,7 +113,16 @@ typedef struct _lv_global_t {
     lv_draw_sw_shadow_cache_t sw_shadow_cache;
 #endif
 #if LV_DRAW_SW_COMPLEX
-    _lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    _lv_draw_sw_mask_circle_cache_t sw_circle_cache;
+#endif
+#if LV_USE_DRAW_SW && defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    _lv_gradient_cache_t sw_grad_cache;
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_STRIPE_MIN_AREA && LV_USE_OS
+    lv_draw_sw_stripe_job_t sw_stripe_job;
+#endif
+#if LV_USE_DRAW_SW
+    lv_draw_sw_dispatch_t sw_dispatch;
 #endif
 
 #if LV_USE_LOG
@@ -164,6 +173,18 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    _lv_font_fmt_txt_glyph_cache_t font_fmt_txt_glyph_cache;
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    _lv_font_fmt_txt_lookup_registry_t font_fmt_txt_lookup;
+#endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    _lv_text_layout_cache_t text_layout_cache;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
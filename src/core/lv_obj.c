@@ -162,6 +162,11 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+    if((f & LV_OBJ_FLAG_DISPLAY_LIST) && obj->spec_attr && obj->spec_attr->draw_list) {
+        lv_draw_list_delete(obj->spec_attr->draw_list);
+        obj->spec_attr->draw_list = NULL;
+    }
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -377,6 +382,10 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             obj->spec_attr->event_list.dsc = NULL;
             obj->spec_attr->event_list.cnt = 0;
         }
+        if(obj->spec_attr->draw_list) {
+            lv_draw_list_delete(obj->spec_attr->draw_list);
+            obj->spec_attr->draw_list = NULL;
+        }
 
         lv_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -801,6 +801,8 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_invalidate_draw_lists(obj);
+
     lv_display_t * disp   = lv_obj_get_disp(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -827,6 +829,15 @@ void lv_obj_invalidate(const lv_obj_t * obj)
     lv_obj_invalidate_area(obj, &obj_coords);
 }
 
+void _lv_obj_invalidate_draw_lists(const lv_obj_t * obj)
+{
+    /*The draw tasks of the object are saved in the draw lists of the object and its parents*/
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->draw_list) lv_draw_list_invalidate(obj->spec_attr->draw_list);
+        obj = obj->parent;
+    }
+}
+
 bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
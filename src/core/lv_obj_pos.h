@@ -363,6 +363,14 @@ void lv_obj_invalidate_area(const struct _lv_obj_t * obj, const lv_area_t * area
  */
 void lv_obj_invalidate(const struct _lv_obj_t * obj);
 
+/**
+ * Drop the recorded draw tasks of an object without invalidating its area,
+ * e.g. if the memory used by the draw tasks was freed or moved.
+ * `lv_obj_invalidate_area` calls it too.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_invalidate_draw_lists(const struct _lv_obj_t * obj);
+
 /**
  * Tell whether an area of an object is visible (even partially) now or not
  * @param obj       pointer to an object
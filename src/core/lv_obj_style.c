@@ -62,6 +62,7 @@ static void full_cache_refresh(lv_obj_t * obj, lv_part_t part);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
+static void invalidate_draw_lists(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -270,6 +271,13 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
+
+    /*The saved draw tasks of the children depend on the inherited properties and the opacity too*/
+    if(prop == LV_STYLE_PROP_ANY || prop == LV_STYLE_OPA || is_inheritable) {
+        invalidate_draw_lists(obj);
+    }
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -278,7 +286,6 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
     bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
-    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
 
     if(is_layout_refr) {
@@ -1140,3 +1147,15 @@ static bool style_has_flag(const lv_style_t * style, uint32_t flag)
     }
     return false;
 }
+
+static void invalidate_draw_lists(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL) return;
+
+    if(obj->spec_attr->draw_list) lv_draw_list_invalidate(obj->spec_attr->draw_list);
+
+    uint32_t i;
+    for(i = 0; i < obj->spec_attr->child_cnt; i++) {
+        invalidate_draw_lists(obj->spec_attr->children[i]);
+    }
+}
@@ -45,6 +45,7 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+static lv_draw_list_t * get_draw_list(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -103,6 +104,22 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
 
     if(!_lv_area_intersect(&clip_coords_for_obj, &clip_area_ori, &obj_coords_ext)) return;
+
+    /*Add the saved draw tasks if nothing has changed since the last time, else save them now.
+     *It can be saved only if the object is fully on the clip area, else some draw tasks would be missing.*/
+    lv_draw_list_t * draw_list = NULL;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_DISPLAY_LIST)) {
+        draw_list = get_draw_list(obj);
+        if(draw_list && lv_draw_list_replay(draw_list, layer, &obj_coords_ext) == LV_RESULT_OK) return;
+
+        if(draw_list && _lv_area_is_in(&obj_coords_ext, &clip_area_ori, 0) && lv_draw_list_is_recordable(draw_list)) {
+            lv_draw_list_start_record(draw_list, layer, &obj_coords_ext);
+        }
+        else {
+            draw_list = NULL;
+        }
+    }
+
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
@@ -246,6 +263,8 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     }
 
     layer->_clip_area = clip_area_ori;
+
+    if(draw_list) lv_draw_list_finish_record(draw_list);
 }
 
 /**
@@ -416,10 +435,6 @@ refr_clean_up:
 
 refr_finish:
 
-#if LV_DRAW_SW_COMPLEX == 1
-    _lv_draw_sw_mask_cleanup();
-#endif
-
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
@@ -906,6 +921,18 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
             max_argb_row_height = LV_DRAW_SW_LAYER_SIMPLE_BUF_SIZE / w / sizeof(lv_color32_t);
         }
 
+        /*Opaque layers of low bpp displays are rendered in L8 to keep the colors and save memory*/
+        lv_color_format_t layer_cf = LV_COLOR_FORMAT_NATIVE;
+        if(layer->color_format == LV_COLOR_FORMAT_L8 || layer->color_format == LV_COLOR_FORMAT_I1) {
+            layer_cf = LV_COLOR_FORMAT_L8;
+        }
+
+        /*Transformed layers keep straight alpha to use the accelerated samplers*/
+        lv_color_format_t layer_alpha_cf = LV_COLOR_FORMAT_ARGB8888;
+#if LV_USE_DRAW_SW && LV_DRAW_SW_PREMULTIPLY
+        if(layer_type == LV_LAYER_TYPE_SIMPLE) layer_alpha_cf = LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED;
+#endif
+
         lv_area_t layer_area_act;
         layer_area_act.x1 = layer_area_full.x1;
         layer_area_act.x2 = layer_area_full.x2;
@@ -924,7 +951,7 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
             }
 
             lv_layer_t * new_layer = lv_draw_layer_create(layer,
-                                                          area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE, &layer_area_act);
+                                                          area_need_alpha ? layer_alpha_cf : layer_cf, &layer_area_act);
             lv_obj_redraw(new_layer, obj);
 
             lv_draw_image_dsc_t layer_draw_dsc;
@@ -956,7 +983,14 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
     bool has_alpha = lv_color_format_has_alpha(disp->color_format);
     uint32_t px_size_disp =  lv_color_format_get_size(disp->color_format);
     uint8_t px_size_render = has_alpha ? sizeof(lv_color32_t) : px_size_disp;
-    int32_t max_row = (uint32_t)disp->buf_size_in_bytes / LV_MAX(px_size_render, px_size_disp) / area_w;
+    int32_t max_row;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) {
+        /*More pixels are packed into a byte so use the real size of the rows*/
+        max_row = (uint32_t)disp->buf_size_in_bytes / lv_draw_buf_width_to_stride(area_w, disp->color_format);
+    }
+    else {
+        max_row = (uint32_t)disp->buf_size_in_bytes / LV_MAX(px_size_render, px_size_disp) / area_w;
+    }
 
     if(max_row > area_h) max_row = area_h;
 
@@ -1069,3 +1103,17 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+static lv_draw_list_t * get_draw_list(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL) {
+        lv_obj_allocate_spec_attr(obj);
+        if(obj->spec_attr == NULL) return NULL;
+    }
+
+    if(obj->spec_attr->draw_list == NULL) {
+        obj->spec_attr->draw_list = lv_draw_list_create();
+    }
+
+    return obj->spec_attr->draw_list;
+}
@@ -12,20 +12,86 @@
 #include "../core/lv_global.h"
 #include "../core/lv_refr.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/lv_array.h"
+#include "../tick/lv_tick.h"
+
+#if LV_USE_DRAW_STAT && LV_USE_OS == LV_OS_PTHREAD
+    #include <time.h>
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*Create the draw task grid of a layer only if it has at least this many draw tasks.
+ *With less draw tasks a linear search is faster than updating the grid.*/
+#define DRAW_TASK_GRID_MIN_CNT  32
+
+#if LV_DRAW_TASK_GRID_SIZE > 255
+    #error "LV_DRAW_TASK_GRID_SIZE can be 255 at most"
+#endif
+
+/*The block is not stored in any of the pools as all of them are used for other sizes*/
+#define DRAW_TASK_POOL_ID_NONE  0xFFFFFFFF
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_TASK_GRID_SIZE
+typedef struct _lv_draw_task_grid_t {
+    /** The area divided into cells. Draw tasks outside of it are indexed in the cells on the edges.*/
+    lv_area_t area;
+    int32_t cell_w;
+    int32_t cell_h;
+
+    /** The draw tasks (`lv_draw_task_t *`) overlapping each cell in the order of their creation*/
+    lv_array_t cells[LV_DRAW_TASK_GRID_SIZE * LV_DRAW_TASK_GRID_SIZE];
+} lv_draw_task_grid_t;
+#endif
+
+#if LV_DRAW_TASK_POOL_SIZE
+/*Placed before the blocks allocated by `lv_draw_task_pool_alloc`. The union keeps the alignment of the blocks.*/
+typedef union {
+    uint32_t pool_id;       /*Index of the pool or DRAW_TASK_POOL_ID_NONE while the block is in use*/
+    void * next;            /*The next free block while the block is in the pool*/
+    uint64_t align;
+} draw_task_pool_header_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+#if LV_USE_DRAW_STAT
+    static uint32_t stat_get_time_us(void);
+#endif
+#if LV_DRAW_TASK_GRID_SIZE
+    static void task_grid_create(lv_layer_t * layer);
+    static void task_grid_delete(lv_layer_t * layer);
+    static void task_grid_invalidate(lv_layer_t * layer);
+    static bool task_grid_add(lv_draw_task_grid_t * grid, lv_draw_task_t * t);
+    static void task_grid_remove(lv_draw_task_grid_t * grid, lv_draw_task_t * t);
+    static bool task_grid_is_independent(lv_draw_task_grid_t * grid, lv_draw_task_t * t_check);
+#endif
+static void * layer_buf_alloc(uint32_t size, uint32_t stride, lv_color_format_t color_format, uint32_t * buf_size);
+static void layer_buf_free(void * buf_unaligned, uint32_t size, uint32_t stride, lv_color_format_t color_format);
+static void layer_add_draw_area(lv_layer_t * layer, const lv_draw_task_t * t);
+static void layer_clear_area(lv_layer_t * layer, const lv_area_t * area);
+static bool image_is_transformed(const lv_draw_image_dsc_t * dsc);
+static void layer_finish_clear(lv_layer_t * layer, lv_draw_task_t * t_src);
+static void draw_dsc_free(lv_draw_task_type_t type, void * draw_dsc);
+#if LV_DRAW_TASK_BATCH_MAX
+    static bool batch_start(lv_layer_t * layer, lv_draw_task_t * t);
+    static bool batch_merge(lv_layer_t * layer, lv_draw_task_t * t);
+    static bool batch_is_compatible(lv_draw_task_type_t type, const void * dsc1, const void * dsc2);
+#endif
+#if LV_DRAW_OCCLUSION_CULLING
+    static void cull_hidden_tasks(lv_layer_t * layer, lv_draw_task_t * t_cover);
+    static void cull_task(lv_draw_task_t * t, const lv_area_t * cover);
+    static bool get_cover_area(const lv_draw_task_t * t, lv_area_t * cover);
+    static bool get_draw_area(const lv_draw_task_t * t, lv_area_t * draw_area);
+#endif
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -52,6 +118,10 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+
+#if LV_USE_DRAW_STAT
+    _draw_info.stat_start_time = stat_get_time_us();
+#endif
 }
 
 void lv_draw_deinit(void)
@@ -60,6 +130,9 @@ void lv_draw_deinit(void)
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
 
+    lv_draw_task_pool_flush();
+    lv_draw_layer_buf_pool_flush();
+
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
         lv_draw_unit_t * cur_unit = u;
@@ -84,22 +157,31 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+    lv_draw_task_t * new_task = lv_draw_task_pool_alloc(sizeof(lv_draw_task_t));
+    LV_ASSERT_MALLOC(new_task);
+    lv_memzero(new_task, sizeof(lv_draw_task_t));
 
     new_task->area = *coords;
     new_task->clip_area = layer->_clip_area;
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
+        layer->draw_task_tail->next = new_task;
+    }
+    layer->draw_task_tail = new_task;
 
-        tail->next = new_task;
+#if LV_DRAW_TASK_GRID_SIZE
+    layer->draw_task_cnt++;
+    if(layer->draw_task_grid) {
+        if(!task_grid_add(layer->draw_task_grid, new_task)) task_grid_invalidate(layer);
     }
+    else if(layer->draw_task_cnt >= DRAW_TASK_GRID_MIN_CNT && !layer->draw_task_grid_invalid) {
+        task_grid_create(layer);
+    }
+#endif
 
     LV_PROFILER_END;
     return new_task;
@@ -111,6 +193,13 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
     lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
     base_dsc->layer = layer;
 
+    layer_add_draw_area(layer, t);
+
+#if LV_USE_DRAW_STAT
+    _draw_info.stat.task_created_cnt++;
+    _draw_info.stat.types[t->type].created_cnt++;
+#endif
+
     lv_draw_global_info_t * info = &_draw_info;
 
     /*Send LV_EVENT_DRAW_TASK_ADDED and dispatch only on the "main" draw_task
@@ -119,12 +208,20 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
      *dispatching might remove the "main" draw task while it's still being used in the event*/
 
     if(info->task_running == false) {
+        /*Save only the "main" draw tasks as the events will add the others again on replay*/
+        if(info->draw_list_act) _lv_draw_list_record_task(layer, t);
+
         if(base_dsc->obj && lv_obj_has_flag(base_dsc->obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
             info->task_running = true;
             lv_obj_send_event(base_dsc->obj, LV_EVENT_DRAW_TASK_ADDED, t);
             info->task_running = false;
         }
 
+#if LV_DRAW_OCCLUSION_CULLING
+        /*The event could change the draw descriptor so check the coverage only now*/
+        cull_hidden_tasks(layer, t);
+#endif
+
         /*Let the draw units set their preference score*/
         t->preference_score = 100;
         t->preferred_draw_unit_id = 0;
@@ -134,6 +231,24 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             u = u->next;
         }
 
+#if LV_DRAW_TASK_BATCH_MAX
+        /*Merged into the previous draw task if the same draw unit wants to render both.
+         *It will be dispatched later.*/
+        if(batch_merge(layer, t)) {
+            LV_PROFILER_END;
+            return;
+        }
+
+
+        /*Don't let the draw units take it yet so that the next similar draw tasks can be merged into it.
+         *Just request a dispatch to be sure it will be dispatched later.*/
+        if(batch_start(layer, t)) {
+            lv_draw_dispatch_request();
+            LV_PROFILER_END;
+            return;
+        }
+#endif
+
         lv_draw_dispatch();
     }
     else {
@@ -149,6 +264,182 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
     LV_PROFILER_END;
 }
 
+void * lv_draw_task_pool_alloc(size_t size)
+{
+#if LV_DRAW_TASK_POOL_SIZE
+    _lv_draw_task_pool_t * pools = _draw_info.task_pools;
+    uint32_t pool_id = DRAW_TASK_POOL_ID_NONE;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_POOL_SIZE_CNT; i++) {
+        /*Use the first unused pool for a new size*/
+        if(pools[i].size == 0) pools[i].size = size;
+        if(pools[i].size == size) {
+            pool_id = i;
+            break;
+        }
+    }
+
+    draw_task_pool_header_t * header;
+    if(pool_id != DRAW_TASK_POOL_ID_NONE && pools[pool_id].free_head) {
+        header = pools[pool_id].free_head;
+        pools[pool_id].free_head = header->next;
+        _draw_info.task_pool_stat.pooled_size -= sizeof(draw_task_pool_header_t) + size;
+        _draw_info.task_pool_stat.reuse_cnt++;
+    }
+    else {
+        header = lv_malloc(sizeof(draw_task_pool_header_t) + size);
+        if(header == NULL) return NULL;
+        _draw_info.task_pool_stat.heap_alloc_cnt++;
+    }
+
+    header->pool_id = pool_id;
+    return header + 1;
+#else
+    _draw_info.task_pool_stat.heap_alloc_cnt++;
+    return lv_malloc(size);
+#endif
+}
+
+void lv_draw_task_pool_free(void * p)
+{
+    if(p == NULL) return;
+
+#if LV_DRAW_TASK_POOL_SIZE
+    draw_task_pool_header_t * header = (draw_task_pool_header_t *)p - 1;
+    uint32_t pool_id = header->pool_id;
+    if(pool_id != DRAW_TASK_POOL_ID_NONE) {
+        _lv_draw_task_pool_t * pool = &_draw_info.task_pools[pool_id];
+        uint32_t block_size = sizeof(draw_task_pool_header_t) + pool->size;
+        if(_draw_info.task_pool_stat.pooled_size + block_size <= LV_DRAW_TASK_POOL_SIZE) {
+            header->next = pool->free_head;
+            pool->free_head = header;
+            _draw_info.task_pool_stat.pooled_size += block_size;
+            return;
+        }
+    }
+
+    _draw_info.task_pool_stat.heap_free_cnt++;
+    lv_free(header);
+#else
+    _draw_info.task_pool_stat.heap_free_cnt++;
+    lv_free(p);
+#endif
+}
+
+void lv_draw_task_pool_flush(void)
+{
+#if LV_DRAW_TASK_POOL_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_POOL_SIZE_CNT; i++) {
+        draw_task_pool_header_t * header = _draw_info.task_pools[i].free_head;
+        while(header) {
+            draw_task_pool_header_t * next = header->next;
+            lv_free(header);
+            _draw_info.task_pool_stat.heap_free_cnt++;
+            header = next;
+        }
+        _draw_info.task_pools[i].free_head = NULL;
+    }
+    _draw_info.task_pool_stat.pooled_size = 0;
+#endif
+}
+
+void lv_draw_task_pool_get_stat(lv_draw_task_pool_stat_t * stat)
+{
+    *stat = _draw_info.task_pool_stat;
+}
+
+void lv_draw_task_pool_reset_stat(void)
+{
+    _draw_info.task_pool_stat.heap_alloc_cnt = 0;
+    _draw_info.task_pool_stat.heap_free_cnt = 0;
+    _draw_info.task_pool_stat.reuse_cnt = 0;
+}
+
+void lv_draw_occlusion_get_stat(lv_draw_occlusion_stat_t * stat)
+{
+    *stat = _draw_info.occlusion_stat;
+}
+
+void lv_draw_occlusion_reset_stat(void)
+{
+    lv_memzero(&_draw_info.occlusion_stat, sizeof(lv_draw_occlusion_stat_t));
+}
+
+#if LV_USE_DRAW_STAT
+
+void lv_draw_stat_get(lv_draw_stat_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+
+    *stat = _draw_info.stat;
+    stat->elapsed_time = stat_get_time_us() - _draw_info.stat_start_time;
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_TASK_TYPE_CNT; i++) {
+            stat->types[i].rendered_cnt += u->stat.types[i].rendered_cnt;
+            stat->types[i].blend_px_cnt += u->stat.types[i].blend_px_cnt;
+            stat->types[i].render_time += u->stat.types[i].render_time;
+        }
+        stat->unit_cnt++;
+        u = u->next;
+    }
+}
+
+lv_result_t lv_draw_stat_get_unit(uint32_t idx, lv_draw_stat_unit_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u && idx) {
+        u = u->next;
+        idx--;
+    }
+    if(u == NULL) return LV_RESULT_INVALID;
+
+    *stat = u->stat;
+    return LV_RESULT_OK;
+}
+
+void lv_draw_stat_reset(void)
+{
+    lv_memzero(&_draw_info.stat, sizeof(lv_draw_stat_t));
+    _draw_info.stat.layer_mem_peak_kb = _draw_info.used_memory_for_layers_kb;
+    _draw_info.stat_start_time = stat_get_time_us();
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        lv_memzero(&u->stat, sizeof(lv_draw_stat_unit_t));
+        u = u->next;
+    }
+}
+
+void lv_draw_stat_task_start(lv_draw_unit_t * draw_unit, lv_draw_task_type_t type)
+{
+    draw_unit->stat._task_type = type;
+    draw_unit->stat._task_start = stat_get_time_us();
+}
+
+void lv_draw_stat_task_finish(lv_draw_unit_t * draw_unit)
+{
+    /*Only the draw unit's own thread writes its statistics so no locking is required*/
+    lv_draw_stat_unit_t * stat = &draw_unit->stat;
+    uint32_t elaps = stat_get_time_us() - stat->_task_start;
+    stat->task_cnt++;
+    stat->busy_time += elaps;
+    stat->types[stat->_task_type].rendered_cnt++;
+    stat->types[stat->_task_type].render_time += elaps;
+}
+
+void lv_draw_stat_add_blend_px(lv_draw_unit_t * draw_unit, uint32_t px_cnt)
+{
+    draw_unit->stat.types[draw_unit->stat._task_type].blend_px_cnt += px_cnt;
+}
+
+#endif /*LV_USE_DRAW_STAT*/
+
 void lv_draw_dispatch(void)
 {
     LV_PROFILER_BEGIN;
@@ -180,6 +471,12 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
         if(t->state == LV_DRAW_TASK_STATE_READY) {
             if(t_prev) t_prev->next = t->next;      /*Remove by it by assigning the next task to the previous*/
             else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
+            if(layer->draw_task_tail == t) layer->draw_task_tail = t_prev;
+
+#if LV_DRAW_TASK_GRID_SIZE
+            layer->draw_task_cnt--;
+            if(layer->draw_task_grid) task_grid_remove(layer->draw_task_grid, t);
+#endif
 
             /*If it was layer drawing free the layer too*/
             if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
@@ -187,13 +484,10 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
                 lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
 
                 if(layer_drawn->buf) {
-                    int32_t h = lv_area_get_height(&layer_drawn->buf_area);
-                    int32_t w = lv_area_get_width(&layer_drawn->buf_area);
-                    uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer_drawn->color_format);
-
-                    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
+                    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_drawn->_buf_size);
                     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
-                    lv_draw_buf_free(layer_drawn->buf_unaligned);
+                    layer_buf_free(layer_drawn->buf_unaligned, layer_drawn->_buf_size, layer_drawn->buf_stride,
+                                   layer_drawn->color_format);
                 }
 
                 /*Remove the layer from  the display's*/
@@ -208,19 +502,26 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
                     }
 
                     if(disp->layer_deinit) disp->layer_deinit(disp, layer_drawn);
+#if LV_DRAW_TASK_GRID_SIZE
+                    task_grid_delete(layer_drawn);
+#endif
                     lv_free(layer_drawn);
                 }
             }
-            if(t->type == LV_DRAW_TASK_TYPE_LABEL) {
-                lv_draw_label_dsc_t * draw_label_dsc = t->draw_dsc;
-                if(draw_label_dsc->text_local) {
-                    lv_free((void *)draw_label_dsc->text);
-                    draw_label_dsc->text = NULL;
+#if LV_DRAW_TASK_BATCH_MAX
+            if(layer->_batch_task == t) layer->_batch_task = NULL;
+            if(t->batch) {
+                /*The first item is the task's own draw descriptor*/
+                uint32_t i;
+                for(i = 1; i < t->batch->cnt; i++) {
+                    draw_dsc_free(t->type, t->batch->items[i].draw_dsc);
                 }
+                lv_draw_task_pool_free(t->batch);
             }
+#endif
 
-            lv_free(t->draw_dsc);
-            lv_free(t);
+            draw_dsc_free(t->type, t->draw_dsc);
+            lv_draw_task_pool_free(t);
         }
         else {
             t_prev = t;
@@ -228,6 +529,14 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
         t = t_next;
     }
 
+#if LV_DRAW_TASK_GRID_SIZE
+    /*All draw tasks are ready, the next draw tasks might be added to a different area*/
+    if(layer->draw_task_head == NULL) {
+        task_grid_delete(layer);
+        layer->draw_task_grid_invalid = false;
+    }
+#endif
+
     bool render_running = false;
 
     /*This layer is ready, enable blending its buffer*/
@@ -238,6 +547,7 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
             if(t_src->type == LV_DRAW_TASK_TYPE_LAYER && t_src->state == LV_DRAW_TASK_STATE_WAITING) {
                 lv_draw_image_dsc_t * draw_dsc = t_src->draw_dsc;
                 if(draw_dsc->src == layer) {
+                    if(layer->_lazy_clear && layer->buf) layer_finish_clear(layer, t_src);
                     t_src->state = LV_DRAW_TASK_STATE_QUEUED;
                     lv_draw_dispatch_request();
                     break;
@@ -254,6 +564,9 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
         while(u) {
             int32_t taken_cnt = u->dispatch_cb(u, layer);
             if(taken_cnt >= 0) render_running = true;
+#if LV_USE_DRAW_STAT
+            if(taken_cnt > 0) _draw_info.stat.task_dispatched_cnt += taken_cnt;
+#endif
             u = u->next;
         }
     }
@@ -264,12 +577,14 @@ bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer)
 
 void lv_draw_dispatch_wait_for_request(void)
 {
+    LV_PROFILER_BEGIN;
 #if LV_USE_OS
     lv_thread_sync_wait(&_draw_info.sync);
 #else
     while(!_draw_info.dispatch_req);
     _draw_info.dispatch_req = 0;
 #endif
+    LV_PROFILER_END;
 }
 
 void lv_draw_dispatch_request(void)
@@ -297,18 +612,30 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
     //        }
     //    }
 
+#if LV_USE_DRAW_STAT
+    bool stalled = false;
+#endif
     lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
     while(t) {
         /*Find a queued and independent task*/
         if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
-           (t->preferred_draw_unit_id == LV_DRAW_UNIT_ID_ANY || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
-            LV_PROFILER_END;
-            return t;
+           (t->preferred_draw_unit_id == LV_DRAW_UNIT_ID_ANY || t->preferred_draw_unit_id == draw_unit_id)) {
+            if(is_independent(layer, t)) {
+                LV_PROFILER_END;
+                return t;
+            }
+#if LV_USE_DRAW_STAT
+            stalled = true;
+#endif
         }
         t = t->next;
     }
 
+#if LV_USE_DRAW_STAT
+    /*There was work for the draw unit but all of it waits for other draw tasks*/
+    if(stalled) _draw_info.stat.task_stall_cnt++;
+#endif
+
     LV_PROFILER_END;
     return NULL;
 }
@@ -346,6 +673,8 @@ lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t c
     new_layer->buf_area = *area;
     new_layer->buf_stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), color_format);
     new_layer->color_format = color_format;
+    lv_area_set(&new_layer->_draw_area, 0, 0, -1, -1);
+    lv_area_set(&new_layer->_cleared_area, 0, 0, -1, -1);
 
     if(disp->layer_head) {
         lv_layer_t * tail = disp->layer_head;
@@ -368,7 +697,7 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     if(layer->buf == NULL) {
         int32_t h = lv_area_get_height(&layer->buf_area);
         uint32_t layer_size_byte = h * stride;
-        layer->buf_unaligned = lv_draw_buf_malloc(layer_size_byte, layer->color_format);
+        layer->buf_unaligned = layer_buf_alloc(layer_size_byte, stride, layer->color_format, &layer->_buf_size);
 
         if(layer->buf_unaligned == NULL) {
             LV_LOG_WARN("Allocating %"LV_PRIu32" bytes of layer buffer failed. Try later", layer_size_byte);
@@ -377,19 +706,20 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
 
         layer->buf = lv_draw_buf_align(layer->buf_unaligned, layer->color_format);
 
-        _draw_info.used_memory_for_layers_kb += get_layer_size_kb(layer_size_byte);
+        _draw_info.used_memory_for_layers_kb += get_layer_size_kb(layer->_buf_size);
         LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+#if LV_USE_DRAW_STAT
+        _draw_info.stat.layer_mem_peak_kb = LV_MAX(_draw_info.stat.layer_mem_peak_kb, _draw_info.used_memory_for_layers_kb);
+#endif
 
-        if(lv_color_format_has_alpha(layer->color_format)) {
-            lv_area_t a;
-            a.x1 = 0;
-            a.y1 = 0;
-            a.x2 = w - 1;
-            a.y2 = h - 1;
-            lv_draw_buf_clear(layer->buf, w, h, layer->color_format, &a);
-        }
+        /*Clear only the area where the draw tasks will draw. The rest is cleared when the layer is blended
+         *if needed. Layers without alpha channel are fully covered by the widget so no need to clear them.*/
+        layer->_lazy_clear = lv_color_format_has_alpha(layer->color_format);
     }
 
+    /*Clear the areas of the newly added draw tasks*/
+    if(layer->_lazy_clear) layer_clear_area(layer, &layer->_draw_area);
+
     /*Set the stride also for static allocated buffers as well as for new dynamically allocated*/
     layer->buf_stride = stride;
 
@@ -397,6 +727,22 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     return lv_draw_buf_align(layer->buf, layer->color_format);
 }
 
+void lv_draw_layer_buf_pool_flush(void)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_POOL_CNT; i++) {
+        _lv_draw_layer_buf_pool_entry_t * entry = &_draw_info.layer_buf_pool[i];
+        if(entry->buf_unaligned) {
+            lv_draw_buf_free(entry->buf_unaligned);
+            entry->buf_unaligned = NULL;
+        }
+    }
+    _draw_info.layer_buf_pooled_size = 0;
+    _draw_info.pooled_memory_for_layers_kb = 0;
+#endif
+}
+
 void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
 {
     return lv_draw_buf_go_to_xy(layer->buf, layer->buf_stride, layer->color_format, x, y);
@@ -407,6 +753,172 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get a layer buffer from the pool or allocate a new one
+ * @param size          the required size in bytes
+ * @param stride        stride of the layer
+ * @param color_format  color format of the layer
+ * @param buf_size      store the real size of the buffer here (a buffer from the pool can be larger)
+ * @return              the unaligned buffer or NULL on error
+ */
+static void * layer_buf_alloc(uint32_t size, uint32_t stride, lv_color_format_t color_format, uint32_t * buf_size)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    /*Find the smallest large enough buffer, but don't waste more than the required size*/
+    _lv_draw_layer_buf_pool_entry_t * pool = _draw_info.layer_buf_pool;
+    int32_t best_i = -1;
+    int32_t i;
+    for(i = 0; i < LV_DRAW_LAYER_BUF_POOL_CNT && pool[i].buf_unaligned; i++) {
+        if(pool[i].color_format != color_format || pool[i].stride != stride) continue;
+        if(pool[i].size < size || pool[i].size > size * 2) continue;
+        if(best_i < 0 || pool[i].size < pool[best_i].size) best_i = i;
+    }
+
+    if(best_i >= 0) {
+        void * buf = pool[best_i].buf_unaligned;
+        *buf_size = pool[best_i].size;
+        _draw_info.layer_buf_pooled_size -= pool[best_i].size;
+        _draw_info.pooled_memory_for_layers_kb -= get_layer_size_kb(pool[best_i].size);
+        _draw_info.layer_buf_reuse_cnt++;
+
+        /*Keep the used entries at the beginning*/
+        lv_memmove(&pool[best_i], &pool[best_i + 1], (LV_DRAW_LAYER_BUF_POOL_CNT - best_i - 1) * sizeof(pool[0]));
+        pool[LV_DRAW_LAYER_BUF_POOL_CNT - 1].buf_unaligned = NULL;
+        return buf;
+    }
+#endif
+
+    void * buf = lv_draw_buf_malloc(size, color_format);
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    /*The free buffers in the pool might take the memory*/
+    if(buf == NULL && _draw_info.layer_buf_pooled_size) {
+        lv_draw_layer_buf_pool_flush();
+        buf = lv_draw_buf_malloc(size, color_format);
+    }
+#endif
+    if(buf == NULL) return NULL;
+
+    _draw_info.layer_buf_alloc_cnt++;
+    *buf_size = size;
+    return buf;
+}
+
+/**
+ * Put a layer buffer to the pool or free it
+ * @param buf_unaligned the buffer to free
+ * @param size          size of the buffer in bytes
+ * @param stride        stride of the layer
+ * @param color_format  color format of the layer
+ */
+static void layer_buf_free(void * buf_unaligned, uint32_t size, uint32_t stride, lv_color_format_t color_format)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    if(size > 0 && size <= LV_DRAW_LAYER_BUF_POOL_SIZE) {
+        _lv_draw_layer_buf_pool_entry_t * pool = _draw_info.layer_buf_pool;
+        uint32_t cnt = 0;
+        while(cnt < LV_DRAW_LAYER_BUF_POOL_CNT && pool[cnt].buf_unaligned) cnt++;
+
+        /*Free the least recently added buffers (at the end) until the new one fits*/
+        while(cnt == LV_DRAW_LAYER_BUF_POOL_CNT || _draw_info.layer_buf_pooled_size + size > LV_DRAW_LAYER_BUF_POOL_SIZE) {
+            cnt--;
+            lv_draw_buf_free(pool[cnt].buf_unaligned);
+            pool[cnt].buf_unaligned = NULL;
+            _draw_info.layer_buf_pooled_size -= pool[cnt].size;
+            _draw_info.pooled_memory_for_layers_kb -= get_layer_size_kb(pool[cnt].size);
+        }
+
+        lv_memmove(&pool[1], &pool[0], cnt * sizeof(pool[0]));
+        pool[0].buf_unaligned = buf_unaligned;
+        pool[0].size = size;
+        pool[0].stride = stride;
+        pool[0].color_format = color_format;
+        _draw_info.layer_buf_pooled_size += size;
+        _draw_info.pooled_memory_for_layers_kb += get_layer_size_kb(size);
+        return;
+    }
+#else
+    LV_UNUSED(size);
+    LV_UNUSED(stride);
+    LV_UNUSED(color_format);
+#endif
+
+    lv_draw_buf_free(buf_unaligned);
+}
+
+/**
+ * Add the area where a draw task will draw to the layer's `_draw_area`
+ * to know which part of the layer's buffer needs to be cleared
+ * @param layer     pointer to a layer
+ * @param t         a new draw task of the layer
+ */
+static void layer_add_draw_area(lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    /*Draw units stay in the clip area but anti-aliased edges, transformed images, etc.
+     *can be drawn a little out of the task's area*/
+    const lv_area_t * draw_area = &t->clip_area;
+    if(layer->_draw_area.x2 < layer->_draw_area.x1) layer->_draw_area = *draw_area;
+    else _lv_area_join(&layer->_draw_area, &layer->_draw_area, draw_area);
+}
+
+/**
+ * Clear the part of an area on a layer's buffer which is not cleared yet.
+ * The cleared area is tracked as a single rectangle so it's extended to the bounding box of the two areas.
+ * @param layer     pointer to a layer with allocated buffer
+ * @param area      the area to clear (absolute coordinates)
+ */
+static void layer_clear_area(lv_layer_t * layer, const lv_area_t * area)
+{
+    lv_area_t new_area;
+    if(!_lv_area_intersect(&new_area, area, &layer->buf_area)) return;
+
+    const lv_area_t * cleared = &layer->_cleared_area;
+    lv_area_t parts[4];
+    uint32_t part_cnt = 0;
+    if(cleared->x2 < cleared->x1) {
+        parts[part_cnt++] = new_area;
+    }
+    else {
+        if(_lv_area_is_in(&new_area, cleared, 0)) return;
+        _lv_area_join(&new_area, &new_area, cleared);
+
+        /*The bands above, below, left and right of the already cleared area*/
+        if(new_area.y1 < cleared->y1) lv_area_set(&parts[part_cnt++], new_area.x1, new_area.y1, new_area.x2, cleared->y1 - 1);
+        if(new_area.y2 > cleared->y2) lv_area_set(&parts[part_cnt++], new_area.x1, cleared->y2 + 1, new_area.x2, new_area.y2);
+        if(new_area.x1 < cleared->x1) lv_area_set(&parts[part_cnt++], new_area.x1, cleared->y1, cleared->x1 - 1, cleared->y2);
+        if(new_area.x2 > cleared->x2) lv_area_set(&parts[part_cnt++], cleared->x2 + 1, cleared->y1, new_area.x2, cleared->y2);
+    }
+
+    int32_t w = lv_area_get_width(&layer->buf_area);
+    int32_t h = lv_area_get_height(&layer->buf_area);
+    uint32_t i;
+    for(i = 0; i < part_cnt; i++) {
+        lv_area_move(&parts[i], -layer->buf_area.x1, -layer->buf_area.y1);
+        lv_draw_buf_clear(layer->buf, w, h, layer->color_format, &parts[i]);
+    }
+
+    layer->_cleared_area = new_area;
+}
+
+/**
+ * Prepare a layer to be blended: the area outside of the drawn area is not cleared yet
+ * so either don't blend it or clear it now.
+ * @param layer     pointer to a layer which is ready
+ * @param t_src     the draw task blending the layer
+ */
+static void layer_finish_clear(lv_layer_t * layer, lv_draw_task_t * t_src)
+{
+    /*Without transformation the pixels are blended 1:1 so it's enough to blend the drawn area*/
+    lv_area_t clip_area;
+    if(!image_is_transformed(t_src->draw_dsc) &&
+       _lv_area_intersect(&clip_area, &t_src->clip_area, &layer->_cleared_area)) {
+        t_src->clip_area = clip_area;
+        return;
+    }
+
+    /*Transformations can sample any pixel of the layer*/
+    layer_clear_area(layer, &layer->buf_area);
+}
+
 /**
  * Check if there are older draw task overlapping the area of `t_check`
  * @param layer      the draw ctx to search in
@@ -415,6 +927,10 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
  */
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 {
+#if LV_DRAW_TASK_GRID_SIZE
+    if(layer->draw_task_grid) return task_grid_is_independent(layer->draw_task_grid, t_check);
+#endif
+
     LV_PROFILER_BEGIN;
     lv_draw_task_t * t = layer->draw_task_head;
 
@@ -433,3 +949,520 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 
     return true;
 }
+
+#if LV_DRAW_TASK_GRID_SIZE
+
+/**
+ * Create a grid for the draw tasks of a layer and add its existing draw tasks to it.
+ * If the grid can't be created the linear search will be used.
+ * @param layer     pointer to a layer
+ */
+static void task_grid_create(lv_layer_t * layer)
+{
+    LV_PROFILER_BEGIN;
+    lv_draw_task_grid_t * grid = lv_malloc_zeroed(sizeof(lv_draw_task_grid_t));
+    if(grid == NULL) {
+        layer->draw_task_grid_invalid = true;
+        LV_PROFILER_END;
+        return;
+    }
+
+    grid->area = layer->buf_area;
+    grid->cell_w = LV_MAX(1, (lv_area_get_width(&grid->area) + LV_DRAW_TASK_GRID_SIZE - 1) / LV_DRAW_TASK_GRID_SIZE);
+    grid->cell_h = LV_MAX(1, (lv_area_get_height(&grid->area) + LV_DRAW_TASK_GRID_SIZE - 1) / LV_DRAW_TASK_GRID_SIZE);
+    layer->draw_task_grid = grid;
+
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        if(!task_grid_add(grid, t)) {
+            task_grid_invalidate(layer);
+            break;
+        }
+        t = t->next;
+    }
+    LV_PROFILER_END;
+}
+
+static void task_grid_delete(lv_layer_t * layer)
+{
+    lv_draw_task_grid_t * grid = layer->draw_task_grid;
+    if(grid == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_GRID_SIZE * LV_DRAW_TASK_GRID_SIZE; i++) {
+        lv_array_destroy(&grid->cells[i]);
+    }
+
+    lv_free(grid);
+    layer->draw_task_grid = NULL;
+}
+
+/**
+ * Delete the grid after it couldn't be updated and use the linear search until all draw tasks are ready
+ * @param layer     pointer to a layer
+ */
+static void task_grid_invalidate(lv_layer_t * layer)
+{
+    LV_LOG_WARN("couldn't add a draw task to the grid, falling back to the linear search");
+    task_grid_delete(layer);
+    layer->draw_task_grid_invalid = true;
+}
+
+static inline uint8_t task_grid_get_col(lv_draw_task_grid_t * grid, int32_t x)
+{
+    int32_t col = (x - grid->area.x1) / grid->cell_w;
+    return (uint8_t)LV_CLAMP(0, col, LV_DRAW_TASK_GRID_SIZE - 1);
+}
+
+static inline uint8_t task_grid_get_row(lv_draw_task_grid_t * grid, int32_t y)
+{
+    int32_t row = (y - grid->area.y1) / grid->cell_h;
+    return (uint8_t)LV_CLAMP(0, row, LV_DRAW_TASK_GRID_SIZE - 1);
+}
+
+/**
+ * Append a draw task to all the cells it overlaps.
+ * As the cells of a task are clamped to the grid, overlapping tasks always share at least one cell.
+ * @param grid      pointer to a draw task grid
+ * @param t         the draw task to add. Needs to be newer than the tasks already in the grid.
+ * @return          true: success; false: out of memory
+ */
+static bool task_grid_add(lv_draw_task_grid_t * grid, lv_draw_task_t * t)
+{
+    t->grid_col1 = task_grid_get_col(grid, t->area.x1);
+    t->grid_col2 = task_grid_get_col(grid, t->area.x2);
+    t->grid_row1 = task_grid_get_row(grid, t->area.y1);
+    t->grid_row2 = task_grid_get_row(grid, t->area.y2);
+
+    uint32_t row;
+    uint32_t col;
+    for(row = t->grid_row1; row <= t->grid_row2; row++) {
+        for(col = t->grid_col1; col <= t->grid_col2; col++) {
+            lv_array_t * cell = &grid->cells[row * LV_DRAW_TASK_GRID_SIZE + col];
+            if(cell->data == NULL) {
+                LV_ARRAY_INIT(cell, lv_draw_task_t *);
+            }
+            else if(lv_array_is_full(cell)) {
+                if(!lv_array_resize(cell, lv_array_capacity(cell) * 2)) return false;
+            }
+
+            /*A task missing from a cell would look independent, so give up the grid if it can't be added*/
+            if(!LV_ARRAY_APPEND_VALUE(cell, t)) return false;
+        }
+    }
+
+    return true;
+}
+
+static void task_grid_remove(lv_draw_task_grid_t * grid, lv_draw_task_t * t)
+{
+    uint32_t row;
+    uint32_t col;
+    for(row = t->grid_row1; row <= t->grid_row2; row++) {
+        for(col = t->grid_col1; col <= t->grid_col2; col++) {
+            lv_array_t * cell = &grid->cells[row * LV_DRAW_TASK_GRID_SIZE + col];
+            lv_draw_task_t ** tasks = (lv_draw_task_t **)cell->data;
+            uint32_t cnt = lv_array_length(cell);
+            uint32_t i;
+            /*The older tasks are usually finished first so they are probably at the beginning*/
+            for(i = 0; i < cnt; i++) {
+                if(tasks[i] == t) {
+                    lv_array_remove(cell, i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Same as `is_independent()` but check only the older draw tasks in the cells of `t_check`
+ * @param grid      pointer to a draw task grid
+ * @param t_check   check this task if it overlaps with the older ones
+ * @return          true: `t_check` is not overlapping with older tasks so it's independent
+ */
+static bool task_grid_is_independent(lv_draw_task_grid_t * grid, lv_draw_task_t * t_check)
+{
+    LV_PROFILER_BEGIN;
+    uint32_t row;
+    uint32_t col;
+    for(row = t_check->grid_row1; row <= t_check->grid_row2; row++) {
+        for(col = t_check->grid_col1; col <= t_check->grid_col2; col++) {
+            lv_array_t * cell = &grid->cells[row * LV_DRAW_TASK_GRID_SIZE + col];
+            lv_draw_task_t ** tasks = (lv_draw_task_t **)cell->data;
+            uint32_t cnt = lv_array_length(cell);
+            uint32_t i;
+            /*The cells are ordered by creation so the older tasks are before t_check*/
+            for(i = 0; i < cnt && tasks[i] != t_check; i++) {
+                lv_draw_task_t * t = tasks[i];
+                if(t->state != LV_DRAW_TASK_STATE_READY) {
+                    lv_area_t a;
+                    if(_lv_area_intersect(&a, &t->area, &t_check->area)) {
+                        LV_PROFILER_END;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    LV_PROFILER_END;
+
+    return true;
+}
+
+#endif /*LV_DRAW_TASK_GRID_SIZE*/
+
+/**
+ * Free a draw descriptor of a finished draw task
+ * @param type      type of the draw task
+ * @param draw_dsc  the draw descriptor
+ */
+static void draw_dsc_free(lv_draw_task_type_t type, void * draw_dsc)
+{
+    if(type == LV_DRAW_TASK_TYPE_LABEL) {
+        lv_draw_label_dsc_t * draw_label_dsc = draw_dsc;
+        if(draw_label_dsc->text_local) {
+            lv_free((void *)draw_label_dsc->text);
+            draw_label_dsc->text = NULL;
+        }
+    }
+
+    lv_draw_task_pool_free(draw_dsc);
+}
+
+#if LV_DRAW_TASK_BATCH_MAX
+
+/**
+ * Check if the next draw tasks can be merged into a new draw task
+ * and save it as the layer's batch task if so.
+ * @param layer     the layer of the draw task
+ * @param t         a new, evaluated draw task
+ * @return          true: the next draw tasks can be merged into `t`
+ */
+static bool batch_start(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    layer->_batch_task = NULL;
+
+    /*The draw tasks added in the events are after it*/
+    if(layer->draw_task_tail != t) return false;
+
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+                if(dsc->radius != 0 || dsc->grad.dir != LV_GRAD_DIR_NONE) return false;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_BORDER: {
+                const lv_draw_border_dsc_t * dsc = t->draw_dsc;
+                if(dsc->radius != 0) return false;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_LABEL:
+            break;
+        default:
+            return false;
+    }
+
+    /*Only the draw unit taking it knows how to render a batch*/
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->batch_id != 0 && u->batch_id == t->preferred_draw_unit_id) break;
+        u = u->next;
+    }
+    if(u == NULL) return false;
+
+    layer->_batch_task = t;
+    return true;
+}
+
+/**
+ * Merge a new draw task into the layer's batch task if it's right before the new task, they are similar
+ * and the draw units' evaluation selected the same draw unit for both.
+ * The new draw task is removed from the layer and freed, only its draw descriptor is kept.
+ * @param layer     the layer of the draw task
+ * @param t         a new, evaluated draw task
+ * @return          true: `t` was merged and freed
+ */
+static bool batch_merge(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    lv_draw_task_t * t_batch = layer->_batch_task;
+    if(t_batch == NULL) return false;
+
+    /*A draw unit might have taken the batch task or the occlusion culling dropped it*/
+    if(t_batch->state != LV_DRAW_TASK_STATE_QUEUED || t_batch->next != t || layer->draw_task_tail != t) return false;
+    if(t_batch->type != t->type || !batch_is_compatible(t->type, t_batch->draw_dsc, t->draw_dsc)) return false;
+
+    /*An other draw unit (e.g. a GPU) claimed the new task so it can't be rendered in the batch*/
+    if(t_batch->preferred_draw_unit_id != t->preferred_draw_unit_id) return false;
+
+    lv_draw_task_batch_t * batch = t_batch->batch;
+    if(batch == NULL) {
+        batch = lv_draw_task_pool_alloc(sizeof(lv_draw_task_batch_t));
+        if(batch == NULL) return false;
+        batch->items[0].area = t_batch->area;
+        batch->items[0].clip_area = t_batch->clip_area;
+        batch->items[0].draw_dsc = t_batch->draw_dsc;
+        batch->cnt = 1;
+        t_batch->batch = batch;
+    }
+    else if(batch->cnt >= LV_DRAW_TASK_BATCH_MAX) {
+        return false;
+    }
+
+    LV_PROFILER_BEGIN;
+    batch->items[batch->cnt].area = t->area;
+    batch->items[batch->cnt].clip_area = t->clip_area;
+    batch->items[batch->cnt].draw_dsc = t->draw_dsc;
+    batch->cnt++;
+
+    /*Remove the new task. It's the last one, right after the batch task.*/
+    t_batch->next = NULL;
+    layer->draw_task_tail = t_batch;
+
+#if LV_DRAW_TASK_GRID_SIZE
+    layer->draw_task_cnt--;
+    /*Index the batch task again with its new area. It's the newest task so it goes to the end of the cells.*/
+    lv_draw_task_grid_t * grid = layer->draw_task_grid;
+    if(grid) {
+        task_grid_remove(grid, t);
+        task_grid_remove(grid, t_batch);
+    }
+#endif
+
+    _lv_area_join(&t_batch->area, &t_batch->area, &t->area);
+    _lv_area_join(&t_batch->clip_area, &t_batch->clip_area, &t->clip_area);
+
+#if LV_DRAW_TASK_GRID_SIZE
+    if(grid && !task_grid_add(grid, t_batch)) task_grid_invalidate(layer);
+#endif
+
+    lv_draw_task_pool_free(t);
+    LV_PROFILER_END;
+    return true;
+}
+
+/**
+ * Check if two draw descriptors of the same type are similar enough to render them in one go
+ * @param type      type of the draw tasks
+ * @param dsc1      the first draw descriptor
+ * @param dsc2      the second draw descriptor
+ * @return          true: the draw tasks can be merged
+ */
+static bool batch_is_compatible(lv_draw_task_type_t type, const void * dsc1, const void * dsc2)
+{
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * fill1 = dsc1;
+                const lv_draw_fill_dsc_t * fill2 = dsc2;
+                return fill2->radius == 0 && fill2->grad.dir == LV_GRAD_DIR_NONE &&
+                       fill1->opa == fill2->opa && lv_color_eq(fill1->color, fill2->color);
+            }
+        case LV_DRAW_TASK_TYPE_BORDER: {
+                const lv_draw_border_dsc_t * border1 = dsc1;
+                const lv_draw_border_dsc_t * border2 = dsc2;
+                return border2->radius == 0 && border1->width == border2->width && border1->side == border2->side &&
+                       border1->opa == border2->opa && lv_color_eq(border1->color, border2->color);
+            }
+        case LV_DRAW_TASK_TYPE_LABEL: {
+                const lv_draw_label_dsc_t * label1 = dsc1;
+                const lv_draw_label_dsc_t * label2 = dsc2;
+                return label1->font == label2->font && label1->opa == label2->opa &&
+                       label1->blend_mode == label2->blend_mode && lv_color_eq(label1->color, label2->color);
+            }
+        default:
+            return false;
+    }
+}
+
+#endif /*LV_DRAW_TASK_BATCH_MAX*/
+
+#if LV_DRAW_OCCLUSION_CULLING
+
+/**
+ * Drop or clip the not started draw tasks which are hidden by a new opaque draw task
+ * @param layer     the layer of the draw tasks
+ * @param t_cover   the new draw task. Nothing happens if it's not opaque.
+ */
+static void cull_hidden_tasks(lv_layer_t * layer, lv_draw_task_t * t_cover)
+{
+    lv_area_t cover;
+    if(!get_cover_area(t_cover, &cover)) return;
+
+    LV_PROFILER_BEGIN;
+#if LV_DRAW_TASK_GRID_SIZE
+    /*Only the tasks in the cells of the cover can be hidden.
+     *A task might be checked in more cells but culling it again doesn't change anything*/
+    lv_draw_task_grid_t * grid = layer->draw_task_grid;
+    if(grid) {
+        uint32_t row;
+        uint32_t col;
+        for(row = task_grid_get_row(grid, cover.y1); row <= task_grid_get_row(grid, cover.y2); row++) {
+            for(col = task_grid_get_col(grid, cover.x1); col <= task_grid_get_col(grid, cover.x2); col++) {
+                lv_array_t * cell = &grid->cells[row * LV_DRAW_TASK_GRID_SIZE + col];
+                lv_draw_task_t ** tasks = (lv_draw_task_t **)cell->data;
+                uint32_t cnt = lv_array_length(cell);
+                uint32_t i;
+                for(i = 0; i < cnt && tasks[i] != t_cover; i++) {
+                    cull_task(tasks[i], &cover);
+                }
+            }
+        }
+        LV_PROFILER_END;
+        return;
+    }
+#endif
+
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t && t != t_cover) {
+        cull_task(t, &cover);
+        t = t->next;
+    }
+    LV_PROFILER_END;
+}
+
+/**
+ * Drop a draw task if it's completely covered or
+ * reduce its clip area if one side of it is covered
+ * @param t         an older draw task
+ * @param cover     an area where a newer draw task will overwrite all pixels
+ */
+static void cull_task(lv_draw_task_t * t, const lv_area_t * cover)
+{
+    /*The draw units might already work on the other tasks.
+     *Layers are not dropped as their tasks are still being rendered.*/
+    if(t->state != LV_DRAW_TASK_STATE_QUEUED || t->type == LV_DRAW_TASK_TYPE_LAYER) return;
+
+    lv_area_t draw_area;
+    if(!get_draw_area(t, &draw_area)) return;
+    if(!_lv_area_is_on(&draw_area, cover)) return;
+
+    lv_draw_occlusion_stat_t * stat = &_draw_info.occlusion_stat;
+    if(_lv_area_is_in(&draw_area, cover, 0)) {
+        /*Just mark it as ready. It will be freed when the finished tasks are removed.*/
+        t->state = LV_DRAW_TASK_STATE_READY;
+        stat->culled_task_cnt++;
+        stat->culled_px_cnt += lv_area_get_size(&draw_area);
+        return;
+    }
+
+    /*If the cover hides a whole side of the task it can be clipped.
+     *Otherwise the visible part is not a rectangle.*/
+    lv_area_t visible = draw_area;
+    if(cover->x1 <= draw_area.x1 && cover->x2 >= draw_area.x2) {
+        if(cover->y1 <= draw_area.y1) visible.y1 = cover->y2 + 1;
+        else if(cover->y2 >= draw_area.y2) visible.y2 = cover->y1 - 1;
+        else return;
+    }
+    else if(cover->y1 <= draw_area.y1 && cover->y2 >= draw_area.y2) {
+        if(cover->x1 <= draw_area.x1) visible.x1 = cover->x2 + 1;
+        else if(cover->x2 >= draw_area.x2) visible.x2 = cover->x1 - 1;
+        else return;
+    }
+    else {
+        return;
+    }
+
+    /*The draw area is inside the clip area so the visible part can be the new clip area*/
+    t->clip_area = visible;
+    stat->clipped_task_cnt++;
+    stat->culled_px_cnt += lv_area_get_size(&draw_area) - lv_area_get_size(&visible);
+}
+
+/**
+ * Get the area where a draw task will set all the pixels independently of what was drawn before
+ * @param t         pointer to a draw task
+ * @param cover     store the covered area here
+ * @return          true: the draw task covers `cover`; false: it doesn't cover any area for sure
+ */
+static bool get_cover_area(const lv_draw_task_t * t, lv_area_t * cover)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+                if(dsc->radius != 0 || dsc->opa < LV_OPA_MAX || dsc->grad.dir != LV_GRAD_DIR_NONE) return false;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_IMAGE: {
+                const lv_draw_image_dsc_t * dsc = t->draw_dsc;
+                if(dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+                if(dsc->sup || image_is_transformed(dsc)) return false;
+
+                /*Only the images drawn directly from their data can't fail to draw.
+                 *E.g. a file might not be found or decoded and then nothing is drawn under the others.*/
+                if(lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+                const lv_image_dsc_t * img = dsc->src;
+                if(img->data == NULL || (img->header.flags & LV_IMAGE_FLAGS_COMPRESSED)) return false;
+
+                if(dsc->header.cf != LV_COLOR_FORMAT_RGB565 && dsc->header.cf != LV_COLOR_FORMAT_RGB888 &&
+                   dsc->header.cf != LV_COLOR_FORMAT_XRGB8888) return false;
+
+                /*Not tiled images cover only their own size*/
+                if(!dsc->tile &&
+                   (dsc->header.w != lv_area_get_width(&t->area) || dsc->header.h != lv_area_get_height(&t->area))) {
+                    return false;
+                }
+                break;
+            }
+        default:
+            return false;
+    }
+
+    return _lv_area_intersect(cover, &t->area, &t->clip_area);
+}
+
+/**
+ * Get the area where a draw task might change pixels
+ * @param t             pointer to a draw task
+ * @param draw_area     store the area here
+ * @return              true: the draw task can change pixels in `draw_area`; false: it doesn't draw anything
+ */
+static bool get_draw_area(const lv_draw_task_t * t, lv_area_t * draw_area)
+{
+    bool in_area;
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+        case LV_DRAW_TASK_TYPE_BORDER:
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            in_area = true;
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            in_area = !image_is_transformed(t->draw_dsc);
+            break;
+        default:
+            /*E.g. letters and anti-aliased edges can be out of the area*/
+            in_area = false;
+            break;
+    }
+
+    if(in_area) return _lv_area_intersect(draw_area, &t->area, &t->clip_area);
+
+    *draw_area = t->clip_area;
+    return true;
+}
+
+#endif /*LV_DRAW_OCCLUSION_CULLING*/
+
+static bool image_is_transformed(const lv_draw_image_dsc_t * dsc)
+{
+    return dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE ||
+           dsc->skew_x != 0 || dsc->skew_y != 0;
+}
+
+#if LV_USE_DRAW_STAT
+
+/**
+ * Get a timestamp for the statistics in microseconds
+ * @return  the timestamp. With `lv_tick_get` its precision is only 1 ms.
+ */
+static uint32_t stat_get_time_us(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000000 + (uint32_t)(ts.tv_nsec / 1000);
+#else
+    return lv_tick_get() * 1000;
+#endif
+}
+
+#endif /*LV_USE_DRAW_STAT*/
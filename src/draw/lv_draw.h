@@ -28,12 +28,20 @@ extern "C" {
  *********************/
 #define LV_DRAW_UNIT_ID_ANY  0
 
+/*Number of different block sizes the draw task pool can store*/
+#define LV_DRAW_TASK_POOL_SIZE_CNT  12
+
+/*Number of free layer buffers kept in the pool*/
+#define LV_DRAW_LAYER_BUF_POOL_CNT  8
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 struct _lv_draw_image_dsc_t;
 struct _lv_display_t;
+struct _lv_draw_task_grid_t;
+struct _lv_draw_list_t;
 
 typedef enum {
     LV_DRAW_TASK_TYPE_FILL,
@@ -50,6 +58,8 @@ typedef enum {
     LV_DRAW_TASK_TYPE_VECTOR,
 } lv_draw_task_type_t;
 
+#define LV_DRAW_TASK_TYPE_CNT   (LV_DRAW_TASK_TYPE_VECTOR + 1)
+
 typedef enum {
     LV_DRAW_TASK_STATE_WAITING,     /*Waiting for something to be finished. E.g. rendering a layer*/
     LV_DRAW_TASK_STATE_QUEUED,
@@ -57,6 +67,50 @@ typedef enum {
     LV_DRAW_TASK_STATE_READY,
 } lv_draw_task_state_t;
 
+#if LV_USE_DRAW_STAT
+typedef struct {
+    uint32_t created_cnt;       /**< Number of draw tasks created*/
+    uint32_t rendered_cnt;      /**< Number of times a draw unit rendered a draw task (or a stripe of it)*/
+    uint32_t blend_px_cnt;      /**< Number of pixels blended while rendering*/
+    uint32_t render_time;       /**< Time spent rendering [us]*/
+} lv_draw_stat_task_type_t;
+
+typedef struct {
+    uint32_t task_cnt;          /**< Number of draw tasks rendered*/
+    uint32_t busy_time;         /**< Time spent rendering [us]. The draw unit was idle in the rest of the time.*/
+    lv_draw_stat_task_type_t types[LV_DRAW_TASK_TYPE_CNT];  /**< By draw task type. `created_cnt` is not used here.*/
+    uint32_t _task_start;       /**< Start time of the draw task being rendered*/
+    lv_draw_task_type_t _task_type; /**< Type of the draw task being rendered*/
+} lv_draw_stat_unit_t;
+
+typedef struct {
+    uint32_t elapsed_time;          /**< Time since the last reset [us]*/
+    uint32_t task_created_cnt;      /**< Number of draw tasks created*/
+    uint32_t task_dispatched_cnt;   /**< Number of draw tasks taken by the draw units (as returned by `dispatch_cb`)*/
+    uint32_t task_stall_cnt;        /**< Number of times an idle draw unit found only draw tasks waiting for other ones*/
+    uint32_t layer_mem_peak_kb;     /**< The most memory used by the layers at once [kB]*/
+    uint32_t unit_cnt;              /**< Number of draw units. See `lv_draw_stat_get_unit`*/
+    lv_draw_stat_task_type_t types[LV_DRAW_TASK_TYPE_CNT];  /**< By draw task type, summed for all draw units*/
+} lv_draw_stat_t;
+#endif
+
+#if LV_DRAW_TASK_BATCH_MAX
+/**
+ * A draw task merged into an other draw task of the same type
+ */
+typedef struct {
+    lv_area_t area;             /**< The area of the merged draw task*/
+    lv_area_t clip_area;        /**< The clip area of the merged draw task*/
+    void * draw_dsc;            /**< The draw descriptor of the merged draw task*/
+} lv_draw_task_batch_item_t;
+
+typedef struct {
+    uint32_t cnt;
+    /** The first item is the draw task itself with its original area and clip area*/
+    lv_draw_task_batch_item_t items[LV_DRAW_TASK_BATCH_MAX];
+} lv_draw_task_batch_t;
+#endif
+
 typedef struct _lv_draw_task_t {
     struct _lv_draw_task_t * next;
 
@@ -94,6 +148,25 @@ typedef struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+#if LV_DRAW_TASK_GRID_SIZE
+    /**
+     * The first and last column and row of the layer's draw task grid where this task is indexed.
+     * Saved when the task is indexed to remove it from the same cells.
+     */
+    uint8_t grid_col1;
+    uint8_t grid_row1;
+    uint8_t grid_col2;
+    uint8_t grid_row2;
+#endif
+
+#if LV_DRAW_TASK_BATCH_MAX
+    /**
+     * If not NULL the draw task contains more draw tasks of the same type. All of them should be drawn.
+     * `area` and `clip_area` are the bounding boxes of the merged draw tasks' areas and clip areas.
+     */
+    lv_draw_task_batch_t * batch;
+#endif
+
 } lv_draw_task_t;
 
 typedef struct {
@@ -140,6 +213,20 @@ typedef struct _lv_draw_unit_t {
      * @return
      */
     int32_t (*delete_cb)(struct _lv_draw_unit_t * draw_unit);
+
+    /**
+     * If not 0, the draw unit can render the batched draw tasks (see `lv_draw_task_t::batch`)
+     * whose `preferred_draw_unit_id` is this value
+     */
+    uint8_t batch_id;
+
+#if LV_USE_DRAW_STAT
+    /**
+     * Rendering statistics of the draw unit.
+     * Updated by the draw unit via `lv_draw_stat_task_start/finish` and `lv_draw_stat_add_blend_px`
+     */
+    lv_draw_stat_unit_t stat;
+#endif
 } lv_draw_unit_t;
 
 typedef struct _lv_layer_t  {
@@ -171,6 +258,39 @@ typedef struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** The last draw task of the list to add new draw tasks quickly */
+    lv_draw_task_t * draw_task_tail;
+
+#if LV_DRAW_TASK_GRID_SIZE
+    /** Number of draw tasks in the `draw_task_head` list*/
+    uint32_t draw_task_cnt;
+
+    /** Spatial index of the draw tasks to find the overlapping ones quickly.
+     * Created only if there are a lot of draw tasks on the layer and deleted when all of them are ready.*/
+    struct _lv_draw_task_grid_t * draw_task_grid;
+
+    /** Adding a draw task to the grid failed so use the linear search until all draw tasks are ready*/
+    bool draw_task_grid_invalid;
+#endif
+
+    /** Bounding box of the clip areas of the draw tasks added to the layer so far.
+     * Only this part of a new buffer needs to be cleared.*/
+    lv_area_t _draw_area;
+
+    /** The part of the buffer which is already cleared*/
+    lv_area_t _cleared_area;
+
+    /** Size of the buffer allocated by `lv_draw_layer_alloc_buf` [bytes]*/
+    uint32_t _buf_size;
+
+    /** The buffer was allocated by `lv_draw_layer_alloc_buf` and it's cleared only where it's drawn*/
+    bool _lazy_clear;
+
+#if LV_DRAW_TASK_BATCH_MAX
+    /** The last draw task of the layer if the next similar draw tasks can be merged into it*/
+    lv_draw_task_t * _batch_task;
+#endif
+
     struct _lv_layer_t * parent;
     struct _lv_layer_t * next;
     bool all_tasks_added;
@@ -187,9 +307,41 @@ typedef struct {
     void * user_data;
 } lv_draw_dsc_base_t;
 
+typedef struct {
+    uint32_t heap_alloc_cnt;    /**< Number of blocks allocated by `lv_malloc`*/
+    uint32_t heap_free_cnt;     /**< Number of blocks freed by `lv_free`*/
+    uint32_t reuse_cnt;         /**< Number of blocks taken from the pool instead of allocating them*/
+    uint32_t pooled_size;       /**< Size of the free blocks kept in the pool [bytes]*/
+} lv_draw_task_pool_stat_t;
+
+typedef struct {
+    uint32_t culled_task_cnt;   /**< Number of draw tasks dropped as a newer draw task covered them*/
+    uint32_t clipped_task_cnt;  /**< Number of draw tasks whose clip area was reduced as a newer draw task covered a side*/
+    uint32_t culled_px_cnt;     /**< Number of pixels which were not rendered due to the dropped or clipped draw tasks*/
+} lv_draw_occlusion_stat_t;
+
+typedef struct {
+    uint32_t size;              /**< Size of the blocks. 0: this slot is not used yet*/
+    void * free_head;           /**< Linked list of free blocks of this size*/
+} _lv_draw_task_pool_t;
+
+typedef struct {
+    void * buf_unaligned;       /**< A free layer buffer. NULL: this slot is empty*/
+    uint32_t size;              /**< Size of the buffer [bytes]*/
+    uint32_t stride;            /**< The buffer can be reused only for layers with the same stride...*/
+    lv_color_format_t color_format; /**< ...and color format*/
+} _lv_draw_layer_buf_pool_entry_t;
+
 typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t used_memory_for_layers_kb;
+    uint32_t pooled_memory_for_layers_kb;   /**< Size of the free layer buffers kept for reuse*/
+    uint32_t layer_buf_reuse_cnt;           /**< Number of layer buffers taken from the pool*/
+    uint32_t layer_buf_alloc_cnt;           /**< Number of layer buffers allocated as none was found in the pool*/
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    _lv_draw_layer_buf_pool_entry_t layer_buf_pool[LV_DRAW_LAYER_BUF_POOL_CNT];
+    uint32_t layer_buf_pooled_size;         /**< Size of the free layer buffers in bytes*/
+#endif
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
@@ -197,6 +349,16 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_DRAW_TASK_POOL_SIZE
+    _lv_draw_task_pool_t task_pools[LV_DRAW_TASK_POOL_SIZE_CNT];
+#endif
+    lv_draw_task_pool_stat_t task_pool_stat;
+    lv_draw_occlusion_stat_t occlusion_stat;
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_t stat;                        /**< `types` stores only the `created_cnt`*/
+    uint32_t stat_start_time;                   /**< Time of the last reset [us]*/
+#endif
+    struct _lv_draw_list_t * draw_list_act;     /**< The draw list being recorded (the newest if nested)*/
 } lv_draw_global_info_t;
 
 /**********************
@@ -218,6 +380,95 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t);
 
+/**
+ * Allocate memory for a draw task or for the draw descriptor of a draw task.
+ * Blocks freed earlier with the same size are reused if possible.
+ * Should be called only from the thread which creates the draw tasks.
+ * @param size      size of the block in bytes
+ * @return          pointer to the allocated memory or NULL on error
+ */
+void * lv_draw_task_pool_alloc(size_t size);
+
+/**
+ * Free a block allocated by `lv_draw_task_pool_alloc`.
+ * It's kept in the pool for reuse while there is space for it in `LV_DRAW_TASK_POOL_SIZE`.
+ * @param p         pointer to the block to free (NULL is ignored)
+ */
+void lv_draw_task_pool_free(void * p);
+
+/**
+ * Free all the blocks kept in the draw task pool
+ */
+void lv_draw_task_pool_flush(void);
+
+/**
+ * Get the statistics of the draw task pool
+ * @param stat      store the statistics here
+ */
+void lv_draw_task_pool_get_stat(lv_draw_task_pool_stat_t * stat);
+
+/**
+ * Reset the allocation and reuse counters of the draw task pool.
+ * E.g. call it at the beginning of a frame to see how many heap operations the frame needed.
+ */
+void lv_draw_task_pool_reset_stat(void);
+
+/**
+ * Get how much overdraw was avoided by dropping or clipping the hidden draw tasks.
+ * Used only if `LV_DRAW_OCCLUSION_CULLING` is enabled.
+ * @param stat      store the statistics here
+ */
+void lv_draw_occlusion_get_stat(lv_draw_occlusion_stat_t * stat);
+
+/**
+ * Reset the counters of the occlusion culling statistics
+ */
+void lv_draw_occlusion_reset_stat(void);
+
+#if LV_USE_DRAW_STAT
+
+/**
+ * Get the rendering statistics collected since the last `lv_draw_stat_reset`
+ * @param stat      store the statistics here
+ */
+void lv_draw_stat_get(lv_draw_stat_t * stat);
+
+/**
+ * Get the rendering statistics of a draw unit
+ * @param idx       index of the draw unit, `0 .. lv_draw_stat_t::unit_cnt - 1`
+ * @param stat      store the statistics here
+ * @return          LV_RESULT_OK: `stat` is set; LV_RESULT_INVALID: there is no draw unit with this index
+ */
+lv_result_t lv_draw_stat_get_unit(uint32_t idx, lv_draw_stat_unit_t * stat);
+
+/**
+ * Reset all counters of the rendering statistics.
+ * Call it only while no draw unit is rendering, e.g. in `LV_EVENT_REFR_START` to get the statistics of one frame.
+ */
+void lv_draw_stat_reset(void);
+
+/**
+ * Called by the draw units when they start rendering a draw task (or a stripe of it)
+ * @param draw_unit pointer to a draw unit
+ * @param type      type of the draw task
+ */
+void lv_draw_stat_task_start(lv_draw_unit_t * draw_unit, lv_draw_task_type_t type);
+
+/**
+ * Called by the draw units when they finished rendering the draw task passed to `lv_draw_stat_task_start`
+ * @param draw_unit pointer to a draw unit
+ */
+void lv_draw_stat_task_finish(lv_draw_unit_t * draw_unit);
+
+/**
+ * Called by the draw units when they blend pixels for the draw task being rendered
+ * @param draw_unit pointer to a draw unit
+ * @param px_cnt    number of blended pixels
+ */
+void lv_draw_stat_add_blend_px(lv_draw_unit_t * draw_unit, uint32_t px_cnt);
+
+#endif /*LV_USE_DRAW_STAT*/
+
 void lv_draw_dispatch(void);
 
 bool lv_draw_dispatch_layer(struct _lv_display_t * disp, lv_layer_t * layer);
@@ -260,11 +511,19 @@ lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t c
 
 /**
  * Try to allocate a buffer for the layer.
+ * A buffer of a freed layer with the same color format and stride is reused if there is one in the pool.
+ * Layers with alpha channel are cleared only where the draw tasks added so far will draw,
+ * so it should be called again when a new draw task of the layer is started.
  * @param layer             pointer to a layer
  * @return                  pointer to the allocated aligned buffer or NULL on failure
  */
 void * lv_draw_layer_alloc_buf(lv_layer_t * layer);
 
+/**
+ * Free all the layer buffers kept in the pool for reuse
+ */
+void lv_draw_layer_buf_pool_flush(void);
+
 /**
  * Got to a pixel at X and Y coordinate on a layer
  * @param layer             pointer to a layer
@@ -292,6 +551,7 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y);
 #include "lv_draw_line.h"
 #include "lv_draw_triangle.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_list.h"
 
 #ifdef __cplusplus
 } /*extern "C"*/
@@ -217,6 +217,33 @@ lv_draw_buf_t * lv_draw_buf_adjust_stride(const lv_draw_buf_t * src, uint32_t st
     return dst;
 }
 
+lv_result_t lv_draw_buf_premultiply(lv_draw_buf_t * draw_buf)
+{
+    LV_ASSERT_NULL(draw_buf);
+    if(draw_buf == NULL) return LV_RESULT_INVALID;
+
+    if(draw_buf->header.cf == LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED) return LV_RESULT_OK;
+    if(draw_buf->header.cf != LV_COLOR_FORMAT_ARGB8888) {
+        LV_LOG_WARN("Only ARGB8888 can be premultiplied");
+        return LV_RESULT_INVALID;
+    }
+
+    uint8_t * row = draw_buf->data;
+    uint32_t y;
+    for(y = 0; y < draw_buf->header.h; y++) {
+        lv_color32_t * px = (lv_color32_t *)row;
+        uint32_t x;
+        for(x = 0; x < draw_buf->header.w; x++) {
+            if(px[x].alpha < LV_OPA_COVER) px[x] = lv_color32_premultiply(px[x]);
+        }
+        row += draw_buf->header.stride;
+    }
+
+    draw_buf->header.cf = LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED;
+    draw_buf->header.flags |= LV_IMAGE_FLAGS_PREMULTIPLIED;
+    return LV_RESULT_OK;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -260,7 +287,7 @@ static void * buf_go_to_xy(const void * buf, uint32_t stride, lv_color_format_t
 {
     const uint8_t * buf_tmp = buf;
     buf_tmp += stride * y;
-    buf_tmp += x * lv_color_format_get_size(color_format);
+    buf_tmp += (x * lv_color_format_get_bpp(color_format)) >> 3;
 
     return (void *)buf_tmp;
 }
@@ -270,15 +297,16 @@ static void buf_clear(void * buf, uint32_t w, uint32_t h, lv_color_format_t colo
 
     LV_UNUSED(h);
 
-    uint8_t px_size = lv_color_format_get_size(color_format);
+    uint8_t bpp = lv_color_format_get_bpp(color_format);
     uint32_t stride = lv_draw_buf_width_to_stride(w, color_format);
     uint8_t * bufc =  buf;
 
     /*Got the first pixel of each buffer*/
     bufc += stride * a->y1;
-    bufc += a->x1 * px_size;
+    bufc += (a->x1 * bpp) >> 3;
 
-    uint32_t line_length = lv_area_get_width(a) * px_size;
+    /*Formats with less than 8 bpp are cleared in whole bytes*/
+    uint32_t line_length = (((a->x2 + 1) * bpp + 7) >> 3) - ((a->x1 * bpp) >> 3);
     int32_t y;
     for(y = a->y1; y <= a->y2; y++) {
         lv_memzero(bufc, line_length);
@@ -294,7 +322,7 @@ static void buf_copy(void * dest_buf, uint32_t dest_w, uint32_t dest_h, const lv
     LV_UNUSED(dest_h);
     LV_UNUSED(src_h);
 
-    uint8_t px_size = lv_color_format_get_size(color_format);
+    uint8_t bpp = lv_color_format_get_bpp(color_format);
     uint8_t * dest_bufc =  dest_buf;
     uint8_t * src_bufc =  src_buf;
 
@@ -303,12 +331,13 @@ static void buf_copy(void * dest_buf, uint32_t dest_w, uint32_t dest_h, const lv
 
     /*Got the first pixel of each buffer*/
     dest_bufc += dest_stride * dest_area_to_copy->y1;
-    dest_bufc += dest_area_to_copy->x1 * px_size;
+    dest_bufc += (dest_area_to_copy->x1 * bpp) >> 3;
 
     src_bufc += src_stride * src_area_to_copy->y1;
-    src_bufc += src_area_to_copy->x1 * px_size;
+    src_bufc += (src_area_to_copy->x1 * bpp) >> 3;
 
-    uint32_t line_length = lv_area_get_width(dest_area_to_copy) * px_size;
+    /*Formats with less than 8 bpp are copied in whole bytes*/
+    uint32_t line_length = (((dest_area_to_copy->x2 + 1) * bpp + 7) >> 3) - ((dest_area_to_copy->x1 * bpp) >> 3);
     int32_t y;
     for(y = dest_area_to_copy->y1; y <= dest_area_to_copy->y2; y++) {
         lv_memcpy(dest_bufc, src_bufc, line_length);
@@ -193,6 +193,14 @@ void * lv_draw_buf_goto_xy(lv_draw_buf_t * buf, uint32_t x, uint32_t y);
  */
 lv_draw_buf_t * lv_draw_buf_adjust_stride(const lv_draw_buf_t * src, uint32_t stride);
 
+/**
+ * Multiply the color channels of an ARGB8888 draw buf with the alpha channel in place.
+ * The color format of the draw buf is changed to `LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED`.
+ * @param draw_buf  pointer to an ARGB8888 draw buf
+ * @return          LV_RESULT_OK: premultiplied or it was already premultiplied; LV_RESULT_INVALID: not supported color format
+ */
+lv_result_t lv_draw_buf_premultiply(lv_draw_buf_t * draw_buf);
+
 /**
  * As of now, draw buf share same definition as `lv_image_dsc_t`.
  * And is interchangeable with `lv_image_dsc_t`.
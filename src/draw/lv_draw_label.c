@@ -14,6 +14,7 @@
 #include "../misc/lv_assert.h"
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
+#include "../font/lv_font_fmt_txt.h"
 
 /*********************
  *      DEFINES
@@ -30,6 +31,10 @@
  **********************/
 static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,  const lv_point_t * pos,
                         const lv_font_t * font, uint32_t letter, lv_draw_letter_cb_t cb);
+static uint32_t line_end_get(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                             uint32_t line_start, int32_t w);
+static int32_t line_width_get(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,7 +84,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_layer_t * layer, const lv_draw_label
     LV_PROFILER_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_pool_alloc(sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LABEL;
 
@@ -179,7 +184,7 @@ void lv_draw_label_iterate_letters(lv_draw_unit_t * draw_unit, const lv_draw_lab
     int32_t last_line_start = -1;
 
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    if(dsc->hint && dsc->line_ends == NULL && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -193,14 +198,53 @@ void lv_draw_label_iterate_letters(lv_draw_unit_t * draw_unit, const lv_draw_lab
         pos.y += dsc->hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL,
-                                                            dsc->flag);
+    const lv_text_layout_t * layout = NULL;
+    uint32_t line_idx = 0;
+
+    if(dsc->line_ends) {
+        /*Jump to the first visible line using the line index*/
+        int32_t dist = draw_unit->clip_area->y1 - (pos.y + line_height_font);
+        if(dist > 0 && line_height > 0) {
+            line_idx = LV_MIN((uint32_t)((dist + line_height - 1) / line_height), dsc->line_cnt);
+            if(line_idx > 0) line_start = dsc->line_ends[line_idx - 1];
+            pos.y += (int32_t)line_idx * line_height;
+        }
+    }
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    else {
+        /*Use the cached line breaks and widths*/
+        layout = lv_text_layout_get(dsc->text, font, dsc->letter_space, w, dsc->flag);
+    }
+
+    /*Find the line of the hint*/
+    if(layout && line_start > 0) {
+        uint32_t first = 0;
+        uint32_t last = layout->line_cnt;
+        while(first < last) {
+            uint32_t mid = (first + last) / 2;
+            if(layout->line_ends[mid] < line_start) first = mid + 1;
+            else last = mid;
+        }
+
+        if(first < layout->line_cnt && layout->line_ends[first] == line_start) {
+            line_idx = first + 1;
+        }
+        else {
+            /*The hint is not at a line break of the layout, measure the lines instead*/
+            lv_text_layout_release(layout);
+            layout = NULL;
+        }
+    }
+#endif
+
+    uint32_t line_end = line_end_get(dsc, layout, line_idx, line_start, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = line_end_get(dsc, layout, line_idx, line_start, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -210,19 +254,24 @@ void lv_draw_label_iterate_letters(lv_draw_unit_t * draw_unit, const lv_draw_lab
             dsc->hint->coord_y    = coords->y1;
         }
 
-        if(dsc->text[line_start] == '\0') return;
+        if(dsc->text[line_start] == '\0') {
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+            if(layout) lv_text_layout_release(layout);
+#endif
+            return;
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = line_width_get(dsc, layout, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+        line_width = line_width_get(dsc, layout, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -333,20 +382,19 @@ void lv_draw_label_iterate_letters(lv_draw_unit_t * draw_unit, const lv_draw_lab
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_text_get_next_line(&dsc->text[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_idx++;
+        line_end = line_end_get(dsc, layout, line_idx, line_start, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = line_width_get(dsc, layout, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space);
+            line_width = line_width_get(dsc, layout, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -356,6 +404,9 @@ void lv_draw_label_iterate_letters(lv_draw_unit_t * draw_unit, const lv_draw_lab
         if(pos.y > draw_unit->clip_area->y2) break;
     }
     lv_draw_buf_free(draw_letter_dsc._bitmap_buf_unaligned);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout) lv_text_layout_release(layout);
+#endif
 
     LV_ASSERT_MEM_INTEGRITY();
 }
@@ -398,18 +449,29 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
         return;
     }
 
-    uint32_t bitmap_size = lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8) * g.box_h;
-    bitmap_size = (bitmap_size + 63) &
-                  (~63);   /*Round up to avoid many allocations if the next buffer is just slightly larger*/
-    if(dsc->_bitmap_buf_size < bitmap_size) {
-        lv_draw_buf_free(dsc->_bitmap_buf_unaligned);
-        dsc->_bitmap_buf_unaligned = lv_draw_buf_malloc(bitmap_size, LV_COLOR_FORMAT_A8);
-        LV_ASSERT_MALLOC(dsc->_bitmap_buf_unaligned);
-        dsc->bitmap_buf = lv_draw_buf_align(dsc->_bitmap_buf_unaligned, LV_COLOR_FORMAT_A8);
-        dsc->_bitmap_buf_size = bitmap_size;
+    const uint8_t * cached_bitmap = NULL;
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*The decoded bitmaps of the built-in fonts can be shared between the draw units*/
+    if(g.resolved_font && g.resolved_font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt) {
+        cached_bitmap = lv_font_fmt_txt_glyph_cache_get(g.resolved_font, letter);
+    }
+#endif
+
+    if(cached_bitmap) {
+        dsc->bitmap = cached_bitmap;
     }
+    else if(g.resolved_font) {
+        uint32_t bitmap_size = lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8) * g.box_h;
+        bitmap_size = (bitmap_size + 63) &
+                      (~63);   /*Round up to avoid many allocations if the next buffer is just slightly larger*/
+        if(dsc->_bitmap_buf_size < bitmap_size) {
+            lv_draw_buf_free(dsc->_bitmap_buf_unaligned);
+            dsc->_bitmap_buf_unaligned = lv_draw_buf_malloc(bitmap_size, LV_COLOR_FORMAT_A8);
+            LV_ASSERT_MALLOC(dsc->_bitmap_buf_unaligned);
+            dsc->bitmap_buf = lv_draw_buf_align(dsc->_bitmap_buf_unaligned, LV_COLOR_FORMAT_A8);
+            dsc->_bitmap_buf_size = bitmap_size;
+        }
 
-    if(g.resolved_font) {
         dsc->bitmap = lv_font_get_glyph_bitmap(g.resolved_font, letter, dsc->bitmap_buf);
     }
     else {
@@ -420,5 +482,40 @@ static void draw_letter(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * dsc,
     else dsc->format = LV_DRAW_LETTER_BITMAP_FORMAT_A8;
 
     cb(draw_unit, dsc, NULL, NULL);
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    if(cached_bitmap) lv_font_fmt_txt_glyph_cache_release(cached_bitmap);
+#endif
     LV_PROFILER_END;
 }
+
+/**
+ * Get the start of the next line from the line index, the layout or by measuring the text
+ */
+static uint32_t line_end_get(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                             uint32_t line_start, int32_t w)
+{
+    if(dsc->line_ends) return line_idx < dsc->line_cnt ? dsc->line_ends[line_idx] : line_start;
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout) return line_idx < layout->line_cnt ? layout->line_ends[line_idx] : line_start;
+#else
+    LV_UNUSED(layout);
+#endif
+    return line_start + _lv_text_get_next_line(&dsc->text[line_start], dsc->font, dsc->letter_space, w, NULL,
+                                               dsc->flag);
+}
+
+/**
+ * Get the width of a line from the layout or by measuring the text
+ */
+static int32_t line_width_get(const lv_draw_label_dsc_t * dsc, const lv_text_layout_t * layout, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout) return line_idx < layout->line_cnt ? layout->line_widths[line_idx] : 0;
+#else
+    LV_UNUSED(layout);
+    LV_UNUSED(line_idx);
+#endif
+    return lv_text_get_width(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space);
+}
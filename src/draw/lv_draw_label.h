@@ -71,6 +71,11 @@ typedef struct {
      * 0: `text` is const and it's pointer will be valid during rendering.*/
     uint8_t text_local : 1;
     lv_draw_label_hint_t * hint;
+
+    /** Optional start of the next line for each wrapped line of `text`.
+     * If set the drawing starts at the first visible line directly and `hint` is not used.*/
+    const uint32_t * line_ends;
+    uint32_t line_cnt;
 } lv_draw_label_dsc_t;
 
 typedef enum {
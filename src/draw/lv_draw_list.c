@@ -0,0 +1,326 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_list.h"
+#include "../core/lv_global.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define _draw_info LV_GLOBAL_DEFAULT()->draw_info
+
+#define DRAW_LIST_INIT_CAPACITY    8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_draw_task_type_t type;
+    lv_area_t area;
+    lv_area_t clip_area;
+    void * draw_dsc;
+} lv_draw_list_item_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool record_task(lv_draw_list_t * list, lv_layer_t * layer, const lv_draw_task_t * t);
+static size_t get_dsc_size(lv_draw_task_type_t type);
+static void shift_dsc(lv_draw_task_type_t type, void * draw_dsc, int32_t ofs_x, int32_t ofs_y);
+static void free_item_dsc(lv_draw_list_item_t * item);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_draw_list_t * lv_draw_list_create(void)
+{
+    lv_draw_list_t * list = lv_malloc_zeroed(sizeof(lv_draw_list_t));
+    LV_ASSERT_MALLOC(list);
+    if(list == NULL) return NULL;
+
+    lv_array_init(&list->items, DRAW_LIST_INIT_CAPACITY, sizeof(lv_draw_list_item_t));
+    return list;
+}
+
+void lv_draw_list_delete(lv_draw_list_t * list)
+{
+    if(list == NULL) return;
+
+    /*Can't be deleted while recording as it's referenced by the newer recordings*/
+    if(list->recording) {
+        list->delete_pending = 1;
+        return;
+    }
+
+    lv_draw_list_invalidate(list);
+    lv_array_destroy(&list->items);
+    lv_free(list);
+}
+
+void lv_draw_list_invalidate(lv_draw_list_t * list)
+{
+    if(list == NULL) return;
+
+    uint32_t cnt = lv_array_length(&list->items);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        free_item_dsc((lv_draw_list_item_t *)lv_array_get(&list->items, i));
+    }
+    lv_array_clear(&list->items);
+    list->valid = 0;
+}
+
+bool lv_draw_list_is_recordable(const lv_draw_list_t * list)
+{
+    return list->recording == 0 && list->unrecordable == 0;
+}
+
+void lv_draw_list_start_record(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords)
+{
+    LV_ASSERT_NULL(list);
+    LV_ASSERT(list->recording == 0);
+
+    lv_draw_list_invalidate(list);
+
+    list->coords = *coords;
+    list->layer = layer;
+    list->valid = 1;    /*Cleared if a draw task can't be recorded*/
+    list->recording = 1;
+
+    list->prev = _draw_info.draw_list_act;
+    _draw_info.draw_list_act = list;
+}
+
+void lv_draw_list_finish_record(lv_draw_list_t * list)
+{
+    LV_ASSERT_NULL(list);
+
+    /*Recordings are nested so the last started one should be finished first*/
+    LV_ASSERT(_draw_info.draw_list_act == list);
+
+    _draw_info.draw_list_act = list->prev;
+    list->prev = NULL;
+    list->layer = NULL;
+    list->recording = 0;
+
+    if(list->delete_pending) {
+        lv_draw_list_delete(list);
+        return;
+    }
+
+    /*Don't keep the descriptors if they can't be replayed anyway*/
+    if(list->valid == 0) lv_draw_list_invalidate(list);
+}
+
+lv_result_t lv_draw_list_replay(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords)
+{
+    LV_ASSERT_NULL(list);
+    if(list->valid == 0 || list->recording) return LV_RESULT_INVALID;
+
+    LV_PROFILER_BEGIN;
+    int32_t ofs_x = coords->x1 - list->coords.x1;
+    int32_t ofs_y = coords->y1 - list->coords.y1;
+
+    lv_area_t clip_area_ori = layer->_clip_area;
+    uint32_t cnt = lv_array_length(&list->items);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_draw_list_item_t * item = (lv_draw_list_item_t *)lv_array_get(&list->items, i);
+
+        lv_area_t clip_area = item->clip_area;
+        lv_area_move(&clip_area, ofs_x, ofs_y);
+        if(!_lv_area_intersect(&clip_area, &clip_area, &clip_area_ori)) continue;
+
+        lv_area_t area = item->area;
+        lv_area_move(&area, ofs_x, ofs_y);
+
+        layer->_clip_area = clip_area;
+        lv_draw_task_t * t = lv_draw_add_task(layer, &area);
+
+        size_t dsc_size = get_dsc_size(item->type);
+        t->draw_dsc = lv_draw_task_pool_alloc(dsc_size);
+        lv_memcpy(t->draw_dsc, item->draw_dsc, dsc_size);
+        t->type = item->type;
+        shift_dsc(t->type, t->draw_dsc, ofs_x, ofs_y);
+
+        if(t->type == LV_DRAW_TASK_TYPE_LABEL) {
+            lv_draw_label_dsc_t * label_dsc = t->draw_dsc;
+            if(label_dsc->text_local) label_dsc->text = lv_strdup(label_dsc->text);
+        }
+
+        lv_draw_finalize_task_creation(layer, t);
+    }
+
+    layer->_clip_area = clip_area_ori;
+    LV_PROFILER_END;
+
+    return LV_RESULT_OK;
+}
+
+void _lv_draw_list_record_task(lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    lv_draw_list_t * list = _draw_info.draw_list_act;
+    while(list) {
+        if(list->valid) {
+            if(!record_task(list, layer, t)) lv_draw_list_invalidate(list);
+        }
+        list = list->prev;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool record_task(lv_draw_list_t * list, lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    /*Draw tasks of other layers (e.g. of a child with opacity or transformation)
+     *would need the other layer too. It won't change in the next frames so don't try again.*/
+    if(layer != list->layer) {
+        list->unrecordable = 1;
+        return false;
+    }
+
+    size_t dsc_size = get_dsc_size(t->type);
+    if(dsc_size == 0) {
+        list->unrecordable = 1;
+        return false;
+    }
+
+    /*The supplementary data is owned by the caller*/
+    if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t * image_dsc = t->draw_dsc;
+        if(image_dsc->sup) {
+            list->unrecordable = 1;
+            return false;
+        }
+    }
+
+    if(lv_array_is_full(&list->items)) {
+        if(!lv_array_resize(&list->items, lv_array_capacity(&list->items) * 2)) return false;
+    }
+
+    lv_draw_list_item_t item;
+    item.type = t->type;
+    item.area = t->area;
+    item.clip_area = t->clip_area;
+    item.draw_dsc = lv_malloc(dsc_size);
+    LV_ASSERT_MALLOC(item.draw_dsc);
+    if(item.draw_dsc == NULL) return false;
+    lv_memcpy(item.draw_dsc, t->draw_dsc, dsc_size);
+
+    if(item.type == LV_DRAW_TASK_TYPE_LABEL) {
+        /*The text, the hint and the line ends point into the widget which can change or free them
+         *without invalidating the list. Keep a copy of the text and find the lines again when replayed.*/
+        lv_draw_label_dsc_t * label_dsc = item.draw_dsc;
+        label_dsc->text = lv_strdup(label_dsc->text);
+        label_dsc->text_local = 1;
+        label_dsc->hint = NULL;
+        label_dsc->line_ends = NULL;
+        label_dsc->line_cnt = 0;
+        if(label_dsc->text == NULL) {
+            lv_free(item.draw_dsc);
+            return false;
+        }
+    }
+
+    if(!lv_array_append(&list->items, (uint8_t *)&item)) {
+        free_item_dsc(&item);
+        return false;
+    }
+
+    return true;
+}
+
+static size_t get_dsc_size(lv_draw_task_type_t type)
+{
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            return sizeof(lv_draw_fill_dsc_t);
+        case LV_DRAW_TASK_TYPE_BORDER:
+            return sizeof(lv_draw_border_dsc_t);
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            return sizeof(lv_draw_box_shadow_dsc_t);
+        case LV_DRAW_TASK_TYPE_LABEL:
+            return sizeof(lv_draw_label_dsc_t);
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            return sizeof(lv_draw_image_dsc_t);
+        case LV_DRAW_TASK_TYPE_LINE:
+            return sizeof(lv_draw_line_dsc_t);
+        case LV_DRAW_TASK_TYPE_ARC:
+            return sizeof(lv_draw_arc_dsc_t);
+        case LV_DRAW_TASK_TYPE_TRIANGLE:
+            return sizeof(lv_draw_triangle_dsc_t);
+        case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
+            return sizeof(lv_draw_mask_rect_dsc_t);
+        default:
+            /*Layers and bitmap masks refer to other layers, vector graphics have their own data*/
+            return 0;
+    }
+}
+
+/**
+ * Shift the absolute coordinates stored in a draw descriptor
+ */
+static void shift_dsc(lv_draw_task_type_t type, void * draw_dsc, int32_t ofs_x, int32_t ofs_y)
+{
+    if(ofs_x == 0 && ofs_y == 0) return;
+
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_LINE: {
+                lv_draw_line_dsc_t * dsc = draw_dsc;
+                dsc->p1.x += ofs_x;
+                dsc->p1.y += ofs_y;
+                dsc->p2.x += ofs_x;
+                dsc->p2.y += ofs_y;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_ARC: {
+                lv_draw_arc_dsc_t * dsc = draw_dsc;
+                dsc->center.x += ofs_x;
+                dsc->center.y += ofs_y;
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_TRIANGLE: {
+                lv_draw_triangle_dsc_t * dsc = draw_dsc;
+                uint32_t i;
+                for(i = 0; i < 3; i++) {
+                    dsc->p[i].x += ofs_x;
+                    dsc->p[i].y += ofs_y;
+                }
+                break;
+            }
+        case LV_DRAW_TASK_TYPE_MASK_RECTANGLE: {
+                lv_draw_mask_rect_dsc_t * dsc = draw_dsc;
+                lv_area_move(&dsc->area, ofs_x, ofs_y);
+                break;
+            }
+        default:
+            break;
+    }
+}
+
+static void free_item_dsc(lv_draw_list_item_t * item)
+{
+    if(item->type == LV_DRAW_TASK_TYPE_LABEL) {
+        lv_draw_label_dsc_t * label_dsc = item->draw_dsc;
+        if(label_dsc->text_local) lv_free((void *)label_dsc->text);
+    }
+    lv_free(item->draw_dsc);
+    item->draw_dsc = NULL;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file lv_draw_list.h
+ *
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+#include "../misc/lv_array.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The draw tasks added by an object (and its children) saved to add them again later
+ * without sending the draw events to the object.
+ */
+typedef struct _lv_draw_list_t {
+    /** The saved draw tasks. Elements are `lv_draw_list_item_t`*/
+    lv_array_t items;
+
+    /** The coordinates of the recorded area. Used to shift the draw tasks if it has moved.*/
+    lv_area_t coords;
+
+    /** The layer to record the draw tasks from while recording*/
+    lv_layer_t * layer;
+
+    /** The draw list recorded before this one started (recordings can be nested)*/
+    struct _lv_draw_list_t * prev;
+
+    /** The draw tasks are recorded, the list can be replayed*/
+    uint8_t valid : 1;
+
+    /** Set while recording*/
+    uint8_t recording : 1;
+
+    /** `lv_draw_list_delete` was called while recording. The list is deleted when the recording is finished.*/
+    uint8_t delete_pending : 1;
+
+    /** The recorded draw tasks can't be replayed (e.g. some of them are drawn on an other layer)
+     * so don't try to record the list again. Not cleared by `lv_draw_list_invalidate`.*/
+    uint8_t unrecordable : 1;
+} lv_draw_list_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create an empty draw list
+ * @return      the new draw list
+ */
+lv_draw_list_t * lv_draw_list_create(void);
+
+/**
+ * Delete a draw list and the draw descriptors saved in it.
+ * If the list is being recorded it's deleted when the recording is finished.
+ * @param list  pointer to a draw list
+ */
+void lv_draw_list_delete(lv_draw_list_t * list);
+
+/**
+ * Delete the recorded draw tasks. The list needs to be recorded again before replaying it.
+ * @param list  pointer to a draw list
+ */
+void lv_draw_list_invalidate(lv_draw_list_t * list);
+
+/**
+ * Check if a draw list can be recorded
+ * @param list  pointer to a draw list
+ * @return      true: it's not being recorded and it hasn't failed because of an unsupported draw task
+ */
+bool lv_draw_list_is_recordable(const lv_draw_list_t * list);
+
+/**
+ * Start to save the draw tasks added to a layer.
+ * All the draw tasks covering `coords` need to be added while recording,
+ * i.e. the clip area of the layer shouldn't hide any part of `coords`.
+ * @param list      pointer to a draw list
+ * @param layer     save the draw tasks added to this layer
+ * @param coords    the area drawn during the recording (e.g. the object's coordinates with the ext. draw size)
+ */
+void lv_draw_list_start_record(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords);
+
+/**
+ * Finish saving the draw tasks. If a draw task couldn't be saved, the list remains invalid.
+ * If `lv_draw_list_delete` was called during the recording, the list is deleted here.
+ * @param list      pointer to a draw list passed to `lv_draw_list_start_record`
+ */
+void lv_draw_list_finish_record(lv_draw_list_t * list);
+
+/**
+ * Add the recorded draw tasks to a layer again.
+ * The draw tasks are shifted by the distance between `coords` and the recorded area
+ * and clipped to the current clip area of the layer.
+ * @param list      pointer to a valid draw list
+ * @param layer     add the draw tasks to this layer
+ * @param coords    the current coordinates of the recorded area
+ * @return          LV_RESULT_OK: the draw tasks are added; LV_RESULT_INVALID: the list is not recorded
+ */
+lv_result_t lv_draw_list_replay(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords);
+
+/**
+ * Save a new draw task in the draw lists being recorded.
+ * Called by `lv_draw_finalize_task_creation`
+ * @param layer     the layer of the draw task
+ * @param t         the new draw task
+ */
+void _lv_draw_list_record_task(lv_layer_t * layer, const lv_draw_task_t * t);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
@@ -125,12 +125,20 @@ static int32_t _vglite_evaluate(lv_draw_unit_t * u, lv_draw_task_t * t)
     LV_UNUSED(u);
 
     switch(t->type) {
-        case LV_DRAW_TASK_TYPE_FILL:
-            if(t->preference_score > 80) {
-                t->preference_score = 80;
-                t->preferred_draw_unit_id = DRAW_UNIT_ID_VGLITE;
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * draw_dsc = (lv_draw_fill_dsc_t *) t->draw_dsc;
+
+                /*Only the linear gradients are supported*/
+                if(draw_dsc->grad.dir == (lv_grad_dir_t)LV_GRAD_DIR_RADIAL ||
+                   draw_dsc->grad.dir == (lv_grad_dir_t)LV_GRAD_DIR_CONICAL)
+                    return 0;
+
+                if(t->preference_score > 80) {
+                    t->preference_score = 80;
+                    t->preferred_draw_unit_id = DRAW_UNIT_ID_VGLITE;
+                }
+                return 1;
             }
-            return 1;
 
         case LV_DRAW_TASK_TYPE_LINE:
         case LV_DRAW_TASK_TYPE_ARC:
@@ -243,7 +243,7 @@ static int32_t _dave2d_evaluate(lv_draw_unit_t * u, lv_draw_task_t * t)
 #if USE_D2
                 lv_draw_fill_dsc_t * dsc = t->draw_dsc;
                 if(dsc->grad.dir == LV_GRAD_DIR_NONE
-                   || ((dsc->grad.dir != LV_GRAD_DIR_NONE)
+                   || ((dsc->grad.dir == LV_GRAD_DIR_VER || dsc->grad.dir == LV_GRAD_DIR_HOR)
                        && ((dsc->grad.stops[0].color.blue == dsc->grad.stops[dsc->grad.stops_count - 1].color.blue)
                            && (dsc->grad.stops[0].color.red   == dsc->grad.stops[dsc->grad.stops_count - 1].color.red)
                            && (dsc->grad.stops[0].color.green == dsc->grad.stops[dsc->grad.stops_count - 1].color.green)))) {
@@ -326,7 +326,7 @@ static int32_t _dave2d_evaluate(lv_draw_unit_t * u, lv_draw_task_t * t)
 #if USE_D2
                 lv_draw_fill_dsc_t * dsc = t->draw_dsc;
                 if(dsc->grad.dir == LV_GRAD_DIR_NONE
-                   || ((dsc->grad.dir != LV_GRAD_DIR_NONE)
+                   || ((dsc->grad.dir == LV_GRAD_DIR_VER || dsc->grad.dir == LV_GRAD_DIR_HOR)
                        && ((dsc->grad.stops[0].color.blue == dsc->grad.stops[dsc->grad.stops_count - 1].color.blue)
                            && (dsc->grad.stops[0].color.red   == dsc->grad.stops[dsc->grad.stops_count - 1].color.red)
                            && (dsc->grad.stops[0].color.green == dsc->grad.stops[dsc->grad.stops_count - 1].color.green)))) {
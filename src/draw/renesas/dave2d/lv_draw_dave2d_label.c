@@ -83,8 +83,9 @@ static void lv_draw_dave2d_draw_letter_cb(lv_draw_unit_t * u, lv_draw_glyph_dsc_
 #endif
         }
         else if(glyph_draw_dsc->format == LV_DRAW_LETTER_BITMAP_FORMAT_A8) {
+            uint32_t stride = lv_draw_buf_width_to_stride((uint32_t)lv_area_get_width(&letter_coords), LV_COLOR_FORMAT_A8);
             lv_area_t mask_area = letter_coords;
-            mask_area.x2 = mask_area.x1 + lv_draw_buf_width_to_stride(lv_area_get_width(&mask_area), LV_COLOR_FORMAT_A8) - 1;
+            mask_area.x2 = mask_area.x1 + stride - 1;
             //            lv_draw_sw_blend_dsc_t blend_dsc;
             //            lv_memzero(&blend_dsc, sizeof(blend_dsc));
             //            blend_dsc.color = glyph_draw_dsc->color;
@@ -97,11 +98,11 @@ static void lv_draw_dave2d_draw_letter_cb(lv_draw_unit_t * u, lv_draw_glyph_dsc_
 
 #if defined(RENESAS_CORTEX_M85)
 #if (BSP_CFG_DCACHE_ENABLED)
-            d1_cacheblockflush(unit->d2_handle, 0, glyph_draw_dsc->bitmap, glyph_draw_dsc->_bitmap_buf_size);
+            /*The bitmap can come from the glyph cache too so flush only the glyph's rows*/
+            d1_cacheblockflush(unit->d2_handle, 0, glyph_draw_dsc->bitmap, stride * lv_area_get_height(&letter_coords));
 #endif
 #endif
-            d2_settexture(unit->d2_handle, (void *)glyph_draw_dsc->bitmap,
-                          (d2_s32)lv_draw_buf_width_to_stride((uint32_t)lv_area_get_width(&letter_coords), LV_COLOR_FORMAT_A8),
+            d2_settexture(unit->d2_handle, (void *)glyph_draw_dsc->bitmap, (d2_s32)stride,
                           lv_area_get_width(&letter_coords),  lv_area_get_height(&letter_coords), d2_mode_alpha8);
             d2_settexopparam(unit->d2_handle, d2_cc_red, glyph_draw_dsc->color.red, 0);
             d2_settexopparam(unit->d2_handle, d2_cc_green, glyph_draw_dsc->color.green, 0);
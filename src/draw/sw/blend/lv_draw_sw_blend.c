@@ -9,7 +9,11 @@
 #include "../lv_draw_sw.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
 #include "lv_draw_sw_blend_to_argb8888.h"
+#include "lv_draw_sw_blend_to_argb8888_premultiplied.h"
 #include "lv_draw_sw_blend_to_rgb888.h"
+#include "lv_draw_sw_blend_to_l8.h"
+#include "lv_draw_sw_blend_to_a8.h"
+#include "lv_draw_sw_blend_to_i1.h"
 
 #if LV_USE_DRAW_SW
 
@@ -46,6 +50,10 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
     if(!_lv_area_intersect(&blend_area, blend_dsc->blend_area, draw_unit->clip_area)) return;
 
     LV_PROFILER_BEGIN;
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_add_blend_px(draw_unit, lv_area_get_size(&blend_area));
+#endif
+
     lv_layer_t * layer = draw_unit->target_layer;
     uint32_t layer_stride_byte = lv_draw_buf_width_to_stride(lv_area_get_width(&layer->buf_area), layer->color_format);
 
@@ -61,8 +69,9 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
         else if(blend_dsc->mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) fill_dsc.mask_buf = NULL;
         else fill_dsc.mask_buf = blend_dsc->mask_buf;
 
-        fill_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1,
-                                                   blend_area.y1 - layer->buf_area.y1);
+        fill_dsc.relative_area = blend_area;
+        lv_area_move(&fill_dsc.relative_area, -layer->buf_area.x1, -layer->buf_area.y1);
+        fill_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, fill_dsc.relative_area.x1, fill_dsc.relative_area.y1);
 
         if(fill_dsc.mask_buf) {
             fill_dsc.mask_stride = blend_dsc->mask_stride == 0  ? lv_area_get_width(blend_dsc->mask_area) : blend_dsc->mask_stride;
@@ -77,12 +86,24 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
             case LV_COLOR_FORMAT_ARGB8888:
                 lv_draw_sw_blend_color_to_argb8888(&fill_dsc);
                 break;
+            case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+                lv_draw_sw_blend_color_to_argb8888_premultiplied(&fill_dsc);
+                break;
             case LV_COLOR_FORMAT_RGB888:
                 lv_draw_sw_blend_color_to_rgb888(&fill_dsc, 3);
                 break;
             case LV_COLOR_FORMAT_XRGB8888:
                 lv_draw_sw_blend_color_to_rgb888(&fill_dsc, 4);
                 break;
+            case LV_COLOR_FORMAT_L8:
+                lv_draw_sw_blend_color_to_l8(&fill_dsc);
+                break;
+            case LV_COLOR_FORMAT_A8:
+                lv_draw_sw_blend_color_to_a8(&fill_dsc);
+                break;
+            case LV_COLOR_FORMAT_I1:
+                lv_draw_sw_blend_color_to_i1(&fill_dsc);
+                break;
             default:
                 break;
         }
@@ -120,8 +141,9 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
                                   (blend_area.x1 - blend_dsc->mask_area->x1);
         }
 
-        image_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1,
-                                                    blend_area.y1 - layer->buf_area.y1);
+        image_dsc.relative_area = blend_area;
+        lv_area_move(&image_dsc.relative_area, -layer->buf_area.x1, -layer->buf_area.y1);
+        image_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, image_dsc.relative_area.x1, image_dsc.relative_area.y1);
 
         switch(layer->color_format) {
             case LV_COLOR_FORMAT_RGB565:
@@ -131,12 +153,24 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
             case LV_COLOR_FORMAT_ARGB8888:
                 lv_draw_sw_blend_image_to_argb8888(&image_dsc);
                 break;
+            case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+                lv_draw_sw_blend_image_to_argb8888_premultiplied(&image_dsc);
+                break;
             case LV_COLOR_FORMAT_RGB888:
                 lv_draw_sw_blend_image_to_rgb888(&image_dsc, 3);
                 break;
             case LV_COLOR_FORMAT_XRGB8888:
                 lv_draw_sw_blend_image_to_rgb888(&image_dsc, 4);
                 break;
+            case LV_COLOR_FORMAT_L8:
+                lv_draw_sw_blend_image_to_l8(&image_dsc);
+                break;
+            case LV_COLOR_FORMAT_A8:
+                lv_draw_sw_blend_image_to_a8(&image_dsc);
+                break;
+            case LV_COLOR_FORMAT_I1:
+                lv_draw_sw_blend_image_to_i1(&image_dsc);
+                break;
             default:
                 break;
         }
@@ -144,6 +178,48 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
     LV_PROFILER_END;
 }
 
+void lv_draw_sw_blend_spans(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                            const lv_draw_sw_mask_span_t * spans, uint32_t span_cnt)
+{
+    if(span_cnt == 1 && spans[0].type == LV_DRAW_SW_MASK_SPAN_TRANSP) return;
+
+    lv_draw_sw_blend_dsc_t span_dsc = *blend_dsc;
+    lv_area_t span_area = *blend_dsc->blend_area;
+    span_dsc.blend_area = &span_area;
+
+    /*The mask result to blend each type of span with*/
+    lv_draw_sw_mask_res_t span_res[3];
+    /*Blending to ARGB8888 sets the color of the transparent pixels even with zero mask.
+     *The transformations of ARGB8888 layers sample this color too,
+     *so the transparent spans are blended with their cleared mask instead of skipping them.*/
+    span_res[LV_DRAW_SW_MASK_SPAN_TRANSP] = draw_unit->target_layer->color_format == LV_COLOR_FORMAT_ARGB8888 ?
+                                            LV_DRAW_SW_MASK_RES_CHANGED : LV_DRAW_SW_MASK_RES_TRANSP;
+    /*With opacity the covered spans are blended with the mask too to mix them the same way as the partial spans*/
+    span_res[LV_DRAW_SW_MASK_SPAN_COVER] = blend_dsc->opa >= LV_OPA_MAX ? LV_DRAW_SW_MASK_RES_FULL_COVER :
+                                           LV_DRAW_SW_MASK_RES_CHANGED;
+    span_res[LV_DRAW_SW_MASK_SPAN_PARTIAL] = LV_DRAW_SW_MASK_RES_CHANGED;
+
+    int32_t x_ofs = blend_dsc->mask_area->x1;
+    int32_t start = 0;
+    uint32_t i;
+    for(i = 0; i < span_cnt; i++) {
+        /*Blend the neighbor spans with the same result in one step*/
+        lv_draw_sw_mask_res_t res = span_res[spans[i].type];
+        while(i + 1 < span_cnt && span_res[spans[i + 1].type] == res) i++;
+        int32_t end = spans[i].end;
+
+        if(res != LV_DRAW_SW_MASK_RES_TRANSP) {
+            span_area.x1 = LV_MAX(x_ofs + start, blend_dsc->blend_area->x1);
+            span_area.x2 = LV_MIN(x_ofs + end - 1, blend_dsc->blend_area->x2);
+            if(span_area.x1 <= span_area.x2) {
+                span_dsc.mask_res = res;
+                lv_draw_sw_blend(draw_unit, &span_dsc);
+            }
+        }
+        start = end;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
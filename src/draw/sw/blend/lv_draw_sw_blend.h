@@ -24,6 +24,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Make a blend hook returning `void` usable as a `*_RESULT` hook which is always successful*/
+#define LV_DRAW_SW_BLEND_HOOK_OK(hook, ...)     (hook(__VA_ARGS__), LV_RESULT_OK)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -55,6 +58,7 @@ typedef struct {
     int32_t mask_stride;
     lv_color_t color;
     lv_opa_t opa;
+    lv_area_t relative_area;        /**< The blended area relative to the layer's buffer*/
 } _lv_draw_sw_blend_fill_dsc_t;
 
 typedef struct {
@@ -69,6 +73,7 @@ typedef struct {
     lv_color_format_t src_color_format;
     lv_opa_t opa;
     lv_blend_mode_t blend_mode;
+    lv_area_t relative_area;        /**< The blended area relative to the layer's buffer*/
 } _lv_draw_sw_blend_image_dsc_t;
 
 /**********************
@@ -82,6 +87,21 @@ typedef struct {
  */
 void lv_draw_sw_blend(struct _lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * dsc);
 
+/**
+ * Blend a line which is described by the spans of `lv_draw_sw_mask_apply_spans`.
+ * The transparent spans are skipped and the covered spans are blended without mask if the opacity is full.
+ * The covered spans of `mask_buf` keep the value it was initialized with.
+ * On ARGB8888 layers the transparent spans are blended too as it sets the color of the transparent pixels.
+ * Neighbor spans which are blended the same way are blended in one step.
+ * @param draw_unit     pointer to a draw unit
+ * @param dsc           pointer to an initialized blend descriptor. `blend_area` has to be 1 line high
+ *                      and the spans are relative to `mask_area->x1`
+ * @param spans         the spans of the line
+ * @param span_cnt      number of spans
+ */
+void lv_draw_sw_blend_spans(struct _lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * dsc,
+                            const lv_draw_sw_mask_span_t * spans, uint32_t span_cnt);
+
 /**********************
  *      MACROS
  **********************/
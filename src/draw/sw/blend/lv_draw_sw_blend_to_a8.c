@@ -0,0 +1,165 @@
+/**
+ * @file lv_draw_sw_blend_to_a8.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_to_a8.h"
+#if LV_USE_DRAW_SW
+
+#include "lv_draw_sw_blend.h"
+#include "../../../misc/lv_math.h"
+#include "../../../misc/lv_color.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static inline void lv_opa_8_8_mix(uint8_t * dest, lv_opa_t mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*A8 has no color so only the coverage is added. The color and the blend mode are ignored.*/
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_a8(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    int32_t dest_stride = dsc->dest_stride;
+    uint8_t * dest_buf = dsc->dest_buf;
+
+    int32_t x;
+    int32_t y;
+
+    /*Simple fill*/
+    if(mask == NULL && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            lv_memset(dest_buf, LV_OPA_COVER, w);
+            dest_buf += dest_stride;
+        }
+    }
+    /*Opacity only*/
+    else if(mask == NULL && opa < LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_opa_8_8_mix(&dest_buf[x], opa);
+            }
+            dest_buf += dest_stride;
+        }
+    }
+    /*Masked with full opacity*/
+    else if(mask && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_opa_8_8_mix(&dest_buf[x], mask[x]);
+            }
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+    }
+    /*Masked with opacity*/
+    else {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_opa_8_8_mix(&dest_buf[x], LV_OPA_MIX2(opa, mask[x]));
+            }
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_a8(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint8_t * src_buf = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    /*Only the ARGB8888 formats have alpha channel among the supported source formats, the others are opaque*/
+    switch(dsc->src_color_format) {
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_L8: {
+                _lv_draw_sw_blend_fill_dsc_t fill_dsc;
+                lv_memzero(&fill_dsc, sizeof(fill_dsc));
+                fill_dsc.dest_buf = dsc->dest_buf;
+                fill_dsc.dest_w = w;
+                fill_dsc.dest_h = h;
+                fill_dsc.dest_stride = dest_stride;
+                fill_dsc.mask_buf = mask_buf;
+                fill_dsc.mask_stride = mask_stride;
+                fill_dsc.opa = opa;
+                lv_draw_sw_blend_color_to_a8(&fill_dsc);
+                break;
+            }
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED: {
+                int32_t x;
+                int32_t y;
+                for(y = 0; y < h; y++) {
+                    const lv_color32_t * src_buf_c32 = (const lv_color32_t *)src_buf;
+                    for(x = 0; x < w; x++) {
+                        lv_opa_t px_opa = src_buf_c32[x].alpha;
+                        if(opa < LV_OPA_MAX) px_opa = LV_OPA_MIX2(px_opa, opa);
+                        if(mask_buf) px_opa = LV_OPA_MIX2(px_opa, mask_buf[x]);
+                        lv_opa_8_8_mix(&dest_buf[x], px_opa);
+                    }
+                    dest_buf += dest_stride;
+                    src_buf += src_stride;
+                    if(mask_buf) mask_buf += mask_stride;
+                }
+                break;
+            }
+        default:
+            LV_LOG_WARN("Not supported source color format");
+            break;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add `mix` coverage to an opacity value like a layer with alpha channel would do
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void lv_opa_8_8_mix(uint8_t * dest, lv_opa_t mix)
+{
+    if(mix == 0) return;
+
+    if(mix >= LV_OPA_MAX) *dest = LV_OPA_COVER;
+    else *dest = mix + LV_UDIV255((uint32_t)*dest * (255 - mix));
+}
+
+#endif
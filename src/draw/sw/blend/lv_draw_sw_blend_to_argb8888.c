@@ -10,6 +10,7 @@
 #if LV_USE_DRAW_SW
 
 #include "lv_draw_sw_blend.h"
+#include "../lv_draw_sw_dispatch.h"
 #include "../../../misc/lv_math.h"
 #include "../../../display/lv_display.h"
 #include "../../../core/lv_refr.h"
@@ -18,6 +19,10 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
     #include "neon/lv_blend_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #include "x86/lv_blend_x86.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO
+    #include "../../../core/lv_global.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -26,6 +31,109 @@
  *      DEFINES
  *********************/
 
+/*A `*_RESULT` hook returns `LV_RESULT_INVALID` to fall back to the C implementation.
+ *A hook with the plain name returns `void` and is always considered successful.
+ *Without a hook the kernel selected at runtime is used (if any).*/
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_argb8888, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_argb8888, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_argb8888, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_argb8888, MIX_MASK_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_argb8888, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_argb8888, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_argb8888, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_argb8888, MIX_MASK_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_argb8888, NORMAL, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_argb8888, WITH_OPA, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_argb8888, WITH_MASK, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_argb8888, MIX_MASK_OPA, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_argb8888, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_argb8888, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_argb8888, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_argb8888, MIX_MASK_OPA, dsc)
+#endif
+
+/*Number of premultiplied pixels converted to straight alpha at once*/
+#define PREMULTIPLIED_CHUNK     32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -48,6 +156,8 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
 
 LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
 
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_color32_t lv_color_32_32_mix(lv_color32_t fg, lv_color32_t bg,
                                                                     lv_color_mix_alpha_cache_t * cache);
 
@@ -95,91 +205,83 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_argb8888(_lv_draw_sw_blend_
 
     /*Simple fill*/
     if(mask == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888
-        LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888(dsc);
-#else
-        uint32_t color32 = lv_color_to_u32(dsc->color);
-        uint32_t * dest_buf = dsc->dest_buf;
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w - 16; x += 16) {
-                dest_buf[x + 0] = color32;
-                dest_buf[x + 1] = color32;
-                dest_buf[x + 2] = color32;
-                dest_buf[x + 3] = color32;
-
-                dest_buf[x + 4] = color32;
-                dest_buf[x + 5] = color32;
-                dest_buf[x + 6] = color32;
-                dest_buf[x + 7] = color32;
-
-                dest_buf[x + 8] = color32;
-                dest_buf[x + 9] = color32;
-                dest_buf[x + 10] = color32;
-                dest_buf[x + 11] = color32;
-
-                dest_buf[x + 12] = color32;
-                dest_buf[x + 13] = color32;
-                dest_buf[x + 14] = color32;
-                dest_buf[x + 15] = color32;
-            }
-            for(; x < w; x ++) {
-                dest_buf[x] = color32;
-            }
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_RESULT(dsc)) {
+            uint32_t color32 = lv_color_to_u32(dsc->color);
+            uint32_t * dest_buf = dsc->dest_buf;
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w - 16; x += 16) {
+                    dest_buf[x + 0] = color32;
+                    dest_buf[x + 1] = color32;
+                    dest_buf[x + 2] = color32;
+                    dest_buf[x + 3] = color32;
+
+                    dest_buf[x + 4] = color32;
+                    dest_buf[x + 5] = color32;
+                    dest_buf[x + 6] = color32;
+                    dest_buf[x + 7] = color32;
+
+                    dest_buf[x + 8] = color32;
+                    dest_buf[x + 9] = color32;
+                    dest_buf[x + 10] = color32;
+                    dest_buf[x + 11] = color32;
+
+                    dest_buf[x + 12] = color32;
+                    dest_buf[x + 13] = color32;
+                    dest_buf[x + 14] = color32;
+                    dest_buf[x + 15] = color32;
+                }
+                for(; x < w; x ++) {
+                    dest_buf[x] = color32;
+                }
 
-            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+                dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+            }
         }
-#endif
     }
     /*Opacity only*/
     else if(mask == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc);
-#else
-        lv_color32_t color_argb = lv_color_to_32(dsc->color, opa);
-        lv_color32_t * dest_buf = dsc->dest_buf;
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA_RESULT(dsc)) {
+            lv_color32_t color_argb = lv_color_to_32(dsc->color, opa);
+            lv_color32_t * dest_buf = dsc->dest_buf;
 
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
-                dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
+                }
+                dest_buf = drawbuf_next_row(dest_buf, dest_stride);
             }
-            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
         }
-#endif
     }
     /*Masked with full opacity*/
     else if(mask && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
-        LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc);
-#else
-        lv_color32_t color_argb = lv_color_to_32(dsc->color, 0xff);
-        lv_color32_t * dest_buf = dsc->dest_buf;
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
-                color_argb.alpha = mask[x];
-                dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
-            }
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK_RESULT(dsc)) {
+            lv_color32_t color_argb = lv_color_to_32(dsc->color, 0xff);
+            lv_color32_t * dest_buf = dsc->dest_buf;
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    color_argb.alpha = mask[x];
+                    dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
+                }
 
-            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
-            mask += mask_stride;
+                dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+                mask += mask_stride;
+            }
         }
-#endif
     }
     /*Masked with opacity*/
     else {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc);
-#else
-        lv_color32_t color_argb = lv_color_to_32(dsc->color, opa);
-        lv_color32_t * dest_buf = dsc->dest_buf;
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
-                color_argb.alpha = LV_OPA_MIX2(mask[x], opa);
-                dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)) {
+            lv_color32_t color_argb = lv_color_to_32(dsc->color, opa);
+            lv_color32_t * dest_buf = dsc->dest_buf;
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    color_argb.alpha = LV_OPA_MIX2(mask[x], opa);
+                    dest_buf[x] = lv_color_32_32_mix(color_argb, dest_buf[x], &cache);
+                }
+                dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+                mask += mask_stride;
             }
-            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
-            mask += mask_stride;
         }
-#endif
     }
 }
 
@@ -198,6 +300,10 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_argb8888(_lv_draw_sw_blend_
         case LV_COLOR_FORMAT_ARGB8888:
             argb8888_image_blend(dsc);
             break;
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+            /*The destination has straight alpha, so the division can't be avoided*/
+            unpremultiplied_image_blend(dsc);
+            break;
         default:
             LV_LOG_WARN("Not supported source color format");
             break;
@@ -231,62 +337,58 @@ LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888
+            lv_result_t accelerated;
             if(opa >= LV_OPA_MAX) {
-                LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888(dsc);
+                accelerated = LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc);
             }
             else {
-                LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc);
+                accelerated = LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc);
             }
-#else
-            color_argb.alpha = opa;
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
-                    color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
-                    color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == accelerated) {
+                color_argb.alpha = opa;
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
+                        color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
+                        color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb.alpha = mask_buf[x];
-                    color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
-                    color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
-                    color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb.alpha = mask_buf[x];
+                        color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
+                        color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
+                        color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         else {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb.alpha = LV_OPA_MIX2(mask_buf[x], opa);
-                    color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
-                    color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
-                    color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb.alpha = LV_OPA_MIX2(mask_buf[x], opa);
+                        color_argb.red = (src_buf_c16[x].red * 2106) >> 8;  /*To make it rounded*/
+                        color_argb.green = (src_buf_c16[x].green * 1037) >> 8;
+                        color_argb.blue = (src_buf_c16[x].blue * 2106) >> 8;
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -333,83 +435,75 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         /*Special case*/
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888(dsc, src_px_size);
-#else
-            if(src_px_size == 4) {
-                uint32_t line_in_bytes = w * 4;
-                for(y = 0; y < h; y++) {
-                    lv_memcpy(dest_buf_c32, src_buf, line_in_bytes);
-                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                    src_buf = drawbuf_next_row(src_buf, src_stride);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc, src_px_size)) {
+                if(src_px_size == 4) {
+                    uint32_t line_in_bytes = w * 4;
+                    for(y = 0; y < h; y++) {
+                        lv_memcpy(dest_buf_c32, src_buf, line_in_bytes);
+                        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                        src_buf = drawbuf_next_row(src_buf, src_stride);
+                    }
                 }
-            }
-            else if(src_px_size == 3) {
-                for(y = 0; y < h; y++) {
-                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 3) {
-                        dest_buf_c32[dest_x].red = src_buf[src_x + 2];
-                        dest_buf_c32[dest_x].green = src_buf[src_x + 1];
-                        dest_buf_c32[dest_x].blue = src_buf[src_x + 0];
-                        dest_buf_c32[dest_x].alpha = 0xff;
+                else if(src_px_size == 3) {
+                    for(y = 0; y < h; y++) {
+                        for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 3) {
+                            dest_buf_c32[dest_x].red = src_buf[src_x + 2];
+                            dest_buf_c32[dest_x].green = src_buf[src_x + 1];
+                            dest_buf_c32[dest_x].blue = src_buf[src_x + 0];
+                            dest_buf_c32[dest_x].alpha = 0xff;
+                        }
+                        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                        src_buf = drawbuf_next_row(src_buf, src_stride);
                     }
-                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                    src_buf = drawbuf_next_row(src_buf, src_stride);
                 }
             }
-#endif
         }
         if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc, src_px_size);
-#else
-            color_argb.alpha = opa;
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    color_argb.red = src_buf[src_x + 2];
-                    color_argb.green = src_buf[src_x + 1];
-                    color_argb.blue = src_buf[src_x + 0];
-                    dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc, src_px_size)) {
+                color_argb.alpha = opa;
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        color_argb.red = src_buf[src_x + 2];
+                        color_argb.green = src_buf[src_x + 1];
+                        color_argb.blue = src_buf[src_x + 0];
+                        dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf = drawbuf_next_row(src_buf, src_stride);
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf = drawbuf_next_row(src_buf, src_stride);
             }
-#endif
         }
         if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    color_argb.alpha = mask_buf[dest_x];
-                    color_argb.red = src_buf[src_x + 2];
-                    color_argb.green = src_buf[src_x + 1];
-                    color_argb.blue = src_buf[src_x + 0];
-                    dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        color_argb.alpha = mask_buf[dest_x];
+                        color_argb.red = src_buf[src_x + 2];
+                        color_argb.green = src_buf[src_x + 1];
+                        color_argb.blue = src_buf[src_x + 0];
+                        dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf = drawbuf_next_row(src_buf, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf = drawbuf_next_row(src_buf, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    color_argb.alpha = (opa * mask_buf[dest_x]) >> 8;
-                    color_argb.red = src_buf[src_x + 2];
-                    color_argb.green = src_buf[src_x + 1];
-                    color_argb.blue = src_buf[src_x + 0];
-                    dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        color_argb.alpha = (opa * mask_buf[dest_x]) >> 8;
+                        color_argb.red = src_buf[src_x + 2];
+                        color_argb.green = src_buf[src_x + 1];
+                        color_argb.blue = src_buf[src_x + 0];
+                        dest_buf_c32[dest_x] = lv_color_32_32_mix(color_argb, dest_buf_c32[dest_x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf = drawbuf_next_row(src_buf, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf = drawbuf_next_row(src_buf, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -452,64 +546,56 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf_c32[x] = lv_color_32_32_mix(src_buf_c32[x], dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        dest_buf_c32[x] = lv_color_32_32_mix(src_buf_c32[x], dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb = src_buf_c32[x];
-                    color_argb.alpha = LV_OPA_MIX2(color_argb.alpha, opa);
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb = src_buf_c32[x];
+                        color_argb.alpha = LV_OPA_MIX2(color_argb.alpha, opa);
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb = src_buf_c32[x];
-                    color_argb.alpha = LV_OPA_MIX2(color_argb.alpha, mask_buf[x]);
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb = src_buf_c32[x];
+                        color_argb.alpha = LV_OPA_MIX2(color_argb.alpha, mask_buf[x]);
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         else if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    color_argb = src_buf_c32[x];
-                    color_argb.alpha = LV_OPA_MIX3(color_argb.alpha, opa, mask_buf[x]);
-                    dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        color_argb = src_buf_c32[x];
+                        color_argb.alpha = LV_OPA_MIX3(color_argb.alpha, opa, mask_buf[x]);
+                        dest_buf_c32[x] = lv_color_32_32_mix(color_argb, dest_buf_c32[x], &cache);
+                    }
+                    dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -527,6 +613,42 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
     }
 }
 
+/**
+ * Convert the premultiplied pixels to ARGB8888 in small chunks and blend them as ARGB8888
+ */
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    lv_color32_t straight_buf[PREMULTIPLIED_CHUNK];
+    _lv_draw_sw_blend_image_dsc_t straight_dsc = *dsc;
+    straight_dsc.src_buf = straight_buf;
+    straight_dsc.src_stride = sizeof(straight_buf);
+    straight_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    straight_dsc.dest_h = 1;
+
+    uint8_t * dest_row = dsc->dest_buf;
+    const lv_color32_t * src_row = dsc->src_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        for(x = 0; x < dsc->dest_w; x += PREMULTIPLIED_CHUNK) {
+            int32_t len = LV_MIN(PREMULTIPLIED_CHUNK, dsc->dest_w - x);
+            int32_t i;
+            for(i = 0; i < len; i++) {
+                straight_buf[i] = lv_color32_unpremultiply(src_row[x + i]);
+            }
+            straight_dsc.dest_w = len;
+            straight_dsc.dest_buf = dest_row + x * 4;
+            if(mask_row) straight_dsc.mask_buf = mask_row + x;
+            argb8888_image_blend(&straight_dsc);
+        }
+        dest_row += dsc->dest_stride;
+        src_row = drawbuf_next_row(src_row, dsc->src_stride);
+        if(mask_row) mask_row += dsc->mask_stride;
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_color32_t lv_color_32_32_mix(lv_color32_t fg, lv_color32_t bg,
                                                                     lv_color_mix_alpha_cache_t * cache)
 {
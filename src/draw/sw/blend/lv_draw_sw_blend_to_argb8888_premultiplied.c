@@ -0,0 +1,350 @@
+/**
+ * @file lv_draw_sw_blend_to_argb8888_premultiplied.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_to_argb8888_premultiplied.h"
+#if LV_USE_DRAW_SW
+
+#include "lv_draw_sw_blend.h"
+#include "../../../misc/lv_math.h"
+#include "../../../misc/lv_color.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t get_px_opa(lv_opa_t px_opa, lv_opa_t opa, const lv_opa_t * mask,
+                                                        int32_t x);
+
+LV_ATTRIBUTE_FAST_MEM static inline lv_color32_t premultiply_rgb(uint8_t r, uint8_t g, uint8_t b, lv_opa_t a);
+
+LV_ATTRIBUTE_FAST_MEM static inline void blend_px(lv_color32_t * dest, lv_color32_t src, lv_blend_mode_t mode);
+
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_32_32_premultiplied_mix(lv_color32_t * dest, lv_color32_t src);
+
+LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*
+ * The color channels of the destination are already multiplied by its alpha so a source pixel
+ * with premultiplied color `src` is blended as `src + dest * (255 - src.alpha) / 255` on all 4 channels.
+ * The straight alpha sources are premultiplied on the fly, the premultiplied ones are only scaled by the opacity.
+ */
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_argb8888_premultiplied(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    int32_t dest_stride = dsc->dest_stride;
+    lv_color32_t * dest_buf = dsc->dest_buf;
+    lv_color_t color = dsc->color;
+
+    int32_t x;
+    int32_t y;
+
+    /*Simple fill*/
+    if(mask == NULL && opa >= LV_OPA_MAX) {
+        lv_color32_t c32 = lv_color_to_32(color, LV_OPA_COVER);
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                dest_buf[x] = c32;
+            }
+            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+        }
+    }
+    /*Opacity only: the premultiplied color is the same for all pixels*/
+    else if(mask == NULL && opa < LV_OPA_MAX) {
+        lv_color32_t c32 = premultiply_rgb(color.red, color.green, color.blue, opa);
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_color_32_32_premultiplied_mix(&dest_buf[x], c32);
+            }
+            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+        }
+    }
+    /*Masked with or without opacity*/
+    else {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_opa_t mix = opa >= LV_OPA_MAX ? mask[x] : LV_OPA_MIX2(opa, mask[x]);
+                lv_color_32_32_premultiplied_mix(&dest_buf[x], premultiply_rgb(color.red, color.green, color.blue, mix));
+            }
+            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+            mask += mask_stride;
+        }
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_argb8888_premultiplied(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    switch(dsc->src_color_format) {
+        case LV_COLOR_FORMAT_RGB565:
+            rgb565_image_blend(dsc);
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            rgb888_image_blend(dsc, 3);
+            break;
+        case LV_COLOR_FORMAT_XRGB8888:
+            rgb888_image_blend(dsc, 4);
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            argb8888_image_blend(dsc);
+            break;
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+            argb8888_premultiplied_image_blend(dsc);
+            break;
+        default:
+            LV_LOG_WARN("Not supported source color format");
+            break;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    lv_color32_t * dest_buf_c32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color16_t * src_buf_c16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color16_t c16 = src_buf_c16[x];
+            lv_color32_t src = premultiply_rgb((c16.red * 2106) >> 8, (c16.green * 1037) >> 8, (c16.blue * 2106) >> 8,
+                                               get_px_opa(LV_OPA_COVER, opa, mask_buf, x));
+            blend_px(&dest_buf_c32[x], src, dsc->blend_mode);
+        }
+        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+        src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    lv_color32_t * dest_buf_c32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint8_t * src_buf_u8 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t dest_x;
+    int32_t src_x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+            lv_color32_t src = premultiply_rgb(src_buf_u8[src_x + 2], src_buf_u8[src_x + 1], src_buf_u8[src_x + 0],
+                                               get_px_opa(LV_OPA_COVER, opa, mask_buf, dest_x));
+            blend_px(&dest_buf_c32[dest_x], src, dsc->blend_mode);
+        }
+        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+        src_buf_u8 += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    lv_color32_t * dest_buf_c32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t c = src_buf_c32[x];
+            lv_color32_t src = premultiply_rgb(c.red, c.green, c.blue, get_px_opa(c.alpha, opa, mask_buf, x));
+            blend_px(&dest_buf_c32[x], src, dsc->blend_mode);
+        }
+        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    lv_color32_t * dest_buf_c32 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+
+    /*Only multiply-add is required, there is no need to touch the source pixels*/
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL && mask_buf == NULL && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_color_32_32_premultiplied_mix(&dest_buf_c32[x], src_buf_c32[x]);
+            }
+            dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+            src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        }
+        return;
+    }
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t src = src_buf_c32[x];
+            lv_opa_t mix = get_px_opa(LV_OPA_COVER, opa, mask_buf, x);
+            if(mix < LV_OPA_MAX) {
+                src.red = LV_UDIV255(src.red * mix);
+                src.green = LV_UDIV255(src.green * mix);
+                src.blue = LV_UDIV255(src.blue * mix);
+                src.alpha = LV_UDIV255(src.alpha * mix);
+            }
+            blend_px(&dest_buf_c32[x], src, dsc->blend_mode);
+        }
+        dest_buf_c32 = drawbuf_next_row(dest_buf_c32, dest_stride);
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+/**
+ * Combine the opacity of a source pixel with the overall opacity and the mask
+ */
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t get_px_opa(lv_opa_t px_opa, lv_opa_t opa, const lv_opa_t * mask,
+                                                        int32_t x)
+{
+    if(opa < LV_OPA_MAX) px_opa = LV_OPA_MIX2(px_opa, opa);
+    if(mask) px_opa = LV_OPA_MIX2(px_opa, mask[x]);
+    return px_opa;
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline lv_color32_t premultiply_rgb(uint8_t r, uint8_t g, uint8_t b, lv_opa_t a)
+{
+    lv_color32_t c;
+    c.red = r;
+    c.green = g;
+    c.blue = b;
+    c.alpha = a;
+    if(a >= LV_OPA_MAX) c.alpha = LV_OPA_COVER;
+    else c = lv_color32_premultiply(c);
+    return c;
+}
+
+/**
+ * Blend a premultiplied pixel. The non-normal blend modes need the straight color of the destination
+ * so they are slower.
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void blend_px(lv_color32_t * dest, lv_color32_t src, lv_blend_mode_t mode)
+{
+    if(mode == LV_BLEND_MODE_NORMAL) {
+        lv_color_32_32_premultiplied_mix(dest, src);
+        return;
+    }
+
+    if(src.alpha == 0) return;
+
+    lv_color32_t d = lv_color32_unpremultiply(*dest);
+    lv_color32_t s = lv_color32_unpremultiply(src);
+    lv_color32_t res;
+    switch(mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            res.red = LV_MIN(d.red + s.red, 255);
+            res.green = LV_MIN(d.green + s.green, 255);
+            res.blue = LV_MIN(d.blue + s.blue, 255);
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            res.red = LV_MAX(d.red - s.red, 0);
+            res.green = LV_MAX(d.green - s.green, 0);
+            res.blue = LV_MAX(d.blue - s.blue, 0);
+            break;
+        case LV_BLEND_MODE_MULTIPLY:
+            res.red = (d.red * s.red) >> 8;
+            res.green = (d.green * s.green) >> 8;
+            res.blue = (d.blue * s.blue) >> 8;
+            break;
+        default:
+            LV_LOG_WARN("Not supported blend mode: %d", mode);
+            return;
+    }
+
+    lv_color_32_32_premultiplied_mix(dest, premultiply_rgb(res.red, res.green, res.blue, src.alpha));
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_32_32_premultiplied_mix(lv_color32_t * dest, lv_color32_t src)
+{
+    if(src.alpha == 0) return;
+
+    if(src.alpha == LV_OPA_COVER) {
+        *dest = src;
+    }
+    else {
+        uint32_t inv = 255 - src.alpha;
+        dest->red = src.red + LV_UDIV255(dest->red * inv);
+        dest->green = src.green + LV_UDIV255(dest->green * inv);
+        dest->blue = src.blue + LV_UDIV255(dest->blue * inv);
+        dest->alpha = src.alpha + LV_UDIV255(dest->alpha * inv);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif
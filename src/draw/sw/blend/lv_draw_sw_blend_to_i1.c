@@ -0,0 +1,172 @@
+/**
+ * @file lv_draw_sw_blend_to_i1.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_to_i1.h"
+#if LV_USE_DRAW_SW
+
+#include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_to_l8.h"
+#include "../../../misc/lv_math.h"
+#include "../../../misc/lv_color.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels converted to L8 at once*/
+#define I1_CHUNK        64
+
+/*Pixels brighter than this are white if dithering is disabled*/
+#define I1_THRESHOLD    127
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static inline void unpack_row(const uint8_t * row, int32_t bit, int32_t len, uint8_t * l8);
+
+LV_ATTRIBUTE_FAST_MEM static inline void pack_row(uint8_t * row, int32_t bit, int32_t len, const uint8_t * l8,
+                                                  int32_t x, int32_t y);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+#if LV_DRAW_SW_I1_DITHER
+/*4x4 Bayer matrix scaled to 0..255*/
+static const uint8_t dither_threshold[4][4] = {
+    {  8, 136,  40, 168},
+    {200,  72, 232, 104},
+    { 56, 184,  24, 152},
+    {248, 120, 216,  88},
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*
+ * I1 buffers have 1 bit per pixel without palette: 1 is white, 0 is black and the left-most pixel is the MSB.
+ * `dest_buf` points to the byte of the first pixel, so the bit offset comes from `relative_area`.
+ * The pixels are converted to L8 in small chunks, blended with the L8 functions and quantized back.
+ */
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_i1(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    uint8_t l8_buf[I1_CHUNK];
+    _lv_draw_sw_blend_fill_dsc_t l8_dsc = *dsc;
+    l8_dsc.dest_buf = l8_buf;
+    l8_dsc.dest_h = 1;
+    l8_dsc.dest_stride = I1_CHUNK;
+
+    /*An opaque fill overwrites the pixels so they don't need to be read*/
+    bool cover = dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX;
+    int32_t bit_ofs = dsc->relative_area.x1 & 0x7;
+    uint8_t * dest_row = dsc->dest_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        for(x = 0; x < dsc->dest_w; x += I1_CHUNK) {
+            int32_t len = LV_MIN(I1_CHUNK, dsc->dest_w - x);
+            l8_dsc.dest_w = len;
+            if(mask_row) l8_dsc.mask_buf = mask_row + x;
+
+            if(!cover) unpack_row(dest_row, bit_ofs + x, len, l8_buf);
+            lv_draw_sw_blend_color_to_l8(&l8_dsc);
+            pack_row(dest_row, bit_ofs + x, len, l8_buf, dsc->relative_area.x1 + x, dsc->relative_area.y1 + y);
+        }
+        dest_row += dsc->dest_stride;
+        if(mask_row) mask_row += dsc->mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_i1(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    uint8_t l8_buf[I1_CHUNK];
+    _lv_draw_sw_blend_image_dsc_t l8_dsc = *dsc;
+    l8_dsc.dest_buf = l8_buf;
+    l8_dsc.dest_h = 1;
+    l8_dsc.dest_stride = I1_CHUNK;
+
+    uint32_t src_px_size = lv_color_format_get_size(dsc->src_color_format);
+    int32_t bit_ofs = dsc->relative_area.x1 & 0x7;
+    uint8_t * dest_row = dsc->dest_buf;
+    const uint8_t * src_row = dsc->src_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        for(x = 0; x < dsc->dest_w; x += I1_CHUNK) {
+            int32_t len = LV_MIN(I1_CHUNK, dsc->dest_w - x);
+            l8_dsc.dest_w = len;
+            l8_dsc.src_buf = src_row + x * src_px_size;
+            if(mask_row) l8_dsc.mask_buf = mask_row + x;
+
+            unpack_row(dest_row, bit_ofs + x, len, l8_buf);
+            lv_draw_sw_blend_image_to_l8(&l8_dsc);
+            pack_row(dest_row, bit_ofs + x, len, l8_buf, dsc->relative_area.x1 + x, dsc->relative_area.y1 + y);
+        }
+        dest_row += dsc->dest_stride;
+        src_row += dsc->src_stride;
+        if(mask_row) mask_row += dsc->mask_stride;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static inline void unpack_row(const uint8_t * row, int32_t bit, int32_t len, uint8_t * l8)
+{
+    int32_t i;
+    for(i = 0; i < len; i++, bit++) {
+        l8[i] = (row[bit >> 3] >> (7 - (bit & 0x7))) & 0x1 ? 0xff : 0x00;
+    }
+}
+
+/**
+ * Quantize L8 pixels to bits.
+ * `x` and `y` are the coordinates of the first pixel on the layer and select the dither thresholds.
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void pack_row(uint8_t * row, int32_t bit, int32_t len, const uint8_t * l8,
+                                                  int32_t x, int32_t y)
+{
+#if LV_DRAW_SW_I1_DITHER
+    const uint8_t * threshold = dither_threshold[y & 0x3];
+#else
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+#endif
+
+    int32_t i;
+    for(i = 0; i < len; i++, bit++) {
+        uint8_t bit_mask = 0x80 >> (bit & 0x7);
+#if LV_DRAW_SW_I1_DITHER
+        bool white = l8[i] > threshold[(x + i) & 0x3];
+#else
+        bool white = l8[i] > I1_THRESHOLD;
+#endif
+        if(white) row[bit >> 3] |= bit_mask;
+        else row[bit >> 3] &= ~bit_mask;
+    }
+}
+
+#endif
@@ -0,0 +1,339 @@
+/**
+ * @file lv_draw_sw_blend_to_l8.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_to_l8.h"
+#if LV_USE_DRAW_SW
+
+#include "lv_draw_sw_blend.h"
+#include "../../../misc/lv_math.h"
+#include "../../../misc/lv_color.h"
+#include "../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void l8_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t get_px_opa(lv_opa_t px_opa, lv_opa_t opa, const lv_opa_t * mask,
+                                                        int32_t x);
+
+LV_ATTRIBUTE_FAST_MEM static inline void blend_px(uint8_t * dest, uint8_t src, lv_opa_t mix, lv_blend_mode_t mode);
+
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_8_8_mix(uint8_t src, uint8_t * dest, uint8_t mix);
+
+LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_l8(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+    int32_t dest_stride = dsc->dest_stride;
+    uint8_t * dest_buf = dsc->dest_buf;
+    uint8_t color = lv_color_luminance(dsc->color);
+
+    int32_t x;
+    int32_t y;
+
+    /*Simple fill*/
+    if(mask == NULL && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            lv_memset(dest_buf, color, w);
+            dest_buf += dest_stride;
+        }
+    }
+    /*Opacity only*/
+    else if(mask == NULL && opa < LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_color_8_8_mix(color, &dest_buf[x], opa);
+            }
+            dest_buf += dest_stride;
+        }
+    }
+    /*Masked with full opacity*/
+    else if(mask && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_color_8_8_mix(color, &dest_buf[x], mask[x]);
+            }
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+    }
+    /*Masked with opacity*/
+    else {
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                lv_color_8_8_mix(color, &dest_buf[x], LV_OPA_MIX2(opa, mask[x]));
+            }
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_l8(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    switch(dsc->src_color_format) {
+        case LV_COLOR_FORMAT_RGB565:
+            rgb565_image_blend(dsc);
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            rgb888_image_blend(dsc, 3);
+            break;
+        case LV_COLOR_FORMAT_XRGB8888:
+            rgb888_image_blend(dsc, 4);
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            argb8888_image_blend(dsc);
+            break;
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+            argb8888_premultiplied_image_blend(dsc);
+            break;
+        case LV_COLOR_FORMAT_L8:
+            l8_image_blend(dsc);
+            break;
+        default:
+            LV_LOG_WARN("Not supported source color format");
+            break;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color16_t * src_buf_c16 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            blend_px(&dest_buf[x], lv_color16_luminance(src_buf_c16[x]), get_px_opa(LV_OPA_COVER, opa, mask_buf, x),
+                     dsc->blend_mode);
+        }
+        dest_buf += dest_stride;
+        src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint8_t * src_buf_u8 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t dest_x;
+    int32_t src_x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+            uint8_t l = lv_color_luminance(*(const lv_color_t *)&src_buf_u8[src_x]);
+            blend_px(&dest_buf[dest_x], l, get_px_opa(LV_OPA_COVER, opa, mask_buf, dest_x), dsc->blend_mode);
+        }
+        dest_buf += dest_stride;
+        src_buf_u8 += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            blend_px(&dest_buf[x], lv_color32_luminance(src_buf_c32[x]),
+                     get_px_opa(src_buf_c32[x].alpha, opa, mask_buf, x), dsc->blend_mode);
+        }
+        dest_buf += dest_stride;
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t src = src_buf_c32[x];
+            lv_opa_t mix = get_px_opa(LV_OPA_COVER, opa, mask_buf, x);
+            if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
+                /*The luminance is linear so it can be calculated from the premultiplied color too*/
+                uint32_t l = lv_color32_luminance(src);
+                uint32_t a = src.alpha;
+                if(mix < LV_OPA_MAX) {
+                    l = LV_UDIV255(l * mix);
+                    a = LV_UDIV255(a * mix);
+                }
+                if(a >= LV_OPA_MAX) dest_buf[x] = l;
+                else if(a > 0) dest_buf[x] = l + LV_UDIV255(dest_buf[x] * (255 - a));
+            }
+            else {
+                src = lv_color32_unpremultiply(src);
+                blend_px(&dest_buf[x], lv_color32_luminance(src), LV_OPA_MIX2(src.alpha, mix), dsc->blend_mode);
+            }
+        }
+        dest_buf += dest_stride;
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static void l8_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const uint8_t * src_buf = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL && mask_buf == NULL && opa >= LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            lv_memcpy(dest_buf, src_buf, w);
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+        }
+        return;
+    }
+
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            blend_px(&dest_buf[x], src_buf[x], get_px_opa(LV_OPA_COVER, opa, mask_buf, x), dsc->blend_mode);
+        }
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+/**
+ * Combine the opacity of a source pixel with the overall opacity and the mask
+ */
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t get_px_opa(lv_opa_t px_opa, lv_opa_t opa, const lv_opa_t * mask,
+                                                        int32_t x)
+{
+    if(opa < LV_OPA_MAX) px_opa = LV_OPA_MIX2(px_opa, opa);
+    if(mask) px_opa = LV_OPA_MIX2(px_opa, mask[x]);
+    return px_opa;
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline void blend_px(uint8_t * dest, uint8_t src, lv_opa_t mix, lv_blend_mode_t mode)
+{
+    switch(mode) {
+        case LV_BLEND_MODE_NORMAL:
+            break;
+        case LV_BLEND_MODE_ADDITIVE:
+            src = LV_MIN(*dest + src, 255);
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            src = LV_MAX(*dest - src, 0);
+            break;
+        case LV_BLEND_MODE_MULTIPLY:
+            src = (*dest * src) >> 8;
+            break;
+        default:
+            LV_LOG_WARN("Not supported blend mode: %d", mode);
+            return;
+    }
+
+    lv_color_8_8_mix(src, dest, mix);
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_8_8_mix(uint8_t src, uint8_t * dest, uint8_t mix)
+{
+    if(mix == 0) return;
+
+    if(mix >= LV_OPA_MAX) *dest = src;
+    else *dest = (uint32_t)((uint32_t)src * mix + *dest * (255 - mix)) >> 8;
+}
+
+LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+#endif
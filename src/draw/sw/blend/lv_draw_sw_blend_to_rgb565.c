@@ -10,6 +10,7 @@
 #if LV_USE_DRAW_SW
 
 #include "lv_draw_sw_blend.h"
+#include "../lv_draw_sw_dispatch.h"
 #include "../../../misc/lv_math.h"
 #include "../../../display/lv_display.h"
 #include "../../../core/lv_refr.h"
@@ -18,6 +19,10 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
     #include "neon/lv_blend_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #include "x86/lv_blend_x86.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO
+    #include "../../../core/lv_global.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -26,6 +31,109 @@
  *      DEFINES
  *********************/
 
+/*A `*_RESULT` hook returns `LV_RESULT_INVALID` to fall back to the C implementation.
+ *A hook with the plain name returns `void` and is always considered successful.
+ *Without a hook the kernel selected at runtime is used (if any).*/
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB565, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb565, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb565, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb565, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb565, MIX_MASK_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb565, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb565, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb565, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb565, MIX_MASK_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb565, NORMAL, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb565, WITH_OPA, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb565, WITH_MASK, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA, dsc, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb565, MIX_MASK_OPA, dsc, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb565, NORMAL, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb565, WITH_OPA, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb565, WITH_MASK, dsc)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA, dsc)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb565, MIX_MASK_OPA, dsc)
+#endif
+
+/*Number of premultiplied pixels converted to straight alpha at once*/
+#define PREMULTIPLIED_CHUNK     32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -40,8 +148,14 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
 
 LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
 
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc);
+
 LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix);
 
+LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_32_16_premultiplied_mix(lv_color32_t src, uint16_t dest);
+
 LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
 
 /**********************
@@ -96,142 +210,134 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_rgb565(_lv_draw_sw_blend_fi
 
     /*Simple fill*/
     if(mask == NULL && opa >= LV_OPA_MAX)  {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc);
-#else
-        for(y = 0; y < h; y++) {
-            uint16_t * dest_end_final = dest_buf_u16 + w;
-            uint32_t * dest_end_mid = (uint32_t *)((uint16_t *) dest_buf_u16 + ((w - 1) & ~(0xF)));
-            if((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
-                dest_buf_u16[0] = color16;
-                dest_buf_u16++;
-            }
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB565_RESULT(dsc)) {
+            for(y = 0; y < h; y++) {
+                uint16_t * dest_end_final = dest_buf_u16 + w;
+                uint32_t * dest_end_mid = (uint32_t *)((uint16_t *) dest_buf_u16 + ((w - 1) & ~(0xF)));
+                if((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
+                    dest_buf_u16[0] = color16;
+                    dest_buf_u16++;
+                }
 
-            uint32_t c32 = (uint32_t)color16 + ((uint32_t)color16 << 16);
-            uint32_t * dest32 = (uint32_t *)dest_buf_u16;
-            while(dest32 < dest_end_mid) {
-                dest32[0] = c32;
-                dest32[1] = c32;
-                dest32[2] = c32;
-                dest32[3] = c32;
-                dest32[4] = c32;
-                dest32[5] = c32;
-                dest32[6] = c32;
-                dest32[7] = c32;
-                dest32 += 8;
-            }
+                uint32_t c32 = (uint32_t)color16 + ((uint32_t)color16 << 16);
+                uint32_t * dest32 = (uint32_t *)dest_buf_u16;
+                while(dest32 < dest_end_mid) {
+                    dest32[0] = c32;
+                    dest32[1] = c32;
+                    dest32[2] = c32;
+                    dest32[3] = c32;
+                    dest32[4] = c32;
+                    dest32[5] = c32;
+                    dest32[6] = c32;
+                    dest32[7] = c32;
+                    dest32 += 8;
+                }
 
-            dest_buf_u16 = (uint16_t *)dest32;
+                dest_buf_u16 = (uint16_t *)dest32;
 
-            while(dest_buf_u16 < dest_end_final) {
-                *dest_buf_u16 = color16;
-                dest_buf_u16++;
-            }
+                while(dest_buf_u16 < dest_end_final) {
+                    *dest_buf_u16 = color16;
+                    dest_buf_u16++;
+                }
 
-            dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-            dest_buf_u16 -= w;
+                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                dest_buf_u16 -= w;
+            }
         }
-#endif
     }
     /*Opacity only*/
     else if(mask == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc);
-#else
-        uint32_t last_dest32_color = dest_buf_u16[0] + 1; /*Set to value which is not equal to the first pixel*/
-        uint32_t last_res32_color = 0;
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA_RESULT(dsc)) {
+            uint32_t last_dest32_color = dest_buf_u16[0] + 1; /*Set to value which is not equal to the first pixel*/
+            uint32_t last_res32_color = 0;
 
-        for(y = 0; y < h; y++) {
-            x = 0;
-            if((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
-                dest_buf_u16[0] = lv_color_16_16_mix(color16, dest_buf_u16[0], opa);
-                x = 1;
-            }
-
-            for(; x < w - 2; x += 2) {
-                if(dest_buf_u16[x] != dest_buf_u16[x + 1]) {
-                    dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
-                    dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], opa);
+            for(y = 0; y < h; y++) {
+                x = 0;
+                if((lv_uintptr_t)&dest_buf_u16[0] & 0x3) {
+                    dest_buf_u16[0] = lv_color_16_16_mix(color16, dest_buf_u16[0], opa);
+                    x = 1;
                 }
-                else {
-                    volatile uint32_t * dest32 = (uint32_t *)&dest_buf_u16[x];
-                    if(last_dest32_color == *dest32) {
-                        *dest32 = last_res32_color;
+
+                for(; x < w - 2; x += 2) {
+                    if(dest_buf_u16[x] != dest_buf_u16[x + 1]) {
+                        dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
+                        dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], opa);
                     }
                     else {
-                        last_dest32_color =  *dest32;
-
-                        dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
-                        dest_buf_u16[x + 1] = dest_buf_u16[x];
-
-                        last_res32_color = *dest32;
+                        volatile uint32_t * dest32 = (uint32_t *)&dest_buf_u16[x];
+                        if(last_dest32_color == *dest32) {
+                            *dest32 = last_res32_color;
+                        }
+                        else {
+                            last_dest32_color =  *dest32;
+
+                            dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], opa);
+                            dest_buf_u16[x + 1] = dest_buf_u16[x];
+
+                            last_res32_color = *dest32;
+                        }
                     }
                 }
-            }
 
-            for(; x < w ; x++) {
-                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], opa);
+                for(; x < w ; x++) {
+                    dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], opa);
+                }
+                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
             }
-            dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
         }
-#endif
     }
 
     /*Masked with full opacity*/
     else if(mask && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc);
-#else
-        uint32_t c32 = color16 + ((uint32_t)color16 << 16);
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
-                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
-            }
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK_RESULT(dsc)) {
+            uint32_t c32 = color16 + ((uint32_t)color16 << 16);
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
+                    dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
+                }
 
-            for(; x <= w - 4; x += 4) {
-                uint32_t mask32 = *((uint32_t *)&mask[x]);
-                if(mask32 == 0xFFFFFFFF) {
-                    if((lv_uintptr_t)&dest_buf_u16[x] & 0x3) {
-                        dest_buf_u16[x] = color16;
-                        uint32_t * d32 = (uint32_t *)(&dest_buf_u16[x + 1]);
-                        *d32 = c32;
-                        dest_buf_u16[x + 3] = color16;
+                for(; x <= w - 4; x += 4) {
+                    uint32_t mask32 = *((uint32_t *)&mask[x]);
+                    if(mask32 == 0xFFFFFFFF) {
+                        if((lv_uintptr_t)&dest_buf_u16[x] & 0x3) {
+                            dest_buf_u16[x] = color16;
+                            uint32_t * d32 = (uint32_t *)(&dest_buf_u16[x + 1]);
+                            *d32 = c32;
+                            dest_buf_u16[x + 3] = color16;
+                        }
+                        else {
+                            uint32_t * dest32 = (uint32_t *)&dest_buf_u16[x];
+                            dest32[0] = c32;
+                            dest32[1] = c32;
+                        }
                     }
-                    else {
-                        uint32_t * dest32 = (uint32_t *)&dest_buf_u16[x];
-                        dest32[0] = c32;
-                        dest32[1] = c32;
+                    else if(mask32) {
+                        dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], mask[x + 0]);
+                        dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], mask[x + 1]);
+                        dest_buf_u16[x + 2] = lv_color_16_16_mix(color16, dest_buf_u16[x + 2], mask[x + 2]);
+                        dest_buf_u16[x + 3] = lv_color_16_16_mix(color16, dest_buf_u16[x + 3], mask[x + 3]);
                     }
                 }
-                else if(mask32) {
-                    dest_buf_u16[x + 0] = lv_color_16_16_mix(color16, dest_buf_u16[x + 0], mask[x + 0]);
-                    dest_buf_u16[x + 1] = lv_color_16_16_mix(color16, dest_buf_u16[x + 1], mask[x + 1]);
-                    dest_buf_u16[x + 2] = lv_color_16_16_mix(color16, dest_buf_u16[x + 2], mask[x + 2]);
-                    dest_buf_u16[x + 3] = lv_color_16_16_mix(color16, dest_buf_u16[x + 3], mask[x + 3]);
-                }
-            }
 
-            for(; x < w ; x++) {
-                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
+                for(; x < w ; x++) {
+                    dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], mask[x]);
+                }
+                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                mask += mask_stride;
             }
-            dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-            mask += mask_stride;
         }
-#endif
     }
     /*Masked with opacity*/
     else if(mask && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc);
-#else
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
-                dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], LV_OPA_MIX2(mask[x], opa));
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)) {
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x++) {
+                    dest_buf_u16[x] = lv_color_16_16_mix(color16, dest_buf_u16[x], LV_OPA_MIX2(mask[x], opa));
+                }
+                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                mask += mask_stride;
             }
-            dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-            mask += mask_stride;
         }
-#endif
     }
 }
 
@@ -250,6 +356,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_rgb565(_lv_draw_sw_blend_im
         case LV_COLOR_FORMAT_ARGB8888:
             argb8888_image_blend(dsc);
             break;
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+            argb8888_premultiplied_image_blend(dsc);
+            break;
         default:
             LV_LOG_WARN("Not supported source color format");
             break;
@@ -277,57 +386,49 @@ LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc);
-#else
-            uint32_t line_in_bytes = w * 2;
-            for(y = 0; y < h; y++) {
-                lv_memcpy(dest_buf_u16, src_buf_u16, line_in_bytes);
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_RESULT(dsc)) {
+                uint32_t line_in_bytes = w * 2;
+                for(y = 0; y < h; y++) {
+                    lv_memcpy(dest_buf_u16, src_buf_u16, line_in_bytes);
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+                }
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], opa);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], opa);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], mask_buf[x]);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], mask_buf[x]);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         else {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], LV_OPA_MIX2(mask_buf[x], opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x < w; x++) {
+                        dest_buf_u16[x] = lv_color_16_16_mix(src_buf_u16[x], dest_buf_u16[x], LV_OPA_MIX2(mask_buf[x], opa));
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u16 = drawbuf_next_row(src_buf_u16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -394,60 +495,52 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    dest_buf_u16[dest_x]  = ((src_buf_u8[src_x + 2] & 0xF8) << 8) +
-                                            ((src_buf_u8[src_x + 1] & 0xFC) << 3) +
-                                            ((src_buf_u8[src_x + 0] & 0xF8) >> 3);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        dest_buf_u16[dest_x]  = ((src_buf_u8[src_x + 2] & 0xF8) << 8) +
+                                                ((src_buf_u8[src_x + 1] & 0xFC) << 3) +
+                                                ((src_buf_u8[src_x + 0] & 0xF8) >> 3);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], opa);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], opa);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
             }
-#endif
         }
         if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], mask_buf[dest_x]);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], mask_buf[dest_x]);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
         if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], LV_OPA_MIX2(mask_buf[dest_x], opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc, src_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += src_px_size) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], LV_OPA_MIX2(mask_buf[dest_x], opa));
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -510,61 +603,53 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], src_buf_u8[src_x + 3]);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], src_buf_u8[src_x + 3]);
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], LV_OPA_MIX2(src_buf_u8[src_x + 3],
-                                                                                                                    opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x], LV_OPA_MIX2(src_buf_u8[src_x + 3],
+                                                                                                                        opa));
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x],
-                                                              LV_OPA_MIX2(src_buf_u8[src_x + 3], mask_buf[dest_x]));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x],
+                                                                  LV_OPA_MIX2(src_buf_u8[src_x + 3], mask_buf[dest_x]));
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
         else if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
-                    dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x],
-                                                              LV_OPA_MIX3(src_buf_u8[src_x + 3], mask_buf[dest_x], opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA_RESULT(dsc)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; dest_x < w; dest_x++, src_x += 4) {
+                        dest_buf_u16[dest_x] = lv_color_24_16_mix(&src_buf_u8[src_x], dest_buf_u16[dest_x],
+                                                                  LV_OPA_MIX3(src_buf_u8[src_x + 3], mask_buf[dest_x], opa));
+                    }
+                    dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+                    src_buf_u8 += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
-                src_buf_u8 += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -613,6 +698,81 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
     }
 }
 
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    /*The other blend modes need the straight color*/
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        unpremultiplied_image_blend(dsc);
+        return;
+    }
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_color32_t src = src_buf_c32[x];
+            lv_opa_t mix = opa;
+            if(mask_buf) mix = opa >= LV_OPA_MAX ? mask_buf[x] : LV_OPA_MIX2(mask_buf[x], opa);
+            if(mix < LV_OPA_MAX) {
+                src.red = LV_UDIV255(src.red * mix);
+                src.green = LV_UDIV255(src.green * mix);
+                src.blue = LV_UDIV255(src.blue * mix);
+                src.alpha = LV_UDIV255(src.alpha * mix);
+            }
+            dest_buf_u16[x] = lv_color_32_16_premultiplied_mix(src, dest_buf_u16[x]);
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dest_stride);
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+/**
+ * Convert the premultiplied pixels to ARGB8888 in small chunks and blend them as ARGB8888
+ */
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    lv_color32_t straight_buf[PREMULTIPLIED_CHUNK];
+    _lv_draw_sw_blend_image_dsc_t straight_dsc = *dsc;
+    straight_dsc.src_buf = straight_buf;
+    straight_dsc.src_stride = sizeof(straight_buf);
+    straight_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    straight_dsc.dest_h = 1;
+
+    uint8_t * dest_row = dsc->dest_buf;
+    const lv_color32_t * src_row = dsc->src_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        for(x = 0; x < dsc->dest_w; x += PREMULTIPLIED_CHUNK) {
+            int32_t len = LV_MIN(PREMULTIPLIED_CHUNK, dsc->dest_w - x);
+            int32_t i;
+            for(i = 0; i < len; i++) {
+                straight_buf[i] = lv_color32_unpremultiply(src_row[x + i]);
+            }
+            straight_dsc.dest_w = len;
+            straight_dsc.dest_buf = dest_row + x * 2;
+            if(mask_row) straight_dsc.mask_buf = mask_row + x;
+            argb8888_image_blend(&straight_dsc);
+        }
+        dest_row += dsc->dest_stride;
+        src_row = drawbuf_next_row(src_row, dsc->src_stride);
+        if(mask_row) mask_row += dsc->mask_stride;
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
 {
     if(mix == 0) {
@@ -630,6 +790,23 @@ LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_24_16_mix(const uint8_t *
     }
 }
 
+LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_32_16_premultiplied_mix(lv_color32_t src, uint16_t dest)
+{
+    if(src.alpha == 0) return dest;
+
+    uint32_t red = src.red;
+    uint32_t green = src.green;
+    uint32_t blue = src.blue;
+    if(src.alpha < LV_OPA_MAX) {
+        uint32_t inv = 255 - src.alpha;
+        red += LV_UDIV255((((dest >> 11) & 0x1F) * 2106 >> 8) * inv);
+        green += LV_UDIV255((((dest >> 5) & 0x3F) * 1037 >> 8) * inv);
+        blue += LV_UDIV255(((dest & 0x1F) * 2106 >> 8) * inv);
+    }
+
+    return ((red & 0xF8) << 8) + ((green & 0xFC) << 3) + (blue >> 3);
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
 {
     return (void *)((uint8_t *)buf + stride);
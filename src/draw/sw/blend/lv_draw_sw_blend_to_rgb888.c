@@ -10,6 +10,7 @@
 #if LV_USE_DRAW_SW
 
 #include "lv_draw_sw_blend.h"
+#include "../lv_draw_sw_dispatch.h"
 #include "../../../misc/lv_math.h"
 #include "../../../display/lv_display.h"
 #include "../../../core/lv_refr.h"
@@ -18,6 +19,8 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
     #include "neon/lv_blend_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO
+    #include "../../../core/lv_global.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -26,6 +29,109 @@
  *      DEFINES
  *********************/
 
+/*A `*_RESULT` hook returns `LV_RESULT_INVALID` to fall back to the C implementation.
+ *A hook with the plain name returns `void` and is always considered successful.
+ *Without a hook the kernel selected at runtime is used (if any).*/
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB888, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb888, NORMAL, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb888, WITH_OPA, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb888, WITH_MASK, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb888, MIX_MASK_OPA, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb888, NORMAL, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb888, WITH_OPA, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb888, WITH_MASK, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb565_to_rgb888, MIX_MASK_OPA, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888, dsc, dest_px_size, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb888, NORMAL, dsc, dest_px_size, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA, dsc, dest_px_size, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb888, WITH_OPA, dsc, dest_px_size, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK, dsc, dest_px_size, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb888, WITH_MASK, dsc, dest_px_size, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA, dsc, dest_px_size, src_px_size)
+#elif !defined(LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size, src_px_size)  LV_DRAW_SW_BLEND_DISPATCH(rgb888_to_rgb888, MIX_MASK_OPA, dsc, dest_px_size, src_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb888, NORMAL, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb888, WITH_OPA, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb888, WITH_MASK, dsc, dest_px_size)
+#endif
+
+#if defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA) && !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_HOOK_OK(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA, dsc, dest_px_size)
+#elif !defined(LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT)
+    #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)  LV_DRAW_SW_BLEND_DISPATCH(argb8888_to_rgb888, MIX_MASK_OPA, dsc, dest_px_size)
+#endif
+
+/*Number of premultiplied pixels converted to straight alpha at once*/
+#define PREMULTIPLIED_CHUNK     32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -41,8 +147,15 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
 
 LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
 
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                     uint32_t dest_px_size);
+
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+
 LV_ATTRIBUTE_FAST_MEM static inline void lv_color_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix);
 
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_32_24_premultiplied_mix(lv_color32_t src, uint8_t * dest);
+
 LV_ATTRIBUTE_FAST_MEM static inline void blend_non_normal_pixel(uint8_t * dest, lv_color32_t src, lv_blend_mode_t mode);
 LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
 
@@ -81,115 +194,107 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_color_to_rgb888(_lv_draw_sw_blend_fi
 
     /*Simple fill*/
     if(mask == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB888
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB888(dsc, dest_px_size);
-#else
-        if(dest_px_size == 3) {
-            uint8_t * dest_buf_u8 = dsc->dest_buf;
-            uint8_t * dest_buf_ori = dsc->dest_buf;
-            w *= dest_px_size;
-
-            for(x = 0; x < w; x += 3) {
-                dest_buf_u8[x + 0] = dsc->color.blue;
-                dest_buf_u8[x + 1] = dsc->color.green;
-                dest_buf_u8[x + 2] = dsc->color.red;
-            }
-
-            dest_buf_u8 += dest_stride;
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB888_RESULT(dsc, dest_px_size)) {
+            if(dest_px_size == 3) {
+                uint8_t * dest_buf_u8 = dsc->dest_buf;
+                uint8_t * dest_buf_ori = dsc->dest_buf;
+                w *= dest_px_size;
+
+                for(x = 0; x < w; x += 3) {
+                    dest_buf_u8[x + 0] = dsc->color.blue;
+                    dest_buf_u8[x + 1] = dsc->color.green;
+                    dest_buf_u8[x + 2] = dsc->color.red;
+                }
 
-            for(y = 1; y < h; y++) {
-                lv_memcpy(dest_buf_u8, dest_buf_ori, w);
                 dest_buf_u8 += dest_stride;
-            }
-        }
-        if(dest_px_size == 4) {
-            uint32_t color32 = lv_color_to_u32(dsc->color);
-            uint32_t * dest_buf_u32 = dsc->dest_buf;
-            for(y = 0; y < h; y++) {
-                for(x = 0; x <= w - 16; x += 16) {
-                    dest_buf_u32[x + 0] = color32;
-                    dest_buf_u32[x + 1] = color32;
-                    dest_buf_u32[x + 2] = color32;
-                    dest_buf_u32[x + 3] = color32;
-
-                    dest_buf_u32[x + 4] = color32;
-                    dest_buf_u32[x + 5] = color32;
-                    dest_buf_u32[x + 6] = color32;
-                    dest_buf_u32[x + 7] = color32;
-
-                    dest_buf_u32[x + 8] = color32;
-                    dest_buf_u32[x + 9] = color32;
-                    dest_buf_u32[x + 10] = color32;
-                    dest_buf_u32[x + 11] = color32;
-
-                    dest_buf_u32[x + 12] = color32;
-                    dest_buf_u32[x + 13] = color32;
-                    dest_buf_u32[x + 14] = color32;
-                    dest_buf_u32[x + 15] = color32;
-                }
-                for(; x < w; x ++) {
-                    dest_buf_u32[x] = color32;
+
+                for(y = 1; y < h; y++) {
+                    lv_memcpy(dest_buf_u8, dest_buf_ori, w);
+                    dest_buf_u8 += dest_stride;
                 }
+            }
+            if(dest_px_size == 4) {
+                uint32_t color32 = lv_color_to_u32(dsc->color);
+                uint32_t * dest_buf_u32 = dsc->dest_buf;
+                for(y = 0; y < h; y++) {
+                    for(x = 0; x <= w - 16; x += 16) {
+                        dest_buf_u32[x + 0] = color32;
+                        dest_buf_u32[x + 1] = color32;
+                        dest_buf_u32[x + 2] = color32;
+                        dest_buf_u32[x + 3] = color32;
+
+                        dest_buf_u32[x + 4] = color32;
+                        dest_buf_u32[x + 5] = color32;
+                        dest_buf_u32[x + 6] = color32;
+                        dest_buf_u32[x + 7] = color32;
+
+                        dest_buf_u32[x + 8] = color32;
+                        dest_buf_u32[x + 9] = color32;
+                        dest_buf_u32[x + 10] = color32;
+                        dest_buf_u32[x + 11] = color32;
+
+                        dest_buf_u32[x + 12] = color32;
+                        dest_buf_u32[x + 13] = color32;
+                        dest_buf_u32[x + 14] = color32;
+                        dest_buf_u32[x + 15] = color32;
+                    }
+                    for(; x < w; x ++) {
+                        dest_buf_u32[x] = color32;
+                    }
 
-                dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+                    dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dest_stride);
+                }
             }
         }
-#endif
     }
     /*Opacity only*/
     else if(mask == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA(dsc, dest_px_size);
-#else
-        uint32_t color32 = lv_color_to_u32(dsc->color);
-        uint8_t * dest_buf = dsc->dest_buf;
-        w *= dest_px_size;
-        for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x += dest_px_size) {
-                lv_color_24_24_mix((const uint8_t *)&color32, &dest_buf[x], opa);
-            }
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)) {
+            uint32_t color32 = lv_color_to_u32(dsc->color);
+            uint8_t * dest_buf = dsc->dest_buf;
+            w *= dest_px_size;
+            for(y = 0; y < h; y++) {
+                for(x = 0; x < w; x += dest_px_size) {
+                    lv_color_24_24_mix((const uint8_t *)&color32, &dest_buf[x], opa);
+                }
 
-            dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+                dest_buf = drawbuf_next_row(dest_buf, dest_stride);
+            }
         }
-#endif
     }
     /*Masked with full opacity*/
     else if(mask && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK(dsc, dest_px_size);
-#else
-        uint32_t color32 = lv_color_to_u32(dsc->color);
-        uint8_t * dest_buf = dsc->dest_buf;
-        w *= dest_px_size;
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)) {
+            uint32_t color32 = lv_color_to_u32(dsc->color);
+            uint8_t * dest_buf = dsc->dest_buf;
+            w *= dest_px_size;
 
-        for(y = 0; y < h; y++) {
-            uint32_t mask_x;
-            for(x = 0, mask_x = 0; x < w; x += dest_px_size, mask_x++) {
-                lv_color_24_24_mix((const uint8_t *)&color32, &dest_buf[x], mask[mask_x]);
+            for(y = 0; y < h; y++) {
+                uint32_t mask_x;
+                for(x = 0, mask_x = 0; x < w; x += dest_px_size, mask_x++) {
+                    lv_color_24_24_mix((const uint8_t *)&color32, &dest_buf[x], mask[mask_x]);
+                }
+                dest_buf += dest_stride;
+                mask += mask_stride;
             }
-            dest_buf += dest_stride;
-            mask += mask_stride;
         }
-#endif
     }
     /*Masked with opacity*/
     else {
-#ifdef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA
-        LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA(dsc, dest_px_size);
-#else
-        uint32_t color32 = lv_color_to_u32(dsc->color);
-        uint8_t * dest_buf = dsc->dest_buf;
-        w *= dest_px_size;
+        if(LV_RESULT_INVALID == LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)) {
+            uint32_t color32 = lv_color_to_u32(dsc->color);
+            uint8_t * dest_buf = dsc->dest_buf;
+            w *= dest_px_size;
 
-        for(y = 0; y < h; y++) {
-            uint32_t mask_x;
-            for(x = 0, mask_x = 0; x < w; x += dest_px_size, mask_x++) {
-                lv_color_24_24_mix((const uint8_t *) &color32, &dest_buf[x], LV_OPA_MIX2(opa, mask[mask_x]));
+            for(y = 0; y < h; y++) {
+                uint32_t mask_x;
+                for(x = 0, mask_x = 0; x < w; x += dest_px_size, mask_x++) {
+                    lv_color_24_24_mix((const uint8_t *) &color32, &dest_buf[x], LV_OPA_MIX2(opa, mask[mask_x]));
+                }
+                dest_buf += dest_stride;
+                mask += mask_stride;
             }
-            dest_buf += dest_stride;
-            mask += mask_stride;
         }
-#endif
     }
 }
 
@@ -209,6 +314,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_image_to_rgb888(_lv_draw_sw_blend_im
         case LV_COLOR_FORMAT_ARGB8888:
             argb8888_image_blend(dsc, dest_px_size);
             break;
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+            argb8888_premultiplied_image_blend(dsc, dest_px_size);
+            break;
         default:
             LV_LOG_WARN("Not supported source color format");
             break;
@@ -237,72 +345,64 @@ LV_ATTRIBUTE_FAST_MEM static void rgb565_image_blend(_lv_draw_sw_blend_image_dsc
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888(dsc, dest_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    dest_buf_u8[dest_x + 2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
-                    dest_buf_u8[dest_x + 1] = (src_buf_c16[src_x].green * 1037) >> 8;
-                    dest_buf_u8[dest_x + 0] = (src_buf_c16[src_x].blue * 2106) >> 8;
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        dest_buf_u8[dest_x + 2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
+                        dest_buf_u8[dest_x + 1] = (src_buf_c16[src_x].green * 1037) >> 8;
+                        dest_buf_u8[dest_x + 0] = (src_buf_c16[src_x].blue * 2106) >> 8;
+                    }
+                    dest_buf_u8 += dest_stride;
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
                 }
-                dest_buf_u8 += dest_stride;
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dest_px_size);
-#else
-            uint8_t res[3];
-            for(y = 0; y < h; y++) {
-                for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    res[2] = (src_buf_c16[src_x].red * 2106) >> 8; /*To make it rounded*/
-                    res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
-                    res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
-                    lv_color_24_24_mix(res, &dest_buf_u8[dest_x], opa);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)) {
+                uint8_t res[3];
+                for(y = 0; y < h; y++) {
+                    for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        res[2] = (src_buf_c16[src_x].red * 2106) >> 8; /*To make it rounded*/
+                        res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
+                        res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
+                        lv_color_24_24_mix(res, &dest_buf_u8[dest_x], opa);
+                    }
+                    dest_buf_u8 += dest_stride;
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
                 }
-                dest_buf_u8 += dest_stride;
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dest_px_size);
-#else
-            uint8_t res[3];
-            for(y = 0; y < h; y++) {
-                for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    res[2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
-                    res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
-                    res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
-                    lv_color_24_24_mix(res, &dest_buf_u8[dest_x], mask_buf[src_x]);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)) {
+                uint8_t res[3];
+                for(y = 0; y < h; y++) {
+                    for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        res[2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
+                        res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
+                        res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
+                        lv_color_24_24_mix(res, &dest_buf_u8[dest_x], mask_buf[src_x]);
+                    }
+                    dest_buf_u8 += dest_stride;
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u8 += dest_stride;
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         else {
-#ifdef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
-            LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dest_px_size);
-#else
-            uint8_t res[3];
-            for(y = 0; y < h; y++) {
-                for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    res[2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
-                    res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
-                    res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
-                    lv_color_24_24_mix(res, &dest_buf_u8[dest_x], LV_OPA_MIX2(opa, mask_buf[src_x]));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)) {
+                uint8_t res[3];
+                for(y = 0; y < h; y++) {
+                    for(src_x = 0, dest_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        res[2] = (src_buf_c16[src_x].red * 2106) >> 8;  /*To make it rounded*/
+                        res[1] = (src_buf_c16[src_x].green * 1037) >> 8;
+                        res[0] = (src_buf_c16[src_x].blue * 2106) >> 8;
+                        lv_color_24_24_mix(res, &dest_buf_u8[dest_x], LV_OPA_MIX2(opa, mask_buf[src_x]));
+                    }
+                    dest_buf_u8 += dest_stride;
+                    src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf_u8 += dest_stride;
-                src_buf_c16 = drawbuf_next_row(src_buf_c16, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -343,71 +443,63 @@ LV_ATTRIBUTE_FAST_MEM static void rgb888_image_blend(_lv_draw_sw_blend_image_dsc
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         /*Special case*/
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888(dsc, dest_px_size, src_px_size);
-#else
-            if(src_px_size == dest_px_size) {
-                for(y = 0; y < h; y++) {
-                    lv_memcpy(dest_buf, src_buf, w);
-                    dest_buf += dest_stride;
-                    src_buf += src_stride;
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size, src_px_size)) {
+                if(src_px_size == dest_px_size) {
+                    for(y = 0; y < h; y++) {
+                        lv_memcpy(dest_buf, src_buf, w);
+                        dest_buf += dest_stride;
+                        src_buf += src_stride;
+                    }
+                }
+                else {
+                    for(y = 0; y < h; y++) {
+                        for(dest_x = 0, src_x = 0; dest_x < w; dest_x += dest_px_size, src_x += src_px_size) {
+                            dest_buf[dest_x + 0] = src_buf[src_x + 0];
+                            dest_buf[dest_x + 1] = src_buf[src_x + 1];
+                            dest_buf[dest_x + 2] = src_buf[src_x + 2];
+                        }
+                        dest_buf += dest_stride;
+                        src_buf += src_stride;
+                    }
                 }
             }
-            else {
+        }
+        if(mask_buf == NULL && opa < LV_OPA_MAX) {
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size, src_px_size)) {
                 for(y = 0; y < h; y++) {
                     for(dest_x = 0, src_x = 0; dest_x < w; dest_x += dest_px_size, src_x += src_px_size) {
-                        dest_buf[dest_x + 0] = src_buf[src_x + 0];
-                        dest_buf[dest_x + 1] = src_buf[src_x + 1];
-                        dest_buf[dest_x + 2] = src_buf[src_x + 2];
+                        lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], opa);
                     }
                     dest_buf += dest_stride;
                     src_buf += src_stride;
                 }
             }
-#endif
-        }
-        if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dest_px_size, src_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; dest_x < w; dest_x += dest_px_size, src_x += src_px_size) {
-                    lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], opa);
-                }
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-            }
-#endif
         }
         if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dest_px_size, src_px_size);
-#else
-            uint32_t mask_x;
-            for(y = 0; y < h; y++) {
-                for(mask_x = 0, dest_x = 0, src_x = 0; dest_x < w; mask_x++, dest_x += dest_px_size, src_x += src_px_size) {
-                    lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], mask_buf[mask_x]);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size, src_px_size)) {
+                uint32_t mask_x;
+                for(y = 0; y < h; y++) {
+                    for(mask_x = 0, dest_x = 0, src_x = 0; dest_x < w; mask_x++, dest_x += dest_px_size, src_x += src_px_size) {
+                        lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], mask_buf[mask_x]);
+                    }
+                    dest_buf += dest_stride;
+                    src_buf += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
         if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
-            LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dest_px_size, src_px_size);
-#else
-            uint32_t mask_x;
-            for(y = 0; y < h; y++) {
-                for(mask_x = 0, dest_x = 0, src_x = 0; dest_x < w; mask_x++, dest_x += dest_px_size, src_x += src_px_size) {
-                    lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], LV_OPA_MIX2(opa, mask_buf[mask_x]));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size, src_px_size)) {
+                uint32_t mask_x;
+                for(y = 0; y < h; y++) {
+                    for(mask_x = 0, dest_x = 0, src_x = 0; dest_x < w; mask_x++, dest_x += dest_px_size, src_x += src_px_size) {
+                        lv_color_24_24_mix(&src_buf[src_x], &dest_buf[dest_x], LV_OPA_MIX2(opa, mask_buf[mask_x]));
+                    }
+                    dest_buf += dest_stride;
+                    src_buf += src_stride;
+                    mask_buf += mask_stride;
                 }
-                dest_buf += dest_stride;
-                src_buf += src_stride;
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -447,60 +539,52 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
 
     if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
         if(mask_buf == NULL && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888(dsc, dest_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x], src_buf_c32[src_x].alpha);
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_RESULT(dsc, dest_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x], src_buf_c32[src_x].alpha);
+                    }
+                    dest_buf += dest_stride;
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
                 }
-                dest_buf += dest_stride;
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
             }
-#endif
         }
         else if(mask_buf == NULL && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dest_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x], LV_OPA_MIX2(src_buf_c32[src_x].alpha, opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA_RESULT(dsc, dest_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x], LV_OPA_MIX2(src_buf_c32[src_x].alpha, opa));
+                    }
+                    dest_buf += dest_stride;
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
                 }
-                dest_buf += dest_stride;
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
             }
-#endif
         }
         else if(mask_buf && opa >= LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dest_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x],
-                                       LV_OPA_MIX2(src_buf_c32[src_x].alpha, mask_buf[src_x]));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK_RESULT(dsc, dest_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x],
+                                           LV_OPA_MIX2(src_buf_c32[src_x].alpha, mask_buf[src_x]));
+                    }
+                    dest_buf += dest_stride;
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf += dest_stride;
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
         else if(mask_buf && opa < LV_OPA_MAX) {
-#ifdef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
-            LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dest_px_size);
-#else
-            for(y = 0; y < h; y++) {
-                for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
-                    lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x],
-                                       LV_OPA_MIX3(src_buf_c32[src_x].alpha, mask_buf[src_x], opa));
+            if(LV_RESULT_INVALID == LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA_RESULT(dsc, dest_px_size)) {
+                for(y = 0; y < h; y++) {
+                    for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+                        lv_color_24_24_mix((const uint8_t *)&src_buf_c32[src_x], &dest_buf[dest_x],
+                                           LV_OPA_MIX3(src_buf_c32[src_x].alpha, mask_buf[src_x], opa));
+                    }
+                    dest_buf += dest_stride;
+                    src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+                    mask_buf += mask_stride;
                 }
-                dest_buf += dest_stride;
-                src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
-                mask_buf += mask_stride;
             }
-#endif
         }
     }
     else {
@@ -520,6 +604,83 @@ LV_ATTRIBUTE_FAST_MEM static void argb8888_image_blend(_lv_draw_sw_blend_image_d
     }
 }
 
+LV_ATTRIBUTE_FAST_MEM static void argb8888_premultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                     uint32_t dest_px_size)
+{
+    /*The other blend modes need the straight color*/
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        unpremultiplied_image_blend(dsc, dest_px_size);
+        return;
+    }
+
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t dest_stride = dsc->dest_stride;
+    const lv_color32_t * src_buf_c32 = dsc->src_buf;
+    int32_t src_stride = dsc->src_stride;
+    const lv_opa_t * mask_buf = dsc->mask_buf;
+    int32_t mask_stride = dsc->mask_stride;
+
+    int32_t dest_x;
+    int32_t src_x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(dest_x = 0, src_x = 0; src_x < w; dest_x += dest_px_size, src_x++) {
+            lv_color32_t src = src_buf_c32[src_x];
+            lv_opa_t mix = opa;
+            if(mask_buf) mix = opa >= LV_OPA_MAX ? mask_buf[src_x] : LV_OPA_MIX2(mask_buf[src_x], opa);
+            if(mix < LV_OPA_MAX) {
+                src.red = LV_UDIV255(src.red * mix);
+                src.green = LV_UDIV255(src.green * mix);
+                src.blue = LV_UDIV255(src.blue * mix);
+                src.alpha = LV_UDIV255(src.alpha * mix);
+            }
+            lv_color_32_24_premultiplied_mix(src, &dest_buf[dest_x]);
+        }
+        dest_buf += dest_stride;
+        src_buf_c32 = drawbuf_next_row(src_buf_c32, src_stride);
+        if(mask_buf) mask_buf += mask_stride;
+    }
+}
+
+/**
+ * Convert the premultiplied pixels to ARGB8888 in small chunks and blend them as ARGB8888
+ */
+LV_ATTRIBUTE_FAST_MEM static void unpremultiplied_image_blend(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    lv_color32_t straight_buf[PREMULTIPLIED_CHUNK];
+    _lv_draw_sw_blend_image_dsc_t straight_dsc = *dsc;
+    straight_dsc.src_buf = straight_buf;
+    straight_dsc.src_stride = sizeof(straight_buf);
+    straight_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    straight_dsc.dest_h = 1;
+
+    uint8_t * dest_row = dsc->dest_buf;
+    const lv_color32_t * src_row = dsc->src_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        for(x = 0; x < dsc->dest_w; x += PREMULTIPLIED_CHUNK) {
+            int32_t len = LV_MIN(PREMULTIPLIED_CHUNK, dsc->dest_w - x);
+            int32_t i;
+            for(i = 0; i < len; i++) {
+                straight_buf[i] = lv_color32_unpremultiply(src_row[x + i]);
+            }
+            straight_dsc.dest_w = len;
+            straight_dsc.dest_buf = dest_row + x * dest_px_size;
+            if(mask_row) straight_dsc.mask_buf = mask_row + x;
+            argb8888_image_blend(&straight_dsc, dest_px_size);
+        }
+        dest_row += dsc->dest_stride;
+        src_row = drawbuf_next_row(src_row, dsc->src_stride);
+        if(mask_row) mask_row += dsc->mask_stride;
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline void blend_non_normal_pixel(uint8_t * dest, lv_color32_t src, lv_blend_mode_t mode)
 {
     uint8_t res[3] = {0, 0, 0};
@@ -564,6 +725,23 @@ LV_ATTRIBUTE_FAST_MEM static inline void lv_color_24_24_mix(const uint8_t * src,
     }
 }
 
+LV_ATTRIBUTE_FAST_MEM static inline void lv_color_32_24_premultiplied_mix(lv_color32_t src, uint8_t * dest)
+{
+    if(src.alpha == 0) return;
+
+    if(src.alpha >= LV_OPA_MAX) {
+        dest[0] = src.blue;
+        dest[1] = src.green;
+        dest[2] = src.red;
+    }
+    else {
+        uint32_t inv = 255 - src.alpha;
+        dest[0] = src.blue + LV_UDIV255(dest[0] * inv);
+        dest[1] = src.green + LV_UDIV255(dest[1] * inv);
+        dest[2] = src.red + LV_UDIV255(dest[2] * inv);
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
 {
     return (void *)((uint8_t *)buf + stride);
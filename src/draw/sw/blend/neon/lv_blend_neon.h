@@ -16,12 +16,24 @@ extern "C" {
 
 #include "../../../../lv_conf_internal.h"
 
-#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && !defined(__ASSEMBLY__)
+/*The NEON functions are built if they are selected explicitly or can be selected at runtime on 32 bit ARM Linux*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+#define _LV_BLEND_NEON_ENABLED 1
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO && defined(__arm__) && defined(__linux__)
+#define _LV_BLEND_NEON_ENABLED 1
+#else
+#define _LV_BLEND_NEON_ENABLED 0
+#endif
+
+#if _LV_BLEND_NEON_ENABLED && !defined(__ASSEMBLY__)
 
 /*********************
  *      DEFINES
  *********************/
 
+/*In LV_DRAW_SW_ASM_AUTO mode the functions are called via `lv_draw_sw_dispatch` instead*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+
 #define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
     _lv_color_blend_to_rgb565_neon(dsc)
 
@@ -166,6 +178,8 @@ extern "C" {
 #define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
     _lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_neon(dsc)
 
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -1131,7 +1145,7 @@ static inline void _lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_neon(_lv_d
  *      MACROS
  **********************/
 
-#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && !defined(__ASSEMBLY__)*/
+#endif /*_LV_BLEND_NEON_ENABLED && !defined(__ASSEMBLY__)*/
 
 #ifdef __cplusplus
 } /*extern "C"*/
@@ -0,0 +1,75 @@
+/**
+ * @file lv_blend_avx2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED
+
+#include <immintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Build the AVX2 functions even if the whole project is not compiled with `-mavx2`*/
+#if defined(__GNUC__)
+    #define LV_BLEND_X86_ATTR   __attribute__((target("avx2")))
+#else
+    #define LV_BLEND_X86_ATTR
+#endif
+
+#define V_NAME(name)        name##_avx2
+#define V_T                 __m256i
+#define V_PX                8
+
+#define V_LOADU(p)          _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define V_STOREU(p, v)      _mm256_storeu_si256((__m256i *)(void *)(p), v)
+#define V_SET1(x)           _mm256_set1_epi32((int32_t)(x))
+#define V_AND(a, b)         _mm256_and_si256(a, b)
+#define V_OR(a, b)          _mm256_or_si256(a, b)
+#define V_ANDNOT(a, b)      _mm256_andnot_si256(a, b)
+#define V_ADD16(a, b)       _mm256_add_epi16(a, b)
+#define V_ADD32(a, b)       _mm256_add_epi32(a, b)
+#define V_SUB32(a, b)       _mm256_sub_epi32(a, b)
+#define V_SRLI16(a, n)      _mm256_srli_epi16(a, n)
+#define V_SRLI32(a, n)      _mm256_srli_epi32(a, n)
+#define V_SLLI32(a, n)      _mm256_slli_epi32(a, n)
+#define V_SRAI32(a, n)      _mm256_srai_epi32(a, n)
+#define V_MULLO16(a, b)     _mm256_mullo_epi16(a, b)
+#define V_MULHI16(a, b)     _mm256_mulhi_epu16(a, b)
+#define V_MULLO32(a, b)     _mm256_mullo_epi32(a, b)
+#define V_CMPEQ32(a, b)     _mm256_cmpeq_epi32(a, b)
+#define V_CMPGT32(a, b)     _mm256_cmpgt_epi32(a, b)
+#define V_MOVEMASK32(a)     _mm256_movemask_ps(_mm256_castsi256_ps(a))
+
+/*8 bytes to 8 lanes*/
+#define V_LOAD_U8(p)        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(const void *)(p)))
+
+/*8 uint16_t to 8 lanes and back. The values in the lanes must fit into 16 bits.*/
+#define V_LOAD_U16(p)       _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(const void *)(p)))
+#define V_STORE_U16(p, v)   store_u16_avx2(p, v)
+
+/*Index of the lanes and loading 8 uint32_t from `base + ofs` of each lane*/
+#define V_LANE_IDX          _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+#define V_GATHER32(base, ofs) _mm256_i32gather_epi32((const int *)(const void *)(base), ofs, 1)
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline LV_BLEND_X86_ATTR void store_u16_avx2(void * p, __m256i v)
+{
+    /*The pack works in 128 bit lanes so the 64 bit blocks need to be reordered*/
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, _mm256_setzero_si256()), 0xD8);
+    _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(packed));
+}
+
+#include "lv_blend_x86_kernels.h"
+
+#endif /*LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED*/
@@ -0,0 +1,100 @@
+/**
+ * @file lv_blend_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED
+
+#include "../../../../stdlib/lv_string.h"
+#include <emmintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if defined(__GNUC__)
+    #define LV_BLEND_X86_ATTR   __attribute__((target("sse2")))
+#else
+    #define LV_BLEND_X86_ATTR
+#endif
+
+#define V_NAME(name)        name##_sse2
+#define V_T                 __m128i
+#define V_PX                4
+
+#define V_LOADU(p)          _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define V_STOREU(p, v)      _mm_storeu_si128((__m128i *)(void *)(p), v)
+#define V_SET1(x)           _mm_set1_epi32((int32_t)(x))
+#define V_AND(a, b)         _mm_and_si128(a, b)
+#define V_OR(a, b)          _mm_or_si128(a, b)
+#define V_ANDNOT(a, b)      _mm_andnot_si128(a, b)
+#define V_ADD16(a, b)       _mm_add_epi16(a, b)
+#define V_ADD32(a, b)       _mm_add_epi32(a, b)
+#define V_SUB32(a, b)       _mm_sub_epi32(a, b)
+#define V_SRLI16(a, n)      _mm_srli_epi16(a, n)
+#define V_SRLI32(a, n)      _mm_srli_epi32(a, n)
+#define V_SLLI32(a, n)      _mm_slli_epi32(a, n)
+#define V_SRAI32(a, n)      _mm_srai_epi32(a, n)
+#define V_MULLO16(a, b)     _mm_mullo_epi16(a, b)
+#define V_MULHI16(a, b)     _mm_mulhi_epu16(a, b)
+#define V_MULLO32(a, b)     mullo32_sse2(a, b)
+#define V_CMPEQ32(a, b)     _mm_cmpeq_epi32(a, b)
+#define V_CMPGT32(a, b)     _mm_cmpgt_epi32(a, b)
+#define V_MOVEMASK32(a)     _mm_movemask_ps(_mm_castsi128_ps(a))
+
+/*4 bytes to 4 lanes*/
+#define V_LOAD_U8(p)        load_u8_sse2(p)
+
+/*4 uint16_t to 4 lanes and back. The values in the lanes must fit into 16 bits.*/
+#define V_LOAD_U16(p)       _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(const void *)(p)), _mm_setzero_si128())
+#define V_STORE_U16(p, v)   store_u16_sse2(p, v)
+
+/*Index of the lanes and loading 4 uint32_t from `base + ofs` of each lane*/
+#define V_LANE_IDX          _mm_setr_epi32(0, 1, 2, 3)
+#define V_GATHER32(base, ofs) gather32_sse2(base, ofs)
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline LV_BLEND_X86_ATTR __m128i load_u8_sse2(const uint8_t * p)
+{
+    int32_t v;
+    lv_memcpy(&v, p, sizeof(v));
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+}
+
+static inline LV_BLEND_X86_ATTR void store_u16_sse2(void * p, __m128i v)
+{
+    /*There is no unsigned saturating 32 to 16 bit pack in SSE2 so sign extend first*/
+    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+    _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(v, v));
+}
+
+static inline LV_BLEND_X86_ATTR __m128i mullo32_sse2(__m128i a, __m128i b)
+{
+    /*Multiply the even and odd lanes separately and keep the lower 32 bits*/
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline LV_BLEND_X86_ATTR __m128i gather32_sse2(const uint8_t * base, __m128i ofs)
+{
+    int32_t o[4];
+    _mm_storeu_si128((__m128i *)o, ofs);
+    return _mm_setr_epi32(*(const int32_t *)(base + o[0]), *(const int32_t *)(base + o[1]),
+                          *(const int32_t *)(base + o[2]), *(const int32_t *)(base + o[3]));
+}
+
+#include "lv_blend_x86_kernels.h"
+
+#endif /*LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED*/
@@ -0,0 +1,219 @@
+/**
+ * @file lv_blend_x86.h
+ *
+ */
+
+#ifndef LV_BLEND_X86_H
+#define LV_BLEND_X86_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define _LV_BLEND_X86_TARGET 1
+#else
+#define _LV_BLEND_X86_TARGET 0
+#endif
+
+/*The x86 functions are built if they are selected explicitly or can be selected at runtime*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+#if !_LV_BLEND_X86_TARGET
+#error "LV_DRAW_SW_ASM_SSE2 and LV_DRAW_SW_ASM_AVX2 can be used only on x86 targets"
+#endif
+#define _LV_BLEND_X86_ENABLED 1
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO && _LV_BLEND_X86_TARGET
+#define _LV_BLEND_X86_ENABLED 1
+#else
+#define _LV_BLEND_X86_ENABLED 0
+#endif
+
+#if _LV_BLEND_X86_ENABLED
+
+#include "../lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*In LV_DRAW_SW_ASM_AUTO mode the functions are called via `lv_draw_sw_dispatch` instead*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+#define _LV_BLEND_X86(name) name##_avx2
+#else
+#define _LV_BLEND_X86(name) name##_sse2
+#endif
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_rgb565)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_rgb565_with_opa)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_rgb565_with_mask)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_rgb565_mix_mask_opa)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_rgb565)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_rgb565_with_opa)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_rgb565_with_mask)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_rgb565_mix_mask_opa)(dsc)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_rgb565)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_rgb565_with_opa)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_rgb565_with_mask)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_rgb565_mix_mask_opa)(dsc, src_px_size)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_rgb565)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_rgb565_with_opa)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_rgb565_with_mask)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_rgb565_mix_mask_opa)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_argb8888)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_argb8888_with_opa)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_argb8888_with_mask)(dsc)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    _LV_BLEND_X86(lv_color_blend_to_argb8888_mix_mask_opa)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_argb8888)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_argb8888_with_opa)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_argb8888_with_mask)(dsc)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    _LV_BLEND_X86(lv_rgb565_blend_normal_to_argb8888_mix_mask_opa)(dsc)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_argb8888)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_argb8888_with_opa)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_argb8888_with_mask)(dsc, src_px_size)
+
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc, src_px_size)  \
+    _LV_BLEND_X86(lv_rgb888_blend_normal_to_argb8888_mix_mask_opa)(dsc, src_px_size)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_argb8888)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_argb8888_with_opa)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_argb8888_with_mask)(dsc)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    _LV_BLEND_X86(lv_argb8888_blend_normal_to_argb8888_mix_mask_opa)(dsc)
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*Both variants are always built so the AVX2 functions can be tested and selected on CPUs which support them.
+ *The AVX2 functions must not be called on CPUs without AVX2.*/
+
+#define _LV_BLEND_X86_PROTOTYPES(sfx) \
+    void lv_color_blend_to_rgb565_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_rgb565_with_opa_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_rgb565_with_mask_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_rgb565_mix_mask_opa_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_rgb565_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_rgb565_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_rgb565_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb888_blend_normal_to_rgb565_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_rgb565_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_rgb565_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_argb8888_blend_normal_to_rgb565_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_rgb565_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_rgb565_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_color_blend_to_argb8888_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_argb8888_with_opa_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_argb8888_with_mask_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_color_blend_to_argb8888_mix_mask_opa_##sfx(_lv_draw_sw_blend_fill_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_argb8888_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_argb8888_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_argb8888_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb565_blend_normal_to_argb8888_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_rgb888_blend_normal_to_argb8888_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_argb8888_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_argb8888_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_rgb888_blend_normal_to_argb8888_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size); \
+    void lv_argb8888_blend_normal_to_argb8888_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_argb8888_with_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_argb8888_with_mask_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_##sfx(_lv_draw_sw_blend_image_dsc_t * dsc); \
+    void lv_argb8888_transform_##sfx(const uint8_t * src, int32_t src_h, int32_t src_stride, \
+                                     int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, \
+                                     int32_t x_start, int32_t x_end, void * dest_buf, uint8_t * abuf);
+
+_LV_BLEND_X86_PROTOTYPES(sse2)
+_LV_BLEND_X86_PROTOTYPES(avx2)
+
+/*Rotating is bound by the memory access so the SSE2 versions are used with AVX2 too*/
+void lv_argb8888_rotate90_sse2(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                               int32_t src_stride, int32_t dest_stride);
+void lv_argb8888_rotate270_sse2(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                                int32_t src_stride, int32_t dest_stride);
+void lv_rgb565_rotate90_sse2(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                             int32_t src_stride, int32_t dest_stride);
+void lv_rgb565_rotate270_sse2(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                              int32_t src_stride, int32_t dest_stride);
+
+#endif /*_LV_BLEND_X86_ENABLED*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_X86_H*/
@@ -0,0 +1,659 @@
+/**
+ * @file lv_blend_x86_kernels.h
+ *
+ * The blending and transform kernels shared by the SSE2 and AVX2 backends.
+ * It's included by `lv_blend_sse2.c` and `lv_blend_avx2.c` after defining the `V_...` vector primitives
+ * and it shouldn't be included anywhere else.
+ *
+ * One pixel is processed in one 32 bit lane so a vector contains `V_PX` pixels.
+ * The results are bit exact with the C implementations in `lv_draw_sw_blend_to_argb8888.c`
+ * and `lv_draw_sw_blend_to_rgb565.c`, and with the interior sampler in `lv_draw_sw_transform.c`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define V_ALL_LANES     ((1 << V_PX) - 1)
+
+#define V_FUNC          static inline LV_BLEND_X86_ATTR
+#define V_SEL(m, a, b)  V_OR(V_AND(m, a), V_ANDNOT(m, b))
+
+/*LV_OPA_MIX2 on 32 bit lanes*/
+#define V_MIX2(a, b)    V_SRLI32(V_MULLO16(a, b), 8)
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride);
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The loaders and storers handle the last `n < V_PX` pixels of a row via a temporary buffer
+ *to not touch the memory after the end of the row*/
+
+V_FUNC V_T load32(const void * p, int32_t n)
+{
+    if(n >= V_PX) return V_LOADU(p);
+
+    uint32_t tmp[V_PX] = {0};
+    lv_memcpy(tmp, p, n * sizeof(uint32_t));
+    return V_LOADU(tmp);
+}
+
+V_FUNC void store32(void * p, V_T v, int32_t n)
+{
+    if(n >= V_PX) {
+        V_STOREU(p, v);
+        return;
+    }
+
+    uint32_t tmp[V_PX];
+    V_STOREU(tmp, v);
+    lv_memcpy(p, tmp, n * sizeof(uint32_t));
+}
+
+V_FUNC V_T load16(const void * p, int32_t n)
+{
+    if(n >= V_PX) return V_LOAD_U16(p);
+
+    uint16_t tmp[V_PX] = {0};
+    lv_memcpy(tmp, p, n * sizeof(uint16_t));
+    return V_LOAD_U16(tmp);
+}
+
+V_FUNC void store16(void * p, V_T v, int32_t n)
+{
+    if(n >= V_PX) {
+        V_STORE_U16(p, v);
+        return;
+    }
+
+    uint16_t tmp[V_PX];
+    V_STORE_U16(tmp, v);
+    lv_memcpy(p, tmp, n * sizeof(uint16_t));
+}
+
+V_FUNC V_T load8(const uint8_t * p, int32_t n)
+{
+    if(n >= V_PX) return V_LOAD_U8(p);
+
+    uint8_t tmp[V_PX] = {0};
+    lv_memcpy(tmp, p, n);
+    return V_LOAD_U8(tmp);
+}
+
+/*Load RGB888 or XRGB8888 pixels as 0x00RRGGBB. The X channel of XRGB8888 is kept.*/
+V_FUNC V_T load_rgb888(const uint8_t * p, int32_t n, uint32_t px_size)
+{
+    if(px_size == 4) return load32(p, n);
+
+    uint32_t tmp[V_PX] = {0};
+    int32_t i;
+    for(i = 0; i < V_PX && i < n; i++) {
+        tmp[i] = p[0] + (p[1] << 8) + (p[2] << 16);
+        p += 3;
+    }
+    return V_LOADU(tmp);
+}
+
+/*The opacity of the pixels from the mask and/or from `opa`*/
+V_FUNC V_T load_mix(const lv_opa_t * mask, int32_t n, lv_opa_t opa, V_T opa_v)
+{
+    if(mask == NULL) return opa_v;
+
+    V_T m = load8(mask, n);
+    if(opa >= LV_OPA_MAX) return m;
+    else return V_MIX2(m, opa_v);
+}
+
+/*Same as `lv_color_32_32_mix` in `lv_draw_sw_blend_to_argb8888.c` if both colors are semi transparent*/
+static uint32_t argb8888_mix_alpha(uint32_t fg, uint32_t bg)
+{
+    lv_color32_t fg_c;
+    fg_c.blue = fg & 0xff;
+    fg_c.green = (fg >> 8) & 0xff;
+    fg_c.red = (fg >> 16) & 0xff;
+    fg_c.alpha = fg >> 24;
+
+    lv_color32_t bg_c;
+    bg_c.blue = bg & 0xff;
+    bg_c.green = (bg >> 8) & 0xff;
+    bg_c.red = (bg >> 16) & 0xff;
+    bg_c.alpha = bg >> 24;
+
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg_c.alpha, 255 - bg_c.alpha);
+    fg_c.alpha = (uint32_t)((uint32_t)fg_c.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg_c, bg_c);
+
+    return res.blue + (res.green << 8) + (res.red << 16) + ((uint32_t)res_alpha << 24);
+}
+
+/*Same as `lv_color_32_32_mix` in `lv_draw_sw_blend_to_argb8888.c`.
+ *The lanes where both colors are semi transparent need a division so they are calculated one by one.*/
+V_FUNC V_T argb8888_mix(V_T fg, V_T bg)
+{
+    const V_T rb_mask = V_SET1(0x00FF00FF);
+    V_T fa = V_SRLI32(fg, 24);
+    V_T ba = V_SRLI32(bg, 24);
+
+    /*The alpha in both 16 bit halves to mix red and blue, and green in one step*/
+    V_T fa2 = V_OR(fa, V_SLLI32(fa, 16));
+    V_T fa2_inv = V_SUB32(rb_mask, fa2);
+    V_T rb = V_ADD16(V_MULLO16(V_AND(fg, rb_mask), fa2), V_MULLO16(V_AND(bg, rb_mask), fa2_inv));
+    V_T g = V_ADD16(V_MULLO16(V_AND(V_SRLI32(fg, 8), rb_mask), fa2),
+                    V_MULLO16(V_AND(V_SRLI32(bg, 8), rb_mask), fa2_inv));
+    V_T mixed = V_OR(V_OR(V_SRLI16(rb, 8), V_AND(g, V_SET1(0x0000FF00))), V_AND(bg, V_SET1(0xFF000000)));
+
+    V_T take_fg = V_OR(V_CMPGT32(fa, V_SET1(LV_OPA_MAX - 1)), V_CMPGT32(V_SET1(LV_OPA_MIN + 1), ba));
+    V_T take_bg = V_CMPGT32(V_SET1(LV_OPA_MIN + 1), fa);
+    V_T res = V_SEL(take_fg, fg, V_SEL(take_bg, bg, mixed));
+
+    V_T simple = V_OR(V_OR(take_fg, take_bg), V_CMPEQ32(ba, V_SET1(0xFF)));
+    int32_t simple_bits = V_MOVEMASK32(simple);
+    if(simple_bits != V_ALL_LANES) {
+        uint32_t fg_a[V_PX];
+        uint32_t bg_a[V_PX];
+        uint32_t res_a[V_PX];
+        V_STOREU(fg_a, fg);
+        V_STOREU(bg_a, bg);
+        V_STOREU(res_a, res);
+        int32_t i;
+        for(i = 0; i < V_PX; i++) {
+            if((simple_bits & (1 << i)) == 0) res_a[i] = argb8888_mix_alpha(fg_a[i], bg_a[i]);
+        }
+        res = V_LOADU(res_a);
+    }
+
+    return res;
+}
+
+/*Same as `lv_color_16_16_mix`*/
+V_FUNC V_T rgb565_mix(V_T fg, V_T bg, V_T mix)
+{
+    const V_T mask = V_SET1(0x07E0F81F);
+    V_T fg_e = V_AND(V_OR(fg, V_SLLI32(fg, 16)), mask);
+    V_T bg_e = V_AND(V_OR(bg, V_SLLI32(bg, 16)), mask);
+    V_T mix5 = V_SRLI32(V_ADD32(mix, V_SET1(4)), 3);
+    mix5 = V_OR(mix5, V_SLLI32(mix5, 16));
+
+    /*32 bit multiplication from 16 bit ones. Only the lower 32 bits of the result are needed.*/
+    V_T diff = V_SUB32(fg_e, bg_e);
+    V_T prod = V_ADD32(V_MULLO16(diff, mix5), V_SLLI32(V_MULHI16(diff, mix5), 16));
+
+    V_T res = V_AND(V_ADD32(V_SRLI32(prod, 5), bg_e), mask);
+    res = V_AND(V_OR(V_SRLI32(res, 16), res), V_SET1(0xFFFF));
+
+    return V_SEL(V_CMPEQ32(mix, V_SET1(0xFF)), fg, res);
+}
+
+V_FUNC V_T rgb888_to_rgb565(V_T c)
+{
+    V_T r = V_AND(V_SRLI32(c, 19), V_SET1(0x1F));
+    V_T g = V_AND(V_SRLI32(c, 10), V_SET1(0x3F));
+    V_T b = V_AND(V_SRLI32(c, 3), V_SET1(0x1F));
+    return V_OR(V_OR(V_SLLI32(r, 11), V_SLLI32(g, 5)), b);
+}
+
+/*Same as `lv_color_24_16_mix` in `lv_draw_sw_blend_to_rgb565.c`*/
+V_FUNC V_T rgb888_rgb565_mix(V_T fg, V_T bg, V_T mix)
+{
+    V_T mix_inv = V_SUB32(V_SET1(0xFF), mix);
+    V_T fr = V_AND(V_SRLI32(fg, 19), V_SET1(0x1F));
+    V_T fg6 = V_AND(V_SRLI32(fg, 10), V_SET1(0x3F));
+    V_T fb = V_AND(V_SRLI32(fg, 3), V_SET1(0x1F));
+    V_T br = V_AND(V_SRLI32(bg, 11), V_SET1(0x1F));
+    V_T bg6 = V_AND(V_SRLI32(bg, 5), V_SET1(0x3F));
+    V_T bb = V_AND(bg, V_SET1(0x1F));
+
+    V_T r = V_SRLI32(V_ADD32(V_MULLO16(fr, mix), V_MULLO16(br, mix_inv)), 8);
+    V_T g = V_SRLI32(V_ADD32(V_MULLO16(fg6, mix), V_MULLO16(bg6, mix_inv)), 8);
+    V_T b = V_SRLI32(V_ADD32(V_MULLO16(fb, mix), V_MULLO16(bb, mix_inv)), 8);
+    V_T res = V_OR(V_OR(V_SLLI32(r, 11), V_SLLI32(g, 5)), b);
+
+    V_T fg16 = V_OR(V_OR(V_SLLI32(fr, 11), V_SLLI32(fg6, 5)), fb);
+    res = V_SEL(V_CMPEQ32(mix, V_SET1(0xFF)), fg16, res);
+    return V_SEL(V_CMPEQ32(mix, V_SET1(0)), bg, res);
+}
+
+/*RGB565 to 0x00RRGGBB the same way as in `lv_draw_sw_blend_to_argb8888.c`*/
+V_FUNC V_T rgb565_to_rgb888(V_T c)
+{
+    V_T r = V_SRLI32(V_MULLO16(V_AND(V_SRLI32(c, 11), V_SET1(0x1F)), V_SET1(2106)), 8);
+    V_T g = V_SRLI32(V_MULLO16(V_AND(V_SRLI32(c, 5), V_SET1(0x3F)), V_SET1(1037)), 8);
+    V_T b = V_SRLI32(V_MULLO16(V_AND(c, V_SET1(0x1F)), V_SET1(2106)), 8);
+    return V_OR(V_OR(V_SLLI32(r, 16), V_SLLI32(g, 8)), b);
+}
+
+/*--------------------
+ * RGB565 destination
+ *--------------------*/
+
+V_FUNC void color_blend_to_rgb565(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    uint32_t color16 = lv_color_to_u16(dsc->color);
+
+    V_T color_v = V_SET1(color16);
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mask == NULL && opa >= LV_OPA_MAX) {
+            /*Two pixels in each lane*/
+            V_T color2_v = V_SET1(color16 + (color16 << 16));
+            for(x = 0; x <= w - 2 * V_PX; x += 2 * V_PX) {
+                V_STOREU(&dest_buf_u16[x], color2_v);
+            }
+            for(; x < w; x += V_PX) {
+                store16(&dest_buf_u16[x], color_v, w - x);
+            }
+        }
+        else {
+            for(x = 0; x < w; x += V_PX) {
+                int32_t n = w - x;
+                V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+                store16(&dest_buf_u16[x], rgb565_mix(color_v, load16(&dest_buf_u16[x], n), mix), n);
+            }
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dsc->dest_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void rgb565_image_blend_to_rgb565(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mask == NULL && opa >= LV_OPA_MAX) {
+            for(x = 0; x <= w - 2 * V_PX; x += 2 * V_PX) {
+                V_STOREU(&dest_buf_u16[x], V_LOADU(&src_buf_u16[x]));
+            }
+            lv_memcpy(&dest_buf_u16[x], &src_buf_u16[x], (w - x) * sizeof(uint16_t));
+        }
+        else {
+            for(x = 0; x < w; x += V_PX) {
+                int32_t n = w - x;
+                V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+                V_T res = rgb565_mix(load16(&src_buf_u16[x], n), load16(&dest_buf_u16[x], n), mix);
+                store16(&dest_buf_u16[x], res, n);
+            }
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dsc->dest_stride);
+        src_buf_u16 = drawbuf_next_row(src_buf_u16, dsc->src_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void rgb888_image_blend_to_rgb565(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    const uint8_t * src_buf_u8 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += V_PX) {
+            int32_t n = w - x;
+            V_T src = load_rgb888(&src_buf_u8[x * src_px_size], n, src_px_size);
+            V_T res;
+            if(mask == NULL && opa >= LV_OPA_MAX) {
+                res = rgb888_to_rgb565(src);
+            }
+            else {
+                V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+                res = rgb888_rgb565_mix(src, load16(&dest_buf_u16[x], n), mix);
+            }
+            store16(&dest_buf_u16[x], res, n);
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dsc->dest_stride);
+        src_buf_u8 += dsc->src_stride;
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void argb8888_image_blend_to_rgb565(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint16_t * dest_buf_u16 = dsc->dest_buf;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += V_PX) {
+            int32_t n = w - x;
+            V_T src = load32(&src_buf_u32[x], n);
+            V_T mix = V_SRLI32(src, 24);
+            if(mask == NULL) {
+                if(opa < LV_OPA_MAX) mix = V_MIX2(mix, opa_v);
+            }
+            else {
+                mix = V_MULLO16(mix, load8(&mask[x], n));
+                /*LV_OPA_MIX3*/
+                if(opa < LV_OPA_MAX) mix = V_MULHI16(mix, opa_v);
+                else mix = V_SRLI32(mix, 8);
+            }
+            store16(&dest_buf_u16[x], rgb888_rgb565_mix(src, load16(&dest_buf_u16[x], n), mix), n);
+        }
+        dest_buf_u16 = drawbuf_next_row(dest_buf_u16, dsc->dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, dsc->src_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+/*----------------------
+ * ARGB8888 destination
+ *----------------------*/
+
+V_FUNC void color_blend_to_argb8888(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    uint32_t color32 = lv_color_to_u32(dsc->color);
+
+    V_T color_v = V_SET1(color32);
+    V_T rgb_v = V_SET1(color32 & 0x00FFFFFF);
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mask == NULL && opa >= LV_OPA_MAX) {
+            for(x = 0; x < w; x += V_PX) {
+                store32(&dest_buf_u32[x], color_v, w - x);
+            }
+        }
+        else {
+            for(x = 0; x < w; x += V_PX) {
+                int32_t n = w - x;
+                V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+                V_T fg = V_OR(rgb_v, V_SLLI32(mix, 24));
+                store32(&dest_buf_u32[x], argb8888_mix(fg, load32(&dest_buf_u32[x], n)), n);
+            }
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dsc->dest_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void rgb565_image_blend_to_argb8888(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    const uint16_t * src_buf_u16 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += V_PX) {
+            int32_t n = w - x;
+            V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+            V_T fg = V_OR(rgb565_to_rgb888(load16(&src_buf_u16[x], n)), V_SLLI32(mix, 24));
+            store32(&dest_buf_u32[x], argb8888_mix(fg, load32(&dest_buf_u32[x], n)), n);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dsc->dest_stride);
+        src_buf_u16 = drawbuf_next_row(src_buf_u16, dsc->src_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void rgb888_image_blend_to_argb8888(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    const uint8_t * src_buf_u8 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mask == NULL && opa >= LV_OPA_MAX && src_px_size == 4) {
+            lv_memcpy(dest_buf_u32, src_buf_u8, w * sizeof(uint32_t));
+        }
+        else if(mask == NULL && opa >= LV_OPA_MAX) {
+            for(x = 0; x < w; x += V_PX) {
+                V_T src = load_rgb888(&src_buf_u8[x * 3], w - x, 3);
+                store32(&dest_buf_u32[x], V_OR(src, V_SET1(0xFF000000)), w - x);
+            }
+        }
+        else {
+            for(x = 0; x < w; x += V_PX) {
+                int32_t n = w - x;
+                V_T mix = load_mix(mask ? &mask[x] : NULL, n, opa, opa_v);
+                V_T src = V_AND(load_rgb888(&src_buf_u8[x * src_px_size], n, src_px_size), V_SET1(0x00FFFFFF));
+                V_T fg = V_OR(src, V_SLLI32(mix, 24));
+                store32(&dest_buf_u32[x], argb8888_mix(fg, load32(&dest_buf_u32[x], n)), n);
+            }
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dsc->dest_stride);
+        src_buf_u8 += dsc->src_stride;
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+V_FUNC void argb8888_image_blend_to_argb8888(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    lv_opa_t opa = dsc->opa;
+    const lv_opa_t * mask = dsc->mask_buf;
+    uint32_t * dest_buf_u32 = dsc->dest_buf;
+    const uint32_t * src_buf_u32 = dsc->src_buf;
+
+    V_T opa_v = V_SET1(opa);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x += V_PX) {
+            int32_t n = w - x;
+            V_T src = load32(&src_buf_u32[x], n);
+            V_T mix = V_SRLI32(src, 24);
+            if(mask == NULL) {
+                if(opa < LV_OPA_MAX) mix = V_MIX2(mix, opa_v);
+            }
+            else {
+                mix = V_MULLO16(mix, load8(&mask[x], n));
+                /*LV_OPA_MIX3*/
+                if(opa < LV_OPA_MAX) mix = V_MULHI16(mix, opa_v);
+                else mix = V_SRLI32(mix, 8);
+            }
+            V_T fg = V_OR(V_AND(src, V_SET1(0x00FFFFFF)), V_SLLI32(mix, 24));
+            store32(&dest_buf_u32[x], argb8888_mix(fg, load32(&dest_buf_u32[x], n)), n);
+        }
+        dest_buf_u32 = drawbuf_next_row(dest_buf_u32, dsc->dest_stride);
+        src_buf_u32 = drawbuf_next_row(src_buf_u32, dsc->src_stride);
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+/*Same as `mix_argb8888_neighbor` in `lv_draw_sw_transform.c`. `fract` is 0..0x7F.*/
+V_FUNC V_T transform_argb8888_mix(V_T c, V_T px, V_T fract)
+{
+    V_T ch_mask = V_SET1(0x00FF00FF);
+
+    /*(px * fract + c * (255 - fract)) >> 8 on all channels.
+     *B and R are in the 16 bit halves of the lanes, then G and A.*/
+    V_T fract16 = V_OR(fract, V_SLLI32(fract, 16));
+    V_T fract16_inv = V_SUB32(ch_mask, fract16);
+    V_T br = V_ADD16(V_MULLO16(V_AND(px, ch_mask), fract16), V_MULLO16(V_AND(c, ch_mask), fract16_inv));
+    V_T ga = V_ADD16(V_MULLO16(V_AND(V_SRLI32(px, 8), ch_mask), fract16),
+                     V_MULLO16(V_AND(V_SRLI32(c, 8), ch_mask), fract16_inv));
+    V_T mixed = V_OR(V_SRLI16(br, 8), V_SLLI32(V_SRLI16(ga, 8), 8));
+
+    /*Nothing changes if the colors are the same, but a transparent neighbor still fades the alpha.
+     *The color is not mixed with a transparent neighbor or if `lv_color_mix32` would skip it due to the small ratio.*/
+    V_T eq = V_CMPEQ32(c, px);
+    V_T px_transp = V_CMPEQ32(V_AND(px, V_SET1(0xFF000000)), V_SET1(0));
+    V_T keep_alpha = V_ANDNOT(px_transp, eq);
+    V_T keep_color = V_OR(V_OR(eq, px_transp), V_CMPGT32(V_SET1(LV_OPA_MIN + 1), fract));
+    V_T keep = V_OR(V_AND(keep_alpha, V_SET1(0xFF000000)), V_AND(keep_color, V_SET1(0x00FFFFFF)));
+
+    return V_SEL(keep, c, mixed);
+}
+
+/*Get the offset of the neighbor and its weight as `get_neighbor` in `lv_draw_sw_transform.c`*/
+V_FUNC V_T transform_get_neighbor(V_T ups, int32_t step, V_T * fract)
+{
+    V_T f = V_AND(ups, V_SET1(0xFF));
+    V_T upper = V_CMPGT32(f, V_SET1(0x7F));
+    *fract = V_SEL(upper, V_SUB32(f, V_SET1(0x80)), V_SUB32(V_SET1(0x7F), f));
+    return V_SEL(upper, V_SET1(step), V_SET1(-step));
+}
+
+V_FUNC void argb8888_transform(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                               int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end, uint32_t * dest_buf)
+{
+    V_T lane_idx = V_LANE_IDX;
+    V_T xs_lane = V_MULLO32(lane_idx, V_SET1(xs_step));
+    V_T ys_lane = V_MULLO32(lane_idx, V_SET1(ys_step));
+    V_T stride_v = V_SET1(src_stride);
+
+    int32_t x;
+    for(x = x_start; x < x_end; x += V_PX) {
+        int32_t n = x_end - x;
+        V_T xs = V_ADD32(V_SET1(xs_ups), V_SRAI32(V_ADD32(V_SET1(xs_step * x), xs_lane), 8));
+        V_T ys = V_ADD32(V_SET1(ys_ups), V_SRAI32(V_ADD32(V_SET1(ys_step * x), ys_lane), 8));
+
+        V_T xs_fract;
+        V_T ys_fract;
+        V_T x_next = transform_get_neighbor(xs, 4, &xs_fract);
+        V_T y_next = transform_get_neighbor(ys, src_stride, &ys_fract);
+        V_T ofs = V_ADD32(V_MULLO32(V_SRAI32(ys, 8), stride_v), V_SLLI32(V_SRAI32(xs, 8), 2));
+
+        /*The lanes after the end of the span might be out of the image so read the first pixel there*/
+        if(n < V_PX) {
+            V_T valid = V_CMPGT32(V_SET1(n), lane_idx);
+            ofs = V_AND(ofs, valid);
+            x_next = V_AND(x_next, valid);
+            y_next = V_AND(y_next, valid);
+        }
+
+        V_T c = V_GATHER32(src, ofs);
+        c = transform_argb8888_mix(c, V_GATHER32(src, V_ADD32(ofs, y_next)), ys_fract);
+        c = transform_argb8888_mix(c, V_GATHER32(src, V_ADD32(ofs, x_next)), xs_fract);
+        store32(&dest_buf[x], c, n);
+    }
+}
+
+static inline void * drawbuf_next_row(const void * buf, uint32_t stride)
+{
+    return (void *)((uint8_t *)buf + stride);
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/*All the variants of the same source and destination are handled by one function
+ *which checks the mask and the opacity*/
+
+#define _V_FILL_FUNC(name, impl) \
+    LV_BLEND_X86_ATTR void V_NAME(name)(_lv_draw_sw_blend_fill_dsc_t * dsc) \
+    { \
+        impl(dsc); \
+    }
+
+#define _V_IMAGE_FUNC(name, impl) \
+    LV_BLEND_X86_ATTR void V_NAME(name)(_lv_draw_sw_blend_image_dsc_t * dsc) \
+    { \
+        impl(dsc); \
+    }
+
+#define _V_RGB888_IMAGE_FUNC(name, impl) \
+    LV_BLEND_X86_ATTR void V_NAME(name)(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size) \
+    { \
+        impl(dsc, src_px_size); \
+    }
+
+_V_FILL_FUNC(lv_color_blend_to_rgb565, color_blend_to_rgb565)
+_V_FILL_FUNC(lv_color_blend_to_rgb565_with_opa, color_blend_to_rgb565)
+_V_FILL_FUNC(lv_color_blend_to_rgb565_with_mask, color_blend_to_rgb565)
+_V_FILL_FUNC(lv_color_blend_to_rgb565_mix_mask_opa, color_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_rgb565, rgb565_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_rgb565_with_opa, rgb565_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_rgb565_with_mask, rgb565_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_rgb565_mix_mask_opa, rgb565_image_blend_to_rgb565)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_rgb565, rgb888_image_blend_to_rgb565)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_rgb565_with_opa, rgb888_image_blend_to_rgb565)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_rgb565_with_mask, rgb888_image_blend_to_rgb565)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_rgb565_mix_mask_opa, rgb888_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_rgb565, argb8888_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_rgb565_with_opa, argb8888_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_rgb565_with_mask, argb8888_image_blend_to_rgb565)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_rgb565_mix_mask_opa, argb8888_image_blend_to_rgb565)
+
+_V_FILL_FUNC(lv_color_blend_to_argb8888, color_blend_to_argb8888)
+_V_FILL_FUNC(lv_color_blend_to_argb8888_with_opa, color_blend_to_argb8888)
+_V_FILL_FUNC(lv_color_blend_to_argb8888_with_mask, color_blend_to_argb8888)
+_V_FILL_FUNC(lv_color_blend_to_argb8888_mix_mask_opa, color_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_argb8888, rgb565_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_argb8888_with_opa, rgb565_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_argb8888_with_mask, rgb565_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_rgb565_blend_normal_to_argb8888_mix_mask_opa, rgb565_image_blend_to_argb8888)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_argb8888, rgb888_image_blend_to_argb8888)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_argb8888_with_opa, rgb888_image_blend_to_argb8888)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_argb8888_with_mask, rgb888_image_blend_to_argb8888)
+_V_RGB888_IMAGE_FUNC(lv_rgb888_blend_normal_to_argb8888_mix_mask_opa, rgb888_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_argb8888, argb8888_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_argb8888_with_opa, argb8888_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_argb8888_with_mask, argb8888_image_blend_to_argb8888)
+_V_IMAGE_FUNC(lv_argb8888_blend_normal_to_argb8888_mix_mask_opa, argb8888_image_blend_to_argb8888)
+
+LV_BLEND_X86_ATTR void V_NAME(lv_argb8888_transform)(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                                    int32_t x_start, int32_t x_end, void * dest_buf, uint8_t * abuf)
+{
+    LV_UNUSED(src_h);
+    LV_UNUSED(abuf);
+    argb8888_transform(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file lv_rotate_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED
+
+#include <emmintrin.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if defined(__GNUC__)
+    #define LV_ROTATE_X86_ATTR  __attribute__((target("sse2")))
+#else
+    #define LV_ROTATE_X86_ATTR
+#endif
+
+/*Size of the tiles in pixels. The blocks of a tile are transposed while its rows are in the cache.*/
+#define ROTATE_TILE         32
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline LV_ROTATE_X86_ATTR void rotate_sse2(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h,
+                                                  int32_t src_stride, int32_t dst_stride, uint32_t px_size,
+                                                  bool clockwise);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ROTATE_X86_ATTR void lv_argb8888_rotate90_sse2(const void * src, void * dest, int32_t src_width,
+                                                  int32_t src_height, int32_t src_stride, int32_t dest_stride)
+{
+    rotate_sse2(src, dest, src_width, src_height, src_stride, dest_stride, 4, true);
+}
+
+LV_ROTATE_X86_ATTR void lv_argb8888_rotate270_sse2(const void * src, void * dest, int32_t src_width,
+                                                   int32_t src_height, int32_t src_stride, int32_t dest_stride)
+{
+    rotate_sse2(src, dest, src_width, src_height, src_stride, dest_stride, 4, false);
+}
+
+LV_ROTATE_X86_ATTR void lv_rgb565_rotate90_sse2(const void * src, void * dest, int32_t src_width,
+                                                int32_t src_height, int32_t src_stride, int32_t dest_stride)
+{
+    rotate_sse2(src, dest, src_width, src_height, src_stride, dest_stride, 2, true);
+}
+
+LV_ROTATE_X86_ATTR void lv_rgb565_rotate270_sse2(const void * src, void * dest, int32_t src_width,
+                                                 int32_t src_height, int32_t src_stride, int32_t dest_stride)
+{
+    rotate_sse2(src, dest, src_width, src_height, src_stride, dest_stride, 2, false);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline LV_ROTATE_X86_ATTR void transpose_4x32_sse2(__m128i r[4])
+{
+    __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+    __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+    __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+    __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+    r[0] = _mm_unpacklo_epi64(t0, t1);
+    r[1] = _mm_unpackhi_epi64(t0, t1);
+    r[2] = _mm_unpacklo_epi64(t2, t3);
+    r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+static inline LV_ROTATE_X86_ATTR void transpose_8x16_sse2(__m128i r[8])
+{
+    /*Interleave pixels, then pairs, then quads of the rows*/
+    __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+    __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+    __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+    __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+    __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+    __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+    __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+    __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+    __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+    __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+    __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+    __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+    __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+    r[0] = _mm_unpacklo_epi64(u0, u4);
+    r[1] = _mm_unpackhi_epi64(u0, u4);
+    r[2] = _mm_unpacklo_epi64(u1, u5);
+    r[3] = _mm_unpackhi_epi64(u1, u5);
+    r[4] = _mm_unpacklo_epi64(u2, u6);
+    r[5] = _mm_unpackhi_epi64(u2, u6);
+    r[6] = _mm_unpacklo_epi64(u3, u7);
+    r[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+static inline void rotate_px(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y, int32_t w, int32_t h,
+                             int32_t src_stride, int32_t dst_stride, uint32_t px_size, bool clockwise)
+{
+    const uint8_t * s = src + y * src_stride + x * px_size;
+    uint8_t * d;
+    if(clockwise) d = dst + x * dst_stride + (h - y - 1) * px_size;
+    else d = dst + (w - x - 1) * dst_stride + y * px_size;
+
+    if(px_size == 4) *(uint32_t *)d = *(const uint32_t *)s;
+    else *(uint16_t *)d = *(const uint16_t *)s;
+}
+
+/**
+ * Rotate by 90 degrees in either direction with the pixel mapping of `lv_draw_sw_rotate`.
+ * Clockwise moves (x;y) to (h - y - 1;x), else it's moved to (y;w - x - 1).
+ * Blocks of 16 bytes wide rows are transposed in registers and written as whole rows.
+ */
+static inline LV_ROTATE_X86_ATTR void rotate_sse2(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h,
+                                                  int32_t src_stride, int32_t dst_stride, uint32_t px_size,
+                                                  bool clockwise)
+{
+    const int32_t blk = 16 / px_size;
+    __m128i r[8];
+
+    for(int32_t ty = 0; ty < h; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, h);
+        int32_t ty_blk_end = ty + (ty_end - ty) / blk * blk;
+        for(int32_t tx = 0; tx < w; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, w);
+            int32_t tx_blk_end = tx + (tx_end - tx) / blk * blk;
+            int32_t x;
+            int32_t y;
+            int32_t i;
+
+            for(y = ty; y < ty_blk_end; y += blk) {
+                for(x = tx; x < tx_blk_end; x += blk) {
+                    /*Load the rows bottom up for clockwise so the transposed rows are already mirrored*/
+                    for(i = 0; i < blk; i++) {
+                        int32_t sy = clockwise ? y + blk - 1 - i : y + i;
+                        r[i] = _mm_loadu_si128((const __m128i *)(src + sy * src_stride + x * px_size));
+                    }
+
+                    if(px_size == 4) transpose_4x32_sse2(r);
+                    else transpose_8x16_sse2(r);
+
+                    for(i = 0; i < blk; i++) {
+                        uint8_t * d;
+                        if(clockwise) d = dst + (x + i) * dst_stride + (h - y - blk) * px_size;
+                        else d = dst + (w - x - i - 1) * dst_stride + y * px_size;
+                        _mm_storeu_si128((__m128i *)d, r[i]);
+                    }
+                }
+
+                /*Right edge of the image*/
+                for(x = tx_blk_end; x < tx_end; x++) {
+                    for(i = 0; i < blk; i++) {
+                        rotate_px(src, dst, x, y + i, w, h, src_stride, dst_stride, px_size, clockwise);
+                    }
+                }
+            }
+
+            /*Bottom edge of the image*/
+            for(y = ty_blk_end; y < ty_end; y++) {
+                for(x = tx; x < tx_end; x++) {
+                    rotate_px(src, dst, x, y, w, h, src_stride, dst_stride, px_size, clockwise);
+                }
+            }
+        }
+    }
+}
+
+#endif /*LV_USE_DRAW_SW && _LV_BLEND_X86_ENABLED*/
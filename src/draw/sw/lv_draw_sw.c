@@ -27,6 +27,18 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+#if LV_DRAW_SW_STRIPE_MIN_AREA && LV_USE_OS && defined(__GNUC__)
+    #define DRAW_SW_STRIPES     1
+    /*Make more stripes than draw units to balance the load if some stripes are slower to render*/
+    #define STRIPE_PER_UNIT     2
+    #define STRIPE_MIN_H        8
+#else
+    #define DRAW_SW_STRIPES     0
+#endif
+
+/*Rotate the buffers in square tiles so that the rows read and written by a tile stay in the cache*/
+#define ROTATE_TILE         32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -39,6 +51,15 @@
 #endif
 
 static void execute_drawing(lv_draw_sw_unit_t * u);
+static void execute_draw_dsc(lv_draw_sw_unit_t * u, lv_draw_task_type_t type, void * draw_dsc, const lv_area_t * area);
+
+#if DRAW_SW_STRIPES
+    static void stripe_job_start(lv_draw_sw_unit_t * u, lv_layer_t * layer, lv_draw_task_t * t);
+    static bool stripe_job_join(lv_draw_sw_unit_t * u);
+    static void stripe_job_execute(lv_draw_sw_unit_t * u);
+    static bool stripe_image_is_direct(const lv_draw_image_dsc_t * dsc);
+    static bool stripe_image_is_transformed(const lv_draw_image_dsc_t * dsc);
+#endif
 
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
@@ -71,6 +92,7 @@ static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWi
  *  STATIC VARIABLES
  **********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
+#define _stripe_job LV_GLOBAL_DEFAULT()->sw_stripe_job
 
 /**********************
  *      MACROS
@@ -82,11 +104,20 @@ static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWi
 
 void lv_draw_sw_init(void)
 {
+    lv_draw_sw_dispatch_init();
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    _lv_draw_sw_shadow_cache_init();
+#endif
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    _lv_gradient_cache_init();
+#endif
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -94,6 +125,7 @@ void lv_draw_sw_init(void)
         draw_sw_unit->base_unit.evaluate_cb = evaluate;
         draw_sw_unit->idx = i;
         draw_sw_unit->base_unit.delete_cb = LV_USE_OS ? lv_draw_sw_delete : NULL;
+        draw_sw_unit->base_unit.batch_id = DRAW_UNIT_ID_SW;
 
 #if LV_USE_OS
         lv_thread_init(&draw_sw_unit->thread, LV_THREAD_PRIO_HIGH, render_thread_cb, 8 * 1024, draw_sw_unit);
@@ -111,6 +143,14 @@ void lv_draw_sw_deinit(void)
     tvg_engine_term(TVG_ENGINE_SW);
 #endif
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    _lv_draw_sw_shadow_cache_deinit();
+#endif
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    _lv_gradient_cache_deinit();
+#endif
+
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
@@ -170,7 +210,20 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
                        int32_t dest_stride, lv_display_rotation_t rotation, lv_color_format_t color_format)
 {
     uint32_t px_bpp = lv_color_format_get_bpp(color_format);
-    if(rotation == LV_DISPLAY_ROTATION_90) {
+
+    /*Use the kernel selected for the CPU if there is any*/
+    const lv_draw_sw_dispatch_t * d = lv_draw_sw_get_dispatch();
+    lv_draw_sw_rotate_kernel_t kernel = NULL;
+    if(rotation >= LV_DISPLAY_ROTATION_90 && rotation <= LV_DISPLAY_ROTATION_270) {
+        if(px_bpp == 16) kernel = d->rotate_rgb565[rotation];
+        else if(px_bpp == 24) kernel = d->rotate_rgb888[rotation];
+        else if(px_bpp == 32) kernel = d->rotate_argb8888[rotation];
+    }
+
+    if(kernel) {
+        kernel(src, dest, src_width, src_height, src_sride, dest_stride);
+    }
+    else if(rotation == LV_DISPLAY_ROTATION_90) {
         if(px_bpp == 16) rotate90_rgb565(src, dest, src_width, src_height, src_sride, dest_stride);
         if(px_bpp == 24) rotate90_rgb888(src, dest, src_width, src_height, src_sride, dest_stride);
         if(px_bpp == 32) rotate90_argb8888(src, dest, src_width, src_height, src_sride, dest_stride);
@@ -187,13 +240,80 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
     }
 }
 
+void lv_draw_sw_rotate_area(lv_display_t * disp, const lv_area_t * area, const uint8_t * px_map, void * dest,
+                            int32_t dest_stride)
+{
+    LV_ASSERT_NULL(disp);
+
+    lv_color_format_t cf = disp->color_format;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    int32_t src_stride = lv_draw_buf_width_to_stride(hor_res, cf);
+
+    /*The area is in the coordinates of `flush_cb`, the buffer is not shifted by the offset*/
+    lv_area_t a = *area;
+    lv_area_move(&a, -disp->offset_x, -disp->offset_y);
+    int32_t w = lv_area_get_width(&a);
+    int32_t h = lv_area_get_height(&a);
+    const uint8_t * src = px_map + a.y1 * src_stride + a.x1 * px_size;
+
+    lv_display_rotation_t rotation = disp->rotation;
+
+    /*Find where the top left corner of the rotated area is in the destination*/
+    int32_t dest_x;
+    int32_t dest_y;
+    if(rotation == LV_DISPLAY_ROTATION_0) {
+        dest_x = a.x1;
+        dest_y = a.y1;
+    }
+    else if(rotation == LV_DISPLAY_ROTATION_180) {
+        dest_x = hor_res - a.x2 - 1;
+        dest_y = ver_res - a.y2 - 1;
+    }
+    else if(rotation == LV_DISPLAY_ROTATION_90) {
+        dest_x = ver_res - a.y2 - 1;
+        dest_y = a.x1;
+    }
+    else {
+        dest_x = a.y1;
+        dest_y = hor_res - a.x2 - 1;
+    }
+
+    uint8_t * dest_start = (uint8_t *)dest + dest_y * dest_stride + dest_x * px_size;
+    if(rotation == LV_DISPLAY_ROTATION_0) {
+        int32_t y;
+        for(y = 0; y < h; y++) {
+            lv_memcpy(dest_start + y * dest_stride, src + y * src_stride, w * px_size);
+        }
+    }
+    else {
+        lv_draw_sw_rotate(src, dest_start, w, h, src_stride, dest_stride, rotation, cf);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
+#if DRAW_SW_STRIPES
+    if(u->in_stripe_job) {
+        stripe_job_execute(u);
+        return;
+    }
+#endif
+
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_task_start((lv_draw_unit_t *)u, u->task_act->type);
+#endif
+
     execute_drawing(u);
 
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_task_finish((lv_draw_unit_t *)u);
+#endif
+
     u->task_act->state = LV_DRAW_TASK_STATE_READY;
     u->task_act = NULL;
 
@@ -239,6 +359,15 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         return 0;
     }
 
+#if DRAW_SW_STRIPES
+    /*Help to finish the large task being rendered in stripes before starting a new one*/
+    if(stripe_job_join(draw_sw_unit)) {
+        if(draw_sw_unit->inited) lv_thread_sync_signal(&draw_sw_unit->sync);
+        LV_PROFILER_END;
+        return 1;
+    }
+#endif
+
     lv_draw_task_t * t = NULL;
     t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
     if(t == NULL) {
@@ -257,6 +386,10 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     draw_sw_unit->base_unit.clip_area = &t->clip_area;
     draw_sw_unit->task_act = t;
 
+#if DRAW_SW_STRIPES
+    stripe_job_start(draw_sw_unit, layer, t);
+#endif
+
 #if LV_USE_OS
     /*Let the render thread work*/
     if(draw_sw_unit->inited) lv_thread_sync_signal(&draw_sw_unit->sync);
@@ -275,6 +408,13 @@ static void render_thread_cb(void * ptr)
     lv_thread_sync_init(&u->sync);
     u->inited = true;
 
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    /*Show the rendering threads separately on the timeline*/
+    char name[LV_PROFILER_BUILTIN_THREAD_NAME_LEN];
+    lv_snprintf(name, sizeof(name), "draw_sw_%" LV_PRIu32, u->idx);
+    lv_profiler_builtin_set_thread_name(name);
+#endif
+
     while(1) {
         while(u->task_act == NULL) {
             if(u->exit_status) {
@@ -302,45 +442,26 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
     LV_PROFILER_BEGIN;
     /*Render the draw task*/
     lv_draw_task_t * t = u->task_act;
-    switch(t->type) {
-        case LV_DRAW_TASK_TYPE_FILL:
-            lv_draw_sw_fill((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_BORDER:
-            lv_draw_sw_border((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
-            lv_draw_sw_box_shadow((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_LABEL:
-            lv_draw_sw_label((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_IMAGE:
-            lv_draw_sw_image((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_ARC:
-            lv_draw_sw_arc((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_LINE:
-            lv_draw_sw_line((lv_draw_unit_t *)u, t->draw_dsc);
-            break;
-        case LV_DRAW_TASK_TYPE_TRIANGLE:
-            lv_draw_sw_triangle((lv_draw_unit_t *)u, t->draw_dsc);
-            break;
-        case LV_DRAW_TASK_TYPE_LAYER:
-            lv_draw_sw_layer((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-        case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
-            lv_draw_sw_mask_rect((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
-            break;
-#if LV_USE_VECTOR_GRAPHIC
-        case LV_DRAW_TASK_TYPE_VECTOR:
-            lv_draw_sw_vector((lv_draw_unit_t *)u, t->draw_dsc);
-            break;
-#endif
-        default:
-            break;
+#if LV_DRAW_TASK_BATCH_MAX
+    if(t->batch) {
+        /*Render the merged draw tasks one by one with their own clip area*/
+        const lv_area_t * clip_area_ori = u->base_unit.clip_area;
+        uint32_t i;
+        for(i = 0; i < t->batch->cnt; i++) {
+            lv_draw_task_batch_item_t * item = &t->batch->items[i];
+            lv_area_t clip_area;
+            if(!_lv_area_intersect(&clip_area, &item->clip_area, clip_area_ori)) continue;
+            u->base_unit.clip_area = &clip_area;
+            execute_draw_dsc(u, t->type, item->draw_dsc, &item->area);
+        }
+        u->base_unit.clip_area = clip_area_ori;
+    }
+    else {
+        execute_draw_dsc(u, t->type, t->draw_dsc, &t->area);
     }
+#else
+    execute_draw_dsc(u, t->type, t->draw_dsc, &t->area);
+#endif
 
 #if LV_USE_PARALLEL_DRAW_DEBUG
     /*Layers manage it for themselves*/
@@ -388,6 +509,229 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
     LV_PROFILER_END;
 }
 
+/**
+ * Render a draw descriptor with the current clip area of the draw unit
+ * @param u         pointer to a software draw unit
+ * @param type      type of the draw task
+ * @param draw_dsc  the draw descriptor of the draw task
+ * @param area      the area of the draw task
+ */
+static void execute_draw_dsc(lv_draw_sw_unit_t * u, lv_draw_task_type_t type, void * draw_dsc, const lv_area_t * area)
+{
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            lv_draw_sw_fill((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_BORDER:
+            lv_draw_sw_border((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            lv_draw_sw_box_shadow((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            lv_draw_sw_label((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            lv_draw_sw_image((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_ARC:
+            lv_draw_sw_arc((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_LINE:
+            lv_draw_sw_line((lv_draw_unit_t *)u, draw_dsc);
+            break;
+        case LV_DRAW_TASK_TYPE_TRIANGLE:
+            lv_draw_sw_triangle((lv_draw_unit_t *)u, draw_dsc);
+            break;
+        case LV_DRAW_TASK_TYPE_LAYER:
+            lv_draw_sw_layer((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+        case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
+            lv_draw_sw_mask_rect((lv_draw_unit_t *)u, draw_dsc, area);
+            break;
+#if LV_USE_VECTOR_GRAPHIC
+        case LV_DRAW_TASK_TYPE_VECTOR:
+            lv_draw_sw_vector((lv_draw_unit_t *)u, draw_dsc);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+#if DRAW_SW_STRIPES
+
+/**
+ * Start rendering a draw task in stripes if it's large enough and there is no other stripe job.
+ * The other draw units can join with `stripe_job_join` until all the stripes are taken.
+ * Called from the dispatcher only, so only the render threads run in parallel with it.
+ * @param u         the draw unit which took the draw task
+ * @param layer     the layer of the draw task
+ * @param t         the draw task
+ */
+static void stripe_job_start(lv_draw_sw_unit_t * u, lv_layer_t * layer, lv_draw_task_t * t)
+{
+    lv_draw_sw_stripe_job_t * job = &_stripe_job;
+    if(__atomic_load_n(&job->task, __ATOMIC_ACQUIRE)) return;
+
+    /*Transformed images and layers can draw outside of the task's area*/
+    bool clip_only = false;
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            /*Each stripe opens the image for itself so it shouldn't need decoding*/
+            if(!stripe_image_is_direct(t->draw_dsc)) return;
+            clip_only = stripe_image_is_transformed(t->draw_dsc);
+            break;
+        case LV_DRAW_TASK_TYPE_LAYER:
+            /*Layers are opened via a temporary image descriptor of each stripe*/
+            clip_only = stripe_image_is_transformed(t->draw_dsc);
+            break;
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            /*Each stripe gets the blurred corner for itself so it should be cached already.
+             *If it's not, it's blurred once now without stripes and the next frame can use stripes.*/
+            if(!_lv_draw_sw_box_shadow_is_cached(t->draw_dsc, &t->area)) return;
+            clip_only = true;
+            break;
+#endif
+        default:
+            /*The others would repeat their preparation in each stripe*/
+            return;
+    }
+
+    lv_area_t area;
+    if(clip_only) area = t->clip_area;
+    else if(!_lv_area_intersect(&area, &t->area, &t->clip_area)) return;
+
+    if(lv_area_get_size(&area) < LV_DRAW_SW_STRIPE_MIN_AREA) return;
+
+    int32_t h = lv_area_get_height(&area);
+    int32_t stripe_cnt = LV_MIN(LV_DRAW_SW_DRAW_UNIT_CNT * STRIPE_PER_UNIT, h / STRIPE_MIN_H);
+    if(stripe_cnt < 2) return;
+
+    job->layer = layer;
+    job->area = area;
+    job->stripe_h = (h + stripe_cnt - 1) / stripe_cnt;
+    job->stripe_cnt = stripe_cnt;
+    job->next_stripe = 0;
+    job->task = t;
+    /*Publish the job to the render threads with the first unit counted in*/
+    __atomic_store_n(&job->unit_cnt, 1, __ATOMIC_RELEASE);
+
+    u->in_stripe_job = true;
+    u->stripe_job_owner = true;
+}
+
+/**
+ * Let an idle draw unit take the remaining stripes of the current stripe job.
+ * @param u     an idle draw unit
+ * @return      true: the draw unit joined the job and needs to be started
+ */
+static bool stripe_job_join(lv_draw_sw_unit_t * u)
+{
+    lv_draw_sw_stripe_job_t * job = &_stripe_job;
+    if(__atomic_load_n(&job->task, __ATOMIC_ACQUIRE) == NULL) return false;
+    if(__atomic_load_n(&job->next_stripe, __ATOMIC_ACQUIRE) >= job->stripe_cnt) return false;
+
+    /*Join only if the others haven't finished the job yet, else the task might be already READY*/
+    int32_t unit_cnt = __atomic_load_n(&job->unit_cnt, __ATOMIC_ACQUIRE);
+    while(unit_cnt > 0) {
+        if(__atomic_compare_exchange_n(&job->unit_cnt, &unit_cnt, unit_cnt + 1, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) break;
+    }
+    if(unit_cnt == 0) return false;
+
+    u->base_unit.target_layer = job->layer;
+    u->in_stripe_job = true;
+    u->stripe_job_owner = false;
+    u->task_act = job->task;
+    return true;
+}
+
+/**
+ * Render stripes of the current stripe job until all of them are taken.
+ * The last draw unit leaving the job sets the task to READY.
+ * @param u     a draw unit which started or joined the job
+ */
+static void stripe_job_execute(lv_draw_sw_unit_t * u)
+{
+    LV_PROFILER_BEGIN;
+    lv_draw_sw_stripe_job_t * job = &_stripe_job;
+    lv_draw_task_t * t = u->task_act;
+
+#if LV_USE_DRAW_STAT
+    /*The task is counted only once, in the draw unit which started the stripe job*/
+    if(u->stripe_job_owner) lv_draw_stat_task_start((lv_draw_unit_t *)u, t->type);
+    else u->base_unit.stat._task_type = t->type;  /*Count the blended pixels of the helpers*/
+#endif
+
+    int32_t i;
+    while((i = __atomic_fetch_add(&job->next_stripe, 1, __ATOMIC_ACQ_REL)) < job->stripe_cnt) {
+        u->stripe_clip_area = job->area;
+        u->stripe_clip_area.y1 = job->area.y1 + i * job->stripe_h;
+        u->stripe_clip_area.y2 = LV_MIN(u->stripe_clip_area.y1 + job->stripe_h - 1, job->area.y2);
+        if(u->stripe_clip_area.y1 > u->stripe_clip_area.y2) continue;
+
+        u->base_unit.clip_area = &u->stripe_clip_area;
+        execute_drawing(u);
+    }
+
+#if LV_USE_DRAW_STAT
+    /*Record it before the task can become READY to not count it after the statistics are read*/
+    if(u->stripe_job_owner) lv_draw_stat_task_finish((lv_draw_unit_t *)u);
+#endif
+
+    u->in_stripe_job = false;
+    if(__atomic_sub_fetch(&job->unit_cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+        __atomic_store_n(&job->task, NULL, __ATOMIC_RELEASE);
+        t->state = LV_DRAW_TASK_STATE_READY;
+    }
+    u->task_act = NULL;
+
+    /*The draw unit is free now. Request a new dispatching as it can get a new task*/
+    lv_draw_dispatch_request();
+    LV_PROFILER_END;
+}
+
+/**
+ * Check if an image can be opened by each stripe without decoding it.
+ * @param dsc   the draw descriptor of an image draw task
+ * @return      true: the image is a variable which is drawn directly from its data
+ */
+static bool stripe_image_is_direct(const lv_draw_image_dsc_t * dsc)
+{
+    if(lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) return false;
+
+    const lv_image_dsc_t * img = dsc->src;
+    if(img->data == NULL || (img->header.flags & LV_IMAGE_FLAGS_COMPRESSED)) return false;
+
+    /*The other formats (e.g. indexed, alpha only or PNG data) are converted when opened*/
+    switch(img->header.cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+#if LV_DRAW_SW_PREMULTIPLY
+            /*Copied and premultiplied when opened*/
+            return false;
+#endif
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool stripe_image_is_transformed(const lv_draw_image_dsc_t * dsc)
+{
+    return dsc->rotation || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE;
+}
+
+#endif /*DRAW_SW_STRIPES*/
+
 static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t srcWidth, int32_t srcHeight,
                               int32_t srcStride,
                               int32_t dstStride)
@@ -395,12 +739,18 @@ static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t srcW
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t ty = 0; ty < srcHeight; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, srcHeight);
+        for(int32_t tx = 0; tx < srcWidth; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, srcWidth);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint32_t * dst_row = dst + x * dstStride + srcHeight - 1;
+                const uint32_t * src_col = src + ty * srcStride + x;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_row[-y] = *src_col;
+                    src_col += srcStride;
+                }
+            }
         }
     }
 }
@@ -412,7 +762,7 @@ static void rotate180_argb8888(const uint32_t * src, uint32_t * dst, int32_t wid
     dest_stride /= sizeof(uint32_t);
 
     for(int32_t y = 0; y < height; ++y) {
-        int32_t dstIndex = (height - y - 1) * src_stride;
+        int32_t dstIndex = (height - y - 1) * dest_stride;
         int32_t srcIndex = y * src_stride;
         for(int32_t x = 0; x < width; ++x) {
             dst[dstIndex + width - x - 1] = src[srcIndex + x];
@@ -427,12 +777,18 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t ty = 0; ty < srcHeight; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, srcHeight);
+        for(int32_t tx = 0; tx < srcWidth; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, srcWidth);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint32_t * dst_row = dst + (srcWidth - x - 1) * dstStride;
+                const uint32_t * src_col = src + ty * srcStride + x;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_row[y] = *src_col;
+                    src_col += srcStride;
+                }
+            }
         }
     }
 }
@@ -440,13 +796,21 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
 static void rotate90_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
                             int32_t dstStride)
 {
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = (srcWidth - x - 1) * dstStride + y * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+    for(int32_t ty = 0; ty < srcHeight; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, srcHeight);
+        for(int32_t tx = 0; tx < srcWidth; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, srcWidth);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint8_t * dst_px = dst + x * dstStride + (srcHeight - ty - 1) * 3;
+                const uint8_t * src_px = src + ty * srcStride + x * 3;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_px[0] = src_px[0];  /*Red*/
+                    dst_px[1] = src_px[1];  /*Green*/
+                    dst_px[2] = src_px[2];  /*Blue*/
+                    dst_px -= 3;
+                    src_px += srcStride;
+                }
+            }
         }
     }
 }
@@ -454,14 +818,15 @@ static void rotate90_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidth
 static void rotate180_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, int32_t height, int32_t src_stride,
                              int32_t dest_stride)
 {
-
     for(int32_t y = 0; y < height; ++y) {
+        const uint8_t * src_px = src + y * src_stride;
+        uint8_t * dst_px = dst + (height - y - 1) * dest_stride + (width - 1) * 3;
         for(int32_t x = 0; x < width; ++x) {
-            int32_t srcIndex = y * src_stride + x * 3;
-            int32_t dstIndex = (height - y - 1) * dest_stride + (width - x - 1) * 3;
-            dst[dstIndex] = src[srcIndex];
-            dst[dstIndex + 1] = src[srcIndex + 1];
-            dst[dstIndex + 2] = src[srcIndex + 2];
+            dst_px[0] = src_px[0];
+            dst_px[1] = src_px[1];
+            dst_px[2] = src_px[2];
+            dst_px -= 3;
+            src_px += 3;
         }
     }
 }
@@ -469,13 +834,21 @@ static void rotate180_rgb888(const uint8_t * src, uint8_t * dst, int32_t width,
 static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, int32_t height, int32_t srcStride,
                              int32_t dstStride)
 {
-    for(int32_t x = 0; x < width; ++x) {
-        for(int32_t y = 0; y < height; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = x * dstStride + (height - y - 1) * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+    for(int32_t ty = 0; ty < height; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, height);
+        for(int32_t tx = 0; tx < width; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, width);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint8_t * dst_px = dst + (width - x - 1) * dstStride + ty * 3;
+                const uint8_t * src_px = src + ty * srcStride + x * 3;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_px[0] = src_px[0];  /*Red*/
+                    dst_px[1] = src_px[1];  /*Green*/
+                    dst_px[2] = src_px[2];  /*Blue*/
+                    dst_px += 3;
+                    src_px += srcStride;
+                }
+            }
         }
     }
 }
@@ -487,12 +860,18 @@ static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWid
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t ty = 0; ty < srcHeight; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, srcHeight);
+        for(int32_t tx = 0; tx < srcWidth; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, srcWidth);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint16_t * dst_row = dst + x * dstStride + srcHeight - 1;
+                const uint16_t * src_col = src + ty * srcStride + x;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_row[-y] = *src_col;
+                    src_col += srcStride;
+                }
+            }
         }
     }
 }
@@ -519,12 +898,18 @@ static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWi
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t ty = 0; ty < srcHeight; ty += ROTATE_TILE) {
+        int32_t ty_end = LV_MIN(ty + ROTATE_TILE, srcHeight);
+        for(int32_t tx = 0; tx < srcWidth; tx += ROTATE_TILE) {
+            int32_t tx_end = LV_MIN(tx + ROTATE_TILE, srcWidth);
+            for(int32_t x = tx; x < tx_end; ++x) {
+                uint16_t * dst_row = dst + (srcWidth - x - 1) * dstStride;
+                const uint16_t * src_col = src + ty * srcStride + x;
+                for(int32_t y = ty; y < ty_end; ++y) {
+                    dst_row[y] = *src_col;
+                    src_col += srcStride;
+                }
+            }
         }
     }
 }
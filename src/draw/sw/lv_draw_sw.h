@@ -38,15 +38,58 @@ typedef struct {
     lv_thread_t thread;
     volatile bool inited;
     volatile bool exit_status;
+#endif
+#if LV_DRAW_SW_STRIPE_MIN_AREA && LV_USE_OS
+    /** The clip area of the stripe being rendered if `in_stripe_job` is set*/
+    lv_area_t stripe_clip_area;
+    volatile bool in_stripe_job;
+    /** This draw unit started the stripe job. Only it records the statistics of the task.*/
+    bool stripe_job_owner;
 #endif
     uint32_t idx;
 } lv_draw_sw_unit_t;
 
+#if LV_DRAW_SW_STRIPE_MIN_AREA && LV_USE_OS
+/**
+ * A large draw task cut into horizontal stripes.
+ * All the idle software draw units take stripes from it until all of them are rendered.
+ */
+typedef struct {
+    struct _lv_draw_task_t * task;  /**< The task being rendered, NULL if there is no stripe job*/
+    struct _lv_layer_t * layer;     /**< The layer of the task*/
+    lv_area_t area;                 /**< The area to cut into stripes*/
+    int32_t stripe_h;               /**< Height of a stripe*/
+    int32_t stripe_cnt;             /**< Number of stripes*/
+    int32_t next_stripe;            /**< Index of the next stripe to render, changed atomically*/
+    int32_t unit_cnt;               /**< Number of draw units working on the job, changed atomically*/
+} lv_draw_sw_stripe_job_t;
+#endif
+
 #if LV_DRAW_SW_SHADOW_CACHE_SIZE
 typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
+    uint8_t * buf;              /**< The blurred corner, `size * size` bytes*/
+    int32_t sw;                 /**< Shadow width*/
+    int32_t r;                  /**< Radius*/
+    int32_t w;                  /**< Width of the shadow's core, limited to where it affects the corner*/
+    int32_t h;                  /**< Height of the shadow's core, limited to where it affects the corner*/
+    uint32_t last_used;         /**< Value of the cache's access counter when the corner was used the last time*/
+    uint32_t used_cnt;          /**< Number of shadows being drawn with this corner*/
+} _lv_draw_sw_shadow_cache_entry_t;
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of shadows which found their corner in the cache*/
+    uint32_t miss_cnt;          /**< Number of shadows which needed to calculate their corner*/
+    uint32_t evict_cnt;         /**< Number of corners dropped from the cache*/
+    uint32_t entry_cnt;         /**< Number of the cached corners*/
+} lv_draw_sw_shadow_cache_stat_t;
+
+typedef struct {
+    /*The corners are read without locking while they are used, so they are
+     *never changed after they are added, only freed when they are not used anymore*/
+    _lv_draw_sw_shadow_cache_entry_t entries[LV_DRAW_SW_SHADOW_CACHE_CNT];
+    uint32_t access_cnt;
+    lv_draw_sw_shadow_cache_stat_t stat;
+    lv_mutex_t mutex;
 } lv_draw_sw_shadow_cache_t;
 #endif
 
@@ -67,6 +110,36 @@ void lv_draw_sw_border(lv_draw_unit_t * draw_unit, const lv_draw_border_dsc_t *
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
 
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+/**
+ * Get the statistics of the cache of the blurred shadow corners
+ * @param stat      store the statistics here
+ */
+void lv_draw_sw_shadow_cache_get_stat(lv_draw_sw_shadow_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and evict counters of the shadow cache
+ */
+void lv_draw_sw_shadow_cache_reset_stat(void);
+
+/**
+ * Free the cached shadow corners which are not used
+ */
+void lv_draw_sw_shadow_cache_drop(void);
+
+/**
+ * Check if the blurred corner of a box shadow is in the cache
+ * @param dsc       the draw descriptor of the box shadow
+ * @param coords    the coordinates of the box shadow's draw task
+ * @return          true: the corner doesn't need to be blurred again (unless it's dropped meanwhile)
+ */
+bool _lv_draw_sw_box_shadow_is_cached(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
+
+void _lv_draw_sw_shadow_cache_init(void);
+
+void _lv_draw_sw_shadow_cache_deinit(void);
+#endif
+
 void lv_draw_sw_label(lv_draw_unit_t * draw_unit, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_arc(lv_draw_unit_t * draw_unit, const lv_draw_arc_dsc_t * dsc, const lv_area_t * coords);
@@ -98,6 +171,19 @@ void lv_draw_sw_rgb565_swap(void * buf, int32_t buf_size_px);
 void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t src_height, int32_t src_sride,
                        int32_t dest_stride, lv_display_rotation_t rotation, lv_color_format_t color_format);
 
+/**
+ * Rotate a rendered area of a display into its place in a frame buffer with the physical orientation.
+ * Useful in `LV_DISPLAY_RENDER_MODE_DIRECT` to copy only the refreshed areas to the frame buffer
+ * in `flush_cb` instead of rotating the whole draw buffer first.
+ * @param disp          the display whose rotation, resolution and color format are used
+ * @param area          the area to rotate, as received by `flush_cb`
+ * @param px_map        the draw buffer of the display with the rendered area, as received by `flush_cb`
+ * @param dest          the frame buffer with the physical resolution of the display
+ * @param dest_stride   the stride of `dest` in bytes
+ */
+void lv_draw_sw_rotate_area(lv_display_t * disp, const lv_area_t * area, const uint8_t * px_map, void * dest,
+                            int32_t dest_stride);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
@@ -107,6 +193,7 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
  **********************/
 
 #include "blend/lv_draw_sw_blend.h"
+#include "lv_draw_sw_dispatch.h"
 
 #endif /*LV_USE_DRAW_SW*/
 
@@ -184,8 +184,10 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
         }
     }
 
-    /*Draw the corners*/
+    /*Draw the corners. The masks tell where the line is transparent or covered so only the edges are masked*/
     int32_t blend_w;
+    lv_draw_sw_mask_span_t spans[LV_DRAW_SW_MASK_SPAN_MAX];
+    uint32_t span_cnt;
 
     /*Left and right corner together if they are close to each other*/
     if(!split_hor) {
@@ -199,18 +201,18 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
             if(top_y < draw_area.y1 && bottom_y > draw_area.y2) continue;   /*This line is clipped now*/
 
             lv_memset(mask_buf, 0xff, draw_area_w);
-            blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, top_y, draw_area_w);
+            span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, top_y, draw_area_w, spans);
 
             if(top_y >= draw_area.y1) {
                 blend_area.y1 = top_y;
                 blend_area.y2 = top_y;
-                lv_draw_sw_blend(draw_unit, &blend_dsc);
+                lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
             }
 
             if(bottom_y <= draw_area.y2) {
                 blend_area.y1 = bottom_y;
                 blend_area.y2 = bottom_y;
-                lv_draw_sw_blend(draw_unit, &blend_dsc);
+                lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
             }
         }
     }
@@ -226,8 +228,8 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
                     blend_area.y2 = h;
 
                     lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, h, blend_w, spans);
+                    lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
                 }
             }
 
@@ -237,8 +239,8 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
                     blend_area.y2 = h;
 
                     lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, h, blend_w, spans);
+                    lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
                 }
             }
         }
@@ -257,8 +259,8 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
                     blend_area.y2 = h;
 
                     lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, h, blend_w, spans);
+                    lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
                 }
             }
 
@@ -268,8 +270,8 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
                     blend_area.y2 = h;
 
                     lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, h, blend_w, spans);
+                    lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
                 }
             }
         }
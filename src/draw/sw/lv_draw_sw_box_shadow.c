@@ -34,10 +34,21 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static int32_t shadow_core_get(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords, lv_area_t * core_area);
 #if LV_DRAW_SW_COMPLEX
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                          int32_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+LV_ATTRIBUTE_FAST_MEM static inline void shadow_line_mirror(lv_opa_t * dest, const lv_opa_t * src_end, int32_t len);
+static lv_opa_t * shadow_corner_create(const lv_area_t * coords, int32_t sw, int32_t r);
+static const lv_opa_t * shadow_corner_get(const lv_area_t * coords, int32_t sw, int32_t r);
+static void shadow_corner_release(const lv_opa_t * sh_buf);
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+static _lv_draw_sw_shadow_cache_entry_t * shadow_cache_find(const lv_area_t * coords, int32_t sw, int32_t r);
+static void shadow_cache_use(_lv_draw_sw_shadow_cache_entry_t * entry);
+static void shadow_cache_key_get(const lv_area_t * coords, int32_t sw, int32_t r, int32_t * w, int32_t * h);
+static bool shadow_cache_add(lv_opa_t * sh_buf, const lv_area_t * coords, int32_t sw, int32_t r);
+#endif
 #endif /*LV_DRAW_SW_COMPLEX*/
 
 /**********************
@@ -56,10 +67,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
     lv_area_t core_area;
-    core_area.x1 = coords->x1  + dsc->ofs_x - dsc->spread;
-    core_area.x2 = coords->x2  + dsc->ofs_x + dsc->spread;
-    core_area.y1 = coords->y1  + dsc->ofs_y - dsc->spread;
-    core_area.y2 = coords->y2  + dsc->ofs_y + dsc->spread;
+    int32_t r_sh = shadow_core_get(dsc, coords, &core_area);
 
     /*Calculate the bounding box of the shadow*/
     lv_area_t shadow_area;
@@ -86,39 +94,10 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     int32_t short_side = LV_MIN(lv_area_get_width(&bg_area), lv_area_get_height(&bg_area));
     if(r_bg > short_side >> 1) r_bg = short_side >> 1;
 
-    /*Get the clamped radius*/
-    int32_t r_sh = dsc->radius;
-    short_side = LV_MIN(lv_area_get_width(&core_area), lv_area_get_height(&core_area));
-    if(r_sh > short_side >> 1) r_sh = short_side >> 1;
-
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    const lv_opa_t * sh_buf = shadow_corner_get(&core_area, dsc->width, r_sh);
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -135,7 +114,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_opa_t * mask_buf = lv_malloc(lv_area_get_width(&shadow_area));
     lv_area_t blend_area;
     lv_area_t clip_area_sub;
-    lv_opa_t * sh_buf_tmp;
+    const lv_opa_t * sh_buf_tmp;
     int32_t y;
     bool simple_sub;
 
@@ -181,7 +160,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -224,7 +203,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -376,22 +355,8 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         }
     }
 
-    /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*The left side is the mirror of the corner buffer. Read its lines from the end
+     *instead of mirroring the buffer as it might be shared via the shadow cache.*/
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -408,22 +373,23 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         int32_t w = lv_area_get_width(&clip_area_sub);
         sh_buf_tmp = sh_buf;
         sh_buf_tmp += (corner_size - 1) * corner_size;
-        sh_buf_tmp += clip_area_sub.x1 - blend_area.x1;
+        sh_buf_tmp += corner_size - 1 - (clip_area_sub.x1 - blend_area.x1);
 
         /*Do not mask if out of the bg*/
         if(simple && _lv_area_is_out(&clip_area_sub, &bg_area, r_bg)) simple_sub = true;
         else simple_sub = simple;
-        blend_dsc.mask_buf = simple_sub ? sh_buf_tmp : mask_buf;
+        blend_dsc.mask_buf = mask_buf;
         if(w > 0) {
             blend_area.x1 = clip_area_sub.x1;
             blend_area.x2 = clip_area_sub.x2;
             blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;    /*In simple mode it won't be overwritten*/
+            if(simple_sub) shadow_line_mirror(mask_buf, sh_buf_tmp, w);
             for(y = clip_area_sub.y1; y <= clip_area_sub.y2; y++) {
                 blend_area.y1 = y;
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, w);
+                    shadow_line_mirror(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -447,7 +413,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         int32_t w = lv_area_get_width(&clip_area_sub);
         sh_buf_tmp = sh_buf;
         sh_buf_tmp += (clip_area_sub.y1 - blend_area.y1) * corner_size;
-        sh_buf_tmp += clip_area_sub.x1 - blend_area.x1;
+        sh_buf_tmp += corner_size - 1 - (clip_area_sub.x1 - blend_area.x1);
 
         /*Do not mask if out of the bg*/
         if(simple && _lv_area_is_out(&clip_area_sub, &bg_area, r_bg)) simple_sub = true;
@@ -462,14 +428,11 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y1 = y;
                 blend_area.y2 = y;
 
+                shadow_line_mirror(mask_buf, sh_buf_tmp, w);
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
-                else {
-                    blend_dsc.mask_buf = sh_buf_tmp;
-                }
 
                 lv_draw_sw_blend(draw_unit, &blend_dsc);
                 sh_buf_tmp += corner_size;
@@ -492,7 +455,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         int32_t w = lv_area_get_width(&clip_area_sub);
         sh_buf_tmp = sh_buf;
         sh_buf_tmp += (blend_area.y2 - clip_area_sub.y2) * corner_size;
-        sh_buf_tmp += clip_area_sub.x1 - blend_area.x1;
+        sh_buf_tmp += corner_size - 1 - (clip_area_sub.x1 - blend_area.x1);
 
         /*Do not mask if out of the bg*/
         if(simple && _lv_area_is_out(&clip_area_sub, &bg_area, r_bg)) simple_sub = true;
@@ -506,14 +469,11 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y1 = y;
                 blend_area.y2 = y;
 
+                shadow_line_mirror(mask_buf, sh_buf_tmp, w);
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
-                else {
-                    blend_dsc.mask_buf = sh_buf_tmp;
-                }
                 lv_draw_sw_blend(draw_unit, &blend_dsc);
                 sh_buf_tmp += corner_size;
             }
@@ -549,15 +509,108 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+    shadow_corner_release(sh_buf);
     lv_free(mask_buf);
 }
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+void lv_draw_sw_shadow_cache_get_stat(lv_draw_sw_shadow_cache_stat_t * stat)
+{
+    lv_mutex_lock(&shadow_cache.mutex);
+    *stat = shadow_cache.stat;
+    lv_mutex_unlock(&shadow_cache.mutex);
+}
+
+void lv_draw_sw_shadow_cache_reset_stat(void)
+{
+    lv_mutex_lock(&shadow_cache.mutex);
+    shadow_cache.stat.hit_cnt = 0;
+    shadow_cache.stat.miss_cnt = 0;
+    shadow_cache.stat.evict_cnt = 0;
+    lv_mutex_unlock(&shadow_cache.mutex);
+}
+
+void lv_draw_sw_shadow_cache_drop(void)
+{
+    lv_mutex_lock(&shadow_cache.mutex);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        _lv_draw_sw_shadow_cache_entry_t * entry = &shadow_cache.entries[i];
+        if(entry->buf && entry->used_cnt == 0) {
+            lv_free(entry->buf);
+            lv_memzero(entry, sizeof(_lv_draw_sw_shadow_cache_entry_t));
+            shadow_cache.stat.entry_cnt--;
+            shadow_cache.stat.evict_cnt++;
+        }
+    }
+    lv_mutex_unlock(&shadow_cache.mutex);
+}
+
+bool _lv_draw_sw_box_shadow_is_cached(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
+{
+#if LV_DRAW_SW_COMPLEX
+    lv_area_t core_area;
+    int32_t r_sh = shadow_core_get(dsc, coords, &core_area);
+    if(dsc->width + r_sh > LV_DRAW_SW_SHADOW_CACHE_SIZE) return false;
+
+    lv_mutex_lock(&shadow_cache.mutex);
+    bool cached = shadow_cache_find(&core_area, dsc->width, r_sh) != NULL;
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    return cached;
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(coords);
+    return false;
+#endif
+}
+
+void _lv_draw_sw_shadow_cache_init(void)
+{
+    lv_memzero(&shadow_cache, sizeof(lv_draw_sw_shadow_cache_t));
+    lv_mutex_init(&shadow_cache.mutex);
+}
+
+void _lv_draw_sw_shadow_cache_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        if(shadow_cache.entries[i].buf) lv_free(shadow_cache.entries[i].buf);
+    }
+
+    lv_mutex_delete(&shadow_cache.mutex);
+    lv_memzero(&shadow_cache, sizeof(lv_draw_sw_shadow_cache_t));
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
 #endif /*LV_USE_DRAW_SW*/
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the rectangle which is blurred to get the shadow
+ * @param dsc           the draw descriptor of the box shadow
+ * @param coords        the coordinates of the box shadow's draw task
+ * @param core_area     store the core area here
+ * @return              the radius clamped to the core area
+ */
+static int32_t shadow_core_get(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords, lv_area_t * core_area)
+{
+    core_area->x1 = coords->x1  + dsc->ofs_x - dsc->spread;
+    core_area->x2 = coords->x2  + dsc->ofs_x + dsc->spread;
+    core_area->y1 = coords->y1  + dsc->ofs_y - dsc->spread;
+    core_area->y2 = coords->y2  + dsc->ofs_y + dsc->spread;
+
+    int32_t r = dsc->radius;
+    int32_t short_side = LV_MIN(lv_area_get_width(core_area), lv_area_get_height(core_area));
+    if(r > short_side >> 1) r = short_side >> 1;
+
+    return r;
+}
+
 #if LV_DRAW_SW_COMPLEX
 
 /**
@@ -698,32 +751,238 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(int32_t size, int32_t sw, u
         else sh_ups_buf[i] = sh_ups_buf[i] / sw;
     }
 
+    /*Blur the columns together line by line to read the buffer sequentially.
+     *A line can be overwritten only when it's not added or forgotten anymore,
+     *so keep the last `s_right + 1` lines of the result in a ring buffer.*/
+    int32_t ring_cnt = s_right + 1;
+    uint16_t * ring_buf = lv_malloc(ring_cnt * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(ring_buf);
+    int32_t * v_buf = lv_malloc(size * sizeof(int32_t));
+    LV_ASSERT_MALLOC(v_buf);
+
     for(x = 0; x < size; x++) {
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        int32_t v = sh_ups_tmp_buf[0] * sw;
-        for(y = 0; y < size ; y++, sh_ups_tmp_buf += size) {
-            sh_ups_blur_buf[y] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
-
-            /*Forget the top pixel*/
-            uint32_t top_val;
-            if(y - s_right <= 0) top_val = sh_ups_tmp_buf[0];
-            else top_val = sh_ups_buf[(y - s_right) * size + x];
-            v -= top_val;
-
-            /*Add the bottom pixel*/
-            uint32_t bottom_val;
-            if(y + s_left + 1 < size) bottom_val = sh_ups_buf[(y + s_left + 1) * size + x];
-            else bottom_val = sh_ups_buf[(size - 1) * size + x];
-            v += bottom_val;
+        v_buf[x] = sh_ups_buf[x] * sw;
+    }
+
+    for(y = 0; y < size; y++) {
+        uint16_t * res_line = &ring_buf[(y % ring_cnt) * size];
+
+        /*The top and bottom pixels to forget and add*/
+        const uint16_t * top_line = &sh_ups_buf[(y - s_right <= 0 ? y : y - s_right) * size];
+        const uint16_t * bottom_line = &sh_ups_buf[(y + s_left + 1 < size ? y + s_left + 1 : size - 1) * size];
+
+        for(x = 0; x < size; x++) {
+            int32_t v = v_buf[x];
+            res_line[x] = v < 0 ? 0 : (v >> SHADOW_UPSCALE_SHIFT);
+            v_buf[x] = v - top_line[x] + bottom_line[x];
         }
 
-        /*Write back the result into `sh_ups_buf`*/
-        sh_ups_tmp_buf = &sh_ups_buf[x];
-        for(y = 0; y < size; y++, sh_ups_tmp_buf += size) {
-            (*sh_ups_tmp_buf) = sh_ups_blur_buf[y];
+        /*Write back the result of the line which won't be read anymore*/
+        if(y >= s_right) {
+            lv_memcpy(&sh_ups_buf[(y - s_right) * size], &ring_buf[((y - s_right) % ring_cnt) * size],
+                      size * sizeof(uint16_t));
         }
     }
 
+    for(y = LV_MAX(size - s_right, 0); y < size; y++) {
+        lv_memcpy(&sh_ups_buf[y * size], &ring_buf[(y % ring_cnt) * size], size * sizeof(uint16_t));
+    }
+
+    lv_free(ring_buf);
+    lv_free(v_buf);
     lv_free(sh_ups_blur_buf);
 }
+/**
+ * Copy a part of a corner line in reverse order to draw the left side
+ * @param dest      destination buffer
+ * @param src_end   the pixel of the corner line to copy to `dest[0]`
+ * @param len       number of pixels to copy
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void shadow_line_mirror(lv_opa_t * dest, const lv_opa_t * src_end, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        dest[i] = src_end[-i];
+    }
+}
+
+/**
+ * Calculate the blurred corner of a shadow
+ * @param coords    coordinates of the shadow's core
+ * @param sw        shadow width
+ * @param r         radius
+ * @return          the `(sw + r)^2` sized corner, free it with `lv_free`
+ */
+static lv_opa_t * shadow_corner_create(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+
+    /*A larger buffer is required for calculation*/
+    lv_opa_t * sh_buf = lv_malloc(size * size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(sh_buf);
+    shadow_draw_corner_buf(coords, (uint16_t *)sh_buf, sw, r);
+
+    return sh_buf;
+}
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+
+/**
+ * Get the blurred corner of a shadow from the cache or calculate it.
+ * The corner needs to be released with `shadow_corner_release`.
+ */
+static const lv_opa_t * shadow_corner_get(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+    if(size > LV_DRAW_SW_SHADOW_CACHE_SIZE) return shadow_corner_create(coords, sw, r);
+
+    lv_mutex_lock(&shadow_cache.mutex);
+    _lv_draw_sw_shadow_cache_entry_t * entry = shadow_cache_find(coords, sw, r);
+    if(entry) {
+        shadow_cache_use(entry);
+        shadow_cache.stat.hit_cnt++;
+    }
+    else {
+        shadow_cache.stat.miss_cnt++;
+    }
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    if(entry) return entry->buf;
+
+    /*Calculate the corner without locking so that the other draw units can use the cache meanwhile*/
+    lv_opa_t * sh_buf = shadow_corner_create(coords, sw, r);
+    lv_opa_t * sh_buf_small = lv_realloc(sh_buf, size * size);
+    if(sh_buf_small) sh_buf = sh_buf_small;
+
+    lv_mutex_lock(&shadow_cache.mutex);
+
+    /*Another draw unit might have added the same corner in the meantime*/
+    entry = shadow_cache_find(coords, sw, r);
+    if(entry) shadow_cache_use(entry);
+    else shadow_cache_add(sh_buf, coords, sw, r);
+
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    if(entry) {
+        lv_free(sh_buf);
+        return entry->buf;
+    }
+
+    return sh_buf;
+}
+
+static void shadow_corner_release(const lv_opa_t * sh_buf)
+{
+    bool cached = false;
+
+    lv_mutex_lock(&shadow_cache.mutex);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        if(shadow_cache.entries[i].buf == sh_buf) {
+            shadow_cache.entries[i].used_cnt--;
+            cached = true;
+            break;
+        }
+    }
+    lv_mutex_unlock(&shadow_cache.mutex);
+
+    /*It was too large or all the entries were in use*/
+    if(!cached) lv_free((void *)sh_buf);
+}
+
+/**
+ * Get the size of the core which identifies a corner in the cache.
+ * The far sides of a large core don't reach the corner so such cores can share it.
+ */
+static void shadow_cache_key_get(const lv_area_t * coords, int32_t sw, int32_t r, int32_t * w, int32_t * h)
+{
+    int32_t size = sw + r;
+    *w = LV_MIN(lv_area_get_width(coords), size + r);
+    *h = LV_MIN(lv_area_get_height(coords), size + r);
+}
+
+/**
+ * Find a corner in the cache. The mutex needs to be locked.
+ */
+static _lv_draw_sw_shadow_cache_entry_t * shadow_cache_find(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    int32_t w;
+    int32_t h;
+    shadow_cache_key_get(coords, sw, r, &w, &h);
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        _lv_draw_sw_shadow_cache_entry_t * entry = &shadow_cache.entries[i];
+        if(entry->buf && entry->sw == sw && entry->r == r && entry->w == w && entry->h == h) return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * Mark a cached corner as used. The mutex needs to be locked.
+ */
+static void shadow_cache_use(_lv_draw_sw_shadow_cache_entry_t * entry)
+{
+    entry->used_cnt++;
+    entry->last_used = ++shadow_cache.access_cnt;
+}
+
+/**
+ * Add a used corner to the cache in place of a free or the least recently used entry.
+ * The mutex needs to be locked.
+ * @return  false: all the entries are in use
+ */
+static bool shadow_cache_add(lv_opa_t * sh_buf, const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    _lv_draw_sw_shadow_cache_entry_t * entry = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT; i++) {
+        _lv_draw_sw_shadow_cache_entry_t * e = &shadow_cache.entries[i];
+        if(e->buf == NULL) {
+            entry = e;
+            break;
+        }
+
+        /*Compare the age instead of `last_used` to handle the overflow of the access counter*/
+        if(e->used_cnt == 0 &&
+           (entry == NULL || shadow_cache.access_cnt - e->last_used > shadow_cache.access_cnt - entry->last_used)) {
+            entry = e;
+        }
+    }
+
+    if(entry == NULL) return false;
+
+    if(entry->buf) {
+        lv_free(entry->buf);
+        shadow_cache.stat.evict_cnt++;
+    }
+    else {
+        shadow_cache.stat.entry_cnt++;
+    }
+
+    entry->buf = sh_buf;
+    shadow_cache_key_get(coords, sw, r, &entry->w, &entry->h);
+    entry->sw = sw;
+    entry->r = r;
+    entry->used_cnt = 1;
+    entry->last_used = ++shadow_cache.access_cnt;
+
+    return true;
+}
+
+#else
+
+static const lv_opa_t * shadow_corner_get(const lv_area_t * coords, int32_t sw, int32_t r)
+{
+    return shadow_corner_create(coords, sw, r);
+}
+
+static void shadow_corner_release(const lv_opa_t * sh_buf)
+{
+    lv_free((void *)sh_buf);
+}
+
+#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+
 #endif /*LV_DRAW_SW_COMPLEX*/
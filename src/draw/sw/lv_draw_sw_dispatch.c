@@ -0,0 +1,215 @@
+/**
+ * @file lv_draw_sw_dispatch.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_dispatch.h"
+#if LV_USE_DRAW_SW
+
+#include "../../core/lv_global.h"
+#include "../../stdlib/lv_string.h"
+#include "blend/x86/lv_blend_x86.h"
+#include "blend/neon/lv_blend_neon.h"
+
+#if _LV_BLEND_X86_TARGET && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#if (defined(__arm__) || defined(__aarch64__)) && defined(__linux__)
+    #include <sys/auxv.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define _dispatch LV_GLOBAL_DEFAULT()->sw_dispatch
+
+/*Bits of AT_HWCAP, defined here to not depend on the kernel headers*/
+#define DISPATCH_HWCAP_NEON     (1UL << 12)
+#define DISPATCH_HWCAP_ASIMD    (1UL << 1)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t detect_cpu_features(void);
+static void select_kernels(uint32_t features);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Set the 4 variants of a blend kernel named `<prefix>[_with_opa|_with_mask|_mix_mask_opa]<suffix>`*/
+#define SET_BLEND_VARIANTS(arr, prefix, suffix) \
+    do { \
+        (arr)[LV_DRAW_SW_BLEND_VARIANT_NORMAL] = prefix##suffix; \
+        (arr)[LV_DRAW_SW_BLEND_VARIANT_WITH_OPA] = prefix##_with_opa##suffix; \
+        (arr)[LV_DRAW_SW_BLEND_VARIANT_WITH_MASK] = prefix##_with_mask##suffix; \
+        (arr)[LV_DRAW_SW_BLEND_VARIANT_MIX_MASK_OPA] = prefix##_mix_mask_opa##suffix; \
+    } while(0)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_dispatch_init(void)
+{
+    lv_draw_sw_dispatch_t * d = &_dispatch;
+    d->cpu_features_detected = detect_cpu_features();
+    select_kernels(d->cpu_features_detected);
+
+    LV_LOG_INFO("CPU features: SSE2: %d, AVX2: %d, NEON: %d",
+                (d->cpu_features_detected & LV_DRAW_SW_CPU_FEATURE_SSE2) ? 1 : 0,
+                (d->cpu_features_detected & LV_DRAW_SW_CPU_FEATURE_AVX2) ? 1 : 0,
+                (d->cpu_features_detected & LV_DRAW_SW_CPU_FEATURE_NEON) ? 1 : 0);
+}
+
+uint32_t lv_draw_sw_get_detected_cpu_features(void)
+{
+    return _dispatch.cpu_features_detected;
+}
+
+uint32_t lv_draw_sw_get_cpu_features(void)
+{
+    return _dispatch.cpu_features;
+}
+
+void lv_draw_sw_set_cpu_features(uint32_t features)
+{
+    select_kernels(features & _dispatch.cpu_features_detected);
+}
+
+const lv_draw_sw_dispatch_t * lv_draw_sw_get_dispatch(void)
+{
+    return &_dispatch;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t detect_cpu_features(void)
+{
+    uint32_t features = LV_DRAW_SW_CPU_FEATURE_NONE;
+
+#if _LV_BLEND_X86_TARGET
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse2")) features |= LV_DRAW_SW_CPU_FEATURE_SSE2;
+    if(__builtin_cpu_supports("avx2")) features |= LV_DRAW_SW_CPU_FEATURE_AVX2;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    if(info[3] & (1 << 26)) features |= LV_DRAW_SW_CPU_FEATURE_SSE2;
+
+    /*AVX2 also needs the OS to save the YMM registers (OSXSAVE and AVX bits, then XCR0)*/
+    bool ymm_enabled = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+    if(max_leaf >= 7 && ymm_enabled) {
+        __cpuidex(info, 7, 0);
+        if(info[1] & (1 << 5)) features |= LV_DRAW_SW_CPU_FEATURE_AVX2;
+    }
+#endif
+#elif defined(__arm__) || defined(__aarch64__)
+#if defined(__linux__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+#if defined(__aarch64__)
+    if(hwcap & DISPATCH_HWCAP_ASIMD) features |= LV_DRAW_SW_CPU_FEATURE_NEON;
+#else
+    if(hwcap & DISPATCH_HWCAP_NEON) features |= LV_DRAW_SW_CPU_FEATURE_NEON;
+#endif
+#elif defined(__ARM_NEON)
+    /*No way to probe without an OS, so trust the compiler flags*/
+    features |= LV_DRAW_SW_CPU_FEATURE_NEON;
+#endif
+#endif
+
+    return features;
+}
+
+static void select_kernels(uint32_t features)
+{
+    /*Fill a new table and publish it with one copy so the live table never has
+     *all its kernels cleared in the middle of an update*/
+    lv_draw_sw_dispatch_t new_dispatch;
+    lv_draw_sw_dispatch_t * d = &new_dispatch;
+    lv_memzero(d, sizeof(lv_draw_sw_dispatch_t));
+    d->cpu_features_detected = _dispatch.cpu_features_detected;
+    d->cpu_features = features;
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO
+#if _LV_BLEND_X86_ENABLED
+    if(features & LV_DRAW_SW_CPU_FEATURE_AVX2) {
+        SET_BLEND_VARIANTS(d->color_to_rgb565, lv_color_blend_to_rgb565, _avx2);
+        SET_BLEND_VARIANTS(d->rgb565_to_rgb565, lv_rgb565_blend_normal_to_rgb565, _avx2);
+        SET_BLEND_VARIANTS(d->rgb888_to_rgb565, lv_rgb888_blend_normal_to_rgb565, _avx2);
+        SET_BLEND_VARIANTS(d->argb8888_to_rgb565, lv_argb8888_blend_normal_to_rgb565, _avx2);
+        SET_BLEND_VARIANTS(d->color_to_argb8888, lv_color_blend_to_argb8888, _avx2);
+        SET_BLEND_VARIANTS(d->rgb565_to_argb8888, lv_rgb565_blend_normal_to_argb8888, _avx2);
+        SET_BLEND_VARIANTS(d->rgb888_to_argb8888, lv_rgb888_blend_normal_to_argb8888, _avx2);
+        SET_BLEND_VARIANTS(d->argb8888_to_argb8888, lv_argb8888_blend_normal_to_argb8888, _avx2);
+    }
+    else if(features & LV_DRAW_SW_CPU_FEATURE_SSE2) {
+        SET_BLEND_VARIANTS(d->color_to_rgb565, lv_color_blend_to_rgb565, _sse2);
+        SET_BLEND_VARIANTS(d->rgb565_to_rgb565, lv_rgb565_blend_normal_to_rgb565, _sse2);
+        SET_BLEND_VARIANTS(d->rgb888_to_rgb565, lv_rgb888_blend_normal_to_rgb565, _sse2);
+        SET_BLEND_VARIANTS(d->argb8888_to_rgb565, lv_argb8888_blend_normal_to_rgb565, _sse2);
+        SET_BLEND_VARIANTS(d->color_to_argb8888, lv_color_blend_to_argb8888, _sse2);
+        SET_BLEND_VARIANTS(d->rgb565_to_argb8888, lv_rgb565_blend_normal_to_argb8888, _sse2);
+        SET_BLEND_VARIANTS(d->rgb888_to_argb8888, lv_rgb888_blend_normal_to_argb8888, _sse2);
+        SET_BLEND_VARIANTS(d->argb8888_to_argb8888, lv_argb8888_blend_normal_to_argb8888, _sse2);
+    }
+#endif /*_LV_BLEND_X86_ENABLED*/
+
+#if _LV_BLEND_NEON_ENABLED
+    if(features & LV_DRAW_SW_CPU_FEATURE_NEON) {
+        SET_BLEND_VARIANTS(d->color_to_rgb565, _lv_color_blend_to_rgb565, _neon);
+        SET_BLEND_VARIANTS(d->rgb565_to_rgb565, _lv_rgb565_blend_normal_to_rgb565, _neon);
+        SET_BLEND_VARIANTS(d->rgb888_to_rgb565, _lv_rgb888_blend_normal_to_rgb565, _neon);
+        SET_BLEND_VARIANTS(d->argb8888_to_rgb565, _lv_argb8888_blend_normal_to_rgb565, _neon);
+        SET_BLEND_VARIANTS(d->color_to_rgb888, _lv_color_blend_to_rgb888, _neon);
+        SET_BLEND_VARIANTS(d->rgb565_to_rgb888, _lv_rgb565_blend_normal_to_rgb888, _neon);
+        SET_BLEND_VARIANTS(d->rgb888_to_rgb888, _lv_rgb888_blend_normal_to_rgb888, _neon);
+        SET_BLEND_VARIANTS(d->argb8888_to_rgb888, _lv_argb8888_blend_normal_to_rgb888, _neon);
+        SET_BLEND_VARIANTS(d->color_to_argb8888, _lv_color_blend_to_argb8888, _neon);
+        SET_BLEND_VARIANTS(d->rgb565_to_argb8888, _lv_rgb565_blend_normal_to_argb8888, _neon);
+        SET_BLEND_VARIANTS(d->rgb888_to_argb8888, _lv_rgb888_blend_normal_to_argb8888, _neon);
+        SET_BLEND_VARIANTS(d->argb8888_to_argb8888, _lv_argb8888_blend_normal_to_argb8888, _neon);
+    }
+#endif /*_LV_BLEND_NEON_ENABLED*/
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO*/
+
+    /*The transform samplers and rotate kernels don't have hook macros,
+     *so they are used in every mode the x86 functions are built*/
+#if _LV_BLEND_X86_ENABLED
+    if(features & LV_DRAW_SW_CPU_FEATURE_AVX2) {
+        d->transform_argb8888 = lv_argb8888_transform_avx2;
+    }
+    else if(features & LV_DRAW_SW_CPU_FEATURE_SSE2) {
+        d->transform_argb8888 = lv_argb8888_transform_sse2;
+    }
+
+    if(features & (LV_DRAW_SW_CPU_FEATURE_SSE2 | LV_DRAW_SW_CPU_FEATURE_AVX2)) {
+        d->rotate_argb8888[LV_DISPLAY_ROTATION_90] = lv_argb8888_rotate90_sse2;
+        d->rotate_argb8888[LV_DISPLAY_ROTATION_270] = lv_argb8888_rotate270_sse2;
+        d->rotate_rgb565[LV_DISPLAY_ROTATION_90] = lv_rgb565_rotate90_sse2;
+        d->rotate_rgb565[LV_DISPLAY_ROTATION_270] = lv_rgb565_rotate270_sse2;
+    }
+#endif /*_LV_BLEND_X86_ENABLED*/
+
+    _dispatch = new_dispatch;
+}
+
+#endif /*LV_USE_DRAW_SW*/
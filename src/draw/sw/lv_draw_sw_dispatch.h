@@ -0,0 +1,169 @@
+/**
+ * @file lv_draw_sw_dispatch.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_DISPATCH_H
+#define LV_DRAW_SW_DISPATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "blend/lv_draw_sw_blend.h"
+#if LV_USE_DRAW_SW
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO
+
+/*Call a kernel of the dispatch table or return `LV_RESULT_INVALID` if it's not set to use the C implementation*/
+#define _LV_DRAW_SW_DISPATCH(kernel, ...) \
+    ((kernel) != NULL ? ((kernel)(__VA_ARGS__), LV_RESULT_OK) : LV_RESULT_INVALID)
+
+/*Call a blend kernel, e.g. `LV_DRAW_SW_BLEND_DISPATCH(color_to_rgb565, WITH_OPA, dsc)`*/
+#define LV_DRAW_SW_BLEND_DISPATCH(name, variant, ...) \
+    _LV_DRAW_SW_DISPATCH(LV_GLOBAL_DEFAULT()->sw_dispatch.name[LV_DRAW_SW_BLEND_VARIANT_##variant], __VA_ARGS__)
+
+#else
+
+/*Without runtime dispatch always use the C implementation*/
+#define LV_DRAW_SW_BLEND_DISPATCH(name, variant, ...)     LV_RESULT_INVALID
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** CPU features which can be used by the software renderer*/
+typedef enum {
+    LV_DRAW_SW_CPU_FEATURE_NONE = 0x00,     /**< Use only the C implementations*/
+    LV_DRAW_SW_CPU_FEATURE_SSE2 = 0x01,
+    LV_DRAW_SW_CPU_FEATURE_AVX2 = 0x02,
+    LV_DRAW_SW_CPU_FEATURE_NEON = 0x04,
+} lv_draw_sw_cpu_feature_t;
+
+/** The variants of a blend kernel, used to index the arrays of `lv_draw_sw_dispatch_t`*/
+typedef enum {
+    LV_DRAW_SW_BLEND_VARIANT_NORMAL,        /**< No mask and `opa >= LV_OPA_MAX`*/
+    LV_DRAW_SW_BLEND_VARIANT_WITH_OPA,      /**< No mask and `opa < LV_OPA_MAX`*/
+    LV_DRAW_SW_BLEND_VARIANT_WITH_MASK,     /**< Mask and `opa >= LV_OPA_MAX`*/
+    LV_DRAW_SW_BLEND_VARIANT_MIX_MASK_OPA,  /**< Mask and `opa < LV_OPA_MAX`*/
+    LV_DRAW_SW_BLEND_VARIANT_CNT,
+} lv_draw_sw_blend_variant_t;
+
+typedef void (*lv_draw_sw_blend_fill_kernel_t)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/** Fill an RGB888 or XRGB8888 buffer. `dest_px_size` is 3 or 4*/
+typedef void (*lv_draw_sw_blend_fill_px_kernel_t)(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+
+typedef void (*lv_draw_sw_blend_image_kernel_t)(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+/** Blend an image where either the source or the destination is RGB888 or XRGB8888. The pixel size is 3 or 4*/
+typedef void (*lv_draw_sw_blend_image_px_kernel_t)(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t px_size);
+
+typedef void (*lv_draw_sw_blend_image_px2_kernel_t)(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                    uint32_t src_px_size);
+
+/** Rotate an image with the parameters of `lv_draw_sw_rotate`*/
+typedef void (*lv_draw_sw_rotate_kernel_t)(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                                           int32_t src_stride, int32_t dest_stride);
+
+/**
+ * Sample the antialiased pixels `x_start..x_end-1` of a transformed row.
+ * It's called only for pixels whose sample and its neighbors are all inside the image, so no bounds checks are needed.
+ * The upscaled source coordinates of pixel `x` are `xs_ups + ((xs_step * x) >> 8)` and `ys_ups + ((ys_step * x) >> 8)`.
+ * `abuf` is the alpha output for the RGB565 formats, else NULL.
+ */
+typedef void (*lv_draw_sw_transform_kernel_t)(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                              int32_t x_start, int32_t x_end, void * dest_buf, uint8_t * abuf);
+
+/**
+ * Accelerated kernels selected for the CPU at runtime.
+ * `NULL` means the C implementation is used.
+ */
+typedef struct {
+    uint32_t cpu_features_detected;     /**< `lv_draw_sw_cpu_feature_t` flags supported by the CPU*/
+    uint32_t cpu_features;              /**< `lv_draw_sw_cpu_feature_t` flags used to select the kernels*/
+
+    /*Blend kernels, indexed by `lv_draw_sw_blend_variant_t`. Used only in LV_DRAW_SW_ASM_AUTO mode*/
+    lv_draw_sw_blend_fill_kernel_t color_to_rgb565[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_kernel_t rgb565_to_rgb565[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_px_kernel_t rgb888_to_rgb565[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_kernel_t argb8888_to_rgb565[LV_DRAW_SW_BLEND_VARIANT_CNT];
+
+    lv_draw_sw_blend_fill_px_kernel_t color_to_rgb888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_px_kernel_t rgb565_to_rgb888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_px2_kernel_t rgb888_to_rgb888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_px_kernel_t argb8888_to_rgb888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+
+    lv_draw_sw_blend_fill_kernel_t color_to_argb8888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_kernel_t rgb565_to_argb8888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_px_kernel_t rgb888_to_argb8888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+    lv_draw_sw_blend_image_kernel_t argb8888_to_argb8888[LV_DRAW_SW_BLEND_VARIANT_CNT];
+
+    /*Rotate kernels, indexed by `lv_display_rotation_t` (LV_DISPLAY_ROTATION_0 is not used)*/
+    lv_draw_sw_rotate_kernel_t rotate_rgb565[4];
+    lv_draw_sw_rotate_kernel_t rotate_rgb888[4];
+    lv_draw_sw_rotate_kernel_t rotate_argb8888[4];
+
+    /*Transform samplers by source color format*/
+    lv_draw_sw_transform_kernel_t transform_rgb888;
+    lv_draw_sw_transform_kernel_t transform_xrgb8888;
+    lv_draw_sw_transform_kernel_t transform_argb8888;
+    lv_draw_sw_transform_kernel_t transform_rgb565;
+    lv_draw_sw_transform_kernel_t transform_rgb565a8;
+    lv_draw_sw_transform_kernel_t transform_a8;
+} lv_draw_sw_dispatch_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Probe the features of the CPU and select the kernels.
+ * Called by `lv_draw_sw_init()`.
+ */
+void lv_draw_sw_dispatch_init(void);
+
+/**
+ * Get the CPU features supported by the CPU.
+ * @return      `lv_draw_sw_cpu_feature_t` flags
+ */
+uint32_t lv_draw_sw_get_detected_cpu_features(void);
+
+/**
+ * Get the CPU features used to select the kernels.
+ * @return      `lv_draw_sw_cpu_feature_t` flags
+ */
+uint32_t lv_draw_sw_get_cpu_features(void);
+
+/**
+ * Select the kernels for a set of CPU features. Features not supported by the CPU are ignored.
+ * Useful to force the C implementations for debugging with `LV_DRAW_SW_CPU_FEATURE_NONE`.
+ * Should be called when no rendering is in progress: the new table is published with a single
+ * copy, but a kernel already picked by a draw unit still runs with the previous features.
+ * @param features  `lv_draw_sw_cpu_feature_t` flags
+ */
+void lv_draw_sw_set_cpu_features(uint32_t features);
+
+/**
+ * Get the table of the selected kernels.
+ * @return      pointer to the dispatch table
+ */
+const lv_draw_sw_dispatch_t * lv_draw_sw_get_dispatch(void);
+
+#endif /*LV_USE_DRAW_SW*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_DISPATCH_H*/
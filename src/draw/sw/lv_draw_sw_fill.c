@@ -29,6 +29,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_SW_COMPLEX
+static void fill_grad_line(const lv_grad_t * grad, const lv_area_t * coords, lv_draw_sw_blend_dsc_t * blend_dsc,
+                           const lv_opa_t * mask_buf, lv_color_t * color_buf, lv_opa_t * opa_buf);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -103,9 +107,13 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
     /*Get gradient if appropriate*/
     lv_grad_t * grad = lv_gradient_get(&dsc->grad, coords_bg_w, coords_bg_h);
     lv_opa_t * grad_opa_map = NULL;
-    if(grad && grad_dir == LV_GRAD_DIR_HOR) {
+
+    /*The radial and conical gradients are calculated line by line into these buffers*/
+    bool grad_line = grad && (grad_dir == LV_GRAD_DIR_RADIAL || grad_dir == LV_GRAD_DIR_CONICAL);
+    lv_color_t * grad_line_color = NULL;
+    lv_opa_t * grad_line_opa = NULL;
+    if(grad && (grad_dir == LV_GRAD_DIR_HOR || grad_line)) {
         blend_dsc.src_area = &blend_area;
-        blend_dsc.src_buf = grad->color_map + clipped_coords.x1 - bg_coords.x1;
         bool transp = false;
         uint32_t s;
         for(s = 0; s < dsc->grad.stops_count; s++) {
@@ -115,12 +123,28 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
             }
         }
 
-        if(transp) grad_opa_map = grad->opa_map + clipped_coords.x1 - bg_coords.x1;
+        if(grad_line) {
+            grad_line_color = lv_malloc(clipped_w * sizeof(lv_color_t));
+            LV_ASSERT_MALLOC(grad_line_color);
+            if(transp) {
+                grad_line_opa = lv_malloc(clipped_w);
+                LV_ASSERT_MALLOC(grad_line_opa);
+            }
+            blend_dsc.src_buf = grad_line_color;
+        }
+        else {
+            blend_dsc.src_buf = grad->color_map + clipped_coords.x1 - bg_coords.x1;
+            if(transp) grad_opa_map = grad->opa_map + clipped_coords.x1 - bg_coords.x1;
+        }
 
         blend_dsc.src_color_format = LV_COLOR_FORMAT_RGB888;
     }
 
-    /* Draw the top of the rectangle line by line and mirror it to the bottom. */
+    /* Draw the top of the rectangle line by line and mirror it to the bottom.
+     * Without a horizontal opacity map only the anti-aliased edges need the mask,
+     * the rest of the line is either skipped or filled as it is.*/
+    lv_draw_sw_mask_span_t spans[LV_DRAW_SW_MASK_SPAN_MAX];
+    uint32_t span_cnt = 0;
     for(h = 0; h < rout; h++) {
         int32_t top_y = bg_coords.y1 + h;
         int32_t bottom_y = bg_coords.y2 - h;
@@ -129,8 +153,21 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
         /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
          * It saves calculating the final opa in lv_draw_sw_blend*/
         lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, top_y, clipped_w);
-        if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+        if(grad_opa_map == NULL && grad_line_opa == NULL) {
+            span_cnt = lv_draw_sw_mask_apply_spans(mask_list, mask_buf, blend_area.x1, top_y, clipped_w, spans);
+
+            /*The opacity is in the mask so it's needed in the covered spans too*/
+            if(opa < LV_OPA_MAX) {
+                uint32_t s;
+                for(s = 0; s < span_cnt; s++) {
+                    if(spans[s].type == LV_DRAW_SW_MASK_SPAN_COVER) spans[s].type = LV_DRAW_SW_MASK_SPAN_PARTIAL;
+                }
+            }
+        }
+        else {
+            blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, top_y, clipped_w);
+            if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+        }
 
         bool hor_grad_processed = false;
         if(top_y >= clipped_coords.y1) {
@@ -151,7 +188,11 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
                     blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
             }
-            lv_draw_sw_blend(draw_unit, &blend_dsc);
+            else if(grad_line) {
+                fill_grad_line(grad, &bg_coords, &blend_dsc, mask_buf, grad_line_color, grad_line_opa);
+            }
+            if(span_cnt) lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
+            else lv_draw_sw_blend(draw_unit, &blend_dsc);
         }
 
         if(bottom_y <= clipped_coords.y2) {
@@ -171,9 +212,14 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
                     blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
             }
-            lv_draw_sw_blend(draw_unit, &blend_dsc);
+            else if(grad_line) {
+                fill_grad_line(grad, &bg_coords, &blend_dsc, mask_buf, grad_line_color, grad_line_opa);
+            }
+            if(span_cnt) lv_draw_sw_blend_spans(draw_unit, &blend_dsc, spans, span_cnt);
+            else lv_draw_sw_blend(draw_unit, &blend_dsc);
         }
     }
+    blend_dsc.mask_buf = mask_buf;
 
     /* Draw the center of the rectangle.*/
 
@@ -195,9 +241,14 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
             blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
             blend_dsc.mask_buf = grad_opa_map;
         }
+        else if(grad_line) {
+            blend_dsc.mask_res = grad_line_opa ? LV_DRAW_SW_MASK_RES_CHANGED : LV_DRAW_SW_MASK_RES_FULL_COVER;
+            blend_dsc.mask_buf = grad_line_opa;
+        }
 
-        int32_t h_end = bg_coords.y2 - rout;
-        for(h = bg_coords.y1 + rout; h <= h_end; h++) {
+        int32_t h_start = LV_MAX(bg_coords.y1 + rout, clipped_coords.y1);
+        int32_t h_end = LV_MIN(bg_coords.y2 - rout, clipped_coords.y2);
+        for(h = h_start; h <= h_end; h++) {
             blend_area.y1 = h;
             blend_area.y2 = h;
 
@@ -206,10 +257,16 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
                 if(opa >= LV_OPA_MAX) blend_dsc.opa = grad->opa_map[h - bg_coords.y1];
                 else blend_dsc.opa = LV_OPA_MIX2(grad->opa_map[h - bg_coords.y1], opa);
             }
+            else if(grad_line) {
+                lv_gradient_get_line(grad, &bg_coords, blend_area.x1, h, clipped_w, grad_line_color, grad_line_opa);
+            }
             lv_draw_sw_blend(draw_unit, &blend_dsc);
         }
     }
 
+    lv_free(grad_line_color);
+    lv_free(grad_line_opa);
+
     if(mask_buf) {
         lv_free(mask_buf);
         lv_draw_sw_mask_free_param(&mask_rout_param);
@@ -221,4 +278,33 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
 #endif
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX
+/**
+ * Calculate a line of a radial or conical gradient and mix its opacities into the mask
+ */
+static void fill_grad_line(const lv_grad_t * grad, const lv_area_t * coords, lv_draw_sw_blend_dsc_t * blend_dsc,
+                           const lv_opa_t * mask_buf, lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    const lv_area_t * a = blend_dsc->blend_area;
+    int32_t len = lv_area_get_width(a);
+    lv_gradient_get_line(grad, coords, a->x1, a->y1, len, color_buf, opa_buf);
+    if(opa_buf == NULL) return;
+
+    /*Don't modify the mask as it's used for the mirrored line too*/
+    if(blend_dsc->mask_res != LV_DRAW_SW_MASK_RES_TRANSP) {
+        int32_t i;
+        for(i = 0; i < len; i++) {
+            if(opa_buf[i] < LV_OPA_MAX) opa_buf[i] = LV_OPA_MIX2(mask_buf[i], opa_buf[i]);
+            else opa_buf[i] = mask_buf[i];
+        }
+        blend_dsc->mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+    }
+    blend_dsc->mask_buf = opa_buf;
+}
+#endif
+
 #endif /*LV_USE_DRAW_SW*/
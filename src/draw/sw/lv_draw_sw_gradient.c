@@ -10,7 +10,9 @@
 #if LV_USE_DRAW_SW
 
 #include "../../misc/lv_types.h"
+#include "../../misc/lv_math.h"
 #include "../../osal/lv_os.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -25,11 +27,34 @@
     #define ALIGN(X)    (((X) + 3) & ~3)
 #endif
 
+/*Number of angles in the map of the conical gradients. An octant is 1/8 of it.*/
+#define CONIC_MAP_SIZE      1024
+#define CONIC_OCTANT        (CONIC_MAP_SIZE / 8)
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    #define grad_cache LV_GLOBAL_DEFAULT()->sw_grad_cache
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static int32_t get_map_size(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static size_t get_item_mem_size(int32_t size);
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t size);
+static lv_grad_t * gradient_create(const lv_grad_dsc_t * g, int32_t size);
+LV_ATTRIBUTE_FAST_MEM static void radial_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x, int32_t y,
+                                              int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf);
+LV_ATTRIBUTE_FAST_MEM static void conical_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x, int32_t y,
+                                               int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf);
+static inline uint32_t conic_octant_angle(uint32_t t);
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+static bool grad_dsc_eq(const lv_grad_dsc_t * a, const lv_grad_dsc_t * b);
+static _lv_gradient_cache_entry_t * grad_cache_find(const lv_grad_dsc_t * g, int32_t size);
+static bool grad_cache_add(lv_grad_t * grad, const lv_grad_dsc_t * g);
+static void grad_cache_drop_entry(_lv_gradient_cache_entry_t * entry);
+#endif
 
 /**********************
  *   STATIC VARIABLE
@@ -39,11 +64,32 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+/**
+ * Get the number of entries in the maps of a gradient
+ */
+static int32_t get_map_size(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+{
+    switch(g->dir) {
+        case LV_GRAD_DIR_HOR:
+            return w;
+        case LV_GRAD_DIR_RADIAL:
+            /*Indexed by the doubled distance from the center, up to the closest side*/
+            return LV_MIN(w, h) + 1;
+        case LV_GRAD_DIR_CONICAL:
+            return CONIC_MAP_SIZE;
+        default:
+            return h;
+    }
+}
+
+static size_t get_item_mem_size(int32_t size)
 {
-    int32_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
+    return ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+}
 
-    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t size)
+{
+    size_t req_size = get_item_mem_size(size);
     lv_grad_t * item  = lv_malloc(req_size);
     LV_ASSERT_MALLOC(item);
     if(item == NULL) return NULL;
@@ -52,9 +98,228 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->dir = g->dir;
     return item;
 }
 
+/**
+ * Allocate a gradient and calculate its maps.
+ * Walk the stops once and interpolate between them instead of searching the stops for each entry.
+ * The result is the same as calling `lv_gradient_color_calculate` for each entry.
+ */
+static lv_grad_t * gradient_create(const lv_grad_dsc_t * g, int32_t size)
+{
+    lv_grad_t * item = allocate_item(g, size);
+    if(item == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return item;
+    }
+
+    const lv_gradient_stop_t * first = &g->stops[0];
+    const lv_gradient_stop_t * last = &g->stops[g->stops_count - 1];
+    int32_t min = (first->frac * size) >> 8;
+    int32_t max = (last->frac * size) >> 8;
+
+    /*Before the first stop*/
+    int32_t i;
+    for(i = 0; i <= min && i < size; i++) {
+        item->color_map[i] = first->color;
+        item->opa_map[i] = first->opa;
+    }
+
+    /*Between the stops*/
+    uint32_t s;
+    for(s = 1; s < g->stops_count && i < max; s++) {
+        const lv_gradient_stop_t * one = &g->stops[s - 1];
+        const lv_gradient_stop_t * two = &g->stops[s];
+        int32_t seg_min = (one->frac * size) >> 8;
+        int32_t seg_max = (two->frac * size) >> 8;
+        int32_t d = seg_max - seg_min;
+        for(; i <= seg_max && i < max; i++) {
+            lv_opa_t mix = ((i - seg_min) * 255) / d;
+            lv_opa_t imix = 255 - mix;
+            item->color_map[i] = GRAD_CM(LV_UDIV255(two->color.red * mix   + one->color.red * imix),
+                                         LV_UDIV255(two->color.green * mix + one->color.green * imix),
+                                         LV_UDIV255(two->color.blue * mix  + one->color.blue * imix));
+            item->opa_map[i] = LV_UDIV255(two->opa * mix + one->opa * imix);
+        }
+    }
+
+    /*After the last stop*/
+    for(; i < size; i++) {
+        item->color_map[i] = last->color;
+        item->opa_map[i] = last->opa;
+    }
+
+    return item;
+}
+
+/**
+ * Calculate a line of a radial gradient.
+ * The map is indexed by the doubled distance from the center so that the center can be between two pixels too.
+ * The distance changes by at most 2 units between neighboring pixels, so the square root
+ * is calculated only for the first pixel and adjusted in a step or two for the others.
+ */
+LV_ATTRIBUTE_FAST_MEM static void radial_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x, int32_t y,
+                                              int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    int32_t dx = 2 * x - (coords->x1 + coords->x2);
+    int32_t dy = 2 * y - (coords->y1 + coords->y2);
+    uint32_t dy_sq = dy * dy;
+    uint32_t last = grad->size - 1;
+
+    lv_sqrt_res_t res;
+    lv_sqrt(dx * dx + dy_sq, &res, 0x8000);
+    uint32_t d = res.i;
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t q = dx * dx + dy_sq;
+        while((d + 1) * (d + 1) <= q) d++;
+        while(d * d > q) d--;
+
+        uint32_t idx = d < last ? d : last;
+        color_buf[i] = grad->color_map[idx];
+        if(opa_buf) opa_buf[i] = grad->opa_map[idx];
+        dx += 2;
+    }
+}
+
+/**
+ * Calculate a line of a conical gradient.
+ * The angle starts on the right and increases clockwise, a full circle is `CONIC_MAP_SIZE`.
+ */
+LV_ATTRIBUTE_FAST_MEM static void conical_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x, int32_t y,
+                                               int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    int32_t dx = 2 * x - (coords->x1 + coords->x2);
+    int32_t dy = 2 * y - (coords->y1 + coords->y2);
+    uint32_t ay = LV_ABS(dy);
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t ax = LV_ABS(dx);
+
+        /*Angle in the first quadrant*/
+        uint32_t a;
+        if(ax >= ay) a = ax == 0 ? 0 : conic_octant_angle((ay << 8) / ax);
+        else a = 2 * CONIC_OCTANT - conic_octant_angle((ax << 8) / ay);
+
+        /*Mirror it to the real quadrant*/
+        if(dx < 0) a = dy >= 0 ? 4 * CONIC_OCTANT - a : 4 * CONIC_OCTANT + a;
+        else if(dy < 0) a = CONIC_MAP_SIZE - a;
+
+        a &= CONIC_MAP_SIZE - 1;
+        color_buf[i] = grad->color_map[a];
+        if(opa_buf) opa_buf[i] = grad->opa_map[a];
+        dx += 2;
+    }
+}
+
+/**
+ * Approximate `atan(t / 256)` in `CONIC_OCTANT / 45°` units
+ * with `atan(x) ~ x * PI / 4 + 0.273 * x * (1 - x)` (max. error 0.22°).
+ * @param t     tangent of the angle in [0..256] range
+ * @return      the angle in [0..CONIC_OCTANT] range
+ */
+static inline uint32_t conic_octant_angle(uint32_t t)
+{
+    /*0.273 * 4 / PI ~ 89 / 256*/
+    return (t * (CONIC_OCTANT * 256 + ((CONIC_OCTANT * 89) >> 8) * (256 - t)) + 32768) >> 16;
+}
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+
+static bool grad_dsc_eq(const lv_grad_dsc_t * a, const lv_grad_dsc_t * b)
+{
+    if(a->dir != b->dir || a->stops_count != b->stops_count) return false;
+
+    uint32_t i;
+    for(i = 0; i < a->stops_count; i++) {
+        if(a->stops[i].frac != b->stops[i].frac) return false;
+        if(a->stops[i].opa != b->stops[i].opa) return false;
+        if(!lv_color_eq(a->stops[i].color, b->stops[i].color)) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Find a gradient in the cache and mark it as used. The mutex needs to be locked.
+ */
+static _lv_gradient_cache_entry_t * grad_cache_find(const lv_grad_dsc_t * g, int32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT; i++) {
+        _lv_gradient_cache_entry_t * entry = &grad_cache.entries[i];
+        if(entry->grad && entry->grad->size == (uint32_t)size && grad_dsc_eq(&entry->dsc, g)) {
+            entry->used_cnt++;
+            entry->last_used = ++grad_cache.access_cnt;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a used gradient to the cache in place of a free or the least recently used entries.
+ * The mutex needs to be locked.
+ * @return  false: there is no free entry or memory and all the entries are in use
+ */
+static bool grad_cache_add(lv_grad_t * grad, const lv_grad_dsc_t * g)
+{
+    uint32_t mem_size = get_item_mem_size(grad->size);
+
+    while(1) {
+        _lv_gradient_cache_entry_t * free_entry = NULL;
+        _lv_gradient_cache_entry_t * lru = NULL;
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT; i++) {
+            _lv_gradient_cache_entry_t * e = &grad_cache.entries[i];
+            if(e->grad == NULL) {
+                if(free_entry == NULL) free_entry = e;
+                continue;
+            }
+
+            /*Compare the age instead of `last_used` to handle the overflow of the access counter*/
+            if(e->used_cnt == 0 &&
+               (lru == NULL || grad_cache.access_cnt - e->last_used > grad_cache.access_cnt - lru->last_used)) {
+                lru = e;
+            }
+        }
+
+        bool mem_ok = LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE == 0 ||
+                      grad_cache.stat.mem_size + mem_size <= LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE;
+        if(free_entry && mem_ok) {
+            free_entry->grad = grad;
+            free_entry->dsc = *g;
+            free_entry->used_cnt = 1;
+            free_entry->last_used = ++grad_cache.access_cnt;
+            grad_cache.stat.entry_cnt++;
+            grad_cache.stat.mem_size += mem_size;
+            return true;
+        }
+
+        if(lru == NULL) return false;
+        grad_cache_drop_entry(lru);
+        grad_cache.stat.evict_cnt++;
+    }
+}
+
+/**
+ * Free the gradient of an unused entry. The mutex needs to be locked.
+ */
+static void grad_cache_drop_entry(_lv_gradient_cache_entry_t * entry)
+{
+    grad_cache.stat.entry_cnt--;
+    grad_cache.stat.mem_size -= get_item_mem_size(entry->grad->size);
+    lv_free(entry->grad);
+    lv_memzero(entry, sizeof(_lv_gradient_cache_entry_t));
+}
+
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_CNT*/
+
 /**********************
  *     FUNCTIONS
  **********************/
@@ -64,19 +329,47 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 1: Search cache for the given key */
-    lv_grad_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
+    int32_t size = get_map_size(g, w, h);
+
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    if(LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE == 0 || get_item_mem_size(size) <= LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE) {
+        lv_mutex_lock(&grad_cache.mutex);
+        _lv_gradient_cache_entry_t * entry = grad_cache_find(g, size);
+        if(entry) grad_cache.stat.hit_cnt++;
+        else grad_cache.stat.miss_cnt++;
+        lv_mutex_unlock(&grad_cache.mutex);
+
+        if(entry) return entry->grad;
+
+        /*Calculate the maps without locking so that the other draw units can use the cache meanwhile*/
+        lv_grad_t * item = gradient_create(g, size);
+        if(item == NULL) return NULL;
+
+        lv_mutex_lock(&grad_cache.mutex);
+
+        /*Another draw unit might have added the same gradient in the meantime*/
+        entry = grad_cache_find(g, size);
+        if(entry == NULL) grad_cache_add(item, g);
+
+        lv_mutex_unlock(&grad_cache.mutex);
+
+        if(entry) {
+            lv_free(item);
+            return entry->grad;
+        }
+
         return item;
     }
+#endif
 
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_gradient_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
-    return item;
+    return gradient_create(g, size);
+}
+
+LV_ATTRIBUTE_FAST_MEM void lv_gradient_get_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x,
+                                                int32_t y, int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    if(grad->dir == LV_GRAD_DIR_RADIAL) radial_line(grad, coords, x, y, len, color_buf, opa_buf);
+    else if(grad->dir == LV_GRAD_DIR_CONICAL) conical_line(grad, coords, x, y, len, color_buf, opa_buf);
 }
 
 LV_ATTRIBUTE_FAST_MEM void lv_gradient_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
@@ -134,7 +427,76 @@ LV_ATTRIBUTE_FAST_MEM void lv_gradient_color_calculate(const lv_grad_dsc_t * dsc
 
 void lv_gradient_cleanup(lv_grad_t * grad)
 {
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+    bool cached = false;
+
+    lv_mutex_lock(&grad_cache.mutex);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT; i++) {
+        if(grad_cache.entries[i].grad == grad) {
+            grad_cache.entries[i].used_cnt--;
+            cached = true;
+            break;
+        }
+    }
+    lv_mutex_unlock(&grad_cache.mutex);
+
+    /*It was too large or all the entries were in use*/
+    if(cached) return;
+#endif
+
     lv_free(grad);
 }
 
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+
+void lv_gradient_cache_get_stat(lv_gradient_cache_stat_t * stat)
+{
+    lv_mutex_lock(&grad_cache.mutex);
+    *stat = grad_cache.stat;
+    lv_mutex_unlock(&grad_cache.mutex);
+}
+
+void lv_gradient_cache_reset_stat(void)
+{
+    lv_mutex_lock(&grad_cache.mutex);
+    grad_cache.stat.hit_cnt = 0;
+    grad_cache.stat.miss_cnt = 0;
+    grad_cache.stat.evict_cnt = 0;
+    lv_mutex_unlock(&grad_cache.mutex);
+}
+
+void lv_gradient_cache_drop(void)
+{
+    lv_mutex_lock(&grad_cache.mutex);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT; i++) {
+        _lv_gradient_cache_entry_t * entry = &grad_cache.entries[i];
+        if(entry->grad && entry->used_cnt == 0) {
+            grad_cache_drop_entry(entry);
+            grad_cache.stat.evict_cnt++;
+        }
+    }
+    lv_mutex_unlock(&grad_cache.mutex);
+}
+
+void _lv_gradient_cache_init(void)
+{
+    lv_memzero(&grad_cache, sizeof(_lv_gradient_cache_t));
+    lv_mutex_init(&grad_cache.mutex);
+}
+
+void _lv_gradient_cache_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT; i++) {
+        if(grad_cache.entries[i].grad) lv_free(grad_cache.entries[i].grad);
+    }
+
+    lv_mutex_delete(&grad_cache.mutex);
+    lv_memzero(&grad_cache, sizeof(_lv_gradient_cache_t));
+}
+
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_CNT*/
+
 #endif /*LV_USE_DRAW_SW*/
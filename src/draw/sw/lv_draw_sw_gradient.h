@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "../../misc/lv_color.h"
 #include "../../misc/lv_style.h"
+#include "../../osal/lv_os.h"
 
 #if LV_USE_DRAW_SW
 
@@ -34,8 +35,35 @@ typedef struct _lv_gradient_cache_t {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_grad_dir_t dir;
 } lv_grad_t;
 
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+typedef struct {
+    lv_grad_t * grad;           /**< The calculated maps, NULL if the entry is free*/
+    lv_grad_dsc_t dsc;          /**< The stops and the direction the maps were calculated from*/
+    uint32_t last_used;         /**< Value of the cache's access counter when the gradient was used the last time*/
+    uint32_t used_cnt;          /**< Number of draws using this gradient*/
+} _lv_gradient_cache_entry_t;
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of draws which found their gradient in the cache*/
+    uint32_t miss_cnt;          /**< Number of draws which needed to calculate their gradient*/
+    uint32_t evict_cnt;         /**< Number of gradients dropped from the cache*/
+    uint32_t entry_cnt;         /**< Number of the cached gradients*/
+    uint32_t mem_size;          /**< Memory used by the cached gradients [bytes]*/
+} lv_gradient_cache_stat_t;
+
+typedef struct {
+    /*The maps are read without locking while they are used, so they are
+     *never changed after they are added, only freed when they are not used anymore*/
+    _lv_gradient_cache_entry_t entries[LV_DRAW_SW_GRADIENT_CACHE_CNT];
+    uint32_t access_cnt;
+    lv_gradient_cache_stat_t stat;
+    lv_mutex_t mutex;
+} _lv_gradient_cache_t;
+#endif
+
 /**********************
  *      PROTOTYPES
  **********************/
@@ -49,15 +77,58 @@ typedef struct _lv_gradient_cache_t {
 LV_ATTRIBUTE_FAST_MEM void lv_gradient_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                        int32_t frac, lv_grad_color_t * color_out, lv_opa_t * opa_out);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get the color and opacity maps of a gradient from the cache or calculate them.
+ * The maps of LV_GRAD_DIR_VER and LV_GRAD_DIR_HOR have an entry for each row or column.
+ * The maps of LV_GRAD_DIR_RADIAL and LV_GRAD_DIR_CONICAL need to be read with `lv_gradient_get_line`.
+ * @param gradient  the gradient descriptor
+ * @param w         width of the area to fill with the gradient
+ * @param h         height of the area to fill with the gradient
+ * @return          the gradient or NULL if there is no gradient or on error
+ */
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Get the colors and opacities of a horizontal line of a radial or conical gradient.
+ * @param grad      the gradient from `lv_gradient_get`
+ * @param coords    the area the gradient fills
+ * @param x         the x coordinate of the line's first pixel
+ * @param y         the y coordinate of the line
+ * @param len       number of pixels
+ * @param color_buf store the colors here
+ * @param opa_buf   store the opacities here, can be NULL
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_gradient_get_line(const lv_grad_t * grad, const lv_area_t * coords, int32_t x,
+                                                int32_t y, int32_t len, lv_color_t * color_buf, lv_opa_t * opa_buf);
+
+/**
+ * Release the gradient after it was get with `lv_gradient_get`.
  * @param grad      pointer to a gradient
  */
 void lv_gradient_cleanup(lv_grad_t * grad);
 
+#if defined(LV_DRAW_SW_GRADIENT_CACHE_CNT) && LV_DRAW_SW_GRADIENT_CACHE_CNT > 0
+/**
+ * Get the statistics of the cache of the gradient maps
+ * @param stat      store the statistics here
+ */
+void lv_gradient_cache_get_stat(lv_gradient_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and evict counters of the gradient cache
+ */
+void lv_gradient_cache_reset_stat(void);
+
+/**
+ * Free the cached gradients which are not used
+ */
+void lv_gradient_cache_drop(void);
+
+void _lv_gradient_cache_init(void);
+
+void _lv_gradient_cache_deinit(void);
+#endif
+
 #endif /*LV_USE_DRAW_SW*/
 
 #ifdef __cplusplus
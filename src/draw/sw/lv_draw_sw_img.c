@@ -33,11 +33,14 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static void img_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                     const lv_area_t * coords, const lv_image_decoder_args_t * args);
+
 static void img_draw_normal(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
-                            const lv_area_t * coords);
+                            const lv_area_t * coords, const lv_image_decoder_args_t * args);
 
 static void img_draw_tiled(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
-                           const lv_area_t * coords);
+                           const lv_area_t * coords, const lv_image_decoder_args_t * args);
 
 static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
                                 lv_image_decoder_dsc_t * decoder_dsc,
@@ -79,7 +82,10 @@ void lv_draw_sw_layer(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dr
     lv_memcpy(&new_draw_dsc, draw_dsc, sizeof(lv_draw_image_dsc_t));
     new_draw_dsc.src = &img_dsc;
 
-    lv_draw_sw_image(draw_unit, &new_draw_dsc, coords);
+    /*The layers are already rendered in the color format they should be blended with*/
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    img_draw(draw_unit, &new_draw_dsc, coords, &args);
 
 #if LV_USE_LAYER_DEBUG || LV_USE_PARALLEL_DRAW_DEBUG
     lv_area_t area_rot;
@@ -162,17 +168,30 @@ void lv_draw_sw_layer(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dr
 
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_image(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
                                             const lv_area_t * coords)
+{
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.premultiply = LV_DRAW_SW_PREMULTIPLY;
+    img_draw(draw_unit, draw_dsc, coords, &args);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void img_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                     const lv_area_t * coords, const lv_image_decoder_args_t * args)
 {
     if(!draw_dsc->tile) {
-        img_draw_normal(draw_unit, draw_dsc, coords);
+        img_draw_normal(draw_unit, draw_dsc, coords, args);
     }
     else {
-        img_draw_tiled(draw_unit, draw_dsc, coords);
+        img_draw_tiled(draw_unit, draw_dsc, coords, args);
     }
 }
 
 static void img_draw_normal(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
-                            const lv_area_t * coords)
+                            const lv_area_t * coords, const lv_image_decoder_args_t * args)
 {
     lv_area_t draw_area;
     lv_area_copy(&draw_area, coords);
@@ -195,7 +214,7 @@ static void img_draw_normal(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_
     }
 
     lv_image_decoder_dsc_t decoder_dsc;
-    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL);
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, args);
     if(res != LV_RESULT_OK) {
         LV_LOG_ERROR("Failed to open image");
         return;
@@ -207,10 +226,10 @@ static void img_draw_normal(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_
 }
 
 static void img_draw_tiled(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
-                           const lv_area_t * coords)
+                           const lv_area_t * coords, const lv_image_decoder_args_t * args)
 {
     lv_image_decoder_dsc_t decoder_dsc;
-    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL);
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, args);
     if(res != LV_RESULT_OK) {
         LV_LOG_ERROR("Failed to open image");
         return;
@@ -470,6 +489,22 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
                                    ((c_mult[0] + (buf16[i] & 0x1F) * mix_inv) >> 8);
                     }
                 }
+                else if(cf_final == LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED) {
+                    /*The recolor also needs to be premultiplied by the alpha of the pixels*/
+                    uint32_t size = lv_area_get_size(&blend_area);
+                    uint32_t i;
+                    uint32_t c_mult[3];
+                    c_mult[0] = color.blue * mix;
+                    c_mult[1] = color.green * mix;
+                    c_mult[2] = color.red * mix;
+                    lv_color32_t * buf32 = (lv_color32_t *)tmp_buf;
+                    for(i = 0; i < size; i++) {
+                        uint32_t a = buf32[i].alpha;
+                        buf32[i].blue = (LV_UDIV255(c_mult[0] * a) + buf32[i].blue * mix_inv) >> 8;
+                        buf32[i].green = (LV_UDIV255(c_mult[1] * a) + buf32[i].green * mix_inv) >> 8;
+                        buf32[i].red = (LV_UDIV255(c_mult[2] * a) + buf32[i].red * mix_inv) >> 8;
+                    }
+                }
                 else  if(cf_final != LV_COLOR_FORMAT_A8) {
                     uint32_t size = lv_area_get_size(&blend_area);
                     uint32_t i;
@@ -504,8 +539,4 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 #endif /*LV_USE_DRAW_SW*/
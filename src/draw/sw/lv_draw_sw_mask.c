@@ -20,8 +20,7 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define CIRCLE_BUF_SIZE(r)              ((r) * 6 + 6)  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
 #define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
 #define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
 
@@ -47,6 +46,12 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_fade(lv_opa_t *
 LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_map(lv_opa_t * mask_buf, int32_t abs_x,
                                                                     int32_t abs_y, int32_t len,
                                                                     lv_draw_sw_mask_map_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static uint32_t lv_draw_mask_radius_spans(lv_draw_sw_mask_span_t * spans, int32_t abs_x,
+                                                                 int32_t abs_y, int32_t len,
+                                                                 lv_draw_sw_mask_radius_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static uint32_t lv_draw_mask_fade_spans(lv_draw_sw_mask_span_t * spans, int32_t abs_x,
+                                                               int32_t abs_y, int32_t len,
+                                                               lv_draw_sw_mask_fade_param_t * param);
 
 LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t line_mask_flat(lv_opa_t * mask_buf, int32_t abs_x,
                                                                   int32_t abs_y,
@@ -63,7 +68,17 @@ static void circ_next(lv_point_t * c, int32_t * tmp);
 static void circ_calc_aa4(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius);
 static lv_opa_t * get_next_line(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius);
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius);
+static bool circle_cache_add(_lv_draw_sw_mask_radius_circle_dsc_t * circle);
+static int32_t circle_cache_drop_lru(void);
+static void circle_free(_lv_draw_sw_mask_radius_circle_dsc_t * circle);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+LV_ATTRIBUTE_FAST_MEM static inline void span_add(lv_draw_sw_mask_span_t * spans, uint32_t * span_cnt, int32_t end,
+                                                  lv_draw_sw_mask_span_type_t type, int32_t len);
+LV_ATTRIBUTE_FAST_MEM static uint32_t spans_intersect(const lv_draw_sw_mask_span_t * a, uint32_t a_cnt,
+                                                      const lv_draw_sw_mask_span_t * b, uint32_t b_cnt,
+                                                      lv_draw_sw_mask_span_t * res);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,14 +94,45 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
 
 void lv_draw_sw_mask_init(void)
 {
+    lv_memzero(&_circle_cache, sizeof(_circle_cache));
     lv_mutex_init(&circle_cache_mutex);
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(_circle_cache.entries[i]) circle_free(_circle_cache.entries[i]);
+    }
+    lv_memzero(&_circle_cache, sizeof(_circle_cache));
+
     lv_mutex_delete(&circle_cache_mutex);
 }
 
+void _lv_draw_sw_mask_cleanup(void)
+{
+    lv_mutex_lock(&circle_cache_mutex);
+    while(circle_cache_drop_lru() >= 0);
+    lv_mutex_unlock(&circle_cache_mutex);
+}
+
+void lv_draw_sw_mask_circle_cache_get_stat(lv_draw_sw_mask_circle_cache_stat_t * stat)
+{
+    lv_mutex_lock(&circle_cache_mutex);
+    *stat = _circle_cache.stat;
+    lv_mutex_unlock(&circle_cache_mutex);
+}
+
+void lv_draw_sw_mask_circle_cache_reset_stat(void)
+{
+    lv_mutex_lock(&circle_cache_mutex);
+    _circle_cache.stat.hit_cnt = 0;
+    _circle_cache.stat.miss_cnt = 0;
+    _circle_cache.stat.evict_cnt = 0;
+    _circle_cache.stat.temporary_cnt = 0;
+    lv_mutex_unlock(&circle_cache_mutex);
+}
+
 LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
                                                                   int32_t abs_y,
                                                                   int32_t len)
@@ -106,6 +152,54 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
     return changed ? LV_DRAW_SW_MASK_RES_CHANGED : LV_DRAW_SW_MASK_RES_FULL_COVER;
 }
 
+LV_ATTRIBUTE_FAST_MEM uint32_t lv_draw_sw_mask_apply_spans(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
+                                                           int32_t abs_y, int32_t len, lv_draw_sw_mask_span_t * spans)
+{
+    lv_draw_sw_mask_span_t mask_spans[LV_DRAW_SW_MASK_SPAN_MAX];
+    lv_draw_sw_mask_span_t tmp_spans[LV_DRAW_SW_MASK_SPAN_MAX];
+
+    spans[0].end = len;
+    spans[0].type = LV_DRAW_SW_MASK_SPAN_COVER;
+    uint32_t span_cnt = 1;
+
+    /*Intersect the spans of the masks. Masks without spans make the whole line partial*/
+    uint32_t i;
+    for(i = 0; masks[i]; i++) {
+        _lv_draw_sw_mask_common_dsc_t * dsc = masks[i];
+        uint32_t mask_span_cnt = 1;
+        if(dsc->span_cb) {
+            mask_span_cnt = dsc->span_cb(mask_spans, abs_x, abs_y, len, masks[i]);
+        }
+        else {
+            mask_spans[0].end = len;
+            mask_spans[0].type = LV_DRAW_SW_MASK_SPAN_PARTIAL;
+        }
+
+        span_cnt = spans_intersect(spans, span_cnt, mask_spans, mask_span_cnt, tmp_spans);
+        lv_memcpy(spans, tmp_spans, span_cnt * sizeof(lv_draw_sw_mask_span_t));
+        if(span_cnt == 1 && spans[0].type == LV_DRAW_SW_MASK_SPAN_TRANSP) {
+            lv_memzero(mask_buf, len);
+            return span_cnt;
+        }
+    }
+
+    /*Calculate the opacity only where it's not known from the spans*/
+    int32_t start = 0;
+    for(i = 0; i < span_cnt; i++) {
+        int32_t span_len = spans[i].end - start;
+        if(spans[i].type == LV_DRAW_SW_MASK_SPAN_PARTIAL) {
+            lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(masks, &mask_buf[start], abs_x + start, abs_y, span_len);
+            if(res == LV_DRAW_SW_MASK_RES_TRANSP) spans[i].type = LV_DRAW_SW_MASK_SPAN_TRANSP;
+            else if(res == LV_DRAW_SW_MASK_RES_FULL_COVER) spans[i].type = LV_DRAW_SW_MASK_SPAN_COVER;
+        }
+
+        if(spans[i].type == LV_DRAW_SW_MASK_SPAN_TRANSP) lv_memzero(&mask_buf[start], span_len);
+        start = spans[i].end;
+    }
+
+    return span_cnt;
+}
+
 /**
  * Free the data from the parameter.
  * It's called inside `lv_draw_mask_remove_id` and `lv_draw_mask_remove_custom`
@@ -115,33 +209,21 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
  */
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     _lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
+            /*Only this mask knows about the temporary circles*/
+            if(radius_p->circle->temporary) {
+                circle_free(radius_p->circle);
             }
             else {
+                lv_mutex_lock(&circle_cache_mutex);
                 radius_p->circle->used_cnt--;
+                lv_mutex_unlock(&circle_cache_mutex);
             }
         }
     }
-
-    lv_mutex_unlock(&circle_cache_mutex);
-}
-
-void _lv_draw_sw_mask_cleanup(void)
-{
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
-        }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
-    }
 }
 
 /**
@@ -186,6 +268,7 @@ void lv_draw_sw_mask_line_points_init(lv_draw_sw_mask_line_param_t * param, int3
     param->yx_steep = 0;
     param->xy_steep = 0;
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_line;
+    param->dsc.span_cb = NULL;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_LINE;
 
     int32_t dx = p2x - p1x;
@@ -301,6 +384,7 @@ void lv_draw_sw_mask_angle_init(lv_draw_sw_mask_angle_param_t * param, int32_t v
     param->cfg.end_angle = end_angle;
     lv_point_set(&param->cfg.vertex_p, vertex_x, vertex_y);
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_angle;
+    param->dsc.span_cb = NULL;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_ANGLE;
 
     LV_ASSERT_MSG(start_angle >= 0 && start_angle <= 360, "Unexpected start angle");
@@ -346,6 +430,7 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
     param->cfg.radius = radius;
     param->cfg.outer = inv ? 1 : 0;
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_radius;
+    param->dsc.span_cb = (lv_draw_sw_mask_span_xcb_t)lv_draw_mask_radius_spans;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_RADIUS;
 
     if(radius == 0) {
@@ -353,47 +438,7 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
-            return;
-        }
-    }
-
-    /*If not cached use the free entry with lowest life*/
-    _lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
-
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
-
+    param->circle = circle_cache_get(radius);
 }
 
 /**
@@ -415,6 +460,7 @@ void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_ar
     param->cfg.y_top = y_top;
     param->cfg.y_bottom = y_bottom;
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_fade;
+    param->dsc.span_cb = (lv_draw_sw_mask_span_xcb_t)lv_draw_mask_fade_spans;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_FADE;
 }
 
@@ -429,6 +475,7 @@ void lv_draw_sw_mask_map_init(lv_draw_sw_mask_map_param_t * param, const lv_area
     lv_area_copy(&param->cfg.coords, coords);
     param->cfg.map = map;
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_map;
+    param->dsc.span_cb = NULL;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_MAP;
 }
 
@@ -1004,6 +1051,70 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_radius(lv_opa_t
     return LV_DRAW_SW_MASK_RES_CHANGED;
 }
 
+/**
+ * The spans follow the pixels touched by `lv_draw_mask_radius`:
+ * the anti-aliased pixels of the circle are partial, the rest are either cleared or left unchanged.
+ */
+LV_ATTRIBUTE_FAST_MEM static uint32_t lv_draw_mask_radius_spans(lv_draw_sw_mask_span_t * spans, int32_t abs_x,
+                                                                 int32_t abs_y, int32_t len,
+                                                                 lv_draw_sw_mask_radius_param_t * p)
+{
+    lv_draw_sw_mask_span_type_t in_type = p->cfg.outer ? LV_DRAW_SW_MASK_SPAN_TRANSP : LV_DRAW_SW_MASK_SPAN_COVER;
+    lv_draw_sw_mask_span_type_t out_type = p->cfg.outer ? LV_DRAW_SW_MASK_SPAN_COVER : LV_DRAW_SW_MASK_SPAN_TRANSP;
+    int32_t radius = p->cfg.radius;
+    const lv_area_t * rect = &p->cfg.rect;
+    uint32_t span_cnt = 0;
+
+    if(abs_y < rect->y1 || abs_y > rect->y2) {
+        span_add(spans, &span_cnt, len, out_type, len);
+        return span_cnt;
+    }
+
+    /*Between the corners only the sides of the rectangle matter*/
+    if(abs_y >= rect->y1 + radius && abs_y <= rect->y2 - radius) {
+        span_add(spans, &span_cnt, rect->x1 - abs_x, out_type, len);
+        span_add(spans, &span_cnt, rect->x2 - abs_x + 1, in_type, len);
+        span_add(spans, &span_cnt, len, out_type, len);
+        return span_cnt;
+    }
+
+    int32_t k = rect->x1 - abs_x;
+    int32_t w = lv_area_get_width(rect);
+    int32_t h = lv_area_get_height(rect);
+    int32_t cir_y = abs_y - rect->y1;
+    if(cir_y < radius) cir_y = radius - cir_y - 1;
+    else cir_y = cir_y - (h - radius);
+
+    int32_t aa_len;
+    int32_t x_start;
+    get_next_line(p->circle, cir_y, &aa_len, &x_start);
+    int32_t cir_x_right = k + w - radius + x_start;
+    int32_t cir_x_left = k + radius - x_start - 1;
+
+    span_add(spans, &span_cnt, cir_x_left - aa_len + 1, out_type, len);
+    span_add(spans, &span_cnt, cir_x_left + 1, LV_DRAW_SW_MASK_SPAN_PARTIAL, len);
+    span_add(spans, &span_cnt, cir_x_right, in_type, len);
+    span_add(spans, &span_cnt, cir_x_right + aa_len, LV_DRAW_SW_MASK_SPAN_PARTIAL, len);
+    span_add(spans, &span_cnt, len, out_type, len);
+    return span_cnt;
+}
+
+LV_ATTRIBUTE_FAST_MEM static uint32_t lv_draw_mask_fade_spans(lv_draw_sw_mask_span_t * spans, int32_t abs_x,
+                                                               int32_t abs_y, int32_t len,
+                                                               lv_draw_sw_mask_fade_param_t * p)
+{
+    uint32_t span_cnt = 0;
+    if(abs_y < p->cfg.coords.y1 || abs_y > p->cfg.coords.y2) {
+        span_add(spans, &span_cnt, len, LV_DRAW_SW_MASK_SPAN_COVER, len);
+        return span_cnt;
+    }
+
+    span_add(spans, &span_cnt, p->cfg.coords.x1 - abs_x, LV_DRAW_SW_MASK_SPAN_COVER, len);
+    span_add(spans, &span_cnt, p->cfg.coords.x2 - abs_x + 1, LV_DRAW_SW_MASK_SPAN_PARTIAL, len);
+    span_add(spans, &span_cnt, len, LV_DRAW_SW_MASK_SPAN_COVER, len);
+    return span_cnt;
+}
+
 LV_ATTRIBUTE_FAST_MEM static lv_draw_sw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, int32_t abs_x,
                                                                      int32_t abs_y, int32_t len,
                                                                      lv_draw_sw_mask_fade_param_t * p)
@@ -1133,7 +1244,7 @@ static void circ_calc_aa4(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radi
     /*Allocate buffers*/
     if(c->buf) lv_free(c->buf);
 
-    c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_malloc(CIRCLE_BUF_SIZE(radius));
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1282,6 +1393,133 @@ static lv_opa_t * get_next_line(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_
     return &c->cir_opa[c->opa_start_on_y[y]];
 }
 
+/**
+ * Get the circle of a radius from the cache or calculate it.
+ * The circle is referenced until `lv_draw_sw_mask_free_param` is called.
+ */
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius)
+{
+    lv_mutex_lock(&circle_cache_mutex);
+    _lv_draw_sw_mask_radius_circle_dsc_t * circle = circle_cache_find(radius);
+    if(circle) _circle_cache.stat.hit_cnt++;
+    else _circle_cache.stat.miss_cnt++;
+    lv_mutex_unlock(&circle_cache_mutex);
+
+    if(circle) return circle;
+
+    /*Calculate the circle without locking so that the other draw units can use the cache meanwhile*/
+    circle = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(circle);
+    circ_calc_aa4(circle, radius);
+    circle->used_cnt = 1;
+
+    lv_mutex_lock(&circle_cache_mutex);
+
+    /*Another draw unit might have added the same circle in the meantime*/
+    _lv_draw_sw_mask_radius_circle_dsc_t * cached = circle_cache_find(radius);
+    if(cached == NULL && circle_cache_add(circle) == false) {
+        circle->temporary = 1;
+        _circle_cache.stat.temporary_cnt++;
+    }
+
+    lv_mutex_unlock(&circle_cache_mutex);
+
+    if(cached) {
+        circle_free(circle);
+        return cached;
+    }
+
+    return circle;
+}
+
+/**
+ * Find a circle in the cache and reference it. The mutex needs to be locked.
+ */
+static _lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_find(int32_t radius)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        _lv_draw_sw_mask_radius_circle_dsc_t * circle = _circle_cache.entries[i];
+        if(circle && circle->radius == radius) {
+            circle->used_cnt++;
+            circle->last_used = ++_circle_cache.access_cnt;
+            return circle;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a circle to the cache. The mutex needs to be locked.
+ * @return  false: the circle doesn't fit as the cache is full with circles in use
+ */
+static bool circle_cache_add(_lv_draw_sw_mask_radius_circle_dsc_t * circle)
+{
+    uint32_t size = CIRCLE_BUF_SIZE(circle->radius);
+
+#if LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE
+    if(size > LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE) return false;
+
+    while(_circle_cache.stat.mem_size + size > LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE) {
+        if(circle_cache_drop_lru() < 0) return false;
+    }
+#endif
+
+    int32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(_circle_cache.entries[i] == NULL) break;
+    }
+
+    if(i == LV_DRAW_SW_CIRCLE_CACHE_SIZE) {
+        i = circle_cache_drop_lru();
+        if(i < 0) return false;
+    }
+
+    circle->last_used = ++_circle_cache.access_cnt;
+    _circle_cache.entries[i] = circle;
+    _circle_cache.stat.entry_cnt++;
+    _circle_cache.stat.mem_size += size;
+
+    return true;
+}
+
+/**
+ * Free the least recently used circle which is not used by any masks. The mutex needs to be locked.
+ * @return  index of the freed entry or -1 if all circles are in use
+ */
+static int32_t circle_cache_drop_lru(void)
+{
+    int32_t lru = -1;
+    int32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        _lv_draw_sw_mask_radius_circle_dsc_t * circle = _circle_cache.entries[i];
+        if(circle == NULL || circle->used_cnt) continue;
+
+        /*Compare the age instead of `last_used` to handle the overflow of the access counter*/
+        if(lru < 0 || _circle_cache.access_cnt - circle->last_used >
+           _circle_cache.access_cnt - _circle_cache.entries[lru]->last_used) {
+            lru = i;
+        }
+    }
+
+    if(lru < 0) return -1;
+
+    _circle_cache.stat.entry_cnt--;
+    _circle_cache.stat.mem_size -= CIRCLE_BUF_SIZE(_circle_cache.entries[lru]->radius);
+    _circle_cache.stat.evict_cnt++;
+    circle_free(_circle_cache.entries[lru]);
+    _circle_cache.entries[lru] = NULL;
+
+    return lru;
+}
+
+static void circle_free(_lv_draw_sw_mask_radius_circle_dsc_t * circle)
+{
+    lv_free(circle->buf);
+    lv_free(circle);
+}
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
     if(mask_new >= LV_OPA_MAX) return mask_act;
@@ -1290,4 +1528,69 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+/**
+ * Append a span ending at `end`. The end is clamped to the line and
+ * empty spans are skipped while the spans of the same type are merged.
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void span_add(lv_draw_sw_mask_span_t * spans, uint32_t * span_cnt, int32_t end,
+                                                  lv_draw_sw_mask_span_type_t type, int32_t len)
+{
+    int32_t start = *span_cnt ? spans[*span_cnt - 1].end : 0;
+    if(end > len) end = len;
+    if(end <= start) return;
+
+    if(*span_cnt && spans[*span_cnt - 1].type == type) {
+        spans[*span_cnt - 1].end = end;
+    }
+    else {
+        spans[*span_cnt].end = end;
+        spans[*span_cnt].type = type;
+        (*span_cnt)++;
+    }
+}
+
+/**
+ * Intersect two span lists of the same line.
+ * If there are too many spans the last one is extended as partial which is always correct.
+ */
+LV_ATTRIBUTE_FAST_MEM static uint32_t spans_intersect(const lv_draw_sw_mask_span_t * a, uint32_t a_cnt,
+                                                      const lv_draw_sw_mask_span_t * b, uint32_t b_cnt,
+                                                      lv_draw_sw_mask_span_t * res)
+{
+    uint32_t res_cnt = 0;
+    uint32_t a_i = 0;
+    uint32_t b_i = 0;
+    while(a_i < a_cnt && b_i < b_cnt) {
+        lv_draw_sw_mask_span_type_t type;
+        if(a[a_i].type == LV_DRAW_SW_MASK_SPAN_TRANSP || b[b_i].type == LV_DRAW_SW_MASK_SPAN_TRANSP) {
+            type = LV_DRAW_SW_MASK_SPAN_TRANSP;
+        }
+        else if(a[a_i].type == LV_DRAW_SW_MASK_SPAN_COVER && b[b_i].type == LV_DRAW_SW_MASK_SPAN_COVER) {
+            type = LV_DRAW_SW_MASK_SPAN_COVER;
+        }
+        else {
+            type = LV_DRAW_SW_MASK_SPAN_PARTIAL;
+        }
+
+        int32_t end = LV_MIN(a[a_i].end, b[b_i].end);
+        if(res_cnt && res[res_cnt - 1].type == type) {
+            res[res_cnt - 1].end = end;
+        }
+        else if(res_cnt < LV_DRAW_SW_MASK_SPAN_MAX) {
+            res[res_cnt].end = end;
+            res[res_cnt].type = type;
+            res_cnt++;
+        }
+        else {
+            res[res_cnt - 1].end = end;
+            res[res_cnt - 1].type = LV_DRAW_SW_MASK_SPAN_PARTIAL;
+        }
+
+        if(a[a_i].end == end) a_i++;
+        if(b[b_i].end == end) b_i++;
+    }
+
+    return res_cnt;
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
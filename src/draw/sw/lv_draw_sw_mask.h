@@ -28,6 +28,9 @@ extern "C" {
 # define _LV_MASK_MAX_NUM     1
 #endif
 
+/*Maximal number of spans a line of masks can be described with*/
+#define LV_DRAW_SW_MASK_SPAN_MAX    16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -41,6 +44,23 @@ enum {
 
 typedef uint8_t lv_draw_sw_mask_res_t;
 
+enum {
+    LV_DRAW_SW_MASK_SPAN_TRANSP,        /**< All pixels of the span are transparent*/
+    LV_DRAW_SW_MASK_SPAN_COVER,         /**< All pixels of the span are fully covered*/
+    LV_DRAW_SW_MASK_SPAN_PARTIAL,       /**< The pixels can have any opacity, see the mask buffer*/
+};
+
+typedef uint8_t lv_draw_sw_mask_span_type_t;
+
+/**
+ * A run of pixels with the same kind of coverage in a line.
+ * The spans of a line follow each other so only the end of the span is stored.
+ */
+typedef struct {
+    int32_t end;                        /**< The first pixel after the span relative to the start of the line*/
+    lv_draw_sw_mask_span_type_t type;
+} lv_draw_sw_mask_span_t;
+
 #if LV_DRAW_SW_COMPLEX
 
 enum {
@@ -68,10 +88,20 @@ typedef lv_draw_sw_mask_res_t (*lv_draw_sw_mask_xcb_t)(lv_opa_t * mask_buf, int3
                                                        int32_t len,
                                                        void * p);
 
+/**
+ * Describe a line of a mask with spans without calculating the opacity of the pixels.
+ * The spans have to cover `len` pixels. Where unsure, `LV_DRAW_SW_MASK_SPAN_PARTIAL` should be used.
+ * Used internally by the library.
+ * @return the number of spans written to `spans`
+ */
+typedef uint32_t (*lv_draw_sw_mask_span_xcb_t)(lv_draw_sw_mask_span_t * spans, int32_t abs_x, int32_t abs_y,
+                                               int32_t len, void * p);
+
 typedef uint8_t lv_draw_sw_mask_line_side_t;
 
 typedef struct {
     lv_draw_sw_mask_xcb_t cb;
+    lv_draw_sw_mask_span_xcb_t span_cb;     /**< Optional, NULL if the mask can't tell the spans*/
     lv_draw_sw_mask_type_t type;
 } _lv_draw_sw_mask_common_dsc_t;
 
@@ -133,12 +163,28 @@ typedef struct  {
     lv_opa_t * cir_opa;         /*Opacity of values on the circumference of an 1/4 circle*/
     uint16_t * x_start_on_y;        /*The x coordinate of the circle for each y value*/
     uint16_t * opa_start_on_y;      /*The index of `cir_opa` for each y value*/
-    int32_t life;               /*How many times the entry way used*/
+    uint32_t last_used;         /*Value of the cache's access counter when the entry was used the last time*/
     uint32_t used_cnt;          /*Like a semaphore to count the referencing masks*/
     int32_t radius;          /*The radius of the entry*/
+    uint8_t temporary : 1;      /*Not in the cache, free it when it's not used anymore*/
 } _lv_draw_sw_mask_radius_circle_dsc_t;
 
-typedef _lv_draw_sw_mask_radius_circle_dsc_t _lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of radius masks which found their circle in the cache*/
+    uint32_t miss_cnt;          /**< Number of radius masks which needed to calculate their circle*/
+    uint32_t evict_cnt;         /**< Number of circles dropped from the cache*/
+    uint32_t temporary_cnt;     /**< Number of circles which couldn't be cached as all entries were in use*/
+    uint32_t entry_cnt;         /**< Number of the cached circles*/
+    uint32_t mem_size;          /**< Memory used by the cached circles [bytes]*/
+} lv_draw_sw_mask_circle_cache_stat_t;
+
+typedef struct {
+    /*The circles are read without locking while a mask references them, so they are
+     *never changed after they are added, only freed when they are not used anymore*/
+    _lv_draw_sw_mask_radius_circle_dsc_t * entries[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
+    uint32_t access_cnt;
+    lv_draw_sw_mask_circle_cache_stat_t stat;
+} _lv_draw_sw_mask_circle_cache_t;
 
 typedef struct {
     /*The first element must be the common descriptor*/
@@ -186,6 +232,17 @@ void lv_draw_sw_mask_init(void);
 
 void lv_draw_sw_mask_deinit(void);
 
+/**
+ * Get the statistics of the cache of the anti-aliased circles used by the radius masks
+ * @param stat      store the statistics here
+ */
+void lv_draw_sw_mask_circle_cache_get_stat(lv_draw_sw_mask_circle_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss, evict and temporary counters of the circle cache
+ */
+void lv_draw_sw_mask_circle_cache_reset_stat(void);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -204,6 +261,23 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
                                                                   int32_t abs_y,
                                                                   int32_t len);
 
+/**
+ * Apply the added masks on a line like `lv_draw_sw_mask_apply` but describe the result with spans.
+ * The masks tell which parts of the line are transparent or fully covered and
+ * the opacity is calculated only for the rest of the pixels.
+ * @param masks the masks list to apply, must be ended with NULL pointer in array.
+ * @param mask_buf store the result mask here. Has to be `len` byte long and initialized like for
+ *                 `lv_draw_sw_mask_apply`. The partial spans are calculated, the transparent spans are
+ *                 cleared and the covered spans are not changed.
+ * @param abs_x absolute X coordinate where the line to calculate start
+ * @param abs_y absolute Y coordinate where the line to calculate start
+ * @param len length of the line to calculate (in pixel count)
+ * @param spans store the spans here. Has to be `LV_DRAW_SW_MASK_SPAN_MAX` long.
+ * @return the number of spans
+ */
+LV_ATTRIBUTE_FAST_MEM uint32_t lv_draw_sw_mask_apply_spans(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
+                                                           int32_t abs_y, int32_t len, lv_draw_sw_mask_span_t * spans);
+
 //! @endcond
 
 /**
@@ -216,8 +290,8 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_res_t lv_draw_sw_mask_apply(void * masks[]
 void lv_draw_sw_mask_free_param(void * p);
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Free the cached circles which are not used by any masks.
+ * The cache is kept between the refreshes so it's needed only to release memory.
  */
 void _lv_draw_sw_mask_cleanup(void);
 
@@ -14,24 +14,30 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_color.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/*Number of source columns mixed at once by `transform_argb8888_scale`*/
+#define TRANSFORM_COL_BUF_SIZE  64
+
 /**********************
  *      TYPEDEFS
  **********************/
+
+/**
+ * The transformation as a linear map of the input coordinates (relative to the pivot).
+ * The upscaled output is `(acc >> shift) + ofs` where `acc` is e.g. `x_by_x * xin + x_by_y * yin`.
+ * This way a row can be moved down by simply adding `x_by_y` and `y_by_y` to the accumulators.
+ */
 typedef struct {
-    int32_t x_in;
-    int32_t y_in;
-    int32_t x_out;
-    int32_t y_out;
-    int32_t sinma;
-    int32_t cosma;
-    int32_t scale_x;
-    int32_t scale_y;
-    int32_t angle;
+    int32_t x_by_x;
+    int32_t x_by_y;
+    int32_t y_by_x;
+    int32_t y_by_y;
+    int32_t shift;
     int32_t pivot_x_256;
     int32_t pivot_y_256;
     lv_point_t pivot;
@@ -40,32 +46,65 @@ typedef struct {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void point_transform_init(point_transform_dsc_t * t, const lv_draw_image_dsc_t * draw_dsc);
+
 /**
- * Transform a point with 1/256 precision (the output coordinates are upscaled by 256)
- * @param t         pointer to n initialized `point_transform_dsc_t` structure
- * @param xin       X coordinate to rotate
- * @param yin       Y coordinate to rotate
- * @param xout      upscaled, transformed X
- * @param yout      upscaled, transformed Y
+ * Get the accumulators of a point for `point_transform_dsc_t`
+ * @param t         pointer to an initialized `point_transform_dsc_t` structure
+ * @param xin       X coordinate to transform
+ * @param yin       Y coordinate to transform
+ * @param x_acc     X accumulator
+ * @param y_acc     Y accumulator
  */
-static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
-                                     int32_t * yout);
+static void point_transform_acc(const point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * x_acc,
+                                int32_t * y_acc);
+
+static void get_interior_span(int32_t src_w, int32_t src_h, int32_t xs_ups, int32_t ys_ups, int32_t xs_step,
+                              int32_t ys_step, int32_t x_end, int32_t * span_start, int32_t * span_end);
 
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa);
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+
+static void transform_argb8888_premultiplied(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa);
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
+
+static void transform_nearest(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                              int32_t x_start, int32_t x_end, lv_color_format_t src_cf, void * dest_buf, uint8_t * abuf);
+
+static void transform_rgb888_interior(const uint8_t * src, int32_t src_stride,
+                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                      int32_t x_start, int32_t x_end, uint8_t * dest_buf, uint32_t px_size);
+
+static void transform_argb8888_interior(const uint8_t * src, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint8_t * dest_buf);
+
+static void transform_argb8888_scale(const uint8_t * src, int32_t src_stride,
+                                     int32_t xs_ups, int32_t ys_ups, int32_t xs_step,
+                                     int32_t x_start, int32_t x_end, uint8_t * dest_buf);
+
+static void transform_rgb565a8_interior(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8);
+
+static void transform_a8_interior(const uint8_t * src, int32_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, uint8_t * abuf);
 
 /**********************
  *  STATIC VARIABLES
@@ -87,27 +126,7 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     LV_UNUSED(sup);
 
     point_transform_dsc_t tr_dsc;
-    tr_dsc.angle = -draw_dsc->rotation;
-    tr_dsc.scale_x = (256 * 256) / draw_dsc->scale_x;
-    tr_dsc.scale_y = (256 * 256) / draw_dsc->scale_y;
-    tr_dsc.pivot = draw_dsc->pivot;
-
-    int32_t angle_low = tr_dsc.angle / 10;
-    int32_t angle_high = angle_low + 1;
-    int32_t angle_rem = tr_dsc.angle  - (angle_low * 10);
-
-    int32_t s1 = lv_trigo_sin(angle_low);
-    int32_t s2 = lv_trigo_sin(angle_high);
-
-    int32_t c1 = lv_trigo_sin(angle_low + 90);
-    int32_t c2 = lv_trigo_sin(angle_high + 90);
-
-    tr_dsc.sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
-    tr_dsc.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
-    tr_dsc.sinma = tr_dsc.sinma >> (LV_TRIGO_SHIFT - 10);
-    tr_dsc.cosma = tr_dsc.cosma >> (LV_TRIGO_SHIFT - 10);
-    tr_dsc.pivot_x_256 = tr_dsc.pivot.x * 256;
-    tr_dsc.pivot_y_256 = tr_dsc.pivot.y * 256;
+    point_transform_init(&tr_dsc, draw_dsc);
 
     int32_t dest_w = lv_area_get_width(dest_area);
     int32_t dest_h = lv_area_get_height(dest_area);
@@ -135,12 +154,55 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
 
     bool aa = draw_dsc->antialias;
 
+    /*Use the sampler selected for the CPU if there is any*/
+    const lv_draw_sw_dispatch_t * d = lv_draw_sw_get_dispatch();
+    lv_draw_sw_transform_kernel_t kernel;
+    switch(src_cf) {
+        case LV_COLOR_FORMAT_XRGB8888:
+            kernel = d->transform_xrgb8888;
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            kernel = d->transform_rgb888;
+            break;
+        case LV_COLOR_FORMAT_A8:
+            kernel = d->transform_a8;
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+            kernel = d->transform_argb8888;
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+            kernel = d->transform_rgb565;
+            break;
+        case LV_COLOR_FORMAT_RGB565A8:
+            kernel = d->transform_rgb565a8;
+            break;
+        default:
+            kernel = NULL;
+            break;
+    }
+
+    /*Without rotation the vertical neighbors can be mixed once per source column.
+     *It's worth it only when upscaling as then a column is used by multiple destination pixels.
+     *The accelerated samplers are faster even in this case.*/
+    bool mix_cols = aa && kernel == NULL && src_cf == LV_COLOR_FORMAT_ARGB8888 && draw_dsc->rotation == 0 &&
+                    draw_dsc->scale_x > LV_SCALE_NONE;
+
+    /*The first and last pixels of the first row. They are moved down by one for each row.*/
+    int32_t x1_acc, y1_acc, x2_acc, y2_acc;
+    point_transform_acc(&tr_dsc, dest_area->x1, dest_area->y1, &x1_acc, &y1_acc);
+    point_transform_acc(&tr_dsc, dest_area->x2, dest_area->y1, &x2_acc, &y2_acc);
+
     int32_t y;
     for(y = 0; y < dest_h; y++) {
-        int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
+        int32_t xs1_ups = (x1_acc >> tr_dsc.shift) + tr_dsc.pivot_x_256;
+        int32_t ys1_ups = (y1_acc >> tr_dsc.shift) + tr_dsc.pivot_y_256;
+        int32_t xs2_ups = (x2_acc >> tr_dsc.shift) + tr_dsc.pivot_x_256;
+        int32_t ys2_ups = (y2_acc >> tr_dsc.shift) + tr_dsc.pivot_y_256;
 
-        transform_point_upscaled(&tr_dsc, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
-        transform_point_upscaled(&tr_dsc, dest_area->x2, dest_area->y1 + y, &xs2_ups, &ys2_ups);
+        x1_acc += tr_dsc.x_by_y;
+        y1_acc += tr_dsc.y_by_y;
+        x2_acc += tr_dsc.x_by_y;
+        y2_acc += tr_dsc.y_by_y;
 
         int32_t xs_diff = xs2_ups - xs1_ups;
         int32_t ys_diff = ys2_ups - ys1_ups;
@@ -154,33 +216,100 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         int32_t xs_ups = xs1_ups + 0x80;
         int32_t ys_ups = ys1_ups + 0x80;
 
-        switch(src_cf) {
-            case LV_COLOR_FORMAT_XRGB8888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 4);
-                break;
-            case LV_COLOR_FORMAT_RGB888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 3);
-                break;
-            case LV_COLOR_FORMAT_A8:
-                transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
-                break;
-            case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
-                break;
-            case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
-                break;
-            case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
-                break;
-            default:
-                break;
+        /*The pixels in the span can be sampled without bounds checks.
+         *Only the pixels around the edges of the image need the general samplers.*/
+        int32_t span_start;
+        int32_t span_end;
+        get_interior_span(src_w, src_h, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, &span_start, &span_end);
+
+        int32_t edge_start[2] = {0, span_end};
+        int32_t edge_end[2] = {span_start, dest_w};
+        uint32_t i;
+        for(i = 0; i < 2; i++) {
+            int32_t x_start = edge_start[i];
+            int32_t x_end = edge_end[i];
+            if(x_start >= x_end) continue;
+
+            switch(src_cf) {
+                case LV_COLOR_FORMAT_XRGB8888:
+                    transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                     dest_buf, aa, 4);
+                    break;
+                case LV_COLOR_FORMAT_RGB888:
+                    transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                     dest_buf, aa, 3);
+                    break;
+                case LV_COLOR_FORMAT_A8:
+                    transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                 dest_buf, aa);
+                    break;
+                case LV_COLOR_FORMAT_ARGB8888:
+                    transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                       dest_buf, aa);
+                    break;
+                case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+                    transform_argb8888_premultiplied(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                                     x_start, x_end, dest_buf, aa);
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                    transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                       dest_buf, alpha_buf, false, aa);
+                    break;
+                case LV_COLOR_FORMAT_RGB565A8:
+                    transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                       (uint16_t *)dest_buf, alpha_buf, true, aa);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if(span_start < span_end) {
+            if(!aa) {
+                transform_nearest(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end,
+                                  src_cf, dest_buf, alpha_buf);
+            }
+            else if(kernel) {
+                kernel(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end, dest_buf,
+                       alpha_buf);
+            }
+            else if(mix_cols && ys_step_256 == 0) {
+                transform_argb8888_scale(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, span_start, span_end, dest_buf);
+            }
+            else {
+                switch(src_cf) {
+                    case LV_COLOR_FORMAT_XRGB8888:
+                        transform_rgb888_interior(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end,
+                                                  dest_buf, 4);
+                        break;
+                    case LV_COLOR_FORMAT_RGB888:
+                        transform_rgb888_interior(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end,
+                                                  dest_buf, 3);
+                        break;
+                    case LV_COLOR_FORMAT_A8:
+                        transform_a8_interior(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end,
+                                              dest_buf);
+                        break;
+                    case LV_COLOR_FORMAT_ARGB8888:
+                        transform_argb8888_interior(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start, span_end,
+                                                    dest_buf);
+                        break;
+                    case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
+                        transform_argb8888_premultiplied(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                                         span_start, span_end, dest_buf, aa);
+                        break;
+                    case LV_COLOR_FORMAT_RGB565:
+                        transform_rgb565a8_interior(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start,
+                                                    span_end, dest_buf, alpha_buf, false);
+                        break;
+                    case LV_COLOR_FORMAT_RGB565A8:
+                        transform_rgb565a8_interior(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, span_start,
+                                                    span_end, (uint16_t *)dest_buf, alpha_buf, true);
+                        break;
+                    default:
+                        break;
+                }
+            }
         }
 
         dest_buf = (uint8_t *)dest_buf + dest_stride;
@@ -192,16 +321,111 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the direction of the neighbor of a sample and how much it should be mixed in
+ * @param ups       upscaled coordinate of the sample
+ * @param next      -1 or 1, the direction of the neighbor
+ * @return          0x00..0x7F, the weight of the neighbor
+ */
+static inline int32_t get_neighbor(int32_t ups, int32_t * next)
+{
+    int32_t fract = ups & 0xFF;
+    if(fract < 0x80) {
+        *next = -1;
+        return 0x7F - fract;
+    }
+    else {
+        *next = 1;
+        return fract - 0x80;
+    }
+}
+
+/*Mix the horizontal or vertical neighbor into the sampled ARGB8888 pixel with the weight of `fract`*/
+static inline lv_color32_t mix_argb8888_neighbor(lv_color32_t c, lv_color32_t px, int32_t fract)
+{
+    if(px.alpha == 0) {
+        c.alpha = (c.alpha * (0xFF - fract)) >> 8;
+    }
+    else if(!lv_color32_eq(c, px)) {
+        c.alpha = ((px.alpha * fract) + (c.alpha * (0xFF - fract))) >> 8;
+        px.alpha = fract;
+        c = lv_color_mix32(px, c);
+    }
+
+    return c;
+}
+
+/*Mix the neighbor of a premultiplied pixel. All channels are mixed the same way, no need to care about the alpha.*/
+static inline lv_color32_t mix_premultiplied_neighbor(lv_color32_t c, lv_color32_t px, int32_t fract)
+{
+    if(fract == 0 || lv_color32_eq(c, px)) return c;
+
+    int32_t fract_inv = 0xFF - fract;
+    c.red = (px.red * fract + c.red * fract_inv) >> 8;
+    c.green = (px.green * fract + c.green * fract_inv) >> 8;
+    c.blue = (px.blue * fract + c.blue * fract_inv) >> 8;
+    c.alpha = (px.alpha * fract + c.alpha * fract_inv) >> 8;
+    return c;
+}
+
+/*Same as `mix_argb8888_neighbor` for opaque pixels*/
+static inline lv_color32_t mix_rgb888_neighbor(lv_color32_t c, lv_color32_t px, int32_t fract)
+{
+    if(!lv_color32_eq(c, px)) {
+        px.alpha = fract;
+        c = lv_color_mix32(px, c);
+    }
+
+    return c;
+}
+
+static inline lv_color32_t get_rgb888(const uint8_t * src_u8)
+{
+    lv_color32_t c;
+    c.red = src_u8[2];
+    c.green = src_u8[1];
+    c.blue = src_u8[0];
+    c.alpha = 0xff;
+    return c;
+}
+
+static inline bool is_interior(int32_t src_w, int32_t src_h, int32_t xs_ups, int32_t ys_ups, int32_t xs_step,
+                               int32_t ys_step, int32_t x)
+{
+    /*The neighbors are at +/-1 so the sample needs to be at least 1 pixel away from the edges*/
+    int32_t xs_int = (xs_ups + ((xs_step * x) >> 8)) >> 8;
+    int32_t ys_int = (ys_ups + ((ys_step * x) >> 8)) >> 8;
+    return xs_int >= 1 && xs_int <= src_w - 2 && ys_int >= 1 && ys_int <= src_h - 2;
+}
+
+static void get_interior_span(int32_t src_w, int32_t src_h, int32_t xs_ups, int32_t ys_ups, int32_t xs_step,
+                              int32_t ys_step, int32_t x_end, int32_t * span_start, int32_t * span_end)
+{
+    /*As the source coordinates change monotonically along the row the interior is a single span*/
+    int32_t x = 0;
+    while(x < x_end && !is_interior(src_w, src_h, xs_ups, ys_ups, xs_step, ys_step, x)) x++;
+    *span_start = x;
+
+    if(x == x_end) {
+        *span_end = x_end;
+        return;
+    }
+
+    x = x_end;
+    while(x > *span_start && !is_interior(src_w, src_h, xs_ups, ys_ups, xs_step, ys_step, x - 1)) x--;
+    *span_end = x;
+}
+
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -214,65 +438,25 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
             continue;
         }
 
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = 0x7F - xs_fract;
-        }
-        else {
-            x_next = 1;
-            xs_fract = xs_fract - 0x80;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = 0x7F - ys_fract;
-        }
-        else {
-            y_next = 1;
-            ys_fract = ys_fract - 0x80;
-        }
+        int32_t xs_fract = get_neighbor(xs_ups, &x_next);
+        int32_t ys_fract = get_neighbor(ys_ups, &y_next);
 
         const uint8_t * src_u8 = &src[ys_int * src_stride + xs_int * px_size];
 
-        dest_c32[x].red = src_u8[2];
-        dest_c32[x].green = src_u8[1];
-        dest_c32[x].blue = src_u8[0];
-        dest_c32[x].alpha = 0xff;
+        dest_c32[x] = get_rgb888(src_u8);
 
         if(aa &&
            xs_int + x_next >= 0 &&
            xs_int + x_next <= src_w - 1 &&
            ys_int + y_next >= 0 &&
            ys_int + y_next <= src_h - 1) {
-            const uint8_t * px_hor_u8 = src_u8 + (int32_t)(x_next * px_size);
-            lv_color32_t px_hor;
-            px_hor.red = px_hor_u8[2];
-            px_hor.green = px_hor_u8[1];
-            px_hor.blue = px_hor_u8[0];
-            px_hor.alpha = 0xff;
-
-            const uint8_t * px_ver_u8 = src_u8 + (int32_t)(y_next * src_stride);
-            lv_color32_t px_ver;
-            px_ver.red = px_ver_u8[2];
-            px_ver.green = px_ver_u8[1];
-            px_ver.blue = px_ver_u8[0];
-            px_ver.alpha = 0xff;
-
-            if(!lv_color32_eq(dest_c32[x], px_ver)) {
-                px_ver.alpha = ys_fract;
-                dest_c32[x] = lv_color_mix32(px_ver, dest_c32[x]);
-            }
+            lv_color32_t px_hor = get_rgb888(src_u8 + (int32_t)(x_next * px_size));
+            lv_color32_t px_ver = get_rgb888(src_u8 + (int32_t)(y_next * src_stride));
 
-            if(!lv_color32_eq(dest_c32[x], px_hor)) {
-                px_hor.alpha = xs_fract;
-                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
-            }
+            dest_c32[x] = mix_rgb888_neighbor(dest_c32[x], px_ver, ys_fract);
+            dest_c32[x] = mix_rgb888_neighbor(dest_c32[x], px_hor, xs_fract);
         }
         /*Partially out of the image*/
         else {
@@ -290,15 +474,14 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa)
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
-    //    lv_memzero(dest_buf, x_end * 4);
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -311,34 +494,12 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             continue;
         }
 
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = 0x7F - xs_fract;
-        }
-        else {
-            x_next = 1;
-            xs_fract = xs_fract - 0x80;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = 0x7F - ys_fract;
-        }
-        else {
-            y_next = 1;
-            ys_fract = ys_fract - 0x80;
-        }
+        int32_t xs_fract = get_neighbor(xs_ups, &x_next);
+        int32_t ys_fract = get_neighbor(ys_ups, &y_next);
 
-        const lv_color32_t * src_c32 = (const lv_color32_t *)src;
-        src_c32 += (ys_int * src_stride) + xs_int;
-
-        src_c32 = (const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
+        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
 
         dest_c32[x] = src_c32[0];
 
@@ -351,23 +512,8 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
             lv_color32_t px_hor = src_c32[x_next];
             lv_color32_t px_ver = *(const lv_color32_t *)((uint8_t *)src_c32 + y_next * src_stride);
 
-            if(px_ver.alpha == 0) {
-                dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - ys_fract)) >> 8;
-            }
-            else if(!lv_color32_eq(dest_c32[x], px_ver)) {
-                dest_c32[x].alpha = ((px_ver.alpha * ys_fract) + (dest_c32[x].alpha * (0xFF - ys_fract))) >> 8;
-                px_ver.alpha = ys_fract;
-                dest_c32[x] = lv_color_mix32(px_ver, dest_c32[x]);
-            }
-
-            if(px_hor.alpha == 0) {
-                dest_c32[x].alpha = (dest_c32[x].alpha * (0xFF - xs_fract)) >> 8;
-            }
-            else if(!lv_color32_eq(dest_c32[x], px_hor)) {
-                dest_c32[x].alpha = ((px_hor.alpha * xs_fract) + (dest_c32[x].alpha * (0xFF - xs_fract))) >> 8;
-                px_hor.alpha = xs_fract;
-                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
-            }
+            dest_c32[x] = mix_argb8888_neighbor(dest_c32[x], px_ver, ys_fract);
+            dest_c32[x] = mix_argb8888_neighbor(dest_c32[x], px_hor, xs_fract);
         }
         /*Partially out of the image*/
         else {
@@ -381,9 +527,57 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
     }
 }
 
+/**
+ * Bilinear sampler of premultiplied ARGB8888 images.
+ * The pixels around the image are transparent, i.e. all channels are 0, so the edges and the interior
+ * can be handled the same way.
+ */
+static void transform_argb8888_premultiplied(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    lv_color32_t transp = lv_color32_make(0, 0, 0, 0);
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
+        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
+            dest_c32[x] = transp;
+            continue;
+        }
+
+        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + ys_int * src_stride + xs_int * 4);
+        lv_color32_t c = src_c32[0];
+        if(aa) {
+            int32_t x_next;
+            int32_t y_next;
+            int32_t xs_fract = get_neighbor(xs, &x_next);
+            int32_t ys_fract = get_neighbor(ys, &y_next);
+
+            bool ver_in = ys_int + y_next >= 0 && ys_int + y_next < src_h;
+            bool hor_in = xs_int + x_next >= 0 && xs_int + x_next < src_w;
+            lv_color32_t px_ver = ver_in ? *(const lv_color32_t *)((const uint8_t *)src_c32 + y_next * src_stride) : transp;
+            lv_color32_t px_hor = hor_in ? src_c32[x_next] : transp;
+
+            c = mix_premultiplied_neighbor(c, px_ver, ys_fract);
+            c = mix_premultiplied_neighbor(c, px_hor, xs_fract);
+        }
+        dest_c32[x] = c;
+    }
+}
+
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
@@ -394,7 +588,7 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -407,29 +601,10 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
             continue;
         }
 
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
+        int32_t xs_fract = get_neighbor(xs_ups, &x_next) * 2;
+        int32_t ys_fract = get_neighbor(ys_ups, &y_next) * 2;
 
         const uint16_t * src_tmp_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
         cbuf[x] = src_tmp_u16[0];
@@ -485,19 +660,22 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
             else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
                 abuf[x] = (a * (0xFF - ys_fract)) >> 8;
             }
+            else {
+                abuf[x] = a;
+            }
         }
     }
 }
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa)
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -510,29 +688,10 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
             continue;
         }
 
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
         int32_t x_next;
         int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
+        int32_t xs_fract = get_neighbor(xs_ups, &x_next) * 2;
+        int32_t ys_fract = get_neighbor(ys_ups, &y_next) * 2;
 
         const uint8_t * src_tmp = src;
         src_tmp += ys_int * src_stride + xs_int;
@@ -563,30 +722,336 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
     }
 }
 
-static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
-                                     int32_t * yout)
+/*The interior samplers below step the source coordinates by adding `xs_step` and `ys_step` instead of multiplying.
+ *They are called only for the pixels returned by `get_interior_span`, so the neighbors are always in the image.*/
+
+static void transform_nearest(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                              int32_t x_start, int32_t x_end, lv_color_format_t src_cf, void * dest_buf, uint8_t * abuf)
 {
-    if(t->angle == 0 && t->scale_x == LV_SCALE_NONE && t->scale_y == LV_SCALE_NONE) {
-        *xout = xin * 256;
-        *yout = yin * 256;
-        return;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    int32_t x;
+
+#define NEAREST_LOOP(px_size, body) \
+    for(x = x_start; x < x_end; x++) { \
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8; \
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8; \
+        xs_acc += xs_step; \
+        ys_acc += ys_step; \
+        int32_t ofs = ys_int * src_stride + xs_int * (px_size); \
+        body \
     }
 
-    xin -= t->pivot.x;
-    yin -= t->pivot.y;
+    switch(src_cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED: {
+                uint32_t * dest_u32 = dest_buf;
+                NEAREST_LOOP(4, dest_u32[x] = *(const uint32_t *)(src + ofs););
+                break;
+            }
+        case LV_COLOR_FORMAT_XRGB8888: {
+                lv_color32_t * dest_c32 = dest_buf;
+                NEAREST_LOOP(4, dest_c32[x] = get_rgb888(src + ofs););
+                break;
+            }
+        case LV_COLOR_FORMAT_RGB888: {
+                lv_color32_t * dest_c32 = dest_buf;
+                NEAREST_LOOP(3, dest_c32[x] = get_rgb888(src + ofs););
+                break;
+            }
+        case LV_COLOR_FORMAT_RGB565: {
+                uint16_t * dest_u16 = dest_buf;
+                NEAREST_LOOP(2, dest_u16[x] = *(const uint16_t *)(src + ofs); abuf[x] = 0xff;);
+                break;
+            }
+        case LV_COLOR_FORMAT_RGB565A8: {
+                uint16_t * dest_u16 = dest_buf;
+                const lv_opa_t * src_alpha = src + src_stride * src_h;
+                int32_t alpha_stride = src_stride / 2;
+                NEAREST_LOOP(2, dest_u16[x] = *(const uint16_t *)(src + ofs);
+                             abuf[x] = src_alpha[ys_int * alpha_stride + xs_int];);
+                break;
+            }
+        case LV_COLOR_FORMAT_A8: {
+                uint8_t * dest_u8 = dest_buf;
+                NEAREST_LOOP(1, dest_u8[x] = src[ofs];);
+                break;
+            }
+        default:
+            break;
+    }
+
+#undef NEAREST_LOOP
+}
+
+static void transform_rgb888_interior(const uint8_t * src, int32_t src_stride,
+                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                      int32_t x_start, int32_t x_end, uint8_t * dest_buf, uint32_t px_size)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract = get_neighbor(xs, &x_next);
+        int32_t ys_fract = get_neighbor(ys, &y_next);
+
+        const uint8_t * src_u8 = src + (ys >> 8) * src_stride + (xs >> 8) * px_size;
+        lv_color32_t c = get_rgb888(src_u8);
+        c = mix_rgb888_neighbor(c, get_rgb888(src_u8 + y_next * src_stride), ys_fract);
+        c = mix_rgb888_neighbor(c, get_rgb888(src_u8 + x_next * (int32_t)px_size), xs_fract);
+        dest_c32[x] = c;
+    }
+}
+
+static void transform_argb8888_interior(const uint8_t * src, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint8_t * dest_buf)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract = get_neighbor(xs, &x_next);
+        int32_t ys_fract = get_neighbor(ys, &y_next);
+
+        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + (ys >> 8) * src_stride + (xs >> 8) * 4);
+        lv_color32_t px_ver = *(const lv_color32_t *)((const uint8_t *)src_c32 + y_next * src_stride);
+
+        lv_color32_t c = mix_argb8888_neighbor(src_c32[0], px_ver, ys_fract);
+        dest_c32[x] = mix_argb8888_neighbor(c, src_c32[x_next], xs_fract);
+    }
+}
+
+/**
+ * The ARGB8888 interior when the source Y is the same for the whole row, i.e. there is no rotation.
+ * The vertical neighbors are mixed once per source column into a small buffer
+ * and only the horizontal neighbors are mixed per destination pixel.
+ * The buffer holds `TRANSFORM_COL_BUF_SIZE` columns and is refilled when the samples leave it.
+ */
+static void transform_argb8888_scale(const uint8_t * src, int32_t src_stride,
+                                     int32_t xs_ups, int32_t ys_ups, int32_t xs_step,
+                                     int32_t x_start, int32_t x_end, uint8_t * dest_buf)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+    lv_color32_t col_buf[TRANSFORM_COL_BUF_SIZE];
+
+    int32_t y_next;
+    int32_t ys_fract = get_neighbor(ys_ups, &y_next);
+    const lv_color32_t * row = (const lv_color32_t *)(src + (ys_ups >> 8) * src_stride);
+    const lv_color32_t * row_ver = (const lv_color32_t *)((const uint8_t *)row + y_next * src_stride);
+
+    /*The range of the used source columns*/
+    int32_t col_first = (xs_ups + ((xs_step * x_start) >> 8)) >> 8;
+    int32_t col_last = (xs_ups + ((xs_step * (x_end - 1)) >> 8)) >> 8;
+    if(col_first > col_last) {
+        int32_t tmp = col_first;
+        col_first = col_last;
+        col_last = tmp;
+    }
+
+    /*The columns in `col_buf` are `buf_first..buf_last`. Start with an empty buffer.*/
+    int32_t buf_first = 0;
+    int32_t buf_last = -1;
+
+    int32_t xs_acc = xs_step * x_start;
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        xs_acc += xs_step;
 
-    if(t->angle == 0) {
-        *xout = ((int32_t)(xin * t->scale_x)) + (t->pivot_x_256);
-        *yout = ((int32_t)(yin * t->scale_y)) + (t->pivot_y_256);
+        int32_t x_next;
+        int32_t xs_fract = get_neighbor(xs, &x_next);
+        int32_t xs_int = xs >> 8;
+
+        if(xs_int < buf_first || xs_int > buf_last) {
+            /*Fill the buffer in the direction of the steps*/
+            if(xs_step >= 0) {
+                buf_first = xs_int;
+                buf_last = LV_MIN(xs_int + TRANSFORM_COL_BUF_SIZE - 1, col_last);
+            }
+            else {
+                buf_first = LV_MAX(xs_int - TRANSFORM_COL_BUF_SIZE + 1, col_first);
+                buf_last = xs_int;
+            }
+
+            int32_t col;
+            for(col = buf_first; col <= buf_last; col++) {
+                col_buf[col - buf_first] = mix_argb8888_neighbor(row[col], row_ver[col], ys_fract);
+            }
+        }
+
+        dest_c32[x] = mix_argb8888_neighbor(col_buf[xs_int - buf_first], row[xs_int + x_next], xs_fract);
+    }
+}
+
+static void transform_rgb565a8_interior(const uint8_t * src, int32_t src_h, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8)
+{
+    const lv_opa_t * src_alpha = src + src_stride * src_h;
+    int32_t alpha_stride = src_stride / 2;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract = get_neighbor(xs, &x_next) * 2;
+        int32_t ys_fract = get_neighbor(ys, &y_next) * 2;
+
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
+
+        if(src_has_a8) {
+            const lv_opa_t * src_alpha_tmp = src_alpha + (ys_int * alpha_stride) + xs_int;
+            lv_opa_t a = src_alpha_tmp[0];
+            lv_opa_t a_hor = src_alpha_tmp[x_next];
+            lv_opa_t a_ver = src_alpha_tmp[y_next * alpha_stride];
+
+            if(a_ver != a) a_ver = ((a_ver * ys_fract) + (a * (0x100 - ys_fract))) >> 8;
+            if(a_hor != a) a_hor = ((a_hor * xs_fract) + (a * (0x100 - xs_fract))) >> 8;
+            abuf[x] = (a_ver + a_hor) >> 1;
+        }
+        else {
+            abuf[x] = 0xff;
+        }
+
+        const uint16_t * src_tmp_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
+        uint16_t c = src_tmp_u16[0];
+        cbuf[x] = c;
+        if(abuf[x] == 0x00) continue;
+
+        uint16_t px_hor = src_tmp_u16[x_next];
+        uint16_t px_ver = *(const uint16_t *)((const uint8_t *)src_tmp_u16 + (y_next * src_stride));
+        if(c != px_ver || c != px_hor) {
+            uint16_t v = lv_color_16_16_mix(px_ver, c, ys_fract);
+            uint16_t h = lv_color_16_16_mix(px_hor, c, xs_fract);
+            cbuf[x] = lv_color_16_16_mix(h, v, LV_OPA_50);
+        }
+    }
+}
+
+static void transform_a8_interior(const uint8_t * src, int32_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, uint8_t * abuf)
+{
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + (xs_acc >> 8);
+        int32_t ys = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t x_next;
+        int32_t y_next;
+        int32_t xs_fract = get_neighbor(xs, &x_next) * 2;
+        int32_t ys_fract = get_neighbor(ys, &y_next) * 2;
+
+        const uint8_t * src_tmp = src + (ys >> 8) * src_stride + (xs >> 8);
+        lv_opa_t a = src_tmp[0];
+
+        /*Same weighting as in `transform_a8`*/
+        lv_opa_t a_ver = src_tmp[x_next];
+        lv_opa_t a_hor = src_tmp[y_next * src_stride];
+
+        if(a_ver != a) a_ver = ((a_ver * ys_fract) + (a * (0x100 - ys_fract))) >> 8;
+        if(a_hor != a) a_hor = ((a_hor * xs_fract) + (a * (0x100 - xs_fract))) >> 8;
+        abuf[x] = (a_ver + a_hor) >> 1;
+    }
+}
+
+static void point_transform_init(point_transform_dsc_t * t, const lv_draw_image_dsc_t * draw_dsc)
+{
+    int32_t angle = -draw_dsc->rotation;
+    int32_t scale_x = (256 * 256) / draw_dsc->scale_x;
+    int32_t scale_y = (256 * 256) / draw_dsc->scale_y;
+
+    int32_t angle_low = angle / 10;
+    int32_t angle_high = angle_low + 1;
+    int32_t angle_rem = angle  - (angle_low * 10);
+
+    int32_t s1 = lv_trigo_sin(angle_low);
+    int32_t s2 = lv_trigo_sin(angle_high);
+
+    int32_t c1 = lv_trigo_sin(angle_low + 90);
+    int32_t c2 = lv_trigo_sin(angle_high + 90);
+
+    int32_t sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
+    int32_t cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
+    sinma = sinma >> (LV_TRIGO_SHIFT - 10);
+    cosma = cosma >> (LV_TRIGO_SHIFT - 10);
+
+    t->pivot = draw_dsc->pivot;
+    t->pivot_x_256 = t->pivot.x * 256;
+    t->pivot_y_256 = t->pivot.y * 256;
+
+    if(angle == 0 && scale_x == LV_SCALE_NONE && scale_y == LV_SCALE_NONE) {
+        t->x_by_x = 256;
+        t->x_by_y = 0;
+        t->y_by_x = 0;
+        t->y_by_y = 256;
+        t->shift = 0;
     }
-    else if(t->scale_x == LV_SCALE_NONE && t->scale_y == LV_SCALE_NONE) {
-        *xout = ((t->cosma * xin - t->sinma * yin) >> 2) + (t->pivot_x_256);
-        *yout = ((t->sinma * xin + t->cosma * yin) >> 2) + (t->pivot_y_256);
+    else if(angle == 0) {
+        t->x_by_x = scale_x;
+        t->x_by_y = 0;
+        t->y_by_x = 0;
+        t->y_by_y = scale_y;
+        t->shift = 0;
+    }
+    else if(scale_x == LV_SCALE_NONE && scale_y == LV_SCALE_NONE) {
+        t->x_by_x = cosma;
+        t->x_by_y = -sinma;
+        t->y_by_x = sinma;
+        t->y_by_y = cosma;
+        t->shift = 2;
     }
     else {
-        *xout = (((t->cosma * xin - t->sinma * yin) * t->scale_x) >> 10) + (t->pivot_x_256);
-        *yout = (((t->sinma * xin + t->cosma * yin) * t->scale_y) >> 10) + (t->pivot_y_256);
+        t->x_by_x = cosma * scale_x;
+        t->x_by_y = -sinma * scale_x;
+        t->y_by_x = sinma * scale_y;
+        t->y_by_y = cosma * scale_y;
+        t->shift = 10;
     }
 }
 
+static void point_transform_acc(const point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * x_acc,
+                                int32_t * y_acc)
+{
+    xin -= t->pivot.x;
+    yin -= t->pivot.y;
+
+    /*The sum fits into 32 bit but the terms might not*/
+    *x_acc = (int32_t)((int64_t)t->x_by_x * xin + (int64_t)t->x_by_y * yin);
+    *y_acc = (int32_t)((int64_t)t->y_by_x * xin + (int64_t)t->y_by_y * yin);
+}
+
 #endif /*LV_USE_DRAW_SW*/
@@ -135,12 +135,23 @@ void lv_draw_sw_triangle(lv_draw_unit_t * draw_unit, const lv_draw_triangle_dsc_
 
     lv_grad_t * grad = lv_gradient_get(&dsc->bg_grad, lv_area_get_width(&tri_area), lv_area_get_height(&tri_area));
     lv_opa_t * grad_opa_map = NULL;
+    lv_color_t * grad_line_color = NULL;
     if(grad && grad_dir == LV_GRAD_DIR_HOR) {
         blend_dsc.src_area = &blend_area;
         blend_dsc.src_buf = grad->color_map + draw_area.x1 - tri_area.x1;
         grad_opa_map = grad->opa_map + draw_area.x1 - tri_area.x1;
         blend_dsc.src_color_format = LV_COLOR_FORMAT_RGB888;
     }
+    else if(grad && (grad_dir == LV_GRAD_DIR_RADIAL || grad_dir == LV_GRAD_DIR_CONICAL)) {
+        /*Calculate these gradients line by line*/
+        grad_line_color = lv_malloc(area_w * sizeof(lv_color_t));
+        LV_ASSERT_MALLOC(grad_line_color);
+        grad_opa_map = lv_malloc(area_w);
+        LV_ASSERT_MALLOC(grad_opa_map);
+        blend_dsc.src_area = &blend_area;
+        blend_dsc.src_buf = grad_line_color;
+        blend_dsc.src_color_format = LV_COLOR_FORMAT_RGB888;
+    }
 
     int32_t y;
     for(y = draw_area.y1; y <= draw_area.y2; y++) {
@@ -153,28 +164,34 @@ void lv_draw_sw_triangle(lv_draw_unit_t * draw_unit, const lv_draw_triangle_dsc_
             blend_dsc.opa = grad->opa_map[y - tri_area.y1];
             if(dsc->bg_opa < LV_OPA_MAX) blend_dsc.opa = LV_OPA_MIX2(blend_dsc.opa, dsc->bg_opa);
         }
-        else if(grad_dir == LV_GRAD_DIR_HOR) {
-            if(grad_opa_map) {
-                int32_t i;
-                if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_CHANGED) {
-                    blend_dsc.mask_buf = mask_buf;
-                    for(i = 0; i < area_w; i++) {
-                        if(grad_opa_map[i] < LV_OPA_MAX) mask_buf[i] = LV_OPA_MIX2(mask_buf[i], grad_opa_map[i]);
-                    }
-                }
-                else if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) {
-                    blend_dsc.mask_buf = grad_opa_map;
-                    blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
-                }
-                else if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_TRANSP) {
-                    continue;
+        else if(grad_opa_map) {
+            if(grad_line_color) {
+                lv_gradient_get_line(grad, &tri_area, draw_area.x1, y, area_w, grad_line_color, grad_opa_map);
+            }
+
+            int32_t i;
+            if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_CHANGED) {
+                blend_dsc.mask_buf = mask_buf;
+                for(i = 0; i < area_w; i++) {
+                    if(grad_opa_map[i] < LV_OPA_MAX) mask_buf[i] = LV_OPA_MIX2(mask_buf[i], grad_opa_map[i]);
                 }
             }
+            else if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) {
+                blend_dsc.mask_buf = grad_opa_map;
+                blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+            }
+            else if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_TRANSP) {
+                continue;
+            }
         }
         lv_draw_sw_blend(draw_unit, &blend_dsc);
     }
 
     lv_free(mask_buf);
+    if(grad_line_color) {
+        lv_free(grad_line_color);
+        lv_free(grad_opa_map);
+    }
     lv_draw_sw_mask_free_param(&mask_bottom);
     lv_draw_sw_mask_free_param(&mask_left);
     lv_draw_sw_mask_free_param(&mask_right);
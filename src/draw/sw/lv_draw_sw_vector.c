@@ -307,7 +307,7 @@ static void _set_paint_fill_pattern(Tvg_Paint * obj, Tvg_Canvas * canvas, const
     const lv_image_header_t * header = &decoder_dsc.header;
     lv_color_format_t cf = header->cf;
 
-    if(cf != LV_COLOR_FORMAT_ARGB8888) {
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED) {
         lv_image_decoder_close(&decoder_dsc);
         LV_LOG_ERROR("Not support image format");
         return;
@@ -92,6 +92,10 @@ lv_result_t lv_binfont_load(lv_font_t * font, const char * path)
     lv_memzero(font, sizeof(lv_font_t));
     if(lvgl_load_font(&file, font)) {
         result = LV_RESULT_OK;
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+        /*Without the tables the font still works, just slower*/
+        lv_font_fmt_txt_lookup_create(font);
+#endif
     }
     else {
         LV_LOG_WARN("Error loading font file: %s\n", path);
@@ -121,6 +125,13 @@ lv_result_t lv_binfont_load_from_buffer(lv_font_t * font, void * buffer, uint32_
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_font_glyph_cache_drop(font);
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+        lv_font_fmt_txt_lookup_delete(font);
+#endif
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+        lv_text_layout_cache_drop(font);
+#endif
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
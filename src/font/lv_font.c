@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
 #include "../misc/lv_text.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
@@ -124,6 +125,15 @@ void lv_font_set_kerning(lv_font_t * font, lv_font_kerning_t kerning)
     font->kerning = kerning;
 }
 
+void lv_font_glyph_cache_drop(const lv_font_t * font)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_drop(font);
+#else
+    LV_UNUSED(font);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -148,6 +148,14 @@ static inline int32_t lv_font_get_line_height(const lv_font_t * font)
  */
 void lv_font_set_kerning(lv_font_t * font, lv_font_kerning_t kerning);
 
+/**
+ * Free the cached glyph bitmaps of a font. Needs to be called before the font is freed or
+ * its memory is reused, else a new font at the same address could get the glyphs of this font.
+ * The font releasing functions (e.g. `lv_font_free`, `lv_tiny_ttf_destroy`) call it already.
+ * @param font    pointer to a font, or NULL to free the cached glyphs of all the fonts
+ */
+void lv_font_glyph_cache_drop(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
@@ -9,11 +9,14 @@
 #include "lv_font.h"
 #include "lv_font_fmt_txt.h"
 #include "../core/lv_global.h"
+#include "../draw/lv_draw_buf.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_types.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
+#include "../misc/lv_text.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +25,18 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #define glyph_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_glyph_cache
+
+    /*The bitmap is stored after the entry in the same allocation*/
+    #define GLYPH_ENTRY_HEADER_SIZE \
+        (((sizeof(_lv_font_fmt_txt_glyph_cache_entry_t) + LV_DRAW_BUF_ALIGN - 1) / LV_DRAW_BUF_ALIGN) * LV_DRAW_BUF_ALIGN)
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    #define lookup_registry LV_GLOBAL_DEFAULT()->font_fmt_txt_lookup
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -43,6 +58,25 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    static const uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t letter, bool count_stat);
+    static _lv_font_fmt_txt_glyph_cache_entry_t ** glyph_cache_bucket(const lv_font_t * font, uint32_t gid);
+    static bool glyph_cache_make_room(uint32_t mem_size);
+    static void glyph_cache_lru_unlink(_lv_font_fmt_txt_glyph_cache_entry_t * entry);
+    static void glyph_cache_lru_push(_lv_font_fmt_txt_glyph_cache_entry_t * entry);
+    static void glyph_cache_remove(_lv_font_fmt_txt_glyph_cache_entry_t * entry);
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    static _lv_font_fmt_txt_lookup_t * lookup_find(const lv_font_fmt_txt_dsc_t * fdsc);
+    static _lv_font_fmt_txt_lookup_t ** lookup_bucket(const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool lookup_set_glyph_id(_lv_font_fmt_txt_lookup_t * lookup, uint32_t letter, uint32_t gid);
+    static bool lookup_fill_cmap(_lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_cmap_t * cmap);
+    static bool lookup_fill_kern(_lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_kern_pair_t * kdsc);
+    static inline uint32_t lookup_kern_hash(uint32_t key, uint32_t mask);
+    static void lookup_free(_lv_font_fmt_txt_lookup_t * lookup);
+#endif /*LV_USE_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -213,6 +247,197 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+
+const uint8_t * lv_font_fmt_txt_glyph_cache_get(const lv_font_t * font, uint32_t unicode_letter)
+{
+    return glyph_cache_get(font, unicode_letter, true);
+}
+
+void lv_font_fmt_txt_glyph_cache_release(const uint8_t * bitmap)
+{
+    _lv_font_fmt_txt_glyph_cache_entry_t * entry = (_lv_font_fmt_txt_glyph_cache_entry_t *)(bitmap -
+                                                                                           GLYPH_ENTRY_HEADER_SIZE);
+    lv_mutex_lock(&glyph_cache.mutex);
+    LV_ASSERT(entry->used_cnt > 0);
+    entry->used_cnt--;
+    lv_mutex_unlock(&glyph_cache.mutex);
+}
+
+uint32_t lv_font_fmt_txt_glyph_cache_prewarm(const lv_font_t * font, const char * txt)
+{
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_text_encoded_next(txt, &i);
+
+        /*Find the font which really has the glyph*/
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) continue;
+        if(g.resolved_font == NULL || g.resolved_font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) continue;
+
+        const uint8_t * bitmap = glyph_cache_get(g.resolved_font, letter, false);
+        if(bitmap) {
+            lv_font_fmt_txt_glyph_cache_release(bitmap);
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font)
+{
+    lv_mutex_lock(&glyph_cache.mutex);
+    _lv_font_fmt_txt_glyph_cache_entry_t * entry = glyph_cache.lru_tail;
+    while(entry) {
+        _lv_font_fmt_txt_glyph_cache_entry_t * prev = entry->lru_prev;
+        if(entry->used_cnt == 0 && (font == NULL || entry->font == font)) {
+            glyph_cache_remove(entry);
+            glyph_cache.stat.evict_cnt++;
+        }
+        entry = prev;
+    }
+    lv_mutex_unlock(&glyph_cache.mutex);
+}
+
+void lv_font_fmt_txt_glyph_cache_get_stat(lv_font_fmt_txt_glyph_cache_stat_t * stat)
+{
+    lv_mutex_lock(&glyph_cache.mutex);
+    *stat = glyph_cache.stat;
+    lv_mutex_unlock(&glyph_cache.mutex);
+}
+
+void lv_font_fmt_txt_glyph_cache_reset_stat(void)
+{
+    lv_mutex_lock(&glyph_cache.mutex);
+    glyph_cache.stat.hit_cnt = 0;
+    glyph_cache.stat.miss_cnt = 0;
+    glyph_cache.stat.evict_cnt = 0;
+    lv_mutex_unlock(&glyph_cache.mutex);
+}
+
+void _lv_font_fmt_txt_glyph_cache_init(void)
+{
+    lv_memzero(&glyph_cache, sizeof(_lv_font_fmt_txt_glyph_cache_t));
+    lv_mutex_init(&glyph_cache.mutex);
+}
+
+void _lv_font_fmt_txt_glyph_cache_deinit(void)
+{
+    while(glyph_cache.lru_head) {
+        glyph_cache_remove(glyph_cache.lru_head);
+    }
+
+    lv_mutex_delete(&glyph_cache.mutex);
+    lv_memzero(&glyph_cache, sizeof(_lv_font_fmt_txt_glyph_cache_t));
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+
+lv_result_t lv_font_fmt_txt_lookup_create(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc == NULL) return LV_RESULT_INVALID;
+    if(lookup_find(fdsc)) return LV_RESULT_OK;
+
+    _lv_font_fmt_txt_lookup_t * lookup = lv_malloc_zeroed(sizeof(_lv_font_fmt_txt_lookup_t));
+    LV_ASSERT_MALLOC(lookup);
+    if(lookup == NULL) return LV_RESULT_INVALID;
+    lookup->fdsc = fdsc;
+    lookup->mem_size = sizeof(_lv_font_fmt_txt_lookup_t);
+
+    /*Find the pages above Latin-1 covered by the cmaps*/
+    uint32_t page_min = UINT32_MAX;
+    uint32_t page_max = 0;
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0) continue;
+        uint32_t last = cmap->range_start + cmap->range_length - 1;
+        if(last < 256) continue;
+        page_min = LV_MIN(page_min, LV_MAX(cmap->range_start, 256) >> 8);
+        page_max = LV_MAX(page_max, last >> 8);
+    }
+
+    bool ok = true;
+    if(page_min <= page_max) {
+        lookup->page_first = page_min;
+        lookup->page_cnt = page_max - page_min + 1;
+        lookup->pages = lv_malloc_zeroed(lookup->page_cnt * sizeof(uint16_t *));
+        lookup->mem_size += lookup->page_cnt * sizeof(uint16_t *);
+        ok = lookup->pages != NULL;
+    }
+
+    /*Go backward so that the first cmap wins if they overlap, like in get_glyph_dsc_id()*/
+    for(i = fdsc->cmap_num; ok && i > 0; i--) {
+        ok = lookup_fill_cmap(lookup, &fdsc->cmaps[i - 1]);
+    }
+
+    if(ok && fdsc->kern_dsc && fdsc->kern_classes == 0) {
+        ok = lookup_fill_kern(lookup, fdsc->kern_dsc);
+    }
+
+    if(!ok) {
+        LV_LOG_WARN("Couldn't create the lookup tables of the font");
+        lookup_free(lookup);
+        return LV_RESULT_INVALID;
+    }
+
+    _lv_font_fmt_txt_lookup_t ** bucket = lookup_bucket(fdsc);
+    lookup->next = *bucket;
+    *bucket = lookup;
+    lookup_registry.cnt++;
+
+    return LV_RESULT_OK;
+}
+
+void lv_font_fmt_txt_lookup_delete(const lv_font_t * font)
+{
+    if(font == NULL || font->dsc == NULL) return;
+
+    _lv_font_fmt_txt_lookup_t ** p = lookup_bucket(font->dsc);
+    while(*p) {
+        if((*p)->fdsc == font->dsc) {
+            _lv_font_fmt_txt_lookup_t * lookup = *p;
+            *p = lookup->next;
+            lookup_registry.cnt--;
+            lookup_free(lookup);
+            return;
+        }
+        p = &(*p)->next;
+    }
+}
+
+uint32_t lv_font_fmt_txt_lookup_get_mem_size(const lv_font_t * font)
+{
+    const _lv_font_fmt_txt_lookup_t * lookup = lookup_find(font->dsc);
+    return lookup ? lookup->mem_size : 0;
+}
+
+void _lv_font_fmt_txt_lookup_init(void)
+{
+    lv_memzero(&lookup_registry, sizeof(_lv_font_fmt_txt_lookup_registry_t));
+}
+
+void _lv_font_fmt_txt_lookup_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_LOOKUP_BUCKETS; i++) {
+        while(lookup_registry.buckets[i]) {
+            _lv_font_fmt_txt_lookup_t * lookup = lookup_registry.buckets[i];
+            lookup_registry.buckets[i] = lookup->next;
+            lookup_free(lookup);
+        }
+    }
+    lookup_registry.cnt = 0;
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_LOOKUP*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -223,6 +448,17 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    const _lv_font_fmt_txt_lookup_t * lookup = lookup_find(fdsc);
+    if(lookup) {
+        if(letter < 256) return lookup->latin1[letter];
+
+        uint32_t page = (letter >> 8) - lookup->page_first;
+        if(page >= lookup->page_cnt || lookup->pages[page] == NULL) return 0;
+        return lookup->pages[page][letter & 0xFF];
+    }
+#endif
+
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -275,6 +511,18 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+        const _lv_font_fmt_txt_lookup_t * lookup = lookup_find(fdsc);
+        if(lookup && lookup->kern_keys) {
+            uint32_t key = (gid_left << 16) | gid_right;
+            uint32_t h = lookup_kern_hash(key, lookup->kern_mask);
+            while(lookup->kern_keys[h]) {
+                if(lookup->kern_keys[h] == key) return lookup->kern_values[h];
+                h = (h + 1) & lookup->kern_mask;
+            }
+            return 0;
+        }
+#endif
         if(kdsc->glyph_ids_size == 0) {
             /*Use binary search to find the kern value.
              *The pairs are ordered left_id first, then right_id secondly.*/
@@ -556,3 +804,271 @@ static int32_t unicode_list_compare(const void * ref, const void * element)
 {
     return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
 }
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+
+static const uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t letter, bool count_stat)
+{
+    if(letter == '\t') letter = ' ';
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = get_glyph_dsc_id(font, letter);
+    if(!gid) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    uint32_t bitmap_size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+    if(bitmap_size == 0) return NULL;
+
+    uint32_t mem_size = GLYPH_ENTRY_HEADER_SIZE + bitmap_size;
+    if(mem_size > LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE) return NULL;
+
+    lv_mutex_lock(&glyph_cache.mutex);
+
+    _lv_font_fmt_txt_glyph_cache_entry_t ** bucket = glyph_cache_bucket(font, gid);
+    _lv_font_fmt_txt_glyph_cache_entry_t * entry;
+    for(entry = *bucket; entry; entry = entry->next) {
+        if(entry->font == font && entry->gid == gid) break;
+    }
+
+    if(entry) {
+        if(count_stat) glyph_cache.stat.hit_cnt++;
+        entry->used_cnt++;
+        glyph_cache_lru_unlink(entry);
+        glyph_cache_lru_push(entry);
+        lv_mutex_unlock(&glyph_cache.mutex);
+        return (const uint8_t *)entry + GLYPH_ENTRY_HEADER_SIZE;
+    }
+
+    if(count_stat) glyph_cache.stat.miss_cnt++;
+
+    /*Decode while locked because the decompressor of the compressed fonts has a global state*/
+    uint8_t * bitmap = NULL;
+    void * buf = glyph_cache_make_room(mem_size) ? lv_draw_buf_malloc(mem_size, LV_COLOR_FORMAT_A8) : NULL;
+    if(buf) {
+        entry = lv_draw_buf_align(buf, LV_COLOR_FORMAT_A8);
+        bitmap = (uint8_t *)entry + GLYPH_ENTRY_HEADER_SIZE;
+        if(lv_font_get_bitmap_fmt_txt(font, letter, bitmap) == NULL) {
+            lv_draw_buf_free(buf);
+            bitmap = NULL;
+        }
+    }
+
+    if(bitmap) {
+        lv_memzero(entry, sizeof(_lv_font_fmt_txt_glyph_cache_entry_t));
+        entry->font = font;
+        entry->gid = gid;
+        entry->buf_unaligned = buf;
+        entry->mem_size = mem_size;
+        entry->used_cnt = 1;
+        entry->next = *bucket;
+        *bucket = entry;
+        glyph_cache_lru_push(entry);
+        glyph_cache.stat.entry_cnt++;
+        glyph_cache.stat.mem_size += mem_size;
+    }
+
+    lv_mutex_unlock(&glyph_cache.mutex);
+
+    return bitmap;
+}
+
+static _lv_font_fmt_txt_glyph_cache_entry_t ** glyph_cache_bucket(const lv_font_t * font, uint32_t gid)
+{
+    uint32_t hash = (uint32_t)((lv_uintptr_t)font >> 4) * 31 + gid;
+    return &glyph_cache.buckets[hash & (LV_FONT_FMT_TXT_GLYPH_CACHE_BUCKETS - 1)];
+}
+
+/**
+ * Drop the least recently used unused glyphs until `mem_size` bytes fit into the cache.
+ * The mutex needs to be locked.
+ * @return  false: the glyphs in use leave not enough space
+ */
+static bool glyph_cache_make_room(uint32_t mem_size)
+{
+    _lv_font_fmt_txt_glyph_cache_entry_t * entry = glyph_cache.lru_tail;
+    while(glyph_cache.stat.mem_size + mem_size > LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE) {
+        while(entry && entry->used_cnt) entry = entry->lru_prev;
+        if(entry == NULL) return false;
+
+        _lv_font_fmt_txt_glyph_cache_entry_t * prev = entry->lru_prev;
+        glyph_cache_remove(entry);
+        glyph_cache.stat.evict_cnt++;
+        entry = prev;
+    }
+
+    return true;
+}
+
+static void glyph_cache_lru_unlink(_lv_font_fmt_txt_glyph_cache_entry_t * entry)
+{
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else glyph_cache.lru_head = entry->lru_next;
+
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else glyph_cache.lru_tail = entry->lru_prev;
+
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void glyph_cache_lru_push(_lv_font_fmt_txt_glyph_cache_entry_t * entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = glyph_cache.lru_head;
+    if(glyph_cache.lru_head) glyph_cache.lru_head->lru_prev = entry;
+    else glyph_cache.lru_tail = entry;
+    glyph_cache.lru_head = entry;
+}
+
+/**
+ * Remove an entry from the cache and free it. The mutex needs to be locked.
+ */
+static void glyph_cache_remove(_lv_font_fmt_txt_glyph_cache_entry_t * entry)
+{
+    _lv_font_fmt_txt_glyph_cache_entry_t ** p = glyph_cache_bucket(entry->font, entry->gid);
+    while(*p != entry) p = &(*p)->next;
+    *p = entry->next;
+
+    glyph_cache_lru_unlink(entry);
+    glyph_cache.stat.entry_cnt--;
+    glyph_cache.stat.mem_size -= entry->mem_size;
+    lv_draw_buf_free(entry->buf_unaligned);
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+
+static _lv_font_fmt_txt_lookup_t * lookup_find(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(lookup_registry.cnt == 0) return NULL;
+
+    _lv_font_fmt_txt_lookup_t * lookup;
+    for(lookup = *lookup_bucket(fdsc); lookup; lookup = lookup->next) {
+        if(lookup->fdsc == fdsc) return lookup;
+    }
+
+    return NULL;
+}
+
+static _lv_font_fmt_txt_lookup_t ** lookup_bucket(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t hash = (uint32_t)((lv_uintptr_t)fdsc >> 4);
+    return &lookup_registry.buckets[hash & (LV_FONT_FMT_TXT_LOOKUP_BUCKETS - 1)];
+}
+
+static bool lookup_set_glyph_id(_lv_font_fmt_txt_lookup_t * lookup, uint32_t letter, uint32_t gid)
+{
+    if(gid > UINT16_MAX) return false;
+
+    if(letter < 256) {
+        lookup->latin1[letter] = (uint16_t)gid;
+        return true;
+    }
+
+    uint32_t page = (letter >> 8) - lookup->page_first;
+    if(lookup->pages[page] == NULL) {
+        if(gid == 0) return true;
+        lookup->pages[page] = lv_malloc_zeroed(256 * sizeof(uint16_t));
+        if(lookup->pages[page] == NULL) return false;
+        lookup->mem_size += 256 * sizeof(uint16_t);
+    }
+
+    lookup->pages[page][letter & 0xFF] = (uint16_t)gid;
+    return true;
+}
+
+/**
+ * Write the glyph IDs of a cmap into the tables, overwriting the earlier written cmaps in its range
+ */
+static bool lookup_fill_cmap(_lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_cmap_t * cmap)
+{
+    uint32_t rcp;
+    if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+        for(rcp = 0; rcp < cmap->range_length; rcp++) {
+            if(!lookup_set_glyph_id(lookup, cmap->range_start + rcp, cmap->glyph_id_start + rcp)) return false;
+        }
+    }
+    else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+        const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+        for(rcp = 0; rcp < cmap->range_length; rcp++) {
+            if(!lookup_set_glyph_id(lookup, cmap->range_start + rcp, cmap->glyph_id_start + gid_ofs_8[rcp])) return false;
+        }
+    }
+    else {
+        /*The code points of the range missing from the list belong to this cmap too*/
+        for(rcp = 0; rcp < cmap->range_length; rcp++) {
+            if(!lookup_set_glyph_id(lookup, cmap->range_start + rcp, 0)) return false;
+        }
+
+        const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+        uint32_t i;
+        for(i = 0; i < cmap->list_length; i++) {
+            uint32_t ofs = cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL ? gid_ofs_16[i] : i;
+            if(!lookup_set_glyph_id(lookup, cmap->range_start + cmap->unicode_list[i], cmap->glyph_id_start + ofs)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool lookup_fill_kern(_lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_kern_pair_t * kdsc)
+{
+    if(kdsc->pair_cnt == 0) return true;
+
+    /*Keep the load factor <= 0.5*/
+    uint32_t size = 1;
+    while(size < kdsc->pair_cnt * 2) size <<= 1;
+
+    lookup->kern_keys = lv_malloc_zeroed(size * sizeof(uint32_t));
+    lookup->kern_values = lv_malloc_zeroed(size * sizeof(int8_t));
+    if(lookup->kern_keys == NULL || lookup->kern_values == NULL) return false;
+    lookup->kern_mask = size - 1;
+    lookup->mem_size += size * (sizeof(uint32_t) + sizeof(int8_t));
+
+    uint32_t i;
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t key;
+        if(kdsc->glyph_ids_size == 0) {
+            const uint8_t * g_ids = kdsc->glyph_ids;
+            key = ((uint32_t)g_ids[i * 2] << 16) | g_ids[i * 2 + 1];
+        }
+        else {
+            const uint16_t * g_ids = kdsc->glyph_ids;
+            key = ((uint32_t)g_ids[i * 2] << 16) | g_ids[i * 2 + 1];
+        }
+
+        /*Glyph ID 0 is not used so 0 can mark the empty slots*/
+        if(key == 0) continue;
+
+        uint32_t h = lookup_kern_hash(key, lookup->kern_mask);
+        while(lookup->kern_keys[h] && lookup->kern_keys[h] != key) h = (h + 1) & lookup->kern_mask;
+        if(lookup->kern_keys[h] == 0) {
+            lookup->kern_keys[h] = key;
+            lookup->kern_values[h] = kdsc->values[i];
+        }
+    }
+
+    return true;
+}
+
+static inline uint32_t lookup_kern_hash(uint32_t key, uint32_t mask)
+{
+    return (key * 2654435761U >> 7) & mask;
+}
+
+static void lookup_free(_lv_font_fmt_txt_lookup_t * lookup)
+{
+    uint32_t i;
+    if(lookup->pages) {
+        for(i = 0; i < lookup->page_cnt; i++) lv_free(lookup->pages[i]);
+        lv_free(lookup->pages);
+    }
+    lv_free(lookup->kern_keys);
+    lv_free(lookup->kern_values);
+    lv_free(lookup);
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_LOOKUP*/
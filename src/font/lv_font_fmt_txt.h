@@ -17,10 +17,15 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 #include "lv_font.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/*Number of hash buckets of the glyph cache. Must be power of 2.*/
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_BUCKETS 64
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -210,6 +215,57 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+typedef struct _lv_font_fmt_txt_glyph_cache_entry_t {
+    struct _lv_font_fmt_txt_glyph_cache_entry_t * next;         /**< Next entry in the same hash bucket*/
+    struct _lv_font_fmt_txt_glyph_cache_entry_t * lru_prev;     /**< The more recently used entry*/
+    struct _lv_font_fmt_txt_glyph_cache_entry_t * lru_next;     /**< The less recently used entry*/
+    const lv_font_t * font;
+    void * buf_unaligned;       /**< The allocated memory of the entry and the bitmap*/
+    uint32_t gid;               /**< Glyph ID in the font*/
+    uint32_t mem_size;          /**< Allocated memory of the entry [bytes]*/
+    uint32_t used_cnt;          /**< Number of glyphs being drawn with this bitmap*/
+} _lv_font_fmt_txt_glyph_cache_entry_t;
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of glyphs found in the cache*/
+    uint32_t miss_cnt;          /**< Number of glyphs which needed to be decoded*/
+    uint32_t evict_cnt;         /**< Number of glyphs dropped from the cache*/
+    uint32_t entry_cnt;         /**< Number of cached glyphs*/
+    uint32_t mem_size;          /**< Memory used by the cached glyphs [bytes]*/
+} lv_font_fmt_txt_glyph_cache_stat_t;
+
+typedef struct {
+    _lv_font_fmt_txt_glyph_cache_entry_t * buckets[LV_FONT_FMT_TXT_GLYPH_CACHE_BUCKETS];
+    _lv_font_fmt_txt_glyph_cache_entry_t * lru_head;    /**< The most recently used entry*/
+    _lv_font_fmt_txt_glyph_cache_entry_t * lru_tail;    /**< The least recently used entry*/
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_mutex_t mutex;
+} _lv_font_fmt_txt_glyph_cache_t;
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+#define LV_FONT_FMT_TXT_LOOKUP_BUCKETS 8
+
+typedef struct _lv_font_fmt_txt_lookup_t {
+    struct _lv_font_fmt_txt_lookup_t * next;    /**< Next lookup in the same hash bucket*/
+    const lv_font_fmt_txt_dsc_t * fdsc;         /**< The font descriptor the tables belong to*/
+    uint16_t latin1[256];       /**< Glyph ID of the code points 0x00..0xFF*/
+    uint16_t ** pages;          /**< Glyph IDs of 256 code points per page, NULL if the page is empty*/
+    uint32_t page_first;        /**< Index of `pages[0]`, i.e. `code_point >> 8`*/
+    uint32_t page_cnt;
+    uint32_t * kern_keys;       /**< Open addressing hash of `(left_gid << 16) | right_gid`, 0: empty*/
+    int8_t * kern_values;
+    uint32_t kern_mask;         /**< Size of the kern hash - 1*/
+    uint32_t mem_size;          /**< Memory used by the tables [bytes]*/
+} _lv_font_fmt_txt_lookup_t;
+
+typedef struct {
+    _lv_font_fmt_txt_lookup_t * buckets[LV_FONT_FMT_TXT_LOOKUP_BUCKETS];
+    uint32_t cnt;
+} _lv_font_fmt_txt_lookup_registry_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -235,6 +291,85 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+/**
+ * Get the decoded A8 bitmap of a glyph from the glyph cache. Decode it into the cache if it's not there yet.
+ * The bitmap's stride is `lv_draw_buf_width_to_stride(box_w, LV_COLOR_FORMAT_A8)`.
+ * @param font              pointer to a font using `lv_font_get_bitmap_fmt_txt`
+ * @param unicode_letter    a unicode letter whose bitmap should be get
+ * @return                  the bitmap which needs to be released with `lv_font_fmt_txt_glyph_cache_release`, or
+ *                          NULL if the glyph is not found or it doesn't fit into the cache
+ */
+const uint8_t * lv_font_fmt_txt_glyph_cache_get(const lv_font_t * font, uint32_t unicode_letter);
+
+/**
+ * Release a bitmap get with `lv_font_fmt_txt_glyph_cache_get`
+ * @param bitmap            pointer to the bitmap
+ */
+void lv_font_fmt_txt_glyph_cache_release(const uint8_t * bitmap);
+
+/**
+ * Decode the glyphs of the given characters into the glyph cache in advance.
+ * The glyphs missing from the font are looked up in its fallback fonts too.
+ * It doesn't change the hit and miss counters.
+ * @param font              pointer to a font
+ * @param txt               the characters in UTF-8
+ * @return                  number of glyphs which are in the cache now
+ */
+uint32_t lv_font_fmt_txt_glyph_cache_prewarm(const lv_font_t * font, const char * txt);
+
+/**
+ * Free the cached glyphs which are not used
+ * @param font              free the glyphs of this font only, or NULL to free the glyphs of all the fonts
+ */
+void lv_font_fmt_txt_glyph_cache_drop(const lv_font_t * font);
+
+/**
+ * Get the statistics of the glyph cache. The hit rate is `hit_cnt / (hit_cnt + miss_cnt)`.
+ * @param stat              store the statistics here
+ */
+void lv_font_fmt_txt_glyph_cache_get_stat(lv_font_fmt_txt_glyph_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and evict counters of the glyph cache
+ */
+void lv_font_fmt_txt_glyph_cache_reset_stat(void);
+
+void _lv_font_fmt_txt_glyph_cache_init(void);
+
+void _lv_font_fmt_txt_glyph_cache_deinit(void);
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+/**
+ * Build lookup tables for a font to find the glyphs and kerning values of its letters in constant time
+ * instead of scanning the cmaps and searching the kern pairs. Fonts loaded by `lv_binfont_load` get them automatically.
+ * The tables are freed by `lv_font_fmt_txt_lookup_delete` or `lv_font_free`.
+ * Should be called before the font is used for drawing.
+ * @param font      pointer to a font using `lv_font_get_glyph_dsc_fmt_txt`
+ * @return          LV_RESULT_OK: the tables are created (or already existed);
+ *                  LV_RESULT_INVALID: out of memory or the font has too many glyphs
+ */
+lv_result_t lv_font_fmt_txt_lookup_create(const lv_font_t * font);
+
+/**
+ * Free the lookup tables of a font. Should not be called while the font is being drawn.
+ * @param font      pointer to a font
+ */
+void lv_font_fmt_txt_lookup_delete(const lv_font_t * font);
+
+/**
+ * Get the memory used by the lookup tables of a font
+ * @param font      pointer to a font
+ * @return          the size of the tables in bytes or 0 if the font has no lookup tables
+ */
+uint32_t lv_font_fmt_txt_lookup_get_mem_size(const lv_font_t * font);
+
+void _lv_font_fmt_txt_lookup_init(void);
+
+void _lv_font_fmt_txt_lookup_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
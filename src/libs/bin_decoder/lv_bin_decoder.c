@@ -66,6 +66,8 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
 static void cache_invalidate_cb(lv_cache_entry_t * entry);
 
+static lv_result_t premultiply_decoded(lv_image_decoder_dsc_t * dsc);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -164,7 +166,6 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
                                 const lv_image_decoder_args_t * args)
 {
     LV_UNUSED(decoder);
-    LV_UNUSED(args);
 
     /*Check the cache first*/
     if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
@@ -300,6 +301,15 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 
     if(dsc->decoded == NULL) return LV_RESULT_OK; /*Need to read via get_area_cb*/
 
+    /*Premultiply the image before adding it to the cache so that it's done only once*/
+    if(args && args->premultiply) {
+        res = premultiply_decoded(dsc);
+        if(res != LV_RESULT_OK) {
+            free_decoder_data(dsc);
+            return res;
+        }
+    }
+
     /*Add it to cache*/
     t = lv_tick_elaps(t);
     lv_cache_lock();
@@ -1045,6 +1055,42 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
     return LV_RESULT_INVALID;
 }
 
+/**
+ * Premultiply a decoded ARGB8888 image.
+ * The images in ROM or in the user's RAM are copied first, the buffers allocated by the decoder are
+ * premultiplied in place.
+ */
+static lv_result_t premultiply_decoded(lv_image_decoder_dsc_t * dsc)
+{
+    lv_draw_buf_t * decoded = (lv_draw_buf_t *)dsc->decoded;
+    if(decoded->header.cf != LV_COLOR_FORMAT_ARGB8888) return LV_RESULT_OK;
+
+    decoder_data_t * decoder_data = dsc->user_data;
+    if(decoded == &decoder_data->c_array && !(dsc->header.flags & LV_IMAGE_FLAGS_MODIFIABLE)) {
+        lv_draw_buf_t * copy = lv_draw_buf_create(decoded->header.w, decoded->header.h, LV_COLOR_FORMAT_ARGB8888,
+                                                  decoded->header.stride);
+        if(copy == NULL) {
+            LV_LOG_ERROR("No memory for the premultiplied image");
+            return LV_RESULT_INVALID;
+        }
+
+        uint8_t * dst_data = copy->data;
+        const uint8_t * src_data = decoded->data;
+        uint32_t y;
+        for(y = 0; y < decoded->header.h; y++) {
+            lv_memcpy(dst_data, src_data, decoded->header.w * 4);
+            src_data += decoded->header.stride;
+            dst_data += copy->header.stride;
+        }
+
+        decoder_data->decoded = copy; /*Free when the cache entry is dropped*/
+        decoded = copy;
+        dsc->decoded = copy;
+    }
+
+    return lv_draw_buf_premultiply(decoded);
+}
+
 static void cache_invalidate_cb(lv_cache_entry_t * entry)
 {
     lv_image_decoder_dsc_t fake = { 0 };
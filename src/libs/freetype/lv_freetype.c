@@ -167,6 +167,10 @@ void lv_freetype_font_delete(lv_font_t * font)
     LV_ASSERT_NULL(dsc);
     LV_ASSERT_FREETYPE_FONT_DSC(dsc);
 
+    lv_font_glyph_cache_drop(font);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_cache_drop(font);
+#endif
     lv_freetype_on_font_delete(dsc);
     lv_freetype_drop_face_id(dsc->context, dsc->face_id);
 
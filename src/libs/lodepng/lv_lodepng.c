@@ -156,7 +156,6 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
                                 const lv_image_decoder_args_t * args)
 {
     LV_UNUSED(decoder);
-    LV_UNUSED(args);
 
     /*Check the cache first*/
     if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
@@ -211,6 +210,11 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         }
     }
 
+    /*Premultiply once here instead of on every draw*/
+    if(args && args->premultiply) {
+        lv_draw_buf_premultiply(decoded);
+    }
+
     t = lv_tick_elaps(t);
     cache->weight = t;
     cache->data = decoded;
@@ -271,10 +271,17 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
     stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
     font->line_height = (int32_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
     font->base_line = (int32_t)(dsc->scale * (line_gap - dsc->descent));
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_cache_drop(font);
+#endif
 }
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
+        lv_font_glyph_cache_drop(font);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+        lv_text_layout_cache_drop(font);
+#endif
         if(font->dsc != NULL) {
             ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
 #if LV_TINY_TTF_FILE_SUPPORT != 0
@@ -26,6 +26,9 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_MVE          2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
+#define LV_DRAW_SW_ASM_AUTO         5
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -215,6 +218,72 @@
     #endif
 #endif
 
+/*Index the draw tasks of a layer in a grid of LV_DRAW_TASK_GRID_SIZE x LV_DRAW_TASK_GRID_SIZE cells
+ *to find the independent draw tasks faster if there are a lot of draw tasks on a layer.
+ *0: disable the grid and always compare the draw tasks with all the older draw tasks*/
+#ifndef LV_DRAW_TASK_GRID_SIZE
+    #ifdef CONFIG_LV_DRAW_TASK_GRID_SIZE
+        #define LV_DRAW_TASK_GRID_SIZE CONFIG_LV_DRAW_TASK_GRID_SIZE
+    #else
+        #define LV_DRAW_TASK_GRID_SIZE                  8
+    #endif
+#endif
+
+/*Keep at most this many bytes of freed draw tasks and draw descriptors to reuse them
+ *for the next draw tasks instead of allocating them again.
+ *0: allocate and free all draw tasks with `lv_malloc` and `lv_free`*/
+#ifndef LV_DRAW_TASK_POOL_SIZE
+    #ifdef CONFIG_LV_DRAW_TASK_POOL_SIZE
+        #define LV_DRAW_TASK_POOL_SIZE CONFIG_LV_DRAW_TASK_POOL_SIZE
+    #else
+        #define LV_DRAW_TASK_POOL_SIZE                  (4 * 1024)    /*[bytes]*/
+    #endif
+#endif
+
+/*Keep at most this many bytes of freed layer buffers to reuse them for the next layers
+ *with the same color format and stride instead of allocating them again.
+ *0: allocate and free all layer buffers with `lv_draw_buf_malloc` and `lv_draw_buf_free`*/
+#ifndef LV_DRAW_LAYER_BUF_POOL_SIZE
+    #ifdef CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+    #else
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE             0     /*[bytes]*/
+    #endif
+#endif
+
+/*1: Drop or clip the draw tasks which are hidden by a newer opaque draw task on the same layer
+ *(e.g. a full opacity rectangle without radius or an opaque RGB image) before they are rendered.*/
+#ifndef LV_DRAW_OCCLUSION_CULLING
+    #ifdef CONFIG_LV_DRAW_OCCLUSION_CULLING
+        #define LV_DRAW_OCCLUSION_CULLING CONFIG_LV_DRAW_OCCLUSION_CULLING
+    #else
+        #define LV_DRAW_OCCLUSION_CULLING               0
+    #endif
+#endif
+
+/*Merge at most this many consecutive, similar small draw tasks (fills and borders without radius
+ *and labels with the same color, opacity and font) into one draw task which is rendered in one go.
+ *It saves the evaluation and dispatching of each draw task.
+ *0: don't merge the draw tasks*/
+#ifndef LV_DRAW_TASK_BATCH_MAX
+    #ifdef CONFIG_LV_DRAW_TASK_BATCH_MAX
+        #define LV_DRAW_TASK_BATCH_MAX CONFIG_LV_DRAW_TASK_BATCH_MAX
+    #else
+        #define LV_DRAW_TASK_BATCH_MAX                  0
+    #endif
+#endif
+
+/*1: Collect rendering statistics: the number of created, dispatched and stalled draw tasks,
+ *the blended pixels and rendering time by draw task type, the busy time of the draw units and
+ *the peak layer memory. Get them with `lv_draw_stat_get()`. Also shown by the performance monitor in log mode.*/
+#ifndef LV_USE_DRAW_STAT
+    #ifdef CONFIG_LV_USE_DRAW_STAT
+        #define LV_USE_DRAW_STAT CONFIG_LV_USE_DRAW_STAT
+    #else
+        #define LV_USE_DRAW_STAT                        0
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_SW
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_DRAW_SW
@@ -242,6 +311,18 @@
         #endif
     #endif
 
+    /* Cut large fill, image, layer and box shadow (if its corner is cached) draw tasks into
+     * horizontal stripes which are rendered in parallel by all the idle draw units.
+     * Tasks drawing on a smaller area than this are rendered by a single draw unit.
+     * 0: disable. Requires `LV_USE_OS` and a GCC compatible compiler (for the atomic operations) */
+    #ifndef LV_DRAW_SW_STRIPE_MIN_AREA
+        #ifdef CONFIG_LV_DRAW_SW_STRIPE_MIN_AREA
+            #define LV_DRAW_SW_STRIPE_MIN_AREA CONFIG_LV_DRAW_SW_STRIPE_MIN_AREA
+        #else
+            #define LV_DRAW_SW_STRIPE_MIN_AREA  0   /*[px]*/
+        #endif
+    #endif
+
     /* If a widget has `style_opa < 255` (not `bg_opa`, `text_opa` etc) or not NORMAL blend mode
      * it is buffered into a "simple" layer before rendering. The widget can be buffered in smaller chunks.
      * "Transformed layers" (if `transform_angle/zoom` are set) use larger buffers
@@ -282,6 +363,16 @@
             #endif
         #endif
 
+        /* Number of shadow corners to cache if LV_DRAW_SW_SHADOW_CACHE_SIZE > 0.
+         * The shadows with the same width, radius and similar size share a corner. */
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_CNT
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+                #define LV_DRAW_SW_SHADOW_CACHE_CNT CONFIG_LV_DRAW_SW_SHADOW_CACHE_CNT
+            #else
+                #define LV_DRAW_SW_SHADOW_CACHE_CNT 4
+            #endif
+        #endif
+
         /* Set number of maximally cached circle data.
         * The circumference of 1/4 circle are saved for anti-aliasing
         * radius * 4 bytes are used per circle (the most often used radiuses are saved)
@@ -293,8 +384,65 @@
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
             #endif
         #endif
+
+        /* Max. memory used by the cached circles [bytes].
+         * If a new circle doesn't fit the least recently used unused ones are dropped.
+         * 0: limit only the number of circles */
+        #ifndef LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE
+                #define LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE
+            #else
+                #define LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE 0
+            #endif
+        #endif
+
+        /* Number of gradients to keep between the frames.
+         * The gradients with the same stops, direction and size share their color maps.
+         * 0: to disable caching */
+        #ifndef LV_DRAW_SW_GRADIENT_CACHE_CNT
+            #ifdef CONFIG_LV_DRAW_SW_GRADIENT_CACHE_CNT
+                #define LV_DRAW_SW_GRADIENT_CACHE_CNT CONFIG_LV_DRAW_SW_GRADIENT_CACHE_CNT
+            #else
+                #define LV_DRAW_SW_GRADIENT_CACHE_CNT 4
+            #endif
+        #endif
+
+        /* Max. memory used by the cached gradients [bytes].
+         * A gradient needs about 4 bytes per pixel of its width or height.
+         * 0: limit only the number of gradients */
+        #ifndef LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE
+                #define LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE CONFIG_LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE
+            #else
+                #define LV_DRAW_SW_GRADIENT_CACHE_MEM_SIZE 0
+            #endif
+        #endif
+    #endif
+
+    /* 1: Dither the pixels drawn on I1 (1 bit per pixel) layers and displays with a 4x4 ordered pattern.
+     * 0: Pixels brighter than 50% are white, the others are black */
+    #ifndef LV_DRAW_SW_I1_DITHER
+        #ifdef CONFIG_LV_DRAW_SW_I1_DITHER
+            #define LV_DRAW_SW_I1_DITHER CONFIG_LV_DRAW_SW_I1_DITHER
+        #else
+            #define LV_DRAW_SW_I1_DITHER        0
+        #endif
     #endif
 
+    /* 1: Render the simple layers (e.g. widgets with `opa < 255`) to premultiplied ARGB8888
+     * and premultiply the ARGB8888 images when they are decoded.
+     * Blending such pixels needs only multiplications and additions. */
+    #ifndef LV_DRAW_SW_PREMULTIPLY
+        #ifdef CONFIG_LV_DRAW_SW_PREMULTIPLY
+            #define LV_DRAW_SW_PREMULTIPLY CONFIG_LV_DRAW_SW_PREMULTIPLY
+        #else
+            #define LV_DRAW_SW_PREMULTIPLY      0
+        #endif
+    #endif
+
+    /* Use SIMD optimized blending functions.
+     * LV_DRAW_SW_ASM_SSE2 and LV_DRAW_SW_ASM_AVX2 can be used on x86 targets.
+     * LV_DRAW_SW_ASM_AUTO probes the CPU in `lv_init()` and selects the best available functions at runtime */
     #ifndef LV_USE_DRAW_SW_ASM
         #ifdef CONFIG_LV_USE_DRAW_SW_ASM
             #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -1159,6 +1307,28 @@
     #endif
 #endif
 
+/*Size of the cache of decoded glyph bitmaps of the built-in (lv_font_fmt_txt) fonts [bytes].
+ *Saves converting the 1/2/4 bpp and compressed glyphs to A8 every time they are drawn.
+ *0: to disable caching*/
+#ifndef LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Enable building lookup tables for the built-in (lv_font_fmt_txt) fonts to find the glyphs and
+ *kerning values in constant time. Useful for fonts with a lot of characters (e.g. CJK).
+ *See lv_font_fmt_txt_lookup_create(). The fonts loaded by lv_binfont_load() get them automatically.*/
+#ifndef LV_USE_FONT_FMT_TXT_LOOKUP
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_LOOKUP
+        #define LV_USE_FONT_FMT_TXT_LOOKUP CONFIG_LV_USE_FONT_FMT_TXT_LOOKUP
+    #else
+        #define LV_USE_FONT_FMT_TXT_LOOKUP 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef _LV_KCONFIG_PRESENT
@@ -1229,6 +1399,17 @@
     #endif
 #endif
 
+/*Size of the cache of the line breaks and line widths of the measured and drawn texts [bytes].
+ *Measuring and drawing unchanged texts (e.g. in tables and labels) needs only a lookup then.
+ *0: to disable caching*/
+#ifndef LV_TEXT_LAYOUT_CACHE_SIZE
+    #ifdef CONFIG_LV_TEXT_LAYOUT_CACHE_SIZE
+        #define LV_TEXT_LAYOUT_CACHE_SIZE CONFIG_LV_TEXT_LAYOUT_CACHE_SIZE
+    #else
+        #define LV_TEXT_LAYOUT_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -1527,6 +1708,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_INDEX
+        #ifdef CONFIG_LV_LABEL_LINE_INDEX
+            #define LV_LABEL_LINE_INDEX CONFIG_LV_LABEL_LINE_INDEX
+        #else
+            #define LV_LABEL_LINE_INDEX 0     /*Store the start of each wrapped line of long texts to draw, edit and click them in O(log n)*/
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -2343,6 +2531,15 @@
                 #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /*[bytes]*/
             #endif
         #endif
+
+        /*Maximum number of threads which can be profiled. Each thread has its own buffer.*/
+        #ifndef LV_PROFILER_BUILTIN_THREAD_CNT
+            #ifdef CONFIG_LV_PROFILER_BUILTIN_THREAD_CNT
+                #define LV_PROFILER_BUILTIN_THREAD_CNT CONFIG_LV_PROFILER_BUILTIN_THREAD_CNT
+            #else
+                #define LV_PROFILER_BUILTIN_THREAD_CNT 8
+            #endif
+        #endif
     #endif
 
     /*Header to include for the profiler*/
@@ -89,10 +89,6 @@ static inline void lv_global_init(lv_global_t * global)
     global->event_last_register_id = _LV_EVENT_LAST;
     global->math_rand_seed = 0x1234ABCD;
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void _lv_cleanup_devices(lv_global_t * global)
@@ -158,6 +154,18 @@ void lv_init(void)
 
     _lv_group_init();
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    _lv_font_fmt_txt_glyph_cache_init();
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    _lv_font_fmt_txt_lookup_init();
+#endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    _lv_text_layout_cache_init();
+#endif
+
     lv_draw_init();
 
 #if LV_USE_DRAW_SW
@@ -363,6 +371,18 @@ void lv_deinit(void)
 
     lv_draw_deinit();
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    _lv_font_fmt_txt_glyph_cache_deinit();
+#endif
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    _lv_font_fmt_txt_lookup_deinit();
+#endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    _lv_text_layout_cache_deinit();
+#endif
+
     _lv_group_deinit();
 
     _lv_anim_core_deinit();
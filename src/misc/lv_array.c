@@ -43,6 +43,7 @@ void lv_array_init(lv_array_t * array, uint32_t capacity, uint32_t element_size)
 
     array->data = lv_malloc(capacity * element_size);
     LV_ASSERT_MALLOC(array->data);
+    if(array->data == NULL) array->capacity = 0; /*Nothing can be appended*/
 }
 
 void lv_array_destroy(lv_array_t * array)
@@ -69,11 +70,13 @@ void lv_array_clear(lv_array_t * array)
     array->size = 0;
 }
 
-void lv_array_resize(lv_array_t * array, uint32_t new_capacity)
+bool lv_array_resize(lv_array_t * array, uint32_t new_capacity)
 {
     if(new_capacity > array->size) {
         if(new_capacity > array->capacity) {
             uint8_t * data = lv_malloc(new_capacity * array->element_size);
+            LV_ASSERT_MALLOC(data);
+            if(data == NULL) return false;
             lv_memcpy(data, array->data, array->size * array->element_size);
             lv_free(array->data);
             array->data = data;
@@ -83,6 +86,8 @@ void lv_array_resize(lv_array_t * array, uint32_t new_capacity)
     else {
         array->size = new_capacity;
     }
+
+    return true;
 }
 
 bool lv_array_append(lv_array_t * array, const uint8_t * element)
@@ -99,6 +104,18 @@ bool lv_array_append(lv_array_t * array, const uint8_t * element)
     return true;
 }
 
+bool lv_array_remove(lv_array_t * array, uint32_t index)
+{
+    if(index >= array->size) {
+        return false;
+    }
+
+    uint8_t * data = array->data + index * array->element_size;
+    lv_memmove(data, data + array->element_size, (array->size - index - 1) * array->element_size);
+    array->size--;
+    return true;
+}
+
 uint8_t * lv_array_get(const lv_array_t * array, uint32_t index)
 {
     if(index > (array->size - 1)) {
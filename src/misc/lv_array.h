@@ -44,12 +44,26 @@ void lv_array_copy(lv_array_t * target, const lv_array_t * array);
 
 void lv_array_clear(lv_array_t * array);
 
-void lv_array_resize(lv_array_t * array, uint32_t new_capacity);
+/**
+ * Change the capacity of an array. If the new capacity is smaller than the size the array is truncated.
+ * @param array         pointer to an array
+ * @param new_capacity  the new capacity
+ * @return              true: success; false: out of memory, the array is not changed
+ */
+bool lv_array_resize(lv_array_t * array, uint32_t new_capacity);
 
 void lv_array_destroy(lv_array_t * array);
 
 bool lv_array_append(lv_array_t * array, const uint8_t * element);
 
+/**
+ * Remove the element at the given index. The elements after it are moved forward.
+ * @param array     pointer to an array
+ * @param index     index of the element to remove
+ * @return          true: the element was removed; false: the index was out of range
+ */
+bool lv_array_remove(lv_array_t * array, uint32_t index);
+
 uint8_t * lv_array_get(const lv_array_t * array, uint32_t index);
 
 uint32_t lv_array_length(const lv_array_t * array);
@@ -65,6 +65,7 @@ uint8_t lv_color_format_get_bpp(lv_color_format_t cf)
             return 24;
         case LV_COLOR_FORMAT_ARGB8888:
         case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
             return 32;
 
         case LV_COLOR_FORMAT_UNKNOWN:
@@ -80,6 +81,7 @@ bool lv_color_format_has_alpha(lv_color_format_t cf)
         case LV_COLOR_FORMAT_I8:
         case LV_COLOR_FORMAT_RGB565A8:
         case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED:
             return true;
         default:
             return false;
@@ -115,6 +115,7 @@ enum _lv_color_format_t {
     LV_COLOR_FORMAT_RGB888            = 0x0F,
     LV_COLOR_FORMAT_ARGB8888          = 0x10,
     LV_COLOR_FORMAT_XRGB8888          = 0x11,
+    LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED = 0x1A,  /**< ARGB8888 with the color channels multiplied by the alpha*/
 
     /*Formats not supported by software renderer but kept here so GPU can use it*/
     LV_COLOR_FORMAT_A1                = 0x0B,
@@ -266,6 +267,65 @@ LV_ATTRIBUTE_FAST_MEM static inline uint16_t lv_color_16_16_mix(uint16_t c1, uin
     return ret;
 }
 
+/**
+ * Get the luminance of a color, i.e. its L8 (grayscale) value
+ * @param c     a color
+ * @return      the luminance in the 0..255 range
+ */
+static inline uint8_t lv_color_luminance(lv_color_t c)
+{
+    return (uint8_t)((c.red * 77 + c.green * 150 + c.blue * 29) >> 8);
+}
+
+/**
+ * Get the luminance of an RGB565 color
+ * @param c     an RGB565 color
+ * @return      the luminance in the 0..255 range
+ */
+static inline uint8_t lv_color16_luminance(lv_color16_t c)
+{
+    /*The weights of `lv_color_luminance` scaled by 255/31 and 255/63*/
+    return (uint8_t)((c.red * 633 + c.green * 607 + c.blue * 239 + 128) >> 8);
+}
+
+/**
+ * Get the luminance of a 32 bit color. The alpha channel is ignored.
+ * @param c     a 32 bit color
+ * @return      the luminance in the 0..255 range
+ */
+static inline uint8_t lv_color32_luminance(lv_color32_t c)
+{
+    return (uint8_t)((c.red * 77 + c.green * 150 + c.blue * 29) >> 8);
+}
+
+/**
+ * Multiply the color channels of a 32 bit color with its alpha channel
+ * @param c     a 32 bit color with straight alpha
+ * @return      the premultiplied color
+ */
+static inline lv_color32_t lv_color32_premultiply(lv_color32_t c)
+{
+    c.red = LV_UDIV255(c.red * c.alpha);
+    c.green = LV_UDIV255(c.green * c.alpha);
+    c.blue = LV_UDIV255(c.blue * c.alpha);
+    return c;
+}
+
+/**
+ * Divide the color channels of a premultiplied 32 bit color by its alpha channel
+ * @param c     a premultiplied 32 bit color
+ * @return      the color with straight alpha
+ */
+static inline lv_color32_t lv_color32_unpremultiply(lv_color32_t c)
+{
+    if(c.alpha == 0 || c.alpha == 255) return c;
+
+    c.red = LV_MIN((c.red * 255 + c.alpha / 2) / c.alpha, 255);
+    c.green = LV_MIN((c.green * 255 + c.alpha / 2) / c.alpha, 255);
+    c.blue = LV_MIN((c.blue * 255 + c.alpha / 2) / c.alpha, 255);
+    return c;
+}
+
 lv_color_t lv_color_lighten(lv_color_t c, lv_opa_t lvl);
 
 lv_color_t lv_color_darken(lv_color_t c, lv_opa_t lvl);
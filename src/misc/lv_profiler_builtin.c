@@ -11,16 +11,45 @@
 #include "../lvgl.h"
 #include "../core/lv_global.h"
 
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+
+#if LV_USE_OS == LV_OS_PTHREAD
+    #include <time.h>
+    #include <pthread.h>
+    #if defined(__linux__)
+        #include <unistd.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 
-#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
-
 #define profiler_ctx LV_GLOBAL_DEFAULT()->profiler_context
 
 #define LV_PROFILER_STR_MAX_LEN 128
-#define LV_PROFILER_TICK_PER_SEC_MAX 1000000
+#define LV_PROFILER_TICK_PER_SEC_MAX 1000000000
+
+/*States of a thread's buffer*/
+#define THREAD_STATE_FREE       0
+#define THREAD_STATE_CLAIMING   1
+#define THREAD_STATE_READY      2
+
+/*The buffers are written by their own thread and read by the flushing thread.
+ *Without atomics the profiler can be used only from a single thread.*/
+#if defined(__GNUC__)
+    #define ATOMIC_LOAD(p)              __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE(p, v)          __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+    #define ATOMIC_INC(p)               __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+    #define ATOMIC_CAS(p, exp, v)       __atomic_compare_exchange_n((p), (exp), (v), false, \
+                                                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+    #define ATOMIC_LOAD(p)              (*(p))
+    #define ATOMIC_STORE(p, v)          (*(p) = (v))
+    #define ATOMIC_INC(p)               ((*(p))++)
+    #define ATOMIC_CAS(p, exp, v)       (*(p) == *(exp) ? (*(p) = (v), true) : (*(exp) = *(p), false))
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -30,7 +59,12 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static lv_profiler_builtin_thread_t * get_thread(void);
+static void flush_thread(lv_profiler_builtin_thread_t * th);
+static void flush_item(const lv_profiler_builtin_thread_t * th, const lv_profiler_builtin_item_t * item);
 static void default_flush_cb(const char * buf);
+static uint64_t default_tick_get64_cb(void);
+static int default_tid_get_cb(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -49,15 +83,22 @@ void lv_profiler_builtin_config_init(lv_profiler_builtin_config_t * config)
     LV_ASSERT_NULL(config);
     lv_memzero(config, sizeof(lv_profiler_builtin_config_t));
     config->buf_size = LV_PROFILER_BUILTIN_BUF_SIZE;
+#if LV_USE_OS == LV_OS_PTHREAD
+    config->tick_per_sec = 1000000000;
+#else
     config->tick_per_sec = 1000;
-    config->tick_get_cb = lv_tick_get;
+#endif
+    config->tick_get64_cb = default_tick_get64_cb;
     config->flush_cb = default_flush_cb;
+    config->tid_get_cb = default_tid_get_cb;
+    config->format = LV_PROFILER_BUILTIN_FORMAT_SYSTRACE;
 }
 
 void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
 {
     LV_ASSERT_NULL(config);
-    LV_ASSERT_NULL(config->tick_get_cb);
+    LV_ASSERT(config->tick_get_cb || config->tick_get64_cb);
+    LV_ASSERT_NULL(config->tid_get_cb);
 
     uint32_t num = config->buf_size / sizeof(lv_profiler_builtin_item_t);
     if(num == 0) {
@@ -70,27 +111,26 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
         return;
     }
 
-    /*Free the old item_arr memory*/
-    if(profiler_ctx.item_arr != NULL) {
+    /*Free the old buffers*/
+    if(profiler_ctx.item_num != 0) {
         lv_profiler_builtin_uninit();
     }
 
+    /*The buffers of the threads are allocated when they write the first item*/
     lv_memzero(&profiler_ctx, sizeof(profiler_ctx));
-    profiler_ctx.item_arr = lv_malloc(num * sizeof(lv_profiler_builtin_item_t));
-    LV_ASSERT_MALLOC(profiler_ctx.item_arr);
-
-    if(profiler_ctx.item_arr == NULL) {
-        LV_LOG_ERROR("malloc failed for item_arr");
-        return;
-    }
-
     profiler_ctx.item_num = num;
     profiler_ctx.config = *config;
 
     if(profiler_ctx.config.flush_cb) {
-        /* add profiler header for perfetto */
-        profiler_ctx.config.flush_cb("# tracer: nop\n");
-        profiler_ctx.config.flush_cb("#\n");
+        if(profiler_ctx.config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON) {
+            /*The closing bracket is optional in the JSON array format*/
+            profiler_ctx.config.flush_cb("[\n");
+        }
+        else {
+            /* add profiler header for perfetto */
+            profiler_ctx.config.flush_cb("# tracer: nop\n");
+            profiler_ctx.config.flush_cb("#\n");
+        }
     }
 
     LV_LOG_INFO("init OK, item_num = %d", (int)num);
@@ -98,59 +138,219 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
 
 void lv_profiler_builtin_uninit(void)
 {
-    LV_ASSERT_NULL(profiler_ctx.item_arr);
-    lv_free(profiler_ctx.item_arr);
+    LV_ASSERT(profiler_ctx.item_num != 0);
+
+    /*The other threads shouldn't write anymore*/
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUILTIN_THREAD_CNT; i++) {
+        lv_free(profiler_ctx.threads[i].item_arr);
+    }
+
+    if(profiler_ctx.dropped_cnt) {
+        LV_LOG_WARN("%" LV_PRIu32 " items were dropped", profiler_ctx.dropped_cnt);
+    }
+
     lv_memzero(&profiler_ctx, sizeof(profiler_ctx));
 }
 
 void lv_profiler_builtin_flush(void)
 {
-    LV_ASSERT_NULL(profiler_ctx.item_arr);
+    LV_ASSERT(profiler_ctx.item_num != 0);
     if(!profiler_ctx.config.flush_cb) {
         LV_LOG_WARN("flush_cb is not registered");
         return;
     }
 
-    uint32_t cur = 0;
-    char buf[LV_PROFILER_STR_MAX_LEN];
-    uint32_t tick_per_sec = profiler_ctx.config.tick_per_sec;
-    while(cur < profiler_ctx.cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx.item_arr[cur++];
-        uint32_t sec = item->tick / tick_per_sec;
-        uint32_t usec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    sec,
-                    usec,
-                    item->tag,
-                    item->func);
-        profiler_ctx.config.flush_cb(buf);
+    /*Any thread can flush (e.g. when its buffer is full) so let only one of them do it at a time*/
+    int unlocked = 0;
+    while(!ATOMIC_CAS(&profiler_ctx.flush_lock, &unlocked, 1)) {
+        unlocked = 0;
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUILTIN_THREAD_CNT; i++) {
+        lv_profiler_builtin_thread_t * th = &profiler_ctx.threads[i];
+        if(ATOMIC_LOAD(&th->state) != THREAD_STATE_READY) continue;
+        flush_thread(th);
     }
+
+    ATOMIC_STORE(&profiler_ctx.flush_lock, 0);
 }
 
 void lv_profiler_builtin_write(const char * func, char tag)
 {
-    LV_ASSERT_NULL(profiler_ctx.item_arr);
+    LV_ASSERT(profiler_ctx.item_num != 0);
     LV_ASSERT_NULL(func);
-    if(profiler_ctx.cur_index >= profiler_ctx.item_num) {
+
+    lv_profiler_builtin_thread_t * th = get_thread();
+    if(th == NULL) {
+        ATOMIC_INC(&profiler_ctx.dropped_cnt);
+        return;
+    }
+
+    /*Only this thread changes `head` so only `tail` needs to be synchronized*/
+    uint32_t head = th->head;
+    if(head - ATOMIC_LOAD(&th->tail) >= profiler_ctx.item_num) {
         lv_profiler_builtin_flush();
-        profiler_ctx.cur_index = 0;
+        if(head - ATOMIC_LOAD(&th->tail) >= profiler_ctx.item_num) {
+            ATOMIC_INC(&profiler_ctx.dropped_cnt);
+            return;
+        }
     }
 
-    lv_profiler_builtin_item_t * item = &profiler_ctx.item_arr[profiler_ctx.cur_index];
+    lv_profiler_builtin_item_t * item = &th->item_arr[head % profiler_ctx.item_num];
     item->func = func;
     item->tag = tag;
-    item->tick = profiler_ctx.config.tick_get_cb();
-    profiler_ctx.cur_index++;
+    if(profiler_ctx.config.tick_get_cb) item->tick = profiler_ctx.config.tick_get_cb();
+    else item->tick = profiler_ctx.config.tick_get64_cb();
+
+    /*Publish the item for the flushing thread*/
+    ATOMIC_STORE(&th->head, head + 1);
+}
+
+void lv_profiler_builtin_set_thread_name(const char * name)
+{
+    LV_ASSERT(profiler_ctx.item_num != 0);
+    LV_ASSERT_NULL(name);
+
+    lv_profiler_builtin_thread_t * th = get_thread();
+    if(th == NULL) return;
+
+    lv_strncpy(th->name, name, sizeof(th->name));
+    th->name[sizeof(th->name) - 1] = '\0';
+    th->name_flushed = false;
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the buffer of the current thread. A free buffer is claimed and allocated
+ * when the thread writes for the first time.
+ * @return the buffer or NULL if there are no free buffers
+ */
+static lv_profiler_builtin_thread_t * get_thread(void)
+{
+    int tid = profiler_ctx.config.tid_get_cb();
+
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_BUILTIN_THREAD_CNT; i++) {
+        lv_profiler_builtin_thread_t * th = &profiler_ctx.threads[i];
+        if(ATOMIC_LOAD(&th->state) == THREAD_STATE_READY && th->tid == tid) return th;
+    }
+
+    for(i = 0; i < LV_PROFILER_BUILTIN_THREAD_CNT; i++) {
+        lv_profiler_builtin_thread_t * th = &profiler_ctx.threads[i];
+        int state = THREAD_STATE_FREE;
+        if(!ATOMIC_CAS(&th->state, &state, THREAD_STATE_CLAIMING)) continue;
+
+        th->item_arr = lv_malloc(profiler_ctx.item_num * sizeof(lv_profiler_builtin_item_t));
+        LV_ASSERT_MALLOC(th->item_arr);
+        if(th->item_arr == NULL) {
+            ATOMIC_STORE(&th->state, THREAD_STATE_FREE);
+            return NULL;
+        }
+
+        th->tid = tid;
+        th->head = 0;
+        th->tail = 0;
+        th->name_flushed = false;
+        lv_strcpy(th->name, "LVGL");
+        ATOMIC_STORE(&th->state, THREAD_STATE_READY);
+        return th;
+    }
+
+    return NULL;
+}
+
+static void flush_thread(lv_profiler_builtin_thread_t * th)
+{
+    if(!th->name_flushed && profiler_ctx.config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON) {
+        char buf[LV_PROFILER_STR_MAX_LEN];
+        lv_snprintf(buf, sizeof(buf),
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+                    th->tid, th->name);
+        profiler_ctx.config.flush_cb(buf);
+    }
+    th->name_flushed = true;
+
+    /*The items written while flushing will be flushed next time*/
+    uint32_t head = ATOMIC_LOAD(&th->head);
+    uint32_t tail = th->tail;
+    while(tail != head) {
+        flush_item(th, &th->item_arr[tail % profiler_ctx.item_num]);
+        tail++;
+    }
+
+    /*Let the thread reuse the flushed items*/
+    ATOMIC_STORE(&th->tail, tail);
+}
+
+static void flush_item(const lv_profiler_builtin_thread_t * th, const lv_profiler_builtin_item_t * item)
+{
+    /*Convert the tick to nanoseconds without overflowing and split it
+     *as printf might not support 64 bit integers*/
+    uint32_t tick_per_sec = profiler_ctx.config.tick_per_sec;
+    uint32_t sec = (uint32_t)(item->tick / tick_per_sec);
+    uint32_t nsec = (uint32_t)((item->tick % tick_per_sec) * LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
+    uint32_t usec = nsec / 1000;
+
+    char buf[LV_PROFILER_STR_MAX_LEN];
+    if(profiler_ctx.config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON) {
+        /*The timestamps are in microseconds*/
+        char ts[32];
+        if(sec) lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32 "%06" LV_PRIu32 ".%03" LV_PRIu32, sec, usec, nsec % 1000);
+        else lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32 ".%03" LV_PRIu32, usec, nsec % 1000);
+
+        lv_snprintf(buf, sizeof(buf),
+                    "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%s,\"pid\":1,\"tid\":%d},\n",
+                    item->func,
+                    item->tag,
+                    ts,
+                    th->tid);
+    }
+    else {
+        lv_snprintf(buf, sizeof(buf),
+                    "   %s-%d [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
+                    th->name,
+                    th->tid,
+                    sec,
+                    usec,
+                    item->tag,
+                    item->func);
+    }
+
+    profiler_ctx.config.flush_cb(buf);
+}
+
 static void default_flush_cb(const char * buf)
 {
     LV_LOG("%s", buf);
 }
 
+static uint64_t default_tick_get64_cb(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+    return lv_tick_get();
+#endif
+}
+
+static int default_tid_get_cb(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+#if defined(__linux__) && defined(SYS_gettid)
+    return (int)syscall(SYS_gettid);
+#else
+    return (int)(uintptr_t)pthread_self();
+#endif
+#else
+    return 1;
+#endif
+}
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
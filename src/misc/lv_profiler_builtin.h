@@ -31,18 +31,32 @@ extern "C" {
 #define LV_PROFILER_BUILTIN_BEGIN           LV_PROFILER_BUILTIN_BEGIN_TAG(__func__)
 #define LV_PROFILER_BUILTIN_END             LV_PROFILER_BUILTIN_END_TAG(__func__)
 
+/*Maximum length of a thread's name including the closing '\0'*/
+#define LV_PROFILER_BUILTIN_THREAD_NAME_LEN 16
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * @brief Format of the flushed profiling data
+ */
+typedef enum {
+    LV_PROFILER_BUILTIN_FORMAT_SYSTRACE,    /**< Android systrace text format, see `scripts/trace_filter.py`*/
+    LV_PROFILER_BUILTIN_FORMAT_CHROME_JSON, /**< Chrome trace event JSON (array format), can be opened by Perfetto too*/
+} lv_profiler_builtin_format_t;
+
 /**
  * @brief LVGL profiler built-in configuration structure
  */
 typedef struct {
-    size_t buf_size;                    /**< The size of the buffer used for profiling data */
-    uint32_t tick_per_sec;              /**< The number of ticks per second */
-    uint32_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
+    size_t buf_size;                    /**< The size of the buffer used for profiling data of each thread */
+    uint32_t tick_per_sec;              /**< The number of ticks per second (at most 1000000000) */
+    uint32_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count. Used instead of `tick_get64_cb` if set */
+    uint64_t (*tick_get64_cb)(void);    /**< Callback function to get the current tick count as a 64-bit value */
     void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
+    int (*tid_get_cb)(void);            /**< Callback function to get the ID of the current thread */
+    lv_profiler_builtin_format_t format; /**< Format of the flushed profiling data */
 } lv_profiler_builtin_config_t;
 
 /**
@@ -50,17 +64,32 @@ typedef struct {
  */
 typedef struct {
     char tag;          /**< The tag of the profiler item */
-    uint32_t tick;     /**< The tick value of the profiler item */
+    uint64_t tick;     /**< The tick value of the profiler item */
     const char * func; /**< A pointer to the function associated with the profiler item */
 } lv_profiler_builtin_item_t;
 
+/**
+ * @brief Ring buffer of the profiler items of a thread.
+ * Only the thread itself writes it, and only the flushing reads it, so no lock is required.
+ */
+typedef struct {
+    lv_profiler_builtin_item_t * item_arr;         /**< Pointer to an array of profiler items */
+    uint32_t head;                                 /**< Number of items written. Changed only by the thread itself */
+    uint32_t tail;                                 /**< Number of items flushed. Changed only while flushing */
+    volatile int state;                            /**< The slot is free, being claimed or used by a thread */
+    int tid;                                       /**< ID of the thread using this buffer */
+    char name[LV_PROFILER_BUILTIN_THREAD_NAME_LEN]; /**< Name of the thread shown on the timeline */
+    bool name_flushed;                             /**< The name of the thread was already flushed */
+} lv_profiler_builtin_thread_t;
+
 /**
  * @brief Structure representing a context for the LVGL built-in profiler
  */
 typedef struct {
-    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
-    uint32_t item_num;                     /**< Number of profiler items in the array */
-    uint32_t cur_index;                    /**< Index of the current profiler item */
+    lv_profiler_builtin_thread_t threads[LV_PROFILER_BUILTIN_THREAD_CNT]; /**< Buffers of the profiled threads */
+    uint32_t item_num;                     /**< Number of profiler items in the buffer of each thread */
+    uint32_t dropped_cnt;                  /**< Number of items dropped as the buffer was full or no buffer was free */
+    int flush_lock;                        /**< Set while a thread is flushing the buffers */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
 } lv_profiler_builtin_ctx_t;
 
@@ -86,17 +115,24 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config);
 void lv_profiler_builtin_uninit(void);
 
 /**
- * @brief Flush the profiling data to the console
+ * @brief Flush the profiling data of all threads to the console
  */
 void lv_profiler_builtin_flush(void);
 
 /**
  * @brief Write the profiling data for a function with the given tag
+ * into the buffer of the current thread
  * @param func Name of the function being profiled
  * @param tag Tag to associate with the profiling data for the function
  */
 void lv_profiler_builtin_write(const char * func, char tag);
 
+/**
+ * @brief Set the name of the current thread shown on the timeline
+ * @param name Name of the thread, e.g. "draw_sw_0". It's copied.
+ */
+void lv_profiler_builtin_set_thread_name(const char * name);
+
 /**********************
  *      MACROS
  **********************/
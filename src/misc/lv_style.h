@@ -132,9 +132,11 @@ typedef uint8_t lv_border_side_t;
  * The direction of the gradient.
  */
 enum _lv_grad_dir_t {
-    LV_GRAD_DIR_NONE, /**< No gradient (the `grad_color` property is ignored)*/
-    LV_GRAD_DIR_VER,  /**< Vertical (top to bottom) gradient*/
-    LV_GRAD_DIR_HOR,  /**< Horizontal (left to right) gradient*/
+    LV_GRAD_DIR_NONE,    /**< No gradient (the `grad_color` property is ignored)*/
+    LV_GRAD_DIR_VER,     /**< Vertical (top to bottom) gradient*/
+    LV_GRAD_DIR_HOR,     /**< Horizontal (left to right) gradient*/
+    LV_GRAD_DIR_RADIAL,  /**< Radial gradient from the center to the closest side*/
+    LV_GRAD_DIR_CONICAL, /**< Conical gradient around the center, clockwise from the right*/
 };
 
 #ifdef DOXYGEN
@@ -157,7 +159,8 @@ typedef struct {
     lv_gradient_stop_t   stops[LV_GRADIENT_MAX_STOPS]; /**< A gradient stop array */
     uint8_t              stops_count;                  /**< The number of used stops in the array */
     lv_grad_dir_t        dir : 3;                      /**< The gradient direction.
-                                                        * Any of LV_GRAD_DIR_HOR, LV_GRAD_DIR_VER, LV_GRAD_DIR_NONE */
+                                                        * Any of LV_GRAD_DIR_HOR, LV_GRAD_DIR_VER, LV_GRAD_DIR_RADIAL,
+                                                        * LV_GRAD_DIR_CONICAL, LV_GRAD_DIR_NONE */
 } lv_grad_dsc_t;
 
 /**
@@ -14,12 +14,17 @@
 #include "lv_assert.h"
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    #define layout_cache LV_GLOBAL_DEFAULT()->text_layout_cache
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -47,6 +52,19 @@
     static uint32_t lv_text_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
     static uint32_t lv_text_iso8859_1_get_length(const char * txt);
 #endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    static lv_text_layout_t * layout_find(const char * text, uint32_t text_len, uint32_t hash, const lv_font_t * font,
+                                          int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+    static lv_text_layout_t * layout_create(const char * text, uint32_t text_len, const lv_font_t * font,
+                                            int32_t letter_space, int32_t max_width, lv_text_flag_t flag);
+    static uint32_t layout_hash(const char * text, uint32_t text_len, const lv_font_t * font, int32_t letter_space,
+                                int32_t max_width, lv_text_flag_t flag);
+    static bool layout_make_room(uint32_t mem_size);
+    static void layout_lru_unlink(lv_text_layout_t * layout);
+    static void layout_lru_push(lv_text_layout_t * layout);
+    static void layout_remove(lv_text_layout_t * layout);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -104,12 +122,33 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
     uint32_t new_line_start = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    /*Use the cached line breaks and widths*/
+    const lv_text_layout_t * layout = lv_text_layout_get(text, font, letter_space, max_width, flag);
+    uint32_t line_idx = 0;
+#endif
+
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
-        new_line_start += _lv_text_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+        int32_t act_line_length;
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+        if(layout) {
+            new_line_start = layout->line_ends[line_idx];
+            act_line_length = layout->line_widths[line_idx];
+            line_idx++;
+        }
+        else
+#endif
+        {
+            new_line_start += _lv_text_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+            act_line_length = lv_text_get_width(&text[line_start], new_line_start - line_start, font, letter_space);
+        }
 
         if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(int32_t)) {
             LV_LOG_WARN("integer overflow while calculating text height");
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+            if(layout) lv_text_layout_release(layout);
+#endif
             return;
         }
         else {
@@ -118,12 +157,14 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
         }
 
         /*Calculate the longest line*/
-        int32_t act_line_length = lv_text_get_width(&text[line_start], new_line_start - line_start, font, letter_space);
-
         size_res->x = LV_MAX(act_line_length, size_res->x);
         line_start  = new_line_start;
     }
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout) lv_text_layout_release(layout);
+#endif
+
     /*Make the text one line taller if the last character is '\n' or '\r'*/
     if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
         size_res->y += letter_height + line_space;
@@ -452,6 +493,128 @@ void _lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_
     *letter_next = *letter != '\0' ? _lv_text_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+
+const lv_text_layout_t * lv_text_layout_get(const char * text, const lv_font_t * font, int32_t letter_space,
+                                            int32_t max_width, lv_text_flag_t flag)
+{
+    if(text == NULL || font == NULL) return NULL;
+
+    /*The max. width doesn't matter in these cases so don't make it part of the key*/
+    if((flag & LV_TEXT_FLAG_EXPAND) || (flag & LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    uint32_t text_len = lv_strlen(text);
+    uint32_t hash = layout_hash(text, text_len, font, letter_space, max_width, flag);
+
+    lv_mutex_lock(&layout_cache.mutex);
+    lv_text_layout_t * layout = layout_find(text, text_len, hash, font, letter_space, max_width, flag);
+    if(layout) {
+        layout_cache.stat.hit_cnt++;
+        layout->used_cnt++;
+        layout_lru_unlink(layout);
+        layout_lru_push(layout);
+        lv_mutex_unlock(&layout_cache.mutex);
+        return layout;
+    }
+    layout_cache.stat.miss_cnt++;
+    lv_mutex_unlock(&layout_cache.mutex);
+
+    /*Measure the text without locking the cache*/
+    lv_text_layout_t * new_layout = layout_create(text, text_len, font, letter_space, max_width, flag);
+    if(new_layout == NULL) return NULL;
+    new_layout->hash = hash;
+    new_layout->used_cnt = 1;
+
+    lv_mutex_lock(&layout_cache.mutex);
+    /*Another thread might have added it in the meantime*/
+    layout = layout_find(text, text_len, hash, font, letter_space, max_width, flag);
+    if(layout) {
+        layout->used_cnt++;
+        lv_mutex_unlock(&layout_cache.mutex);
+        lv_free(new_layout);
+        return layout;
+    }
+
+    if(new_layout->mem_size <= LV_TEXT_LAYOUT_CACHE_SIZE && layout_make_room(new_layout->mem_size)) {
+        lv_text_layout_t ** bucket = &layout_cache.buckets[hash & (LV_TEXT_LAYOUT_CACHE_BUCKETS - 1)];
+        new_layout->next = *bucket;
+        *bucket = new_layout;
+        layout_lru_push(new_layout);
+        layout_cache.stat.entry_cnt++;
+        layout_cache.stat.mem_size += new_layout->mem_size;
+    }
+    else {
+        /*Use it only once if it doesn't fit*/
+        new_layout->temporary = 1;
+    }
+    lv_mutex_unlock(&layout_cache.mutex);
+
+    return new_layout;
+}
+
+void lv_text_layout_release(const lv_text_layout_t * layout)
+{
+    lv_text_layout_t * l = (lv_text_layout_t *)layout;
+    if(l->temporary) {
+        lv_free(l);
+        return;
+    }
+
+    lv_mutex_lock(&layout_cache.mutex);
+    LV_ASSERT(l->used_cnt > 0);
+    l->used_cnt--;
+    lv_mutex_unlock(&layout_cache.mutex);
+}
+
+void lv_text_layout_cache_drop(const lv_font_t * font)
+{
+    lv_mutex_lock(&layout_cache.mutex);
+    lv_text_layout_t * layout = layout_cache.lru_tail;
+    while(layout) {
+        lv_text_layout_t * prev = layout->lru_prev;
+        if(layout->used_cnt == 0 && (font == NULL || layout->font == font)) {
+            layout_remove(layout);
+            layout_cache.stat.evict_cnt++;
+        }
+        layout = prev;
+    }
+    lv_mutex_unlock(&layout_cache.mutex);
+}
+
+void lv_text_layout_cache_get_stat(lv_text_layout_cache_stat_t * stat)
+{
+    lv_mutex_lock(&layout_cache.mutex);
+    *stat = layout_cache.stat;
+    lv_mutex_unlock(&layout_cache.mutex);
+}
+
+void lv_text_layout_cache_reset_stat(void)
+{
+    lv_mutex_lock(&layout_cache.mutex);
+    layout_cache.stat.hit_cnt = 0;
+    layout_cache.stat.miss_cnt = 0;
+    layout_cache.stat.evict_cnt = 0;
+    lv_mutex_unlock(&layout_cache.mutex);
+}
+
+void _lv_text_layout_cache_init(void)
+{
+    lv_memzero(&layout_cache, sizeof(_lv_text_layout_cache_t));
+    lv_mutex_init(&layout_cache.mutex);
+}
+
+void _lv_text_layout_cache_deinit(void)
+{
+    while(layout_cache.lru_head) {
+        layout_remove(layout_cache.lru_head);
+    }
+
+    lv_mutex_delete(&layout_cache.mutex);
+    lv_memzero(&layout_cache, sizeof(_lv_text_layout_cache_t));
+}
+
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -818,3 +981,171 @@ static uint32_t lv_text_iso8859_1_get_length(const char * txt)
 #error "Invalid character encoding. See `LV_TXT_ENC` in `lv_conf.h`"
 
 #endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+/*******************************
+ *   LAYOUT CACHE
+ ******************************/
+
+static lv_text_layout_t * layout_find(const char * text, uint32_t text_len, uint32_t hash, const lv_font_t * font,
+                                      int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    lv_text_layout_t * layout;
+    for(layout = layout_cache.buckets[hash & (LV_TEXT_LAYOUT_CACHE_BUCKETS - 1)]; layout; layout = layout->next) {
+        if(layout->hash == hash && layout->font == font && layout->text_len == text_len &&
+           layout->letter_space == letter_space && layout->max_width == max_width && layout->flag == flag &&
+           lv_strcmp(layout->text, text) == 0) {
+            return layout;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Break the text into lines and measure them.
+ * The layout, the lines and a copy of the text are stored in one allocation.
+ */
+static lv_text_layout_t * layout_create(const char * text, uint32_t text_len, const lv_font_t * font,
+                                        int32_t letter_space, int32_t max_width, lv_text_flag_t flag)
+{
+    uint32_t line_buf_cnt = 8;
+    uint32_t * line_ends = lv_malloc(line_buf_cnt * sizeof(uint32_t));
+    int32_t * line_widths = lv_malloc(line_buf_cnt * sizeof(int32_t));
+    uint32_t line_cnt = 0;
+    int32_t max_line_width = 0;
+
+    uint32_t line_start = 0;
+    while(line_ends && line_widths && text[line_start] != '\0') {
+        if(line_cnt == line_buf_cnt) {
+            line_buf_cnt *= 2;
+            uint32_t * new_ends = lv_realloc(line_ends, line_buf_cnt * sizeof(uint32_t));
+            if(new_ends) line_ends = new_ends;
+            int32_t * new_widths = lv_realloc(line_widths, line_buf_cnt * sizeof(int32_t));
+            if(new_widths) line_widths = new_widths;
+            if(new_ends == NULL || new_widths == NULL) {
+                lv_free(line_ends);
+                lv_free(line_widths);
+                return NULL;
+            }
+        }
+
+        uint32_t line_end = line_start + _lv_text_get_next_line(&text[line_start], font, letter_space, max_width, NULL,
+                                                                flag);
+        line_ends[line_cnt] = line_end;
+        line_widths[line_cnt] = lv_text_get_width(&text[line_start], line_end - line_start, font, letter_space);
+        max_line_width = LV_MAX(max_line_width, line_widths[line_cnt]);
+        line_cnt++;
+        line_start = line_end;
+    }
+
+    uint32_t mem_size = sizeof(lv_text_layout_t) + line_cnt * (sizeof(uint32_t) + sizeof(int32_t)) + text_len + 1;
+    lv_text_layout_t * layout = NULL;
+    if(line_ends && line_widths) {
+        layout = lv_malloc_zeroed(mem_size);
+        LV_ASSERT_MALLOC(layout);
+    }
+
+    if(layout) {
+        uint32_t * ends = (uint32_t *)(layout + 1);
+        int32_t * widths = (int32_t *)(ends + line_cnt);
+        char * text_copy = (char *)(widths + line_cnt);
+        lv_memcpy(ends, line_ends, line_cnt * sizeof(uint32_t));
+        lv_memcpy(widths, line_widths, line_cnt * sizeof(int32_t));
+        lv_memcpy(text_copy, text, text_len + 1);
+
+        layout->font = font;
+        layout->text = text_copy;
+        layout->text_len = text_len;
+        layout->letter_space = letter_space;
+        layout->max_width = max_width;
+        layout->flag = flag;
+        layout->line_cnt = line_cnt;
+        layout->line_ends = ends;
+        layout->line_widths = widths;
+        layout->max_line_width = max_line_width;
+        layout->mem_size = mem_size;
+    }
+
+    lv_free(line_ends);
+    lv_free(line_widths);
+
+    return layout;
+}
+
+static uint32_t layout_hash(const char * text, uint32_t text_len, const lv_font_t * font, int32_t letter_space,
+                            int32_t max_width, lv_text_flag_t flag)
+{
+    /*FNV-1a*/
+    uint32_t hash = 2166136261U;
+    uint32_t i;
+    for(i = 0; i < text_len; i++) {
+        hash = (hash ^ (uint8_t)text[i]) * 16777619U;
+    }
+
+    hash = (hash ^ (uint32_t)((lv_uintptr_t)font >> 4)) * 16777619U;
+    hash = (hash ^ (uint32_t)letter_space) * 16777619U;
+    hash = (hash ^ (uint32_t)max_width) * 16777619U;
+    hash = (hash ^ flag) * 16777619U;
+
+    return hash;
+}
+
+/**
+ * Drop the least recently used unused layouts until `mem_size` bytes fit into the cache.
+ * The mutex needs to be locked.
+ * @return  false: the layouts in use leave not enough space
+ */
+static bool layout_make_room(uint32_t mem_size)
+{
+    lv_text_layout_t * layout = layout_cache.lru_tail;
+    while(layout_cache.stat.mem_size + mem_size > LV_TEXT_LAYOUT_CACHE_SIZE) {
+        while(layout && layout->used_cnt) layout = layout->lru_prev;
+        if(layout == NULL) return false;
+
+        lv_text_layout_t * prev = layout->lru_prev;
+        layout_remove(layout);
+        layout_cache.stat.evict_cnt++;
+        layout = prev;
+    }
+
+    return true;
+}
+
+static void layout_lru_unlink(lv_text_layout_t * layout)
+{
+    if(layout->lru_prev) layout->lru_prev->lru_next = layout->lru_next;
+    else layout_cache.lru_head = layout->lru_next;
+
+    if(layout->lru_next) layout->lru_next->lru_prev = layout->lru_prev;
+    else layout_cache.lru_tail = layout->lru_prev;
+
+    layout->lru_prev = NULL;
+    layout->lru_next = NULL;
+}
+
+static void layout_lru_push(lv_text_layout_t * layout)
+{
+    layout->lru_prev = NULL;
+    layout->lru_next = layout_cache.lru_head;
+    if(layout_cache.lru_head) layout_cache.lru_head->lru_prev = layout;
+    else layout_cache.lru_tail = layout;
+    layout_cache.lru_head = layout;
+}
+
+/**
+ * Remove a layout from the cache and free it. The mutex needs to be locked.
+ */
+static void layout_remove(lv_text_layout_t * layout)
+{
+    lv_text_layout_t ** p = &layout_cache.buckets[layout->hash & (LV_TEXT_LAYOUT_CACHE_BUCKETS - 1)];
+    while(*p != layout) p = &(*p)->next;
+    *p = layout->next;
+
+    layout_lru_unlink(layout);
+    layout_cache.stat.entry_cnt--;
+    layout_cache.stat.mem_size -= layout->mem_size;
+    lv_free(layout);
+}
+
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
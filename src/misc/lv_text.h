@@ -21,6 +21,7 @@ extern "C" {
 #include "../font/lv_font.h"
 #include "../stdlib/lv_sprintf.h"
 #include "lv_types.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +30,10 @@ extern "C" {
 #define LV_TXT_ENC_UTF8 1
 #define LV_TXT_ENC_ASCII 2
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+#define LV_TEXT_LAYOUT_CACHE_BUCKETS 128
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -63,6 +68,45 @@ typedef _lv_text_align_t lv_text_align_t;
 typedef uint8_t lv_text_align_t;
 #endif /*DOXYGEN*/
 
+/** The line breaks and line widths of a text*/
+typedef struct _lv_text_layout_t {
+    struct _lv_text_layout_t * next;        /**< Next layout in the same hash bucket*/
+    struct _lv_text_layout_t * lru_prev;    /**< The more recently used layout*/
+    struct _lv_text_layout_t * lru_next;    /**< The less recently used layout*/
+    const lv_font_t * font;
+    const char * text;          /**< Copy of the text to verify the match*/
+    uint32_t text_len;          /**< Length of the text in bytes*/
+    uint32_t hash;              /**< Hash of the text and the parameters*/
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+    uint8_t temporary : 1;      /**< 1: not in the cache, freed when released*/
+    uint32_t line_cnt;
+    const uint32_t * line_ends; /**< Byte index of the start of the next line for each line*/
+    const int32_t * line_widths;
+    int32_t max_line_width;     /**< The width of the longest line*/
+    uint32_t mem_size;          /**< Allocated memory of the layout [bytes]*/
+    uint32_t used_cnt;          /**< Number of users of the layout*/
+} lv_text_layout_t;
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of layouts found in the cache*/
+    uint32_t miss_cnt;          /**< Number of layouts which needed to be calculated*/
+    uint32_t evict_cnt;         /**< Number of layouts dropped from the cache*/
+    uint32_t entry_cnt;         /**< Number of cached layouts*/
+    uint32_t mem_size;          /**< Memory used by the cached layouts [bytes]*/
+} lv_text_layout_cache_stat_t;
+
+typedef struct {
+    lv_text_layout_t * buckets[LV_TEXT_LAYOUT_CACHE_BUCKETS];
+    lv_text_layout_t * lru_head;    /**< The most recently used layout*/
+    lv_text_layout_t * lru_tail;    /**< The least recently used layout*/
+    lv_text_layout_cache_stat_t stat;
+    lv_mutex_t mutex;
+} _lv_text_layout_cache_t;
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -109,6 +153,49 @@ uint32_t _lv_text_get_next_line(const char * txt, const lv_font_t * font, int32_
  */
 int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * font, int32_t letter_space);
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+/**
+ * Get the line breaks and line widths of a text from the layout cache. Calculate them if they are not cached yet.
+ * The lines are the same as the ones given by `_lv_text_get_next_line` and `lv_text_get_width`.
+ * @param text          a '\0' terminated string
+ * @param font          pointer to a font
+ * @param letter_space  letter space
+ * @param max_width     max width of the text (break the lines to fit this size)
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @return              the layout which needs to be released with `lv_text_layout_release`,
+ *                      or NULL if `text` or `font` is NULL or out of memory
+ */
+const lv_text_layout_t * lv_text_layout_get(const char * text, const lv_font_t * font, int32_t letter_space,
+                                            int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Release a layout get with `lv_text_layout_get`
+ * @param layout        pointer to a layout
+ */
+void lv_text_layout_release(const lv_text_layout_t * layout);
+
+/**
+ * Free the cached layouts which are not used. Needs to be called if the metrics of a font change.
+ * @param font          free the layouts of this font only, or NULL to free the layouts of all the fonts
+ */
+void lv_text_layout_cache_drop(const lv_font_t * font);
+
+/**
+ * Get the statistics of the layout cache. The hit rate is `hit_cnt / (hit_cnt + miss_cnt)`.
+ * @param stat          store the statistics here
+ */
+void lv_text_layout_cache_get_stat(lv_text_layout_cache_stat_t * stat);
+
+/**
+ * Reset the hit, miss and evict counters of the layout cache
+ */
+void lv_text_layout_cache_reset_stat(void);
+
+void _lv_text_layout_cache_init(void);
+
+void _lv_text_layout_cache_deinit(void);
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
+
 /**
  * Insert a string into an other
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
@@ -75,6 +75,10 @@ void lv_imgfont_destroy(lv_font_t * font)
 {
     LV_ASSERT_NULL(font);
 
+    lv_font_glyph_cache_drop(font);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_cache_drop(font);
+#endif
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_free(dsc);
 }
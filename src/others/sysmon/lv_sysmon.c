@@ -160,6 +160,12 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.fps) / info->calculated.run_cnt;
 
+#if LV_USE_DRAW_STAT
+    /*The timers run between the refreshes so no draw unit is rendering now*/
+    lv_draw_stat_get(&info->draw_stat);
+    lv_draw_stat_reset();
+#endif
+
     lv_subject_set_pointer(&sysmon_perf.subject, info);
 
     lv_sysmon_perf_info_t prev_info = *info;
@@ -184,6 +190,24 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt, perf->measured.flush_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_real_avg_time, perf->calculated.flush_avg_time,
            perf->calculated.cpu);
+
+#if LV_USE_DRAW_STAT
+    const lv_draw_stat_t * draw_stat = &perf->draw_stat;
+    uint32_t render_time = 0;
+    uint32_t blend_px_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_TYPE_CNT; i++) {
+        render_time += draw_stat->types[i].render_time;
+        blend_px_cnt += draw_stat->types[i].blend_px_cnt;
+    }
+    uint64_t unit_time = (uint64_t)draw_stat->elapsed_time * draw_stat->unit_cnt;
+    uint32_t busy_pct = unit_time ? (uint32_t)((uint64_t)render_time * 100 / unit_time) : 0;
+    LV_LOG("sysmon: "
+           "%" LV_PRIu32 " draw tasks (dispatched: %" LV_PRIu32 " | stalled: %" LV_PRIu32 "), "
+           "%" LV_PRIu32 " kpx blended, draw units busy %" LV_PRIu32 "%%, layers peak %" LV_PRIu32 " kB\n",
+           draw_stat->task_created_cnt, draw_stat->task_dispatched_cnt, draw_stat->task_stall_cnt,
+           blend_px_cnt / 1000, busy_pct, draw_stat->layer_mem_peak_kb);
+#endif
 #else
     lv_label_set_text_fmt(
         label,
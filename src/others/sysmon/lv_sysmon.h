@@ -16,6 +16,7 @@ extern "C" {
 
 #include "../../misc/lv_timer.h"
 #include "../../others/observer/lv_observer.h"
+#include "../../draw/lv_draw.h"
 
 #if LV_USE_SYSMON
 
@@ -67,6 +68,10 @@ typedef struct {
         uint32_t run_cnt;
     } calculated;
 
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_t draw_stat;   /**< Rendering statistics since the previous update*/
+#endif
+
 } lv_sysmon_perf_info_t;
 #endif
 
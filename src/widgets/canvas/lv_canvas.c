@@ -110,6 +110,9 @@ void lv_canvas_set_px(lv_obj_t * obj, int32_t x, int32_t y, lv_color_t color, lv
     else if(cf == LV_COLOR_FORMAT_A8) {
         *data = opa;
     }
+    else if(cf == LV_COLOR_FORMAT_L8) {
+        *data = lv_color_luminance(color);
+    }
     else if(cf == LV_COLOR_FORMAT_RGB565) {
         lv_color16_t * buf = (lv_color16_t *)data;
         buf->red = color.red >> 3;
@@ -190,6 +193,12 @@ lv_color32_t lv_canvas_get_px(lv_obj_t * obj, int32_t x, int32_t y)
                 ret.alpha = px[0];
                 break;
             }
+        case LV_COLOR_FORMAT_L8:
+            ret.red = px[0];
+            ret.green = px[0];
+            ret.blue = px[0];
+            ret.alpha = 0xFF;
+            break;
         default:
             lv_memzero(&ret, sizeof(lv_color32_t));
             break;
@@ -262,11 +271,16 @@ void lv_canvas_fill_bg(lv_obj_t * obj, lv_color_t color, lv_opa_t opa)
             }
         }
     }
-    else if(dsc->header.cf == LV_COLOR_FORMAT_XRGB8888 || dsc->header.cf == LV_COLOR_FORMAT_ARGB8888) {
+    else if(dsc->header.cf == LV_COLOR_FORMAT_XRGB8888 || dsc->header.cf == LV_COLOR_FORMAT_ARGB8888 ||
+            dsc->header.cf == LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED) {
         uint32_t c32 = lv_color_to_u32(color);
         if(dsc->header.cf == LV_COLOR_FORMAT_ARGB8888) {
             c32 &= 0x00ffffff;
-            c32 |= opa << 24;
+            c32 |= (uint32_t)opa << 24;
+        }
+        else if(dsc->header.cf == LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED) {
+            lv_color32_t c = lv_color32_premultiply(lv_color_to_32(color, opa));
+            lv_memcpy(&c32, &c, sizeof(c32));
         }
         for(y = 0; y < dsc->header.h; y++) {
             uint32_t * buf32 = (uint32_t *)(dsc->data + y * stride);
@@ -55,6 +55,17 @@ static void copy_text_to_label(lv_label_t * label, const char * text);
 static lv_text_flag_t get_label_flags(lv_label_t * label);
 static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, const char * txt,
                                    uint32_t length, const lv_font_t * font, int32_t letter_space, lv_area_t * txt_coords);
+#if LV_LABEL_LINE_INDEX
+    static bool line_index_is_usable(lv_obj_t * obj);
+    static bool line_index_is_valid(lv_obj_t * obj);
+    static const lv_label_line_index_t * line_index_get(lv_obj_t * obj);
+    static bool line_index_update(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len);
+    static uint32_t line_index_break(lv_obj_t * obj, uint32_t first, uint32_t byte_pos, uint32_t del_len,
+                                     uint32_t ins_len);
+    static void line_index_invalidate_lines(lv_obj_t * obj, uint32_t first, uint32_t last);
+    static uint32_t line_index_find_byte(const lv_label_line_index_t * index, uint32_t byte_id);
+    static void line_index_get_size(lv_obj_t * obj, lv_point_t * size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -100,13 +111,20 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     /*If text is NULL then just refresh with the current text*/
     if(text == NULL) text = label->text;
 
+#if LV_LABEL_LINE_INDEX
+    label->line_index.valid = 0;
+#endif
+
     const size_t text_len = get_text_length(text);
 
-    /*If set its own text then reallocate it (maybe its size changed)*/
+    /*If set its own text then reallocate it if it doesn't fit anymore (maybe its size changed)*/
     if(label->text == text && label->static_txt == 0) {
-        label->text = lv_realloc(label->text, text_len);
-        LV_ASSERT_MALLOC(label->text);
-        if(label->text == NULL) return;
+        if(text_len > label->text_size) {
+            label->text = lv_realloc(label->text, text_len);
+            LV_ASSERT_MALLOC(label->text);
+            if(label->text == NULL) return;
+            label->text_size = text_len;
+        }
 
 #if LV_USE_ARABIC_PERSIAN_CHARS
         _lv_text_ap_proc(label->text, label->text);
@@ -123,6 +141,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->text = lv_malloc(text_len);
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
+        label->text_size = text_len;
 
         copy_text_to_label(label, text);
 
@@ -141,6 +160,10 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
 
+#if LV_LABEL_LINE_INDEX
+    label->line_index.valid = 0;
+#endif
+
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
         lv_label_refr_text(obj);
@@ -157,6 +180,7 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     label->text = _lv_text_set_text_vfmt(fmt, args);
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
+    label->text_size = label->text ? lv_strlen(label->text) + 1 : 0;
 
     lv_label_refr_text(obj);
 }
@@ -166,6 +190,10 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_label_t * label = (lv_label_t *)obj;
 
+#if LV_LABEL_LINE_INDEX
+    label->line_index.valid = 0;
+#endif
+
     if(label->static_txt == 0 && label->text != NULL) {
         lv_free(label->text);
         label->text = NULL;
@@ -174,6 +202,7 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
     if(text != NULL) {
         label->static_txt = 1;
         label->text       = (char *)text;
+        label->text_size  = 0;
     }
 
     lv_label_refr_text(obj);
@@ -295,13 +324,26 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     int32_t y = 0;
     uint32_t line_start = 0;
     uint32_t new_line_start = 0;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+#if LV_LABEL_LINE_INDEX
+    const lv_label_line_index_t * index = line_index_get((lv_obj_t *)obj);
+    if(index) {
+        /*Look up the line of the letter*/
+        uint32_t line_idx = line_index_find_byte(index, byte_id);
+        line_start = line_idx > 0 ? index->line_ends[line_idx - 1] : 0;
+        new_line_start = index->line_ends[line_idx];
+        y = (int32_t)line_idx * (letter_height + line_space);
+    }
+    else
+#endif
+    {
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -379,22 +421,49 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
     lv_text_flag_t flag = get_label_flags(label);
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    /*Search the line of the index letter*/;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+    bool line_found = false;
+#if LV_LABEL_LINE_INDEX
+    const lv_label_line_index_t * index = line_index_get((lv_obj_t *)obj);
+    if(index && letter_height + line_space > 0) {
+        /*Jump to the line under the position*/
+        const int32_t line_height = letter_height + line_space;
+        uint32_t line_idx = 0;
+        if(pos.y > letter_height) line_idx = (pos.y - letter_height + line_height - 1) / line_height;
+
+        if(line_idx < index->line_cnt) {
+            line_start = line_idx > 0 ? index->line_ends[line_idx - 1] : 0;
+            new_line_start = index->line_ends[line_idx];
+            line_found = true;
+        }
+        else {
+            line_start = index->line_cnt > 0 ? index->line_ends[index->line_cnt - 1] : 0;
+            new_line_start = line_start;
+        }
+    }
+    else
+#endif
+    {
+        /*Search the line of the index letter*/
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_text_get_next_line(&txt[line_start], font, letter_space, max_w, NULL, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                line_found = true;
+                break;
+            }
+            y += letter_height + line_space;
 
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
-            /*Include the NULL terminator in the last line*/
-            uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = _lv_text_encoded_prev(txt, &tmp);
-            if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
+            line_start = new_line_start;
         }
-        y += letter_height + line_space;
+    }
 
-        line_start = new_line_start;
+    if(line_found) {
+        /*Include the NULL terminator in the last line*/
+        uint32_t tmp = new_line_start;
+        uint32_t letter;
+        letter = _lv_text_encoded_prev(txt, &tmp);
+        if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
     }
 
     char * bidi_txt;
@@ -570,22 +639,43 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     /*Can not append to static text*/
     if(label->static_txt != 0) return;
 
-    lv_obj_invalidate(obj);
-
-    /*Allocate space for the new text*/
+    /*Allocate space for the new text. Allocate some more to not reallocate the text for each inserted character.*/
     size_t old_len = lv_strlen(label->text);
     size_t ins_len = lv_strlen(txt);
     size_t new_len = ins_len + old_len;
-    label->text        = lv_realloc(label->text, new_len + 1);
-    LV_ASSERT_MALLOC(label->text);
-    if(label->text == NULL) return;
+    if(new_len + 1 > label->text_size) {
+        size_t text_size = new_len + 1 + new_len / 4;
+        char * text = lv_realloc(label->text, text_size);
+        LV_ASSERT_MALLOC(text);
+        if(text == NULL) return;
+        label->text = text;
+        label->text_size = text_size;
+    }
+
+    uint32_t byte_pos = pos == LV_LABEL_POS_LAST ? old_len : _lv_text_encoded_get_byte_id(label->text, pos);
+
+    /*Move the end of the text (with the '\0') to make place for the new text*/
+    lv_memmove(&label->text[byte_pos + ins_len], &label->text[byte_pos], old_len - byte_pos + 1);
+    lv_memcpy(&label->text[byte_pos], txt, ins_len);
 
-    if(pos == LV_LABEL_POS_LAST) {
-        pos = _lv_text_get_encoded_length(label->text);
+#if LV_LABEL_LINE_INDEX
+    /*Break and redraw only the changed lines.
+     *Non-ASCII letters might change the Arabic letters around them so refresh the whole text then.*/
+    if((LV_USE_ARABIC_PERSIAN_CHARS == 0 || _lv_text_get_encoded_length(txt) == ins_len) &&
+       line_index_update(obj, byte_pos, 0, ins_len)) {
+        return;
     }
+#endif
 
-    _lv_text_ins(label->text, pos, txt);
+    lv_obj_invalidate(obj);
+#if LV_USE_ARABIC_PERSIAN_CHARS
     lv_label_set_text(obj, NULL);
+#else
+#if LV_LABEL_LINE_INDEX
+    label->line_index.valid = 0;
+#endif
+    lv_label_refr_text(obj);
+#endif
 }
 
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
@@ -596,13 +686,22 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     /*Can not append to static text*/
     if(label->static_txt) return;
 
-    lv_obj_invalidate(obj);
-
     char * label_txt = lv_label_get_text(obj);
+#if LV_LABEL_LINE_INDEX
+    uint32_t byte_pos = _lv_text_encoded_get_byte_id(label_txt, pos);
+    uint32_t del_len = _lv_text_encoded_get_byte_id(&label_txt[byte_pos], cnt);
+#endif
+
     /*Delete the characters*/
     _lv_text_cut(label_txt, pos, cnt);
 
+#if LV_LABEL_LINE_INDEX
+    /*Break and redraw only the changed lines*/
+    if(line_index_update(obj, byte_pos, del_len, 0)) return;
+#endif
+
     /*Refresh the label*/
+    lv_obj_invalidate(obj);
     lv_label_refr_text(obj);
 }
 
@@ -633,6 +732,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
 #endif
+
+#if LV_LABEL_LINE_INDEX
+    lv_memzero(&label->line_index, sizeof(lv_label_line_index_t));
+#endif
     label->dot.tmp_ptr   = NULL;
     label->dot_tmp_alloc = 0;
 
@@ -651,6 +754,13 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LINE_INDEX
+    lv_free(label->line_index.line_ends);
+    lv_free(label->line_index.line_widths);
+    label->line_index.line_ends = NULL;
+    label->line_index.line_widths = NULL;
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -728,6 +838,15 @@ static void draw_main(lv_event_t * e)
     }
 #endif
 
+#if LV_LABEL_LINE_INDEX
+    const lv_label_line_index_t * index = line_index_get(obj);
+    if(index) {
+        label_draw_dsc.line_ends = index->line_ends;
+        label_draw_dsc.line_cnt = index->line_cnt;
+        label_draw_dsc.hint = NULL;
+    }
+#endif
+
     label_draw_dsc.flag = flag;
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
@@ -852,7 +971,18 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+#if LV_LABEL_LINE_INDEX
+    if(line_index_is_valid(obj)) {
+        /*The lines are already known, no need to measure the text again*/
+        line_index_get_size(obj, &size);
+        label->size_cache = size;
+        label->invalid_size_cache = false;
+    }
+    else
+#endif
+    {
+        lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    }
 
     lv_obj_refresh_self_size(obj);
 
@@ -1262,4 +1392,281 @@ static void calculate_x_coordinate(int32_t * x, const lv_text_align_t align, con
     }
 }
 
+#if LV_LABEL_LINE_INDEX
+/**
+ * Tell whether the line index can be used with the current long mode and width of the label
+ */
+static bool line_index_is_usable(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->long_mode != LV_LABEL_LONG_WRAP || label->expand) return false;
+    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) return false;
+
+    return true;
+}
+
+/**
+ * Tell whether the line index matches the current text, style and size of the label
+ */
+static bool line_index_is_valid(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_label_line_index_t * index = &label->line_index;
+    if(!index->valid || !line_index_is_usable(obj)) return false;
+
+    return index->font == lv_obj_get_style_text_font(obj, LV_PART_MAIN) &&
+           index->letter_space == lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN) &&
+           index->max_width == lv_obj_get_content_width(obj);
+}
+
+/**
+ * Get the line index of a label and create it if the text is long enough
+ * @return the line index or NULL if it's not used
+ */
+static const lv_label_line_index_t * line_index_get(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_index_t * index = &label->line_index;
+    if(line_index_is_valid(obj)) return index;
+
+    /*Short texts are fast to measure anyway*/
+    if(!line_index_is_usable(obj) || label->text == NULL) return NULL;
+    if(lv_obj_get_content_height(obj) < LV_LABEL_HINT_HEIGHT_LIMIT) return NULL;
+
+    index->font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    index->letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    index->max_width = lv_obj_get_content_width(obj);
+    index->line_cnt = 0;
+    index->valid = 1;
+    line_index_break(obj, 0, 0, 0, 0);
+
+    return index->valid ? index : NULL;
+}
+
+/**
+ * Update the line index after the text was changed, refresh the size of the label and
+ * invalidate only the changed lines
+ * @param obj       pointer to a label object
+ * @param byte_pos  byte index of the change
+ * @param del_len   number of deleted bytes at `byte_pos`
+ * @param ins_len   number of inserted bytes at `byte_pos`
+ * @return          true: the label is refreshed; false: there is no valid index, the whole label needs to be refreshed
+ */
+static bool line_index_update(lv_obj_t * obj, uint32_t byte_pos, uint32_t del_len, uint32_t ins_len)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_index_t * index = &label->line_index;
+    if(!line_index_is_valid(obj)) {
+        index->valid = 0;
+        return false;
+    }
+
+    /*The text before `byte_pos` is not changed so the lines there can be used to find where to start*/
+    const char * txt = label->text;
+    uint32_t first = line_index_find_byte(index, byte_pos);
+
+    /*A word broken into more lines depends on its beginning, so start at the line of the word's beginning*/
+    while(first > 0) {
+        char c = txt[index->line_ends[first - 1] - 1];
+        if(c == '\n' || c == '\r' || _lv_text_is_break_char((uint8_t)c)) break;
+        first--;
+    }
+
+    /*A word might fit to the end of the previous line after the change*/
+    if(first > 0) first--;
+
+    uint32_t old_line_cnt = index->line_cnt;
+    uint32_t new_cnt = line_index_break(obj, first, byte_pos, del_len, ins_len);
+    if(!index->valid) return false;
+
+#if LV_LABEL_LONG_TXT_HINT
+    label->hint.line_start = -1; /*The hint is invalid if the text changes*/
+#endif
+    line_index_get_size(obj, &label->size_cache);
+    label->invalid_size_cache = false;
+    lv_obj_refresh_self_size(obj);
+
+    /*The lines after the changed ones are moved only if the number of lines has changed*/
+    line_index_invalidate_lines(obj, first, index->line_cnt == old_line_cnt ? first + new_cnt : UINT32_MAX);
+
+    return true;
+}
+
+/**
+ * Break the text into lines from the `first` line until a line ends where a line ended before the change.
+ * The rest of the lines are the same, just shifted.
+ * @param obj       pointer to a label object
+ * @param first     index of the first line to break again
+ * @param byte_pos  byte index of the change
+ * @param del_len   number of deleted bytes at `byte_pos`
+ * @param ins_len   number of inserted bytes at `byte_pos`
+ * @return          number of lines broken again
+ */
+static uint32_t line_index_break(lv_obj_t * obj, uint32_t first, uint32_t byte_pos, uint32_t del_len,
+                                 uint32_t ins_len)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_label_line_index_t * index = &label->line_index;
+    const char * txt = label->text;
+
+    /*Collect the new lines separately as the old ones are needed to find where they become the same*/
+    uint32_t buf_cnt = 8;
+    uint32_t * new_ends = lv_malloc(buf_cnt * sizeof(uint32_t));
+    int32_t * new_widths = lv_malloc(buf_cnt * sizeof(int32_t));
+    bool ok = new_ends != NULL && new_widths != NULL;
+    uint32_t new_cnt = 0;
+    uint32_t old_idx = first;
+    uint32_t same_idx = index->line_cnt;    /*The first old line which is the same after the change*/
+    uint32_t line_start = first > 0 ? index->line_ends[first - 1] : 0;
+
+    while(ok && txt[line_start] != '\0') {
+        if(new_cnt == buf_cnt) {
+            buf_cnt *= 2;
+            uint32_t * ends_tmp = lv_realloc(new_ends, buf_cnt * sizeof(uint32_t));
+            if(ends_tmp) new_ends = ends_tmp;
+            int32_t * widths_tmp = lv_realloc(new_widths, buf_cnt * sizeof(int32_t));
+            if(widths_tmp) new_widths = widths_tmp;
+            if(ends_tmp == NULL || widths_tmp == NULL) {
+                ok = false;
+                break;
+            }
+        }
+
+        uint32_t line_end = line_start + _lv_text_get_next_line(&txt[line_start], index->font, index->letter_space,
+                                                                index->max_width, NULL, LV_TEXT_FLAG_NONE);
+        new_ends[new_cnt] = line_end;
+        new_widths[new_cnt] = lv_text_get_width(&txt[line_start], line_end - line_start, index->font, index->letter_space);
+        new_cnt++;
+        line_start = line_end;
+
+        /*After the changed part the same text follows a line end as before*/
+        if(line_end >= byte_pos + ins_len) {
+            while(old_idx < index->line_cnt && index->line_ends[old_idx] + ins_len < line_end + del_len) old_idx++;
+            if(old_idx < index->line_cnt && index->line_ends[old_idx] + ins_len == line_end + del_len) {
+                same_idx = old_idx + 1;
+                break;
+            }
+        }
+    }
+
+    uint32_t same_cnt = index->line_cnt - same_idx;
+    uint32_t line_cnt = first + new_cnt + same_cnt;
+    if(ok && line_cnt > index->line_buf_cnt) {
+        /*Leave some space for the next lines*/
+        uint32_t line_buf_cnt = line_cnt + line_cnt / 4 + 8;
+        uint32_t * ends_tmp = lv_realloc(index->line_ends, line_buf_cnt * sizeof(uint32_t));
+        if(ends_tmp) index->line_ends = ends_tmp;
+        int32_t * widths_tmp = lv_realloc(index->line_widths, line_buf_cnt * sizeof(int32_t));
+        if(widths_tmp) index->line_widths = widths_tmp;
+        if(ends_tmp && widths_tmp) index->line_buf_cnt = line_buf_cnt;
+        else ok = false;
+    }
+
+    if(ok) {
+        /*Move the lines after the change to their new place*/
+        uint32_t * ends = index->line_ends;
+        lv_memmove(&ends[first + new_cnt], &ends[same_idx], same_cnt * sizeof(uint32_t));
+        lv_memmove(&index->line_widths[first + new_cnt], &index->line_widths[same_idx], same_cnt * sizeof(int32_t));
+        uint32_t i;
+        for(i = first + new_cnt; i < line_cnt; i++) {
+            ends[i] = ends[i] + ins_len - del_len;
+        }
+
+        lv_memcpy(&ends[first], new_ends, new_cnt * sizeof(uint32_t));
+        lv_memcpy(&index->line_widths[first], new_widths, new_cnt * sizeof(int32_t));
+        index->line_cnt = line_cnt;
+    }
+    else {
+        LV_LOG_WARN("couldn't allocate the line index");
+        index->valid = 0;
+    }
+
+    lv_free(new_ends);
+    lv_free(new_widths);
+
+    return new_cnt;
+}
+
+/**
+ * Invalidate some lines of the label
+ * @param obj       pointer to a label object
+ * @param first     index of the first line to invalidate
+ * @param last      index of the line after the last line to invalidate, or `UINT32_MAX` to invalidate until the bottom
+ */
+static void line_index_invalidate_lines(lv_obj_t * obj, uint32_t first, uint32_t last)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const int32_t line_height = lv_font_get_line_height(label->line_index.font) +
+                                lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    const int32_t ext_size = _lv_obj_get_ext_draw_size(obj);
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+    int32_t y_ofs = txt_coords.y1 - lv_obj_get_scroll_top(obj);
+
+    lv_area_t area;
+    area.x1 = obj->coords.x1 - ext_size;
+    area.x2 = obj->coords.x2 + ext_size;
+    area.y1 = y_ofs + (int32_t)first * line_height - ext_size;
+    if(last == UINT32_MAX || line_height <= 0) area.y2 = obj->coords.y2 + ext_size;
+    else area.y2 = y_ofs + (int32_t)last * line_height + ext_size;
+
+    if(area.y1 < obj->coords.y1 - ext_size) area.y1 = obj->coords.y1 - ext_size;
+    if(area.y2 > obj->coords.y2 + ext_size) area.y2 = obj->coords.y2 + ext_size;
+    if(area.y1 > area.y2) {
+        /*The text and the lines might have been moved, so the recorded draw tasks can't be used anyway*/
+        _lv_obj_invalidate_draw_lists(obj);
+        return;
+    }
+
+    lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * Find the line of a byte. Bytes after the text are in the last line.
+ * @return index of the line, or 0 if there are no lines
+ */
+static uint32_t line_index_find_byte(const lv_label_line_index_t * index, uint32_t byte_id)
+{
+    uint32_t first = 0;
+    uint32_t last = index->line_cnt;
+    while(first < last) {
+        uint32_t mid = (first + last) / 2;
+        if(index->line_ends[mid] <= byte_id) first = mid + 1;
+        else last = mid;
+    }
+
+    if(first >= index->line_cnt && index->line_cnt > 0) first = index->line_cnt - 1;
+    return first;
+}
+
+/**
+ * Get the size of the text from the lines in the same way as `lv_text_get_size`
+ */
+static void line_index_get_size(lv_obj_t * obj, lv_point_t * size)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_label_line_index_t * index = &label->line_index;
+    const int32_t letter_height = lv_font_get_line_height(index->font);
+    const int32_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+
+    size->x = 0;
+    uint32_t i;
+    for(i = 0; i < index->line_cnt; i++) {
+        size->x = LV_MAX(size->x, index->line_widths[i]);
+    }
+
+    size->y = (int32_t)index->line_cnt * (letter_height + line_space);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(index->line_cnt > 0) {
+        char last = label->text[index->line_ends[index->line_cnt - 1] - 1];
+        if(last == '\n' || last == '\r') size->y += letter_height + line_space;
+    }
+
+    if(size->y == 0) size->y = letter_height;
+    else size->y -= line_space;
+}
+#endif /*LV_LABEL_LINE_INDEX*/
+
 #endif
@@ -59,9 +59,24 @@ typedef _lv_label_long_mode_t lv_label_long_mode_t;
 typedef uint8_t lv_label_long_mode_t;
 #endif /*DOXYGEN*/
 
+#if LV_LABEL_LINE_INDEX
+/** The wrapped lines of a long text. Valid only with the font, letter space and width it was created with.*/
+typedef struct {
+    uint32_t * line_ends;       /**< Byte index of the start of the next line for each line*/
+    int32_t * line_widths;      /**< Width of each line*/
+    uint32_t line_cnt;
+    uint32_t line_buf_cnt;      /**< Number of lines `line_ends` and `line_widths` can store*/
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    uint8_t valid : 1;
+} lv_label_line_index_t;
+#endif
+
 typedef struct {
     lv_obj_t obj;
     char * text;
+    uint32_t text_size; /*Allocated size of `text`. Can be larger than the text to insert text without reallocation*/
     union {
         char * tmp_ptr; /*Pointer to the allocated memory containing the character replaced by dots*/
         char tmp[LV_LABEL_DOT_NUM + 1]; /*Directly store the characters if <=4 characters*/
@@ -72,6 +87,10 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_INDEX
+    lv_label_line_index_t line_index;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -224,13 +224,18 @@ void lv_textarea_delete_char(lv_obj_t * obj)
     lv_result_t res = insert_handler(obj, del_buf);
     if(res != LV_RESULT_OK) return;
 
+#if LV_USE_ARABIC_PERSIAN_CHARS
     char * label_txt = lv_label_get_text(ta->label);
 
     /*Delete a character*/
     _lv_text_cut(label_txt, ta->cursor.pos - 1, 1);
 
-    /*Refresh the label*/
+    /*Refresh the label. The Arabic letters around the deleted one might need an other form.*/
     lv_label_set_text(ta->label, label_txt);
+#else
+    /*Delete a character and refresh only the changed lines of the label*/
+    lv_label_cut_text(ta->label, ta->cursor.pos - 1, 1);
+#endif
     lv_textarea_clear_selection(obj);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
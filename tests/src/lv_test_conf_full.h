@@ -1,5 +1,7 @@
 #define LV_MEM_SIZE         (32 * 1024 * 1024)
 #define LV_SHADOW_CACHE_SIZE    (8 * 1024)
+#define LV_DRAW_SW_SHADOW_CACHE_SIZE    64
+#define LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE    (4 * 1024)
 #define LV_IMAGE_CACHE_DEF_SIZE   32
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -13,6 +15,15 @@
 #define LV_USE_ASSERT_STYLE             1
 #define LV_USE_FLOAT      1
 
+#define LV_DRAW_SW_STRIPE_MIN_AREA  (1024)
+#define LV_DRAW_LAYER_BUF_POOL_SIZE (256 * 1024)
+#define LV_DRAW_OCCLUSION_CULLING   1
+#define LV_DRAW_TASK_BATCH_MAX      16
+#define LV_USE_DRAW_STAT            1
+
+#define LV_USE_DRAW_SW_ASM          LV_DRAW_SW_ASM_AUTO
+#define LV_DRAW_SW_I1_DITHER        1
+
 #define LV_FONT_MONTSERRAT_8    1
 #define LV_FONT_MONTSERRAT_10   1
 #define LV_FONT_MONTSERRAT_12   1
@@ -42,11 +53,15 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE (16 * 1024)
+#define LV_USE_FONT_FMT_TXT_LOOKUP 1
+#define LV_TEXT_LAYOUT_CACHE_SIZE (16 * 1024)
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
 #define LV_USE_MEM_MONITOR          1
 #define LV_LABEL_TEXT_SELECTION     1
+#define LV_LABEL_LINE_INDEX         1
 
 #define LV_USE_FLEX 1
 #define LV_USE_GRID 1
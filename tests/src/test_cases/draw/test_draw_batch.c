@@ -0,0 +1,259 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    200
+#define CANVAS_H    200
+
+static uint8_t canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static lv_obj_t * canvas;
+static lv_obj_t * ref_canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    ref_canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(ref_canvas, lv_draw_buf_align(ref_canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(ref_canvas, lv_color_white(), LV_OPA_COVER);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_DRAW_TASK_BATCH_MAX
+
+/*Number of keys which fit in a batch*/
+#define KEY_CNT     LV_MIN(10, LV_DRAW_TASK_BATCH_MAX)
+
+static const char * key_texts[] = {"Q", "W", "E", "R", "T", "Y", "U", "I", "O", "P"};
+
+static void add_rect(lv_layer_t * layer, int32_t x, int32_t y, lv_palette_t palette, int32_t radius)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(palette);
+    dsc.radius = radius;
+
+    lv_area_t a = {x, y, x + 15, y + 15};
+    lv_draw_rect(layer, &dsc, &a);
+}
+
+static void add_label(lv_layer_t * layer, int32_t x, int32_t y, const char * text, const lv_font_t * font)
+{
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.text = text;
+    dsc.font = font;
+
+    lv_area_t a = {x, y, x + 39, y + 19};
+    lv_draw_label(layer, &dsc, &a);
+}
+
+static uint32_t get_task_cnt(lv_layer_t * layer)
+{
+    uint32_t cnt = 0;
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        cnt++;
+        t = t->next;
+    }
+    return cnt;
+}
+
+static void add_key_rect(lv_layer_t * layer, uint32_t i)
+{
+    add_rect(layer, (i % 5) * 40, (i / 5) * 40, LV_PALETTE_BLUE, 0);
+}
+
+static void add_key_label(lv_layer_t * layer, uint32_t i)
+{
+    add_label(layer, (i % 5) * 40, (i / 5) * 40 + 20, key_texts[i], &lv_font_montserrat_14);
+}
+
+/*A draw unit which claims the fills on the right side of the canvas but can't render batches*/
+#define FAKE_UNIT_ID    77
+
+static lv_draw_unit_t * fake_unit;
+static bool fake_unit_enabled;
+static uint32_t fake_unit_task_cnt;
+
+static int32_t fake_unit_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    LV_UNUSED(draw_unit);
+    if(fake_unit_enabled && task->type == LV_DRAW_TASK_TYPE_FILL && task->area.x1 >= CANVAS_W / 2) {
+        task->preference_score = 0;
+        task->preferred_draw_unit_id = FAKE_UNIT_ID;
+    }
+    return 0;
+}
+
+static int32_t fake_unit_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    LV_UNUSED(draw_unit);
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, FAKE_UNIT_ID);
+    if(t == NULL) return -1;
+
+    /*Pretend that it's rendered*/
+    t->state = LV_DRAW_TASK_STATE_READY;
+    fake_unit_task_cnt++;
+    lv_draw_dispatch_request();
+    return 1;
+}
+
+static void assert_canvas_equal(void)
+{
+    TEST_ASSERT_EQUAL_MEMORY(lv_canvas_get_buf(ref_canvas), lv_canvas_get_buf(canvas),
+                             CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H);
+}
+
+#endif /*LV_DRAW_TASK_BATCH_MAX*/
+
+/*The tasks are not dispatched before `lv_canvas_finish_layer` so all of them are merged*/
+void test_draw_batch_merge_similar_tasks(void)
+{
+#if LV_DRAW_TASK_BATCH_MAX
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    uint32_t i;
+    for(i = 0; i < KEY_CNT; i++) add_key_rect(&layer, i);
+    for(i = 0; i < KEY_CNT; i++) add_key_label(&layer, i);
+
+    /*A batch of fills and a batch of labels*/
+    TEST_ASSERT_EQUAL_UINT32(2, get_task_cnt(&layer));
+    lv_draw_task_t * t = layer.draw_task_head;
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_TYPE_FILL, t->type);
+    TEST_ASSERT_NOT_NULL(t->batch);
+    TEST_ASSERT_EQUAL_UINT32(KEY_CNT, t->batch->cnt);
+    TEST_ASSERT_EQUAL_INT32(0, t->area.x1);
+    TEST_ASSERT_EQUAL_INT32(0, t->area.y1);
+
+    t = t->next;
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_TYPE_LABEL, t->type);
+    TEST_ASSERT_NOT_NULL(t->batch);
+    TEST_ASSERT_EQUAL_UINT32(KEY_CNT, t->batch->cnt);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*The reference is rendered task by task*/
+    for(i = 0; i < KEY_CNT; i++) {
+        lv_canvas_init_layer(ref_canvas, &layer);
+        add_key_rect(&layer, i);
+        lv_canvas_finish_layer(ref_canvas, &layer);
+    }
+    for(i = 0; i < KEY_CNT; i++) {
+        lv_canvas_init_layer(ref_canvas, &layer);
+        add_key_label(&layer, i);
+        lv_canvas_finish_layer(ref_canvas, &layer);
+    }
+
+    assert_canvas_equal();
+#endif
+}
+
+void test_draw_batch_different_tasks(void)
+{
+#if LV_DRAW_TASK_BATCH_MAX
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*Different color*/
+    add_rect(&layer, 0, 0, LV_PALETTE_RED, 0);
+    add_rect(&layer, 20, 0, LV_PALETTE_RED, 0);
+    add_rect(&layer, 40, 0, LV_PALETTE_GREEN, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, get_task_cnt(&layer));
+
+    /*Radius*/
+    add_rect(&layer, 60, 0, LV_PALETTE_GREEN, 5);
+    add_rect(&layer, 80, 0, LV_PALETTE_GREEN, 5);
+    TEST_ASSERT_EQUAL_UINT32(4, get_task_cnt(&layer));
+
+    /*Different font*/
+    add_label(&layer, 0, 40, "A", &lv_font_montserrat_14);
+    add_label(&layer, 40, 40, "B", &lv_font_montserrat_14);
+    add_label(&layer, 80, 40, "C", &lv_font_montserrat_18);
+    TEST_ASSERT_EQUAL_UINT32(6, get_task_cnt(&layer));
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+#endif
+}
+
+void test_draw_batch_max_size(void)
+{
+#if LV_DRAW_TASK_BATCH_MAX
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TASK_BATCH_MAX + 1; i++) {
+        add_rect(&layer, (i % 10) * 20, (i / 10) * 20, LV_PALETTE_RED, 0);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(2, get_task_cnt(&layer));
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_TASK_BATCH_MAX, layer.draw_task_head->batch->cnt);
+    TEST_ASSERT_NULL(layer.draw_task_tail->batch);
+
+    lv_canvas_finish_layer(canvas, &layer);
+#endif
+}
+
+/*The draw units should evaluate the draw tasks before they are merged*/
+void test_draw_batch_other_draw_unit(void)
+{
+#if LV_DRAW_TASK_BATCH_MAX
+    if(fake_unit == NULL) {
+        fake_unit = lv_draw_create_unit(sizeof(lv_draw_unit_t));
+        fake_unit->evaluate_cb = fake_unit_evaluate;
+        fake_unit->dispatch_cb = fake_unit_dispatch;
+    }
+    fake_unit_enabled = true;
+    fake_unit_task_cnt = 0;
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    add_rect(&layer, 0, 0, LV_PALETTE_RED, 0);
+    add_rect(&layer, 20, 0, LV_PALETTE_RED, 0);
+    add_rect(&layer, CANVAS_W / 2, 0, LV_PALETTE_RED, 0);
+    add_rect(&layer, CANVAS_W / 2 + 20, 0, LV_PALETTE_RED, 0);
+
+    /*The fills claimed by the other draw unit are not merged into the batch of the software renderer*/
+    TEST_ASSERT_EQUAL_UINT32(3, get_task_cnt(&layer));
+    lv_draw_task_t * t = layer.draw_task_head;
+    TEST_ASSERT_EQUAL_UINT32(2, t->batch->cnt);
+    TEST_ASSERT_EQUAL_UINT8(FAKE_UNIT_ID, t->next->preferred_draw_unit_id);
+    TEST_ASSERT_NULL(t->next->batch);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    fake_unit_enabled = false;
+    TEST_ASSERT_EQUAL_UINT32(2, fake_unit_task_cnt);
+#endif
+}
+
+/*Render a screen with a lot of similar small objects with batching. The result should be the same.*/
+void test_draw_batch_screen(void)
+{
+    lv_obj_clean(lv_screen_active());
+
+    lv_obj_t * kb = lv_keyboard_create(lv_screen_active());
+    lv_obj_set_style_radius(kb, 0, LV_PART_ITEMS);
+
+    lv_obj_t * table = lv_table_create(lv_screen_active());
+    lv_obj_set_style_radius(table, 0, 0);
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_table_set_cell_value_fmt(table, i / 3, i % 3, "Cell %" LV_PRIu32, i);
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/batch_screen.png");
+}
+
+#endif
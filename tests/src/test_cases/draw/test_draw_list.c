@@ -0,0 +1,210 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES     800
+#define VER_RES     480
+
+extern uint8_t * last_flushed_buf;
+
+static uint8_t ref_buf[HOR_RES * VER_RES * 4];
+static uint32_t draw_main_cnt;
+static lv_obj_t * cont;
+static lv_obj_t * panel;
+static lv_obj_t * label;
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_main_cnt++;
+}
+
+static void remove_display_list_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+}
+
+static uint32_t get_buf_size(void)
+{
+    return lv_draw_buf_width_to_stride(HOR_RES, LV_COLOR_FORMAT_ARGB8888) * VER_RES;
+}
+
+static void refresh_all(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    draw_main_cnt = 0;
+
+    cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 300, 300);
+    lv_obj_center(cont);
+
+    panel = lv_obj_create(cont);
+    lv_obj_set_size(panel, 240, 160);
+    lv_obj_set_style_shadow_width(panel, 20, 0);
+
+    label = lv_label_create(panel);
+    lv_label_set_text(label, "Hello world");
+    lv_obj_add_event_cb(label, draw_main_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * btn = lv_button_create(panel);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, LV_SYMBOL_OK " Apply");
+
+    lv_obj_t * arc = lv_arc_create(panel);
+    lv_obj_set_size(arc, 80, 80);
+    lv_obj_align(arc, LV_ALIGN_RIGHT_MID, 0, 0);
+
+    refresh_all();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_draw_list_replay_unchanged(void)
+{
+    refresh_all();
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+
+    /*Record*/
+    draw_main_cnt = 0;
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+
+    /*Replay: the label shouldn't be drawn again*/
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+}
+
+void test_draw_list_replay_moved(void)
+{
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+
+    /*Moving the parent moves the panel without invalidating it*/
+    draw_main_cnt = 0;
+    lv_obj_set_pos(cont, 7, -13);
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_main_cnt);
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+}
+
+void test_draw_list_invalidate_child(void)
+{
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+
+    /*Changing a child should record the panel again*/
+    draw_main_cnt = 0;
+    lv_label_set_text(label, "Changed");
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+
+    /*Style changes of the parent can affect the children too*/
+    lv_obj_set_style_opa(cont, LV_OPA_50, 0);
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+}
+
+void test_draw_list_partly_visible(void)
+{
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+
+    /*Move the panel partly out of the screen. It's still replayed but clipped*/
+    draw_main_cnt = 0;
+    lv_obj_set_pos(cont, 350, 100);
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_main_cnt);
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+
+    /*Can't be recorded while it's clipped*/
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(3, draw_main_cnt);
+}
+
+void test_draw_list_remove_flag_while_recording(void)
+{
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    lv_obj_add_event_cb(label, remove_display_list_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    /*The list is deleted when the recording is finished*/
+    draw_main_cnt = 0;
+    refresh_all();
+    TEST_ASSERT_NULL(panel->spec_attr->draw_list);
+
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+}
+
+void test_draw_list_unrecordable_layer(void)
+{
+    /*The label is drawn on its own layer which can't be recorded*/
+    lv_obj_set_style_opa_layered(label, LV_OPA_50, 0);
+    refresh_all();
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    draw_main_cnt = 0;
+    refresh_all();
+    lv_draw_list_t * list = panel->spec_attr->draw_list;
+    TEST_ASSERT_TRUE(list->unrecordable);
+    TEST_ASSERT_FALSE(list->valid);
+    TEST_ASSERT_FALSE(lv_draw_list_is_recordable(list));
+
+    /*Not recorded again, just drawn normally*/
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_array_length(&list->items));
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+}
+
+void test_draw_list_label_text_copied(void)
+{
+    static char text[32];
+    lv_strcpy(text, "Hello world");
+    lv_label_set_text_static(label, text);
+    refresh_all();
+    lv_memcpy(ref_buf, last_flushed_buf, get_buf_size());
+
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_DISPLAY_LIST);
+    refresh_all();
+
+    /*Changing the text without notifying the label doesn't affect the recorded draw tasks*/
+    draw_main_cnt = 0;
+    lv_strcpy(text, "Bye");
+    refresh_all();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_main_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, last_flushed_buf, get_buf_size());
+}
+
+#endif
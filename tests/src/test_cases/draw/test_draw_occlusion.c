@@ -0,0 +1,182 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    200
+#define CANVAS_H    200
+
+static uint8_t canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static lv_obj_t * canvas;
+static lv_obj_t * ref_canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    ref_canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(ref_canvas, lv_draw_buf_align(ref_canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(ref_canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_draw_occlusion_reset_stat();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_task_t * add_rect_task(lv_layer_t * layer, int32_t x, int32_t y, int32_t w, int32_t h,
+                                      lv_palette_t palette, int32_t radius)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(palette);
+    dsc.radius = radius;
+
+    lv_area_t a = {x, y, x + w - 1, y + h - 1};
+    lv_draw_rect(layer, &dsc, &a);
+    return layer->draw_task_tail;
+}
+
+static lv_draw_task_t * add_image_task(lv_layer_t * layer, const lv_image_dsc_t * img, int32_t x, int32_t y)
+{
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = img;
+
+    lv_area_t a = {x, y, x + img->header.w - 1, y + img->header.h - 1};
+    lv_draw_image(layer, &dsc, &a);
+    return layer->draw_task_tail;
+}
+
+static void add_label_task(lv_layer_t * layer, int32_t x, int32_t y)
+{
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.text = "Hidden";
+
+    lv_area_t a = {x, y, x + 59, y + 19};
+    lv_draw_label(layer, &dsc, &a);
+}
+
+/*The tasks are not dispatched before `lv_canvas_finish_layer` so they are still queued when the cover is added*/
+void test_draw_occlusion_cull_and_clip(void)
+{
+#if LV_DRAW_OCCLUSION_CULLING
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_task_t * t_hidden = add_rect_task(&layer, 10, 10, 40, 40, LV_PALETTE_RED, 0);
+    lv_draw_task_t * t_right = add_rect_task(&layer, 100, 20, 60, 20, LV_PALETTE_GREEN, 0);
+    lv_draw_task_t * t_corner = add_rect_task(&layer, 100, 90, 60, 60, LV_PALETTE_BLUE, 0);
+    add_rect_task(&layer, 0, 0, 120, 100, LV_PALETTE_YELLOW, 0);
+
+    /*Fully covered: dropped*/
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_READY, t_hidden->state);
+
+    /*The left side is covered: clipped to the right side*/
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t_right->state);
+    TEST_ASSERT_EQUAL_INT32(120, t_right->clip_area.x1);
+    TEST_ASSERT_EQUAL_INT32(159, t_right->clip_area.x2);
+    TEST_ASSERT_EQUAL_INT32(20, t_right->clip_area.y1);
+    TEST_ASSERT_EQUAL_INT32(39, t_right->clip_area.y2);
+
+    /*Only a corner is covered, the visible part is not a rectangle*/
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t_corner->state);
+    TEST_ASSERT_EQUAL_INT32(0, t_corner->clip_area.x1);
+    TEST_ASSERT_EQUAL_INT32(CANVAS_W - 1, t_corner->clip_area.x2);
+
+    lv_draw_occlusion_stat_t stat;
+    lv_draw_occlusion_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.culled_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.clipped_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(40 * 40 + 20 * 20, stat.culled_px_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*The reference draws the cover on a separate layer so nothing is culled*/
+    lv_canvas_init_layer(ref_canvas, &layer);
+    add_rect_task(&layer, 10, 10, 40, 40, LV_PALETTE_RED, 0);
+    add_rect_task(&layer, 100, 20, 60, 20, LV_PALETTE_GREEN, 0);
+    add_rect_task(&layer, 100, 90, 60, 60, LV_PALETTE_BLUE, 0);
+    lv_canvas_finish_layer(ref_canvas, &layer);
+
+    lv_canvas_init_layer(ref_canvas, &layer);
+    add_rect_task(&layer, 0, 0, 120, 100, LV_PALETTE_YELLOW, 0);
+    lv_canvas_finish_layer(ref_canvas, &layer);
+
+    TEST_ASSERT_EQUAL_MEMORY(lv_canvas_get_buf(ref_canvas), lv_canvas_get_buf(canvas),
+                             CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H);
+#endif
+}
+
+void test_draw_occlusion_not_opaque_cover(void)
+{
+#if LV_DRAW_OCCLUSION_CULLING
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*The letters can be drawn out of the area so it's checked by the clip area which is not covered*/
+    add_label_task(&layer, 20, 20);
+    lv_draw_task_t * t_label = layer.draw_task_tail;
+    add_rect_task(&layer, 0, 0, 120, 100, LV_PALETTE_YELLOW, 0);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t_label->state);
+
+    /*The corners of a rounded rectangle are transparent*/
+    lv_draw_task_t * t_rect = add_rect_task(&layer, 150, 150, 20, 20, LV_PALETTE_RED, 0);
+    add_rect_task(&layer, 140, 140, 60, 60, LV_PALETTE_YELLOW, 10);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t_rect->state);
+
+    lv_draw_occlusion_stat_t stat;
+    lv_draw_occlusion_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.culled_task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.clipped_task_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+#endif
+}
+
+void test_draw_occlusion_image_cover(void)
+{
+#if LV_DRAW_OCCLUSION_CULLING
+    static uint16_t img_data[40 * 40];
+    lv_image_dsc_t img = { 0 };
+    img.header.cf = LV_COLOR_FORMAT_RGB565;
+    img.header.w = 40;
+    img.header.h = 40;
+    img.header.stride = 40 * 2;
+    img.data_size = sizeof(img_data);
+    img.data = (const uint8_t *)img_data;
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*An opaque image drawn from its data hides the tasks under it*/
+    lv_draw_task_t * t_hidden = add_rect_task(&layer, 10, 10, 20, 20, LV_PALETTE_RED, 0);
+    add_image_task(&layer, &img, 0, 0);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_READY, t_hidden->state);
+
+    /*The image needs decoding which can fail (here the data is not compressed really)
+     *so the tasks under it are kept*/
+    img.header.flags = LV_IMAGE_FLAGS_COMPRESSED;
+    lv_draw_task_t * t_kept = add_rect_task(&layer, 110, 10, 20, 20, LV_PALETTE_RED, 0);
+    lv_draw_task_t * t_img = add_image_task(&layer, &img, 100, 0);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_TYPE_IMAGE, t_img->type);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t_kept->state);
+
+    lv_draw_occlusion_stat_t stat;
+    lv_draw_occlusion_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.culled_task_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+#endif
+}
+
+#endif
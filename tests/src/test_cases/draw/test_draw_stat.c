@@ -0,0 +1,147 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    100
+#define CANVAS_H    100
+
+static uint8_t canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_refr_now(NULL);
+
+#if LV_USE_DRAW_STAT
+    lv_draw_stat_reset();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_USE_DRAW_STAT
+
+static lv_draw_task_t * add_rect_task(lv_layer_t * layer, int32_t x, int32_t y, lv_palette_t palette, int32_t radius)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(palette);
+    dsc.radius = radius;
+
+    lv_area_t a = {x, y, x + 19, y + 19};
+    lv_draw_rect(layer, &dsc, &a);
+    return layer->draw_task_tail;
+}
+
+#endif /*LV_USE_DRAW_STAT*/
+
+void test_draw_stat_fill(void)
+{
+#if LV_USE_DRAW_STAT
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    add_rect_task(&layer, 10, 10, LV_PALETTE_RED, 0);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_draw_stat_t stat;
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.task_created_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.task_dispatched_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.types[LV_DRAW_TASK_TYPE_FILL].created_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.types[LV_DRAW_TASK_TYPE_FILL].rendered_cnt);
+    TEST_ASSERT_EQUAL_UINT32(20 * 20, stat.types[LV_DRAW_TASK_TYPE_FILL].blend_px_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.types[LV_DRAW_TASK_TYPE_LABEL].created_cnt);
+
+    /*All draw units are counted and only one of them rendered the task*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stat.unit_cnt);
+    uint32_t task_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < stat.unit_cnt; i++) {
+        lv_draw_stat_unit_t unit_stat;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_stat_get_unit(i, &unit_stat));
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(stat.elapsed_time, unit_stat.busy_time);
+        task_cnt += unit_stat.task_cnt;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, task_cnt);
+
+    lv_draw_stat_unit_t unit_stat;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_draw_stat_get_unit(stat.unit_cnt, &unit_stat));
+
+    /*Reset clears everything*/
+    lv_draw_stat_reset();
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.task_created_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.task_dispatched_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.types[LV_DRAW_TASK_TYPE_FILL].blend_px_cnt);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_stat_get_unit(0, &unit_stat));
+    TEST_ASSERT_EQUAL_UINT32(0, unit_stat.task_cnt);
+#endif
+}
+
+/*The tasks are not dispatched before `lv_canvas_finish_layer` so their states can be set*/
+void test_draw_stat_stall(void)
+{
+#if LV_USE_DRAW_STAT
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*Different color and radius to not merge or cull them*/
+    lv_draw_task_t * t1 = add_rect_task(&layer, 10, 10, LV_PALETTE_RED, 0);
+    lv_draw_task_t * t2 = add_rect_task(&layer, 20, 20, LV_PALETTE_BLUE, 5);
+
+    /*The second task waits for the first one which is being rendered*/
+    t1->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, NULL, t2->preferred_draw_unit_id));
+
+    lv_draw_stat_t stat;
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.task_stall_cnt);
+
+    /*Nothing to do is not a stall*/
+    t2->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, NULL, t2->preferred_draw_unit_id));
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.task_stall_cnt);
+
+    t1->state = LV_DRAW_TASK_STATE_QUEUED;
+    t2->state = LV_DRAW_TASK_STATE_QUEUED;
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.types[LV_DRAW_TASK_TYPE_FILL].rendered_cnt);
+#endif
+}
+
+void test_draw_stat_layer_memory_peak(void)
+{
+#if LV_USE_DRAW_STAT
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_set_style_opa_layered(obj, LV_OPA_50, 0);
+
+    lv_draw_stat_reset();
+    lv_refr_now(NULL);
+
+    lv_draw_stat_t stat;
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.layer_mem_peak_kb);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.types[LV_DRAW_TASK_TYPE_LAYER].created_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.types[LV_DRAW_TASK_TYPE_LAYER].blend_px_cnt);
+
+    /*The layers are freed after rendering*/
+    lv_draw_stat_reset();
+    lv_draw_stat_get(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.layer_mem_peak_kb);
+#endif
+}
+
+#endif
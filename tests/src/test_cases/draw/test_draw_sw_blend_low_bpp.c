@@ -0,0 +1,325 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    100
+#define CANVAS_H    80
+#define CANVAS_BUF_SIZE (CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H)
+
+#define I1_W        40
+#define I1_H        8
+#define I1_STRIDE   CANVAS_WIDTH_TO_STRIDE((I1_W + 7) / 8, 1)
+
+#define DISP_W      64
+#define DISP_H      32
+#define DISP_STRIDE CANVAS_WIDTH_TO_STRIDE(DISP_W / 8, 1)
+
+static uint8_t canvas_buf[CANVAS_BUF_SIZE + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_buf[CANVAS_BUF_SIZE];
+static lv_obj_t * canvas;
+
+static uint8_t disp_buf[DISP_STRIDE * DISP_H + LV_DRAW_BUF_ALIGN];
+static uint8_t disp_frame[DISP_W / 8 * DISP_H];
+static uint32_t flush_cnt;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void * render_scene(lv_color_format_t cf)
+{
+    void * buf = lv_draw_buf_align(canvas_buf, cf);
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, cf);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x204060), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_ORANGE);
+    lv_area_t a = {3, 3, 40, 30};
+    lv_draw_rect(&layer, &rect_dsc, &a);
+
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.bg_opa = LV_OPA_60;
+    rect_dsc.radius = 12;
+    rect_dsc.border_width = 3;
+    rect_dsc.border_color = lv_palette_main(LV_PALETTE_GREEN);
+    lv_area_t a2 = {20, 10, 90, 60};
+    lv_draw_rect(&layer, &rect_dsc, &a2);
+
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.src = &test_image_cogwheel_argb8888;
+    lv_area_t img_a = {10, 20, 10 + test_image_cogwheel_argb8888.header.w - 1,
+                       20 + test_image_cogwheel_argb8888.header.h - 1
+                      };
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    img_dsc.src = &test_image_cogwheel_rgb565;
+    img_dsc.opa = LV_OPA_70;
+    lv_area_move(&img_a, 40, -10);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.color = lv_color_white();
+    label_dsc.text = "Low bpp";
+    lv_area_t label_a = {5, 60, 95, 79};
+    lv_draw_label(&layer, &label_dsc, &label_a);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    return buf;
+}
+
+/*Blend directly to a hand made I1 layer as canvases store the palette in the buffer too*/
+static void blend_to_i1(uint8_t * buf, const lv_area_t * area, const lv_draw_sw_blend_dsc_t * blend_dsc)
+{
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_I1;
+    layer.buf_area.x1 = 0;
+    layer.buf_area.y1 = 0;
+    layer.buf_area.x2 = I1_W - 1;
+    layer.buf_area.y2 = I1_H - 1;
+    layer.buf_stride = I1_STRIDE;
+
+    lv_draw_unit_t draw_unit;
+    lv_memzero(&draw_unit, sizeof(draw_unit));
+    draw_unit.target_layer = &layer;
+    draw_unit.clip_area = area;
+
+    lv_draw_sw_blend(&draw_unit, blend_dsc);
+}
+
+static bool i1_get_px(const uint8_t * buf, int32_t x, int32_t y)
+{
+    return (buf[y * I1_STRIDE + (x >> 3)] >> (7 - (x & 0x7))) & 0x1;
+}
+
+static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), LV_COLOR_FORMAT_I1);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&disp_frame[y * (DISP_W / 8) + area->x1 / 8], px_map, (lv_area_get_width(area) + 7) / 8);
+        px_map += stride;
+    }
+    flush_cnt++;
+    lv_display_flush_ready(disp);
+}
+
+void test_l8_matches_luminance(void)
+{
+    uint32_t stride_argb = CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4);
+    lv_memcpy(ref_buf, render_scene(LV_COLOR_FORMAT_ARGB8888), stride_argb * CANVAS_H);
+    const uint8_t * l8 = render_scene(LV_COLOR_FORMAT_L8);
+    uint32_t stride_l8 = lv_draw_buf_width_to_stride(CANVAS_W, LV_COLOR_FORMAT_L8);
+
+    /*Mixing the luminance is not rounded the same way as mixing the channels*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        const lv_color32_t * ref = (const lv_color32_t *)&ref_buf[y * stride_argb];
+        for(x = 0; x < CANVAS_W; x++) {
+            TEST_ASSERT_INT_WITHIN(4, lv_color32_luminance(ref[x]), l8[y * stride_l8 + x]);
+        }
+    }
+}
+
+void test_a8_accumulates_coverage(void)
+{
+    uint8_t * a8 = lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_A8);
+    uint32_t stride = lv_draw_buf_width_to_stride(CANVAS_W, LV_COLOR_FORMAT_A8);
+    lv_canvas_set_buffer(canvas, a8, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_A8);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_opa = LV_OPA_50;
+    lv_area_t a = {0, 0, 19, 9};
+    lv_draw_rect(&layer, &rect_dsc, &a);
+    lv_area_t a2 = {10, 0, 29, 9};
+    lv_draw_rect(&layer, &rect_dsc, &a2);
+
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.src = &test_image_cogwheel_argb8888;
+    lv_area_t img_a = {0, 20, test_image_cogwheel_argb8888.header.w - 1, 20 + test_image_cogwheel_argb8888.header.h - 1};
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT8(0, a8[35]);
+    TEST_ASSERT_UINT8_WITHIN(1, 127, a8[5]);
+    TEST_ASSERT_UINT8_WITHIN(1, 190, a8[15]);
+    TEST_ASSERT_UINT8_WITHIN(1, 127, a8[25]);
+
+    /*The image is drawn on a transparent area so it's alpha channel is copied*/
+    const uint8_t * img_data = test_image_cogwheel_argb8888.data;
+    uint32_t img_stride = test_image_cogwheel_argb8888.header.w * 4;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 20 && y + 20 < CANVAS_H; y++) {
+        for(x = 0; x < CANVAS_W && x < (int32_t)test_image_cogwheel_argb8888.header.w; x++) {
+            TEST_ASSERT_EQUAL_UINT8(img_data[y * img_stride + x * 4 + 3], a8[(y + 20) * stride + x]);
+        }
+    }
+}
+
+void test_i1_fill(void)
+{
+    static uint8_t buf[I1_STRIDE * I1_H];
+    lv_memset(buf, 0xa5, sizeof(buf));
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    lv_area_t a = {3, 1, 20, 2};
+    blend_dsc.blend_area = &a;
+    blend_dsc.color = lv_color_black();
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_to_i1(buf, &a, &blend_dsc);
+
+    /*Only the bits of the area are changed*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 4; y++) {
+        for(x = 0; x < I1_W; x++) {
+            lv_point_t p = {x, y};
+            bool orig = (0xa5 >> (7 - (x & 0x7))) & 0x1;
+            bool exp = _lv_area_is_point_on(&a, &p, 0) ? false : orig;
+            TEST_ASSERT_EQUAL_MESSAGE(exp, i1_get_px(buf, x, y), "Wrong pixel");
+        }
+    }
+
+    /*Gray on black*/
+    lv_memzero(buf, sizeof(buf));
+    lv_area_t a2 = {5, 0, 36, 7};
+    blend_dsc.blend_area = &a2;
+    blend_dsc.color = lv_color_hex(0x808080);
+    blend_to_i1(buf, &a2, &blend_dsc);
+
+    uint32_t white_cnt = 0;
+    for(y = 0; y < 4; y++) {
+        for(x = 8; x < 12; x++) {
+            white_cnt += i1_get_px(buf, x, y);
+        }
+    }
+#if LV_DRAW_SW_I1_DITHER
+    TEST_ASSERT_EQUAL_UINT32(8, white_cnt);
+#else
+    TEST_ASSERT_EQUAL_UINT32(16, white_cnt);
+#endif
+    TEST_ASSERT_FALSE(i1_get_px(buf, 4, 0));
+    TEST_ASSERT_FALSE(i1_get_px(buf, 37, 0));
+}
+
+void test_i1_image(void)
+{
+    static uint8_t buf[I1_STRIDE * I1_H];
+    static uint32_t src[I1_W * I1_H];
+    int32_t x;
+    int32_t y;
+
+    /*Vertical stripes with a transparent column*/
+    for(y = 0; y < I1_H; y++) {
+        for(x = 0; x < I1_W; x++) {
+            src[y * I1_W + x] = x % 3 == 0 ? 0xffffffff : (x % 3 == 1 ? 0xff000000 : 0x00ffffff);
+        }
+    }
+    lv_memzero(buf, sizeof(buf));
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    lv_area_t a = {1, 0, I1_W - 2, I1_H - 1};
+    lv_area_t src_a = {0, 0, I1_W - 1, I1_H - 1};
+    blend_dsc.blend_area = &a;
+    blend_dsc.src_area = &src_a;
+    blend_dsc.src_buf = src;
+    blend_dsc.src_stride = I1_W * 4;
+    blend_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_to_i1(buf, &a, &blend_dsc);
+
+    for(y = 0; y < I1_H; y++) {
+        for(x = 0; x < I1_W; x++) {
+            bool exp = x >= 1 && x <= I1_W - 2 && x % 3 == 0;
+            TEST_ASSERT_EQUAL_MESSAGE(exp, i1_get_px(buf, x, y), "Wrong pixel");
+        }
+    }
+}
+
+void test_i1_display(void)
+{
+    lv_display_t * disp_ori = lv_display_get_default();
+    lv_display_t * disp = lv_display_create(DISP_W, DISP_H);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_I1);
+    lv_display_set_flush_cb(disp, flush_cb);
+    /*A buffer for the whole panel*/
+    lv_display_set_draw_buffers(disp, lv_draw_buf_align(disp_buf, LV_COLOR_FORMAT_I1), NULL, DISP_STRIDE * DISP_H,
+                                LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_color(obj, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_pos(obj, 3, 0);
+    lv_obj_set_size(obj, 18, DISP_H);
+
+    /*Rendered in a simple layer*/
+    lv_obj_t * obj2 = lv_obj_create(scr);
+    lv_obj_remove_style_all(obj2);
+    lv_obj_set_style_bg_color(obj2, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(obj2, LV_OPA_COVER, 0);
+    lv_obj_set_style_opa(obj2, LV_OPA_50, 0);
+    lv_obj_set_pos(obj2, 32, 0);
+    lv_obj_set_size(obj2, 32, DISP_H);
+
+    flush_cnt = 0;
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+
+    uint32_t white_cnt = 0;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < DISP_H; y++) {
+        for(x = 0; x < DISP_W; x++) {
+            bool white = (disp_frame[y * (DISP_W / 8) + (x >> 3)] >> (7 - (x & 0x7))) & 0x1;
+            if(x < 32) TEST_ASSERT_EQUAL_MESSAGE(x >= 3 && x <= 20, white, "Wrong pixel");
+            else white_cnt += white;
+        }
+    }
+
+#if LV_DRAW_SW_I1_DITHER
+    TEST_ASSERT_EQUAL_UINT32(32 * DISP_H / 2, white_cnt);
+#else
+    TEST_ASSERT_EQUAL_UINT32(0, white_cnt);
+#endif
+
+    lv_display_delete(disp);
+    lv_display_set_default(disp_ori);
+}
+
+#endif
@@ -0,0 +1,348 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/blend/x86/lv_blend_x86.h"
+
+#include "unity/unity.h"
+
+#include <time.h>
+
+/*Odd width to test the tail of the rows too*/
+#define BUF_W       37
+#define BUF_H       5
+#define BUF_STRIDE  ((BUF_W + 3) * 4)
+
+#define BENCH_W     800
+#define BENCH_H     48
+
+#if _LV_BLEND_X86_ENABLED
+
+typedef enum {
+    SRC_COLOR,
+    SRC_RGB565,
+    SRC_RGB888,
+    SRC_XRGB8888,
+    SRC_ARGB8888,
+} src_type_t;
+
+typedef void (*fill_cb_t)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+typedef void (*image_cb_t)(_lv_draw_sw_blend_image_dsc_t * dsc);
+typedef void (*rgb888_image_cb_t)(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+/*Normal, with opa, with mask and mix mask opa variants*/
+typedef struct {
+    fill_cb_t color[4];
+    image_cb_t rgb565[4];
+    rgb888_image_cb_t rgb888[4];
+    image_cb_t argb8888[4];
+} kernels_t;
+
+#define VARIANTS(prefix, sfx) { prefix##_##sfx, prefix##_with_opa_##sfx, prefix##_with_mask_##sfx, prefix##_mix_mask_opa_##sfx }
+
+#define KERNELS(sfx, dest) { \
+        VARIANTS(lv_color_blend_to_##dest, sfx), \
+        VARIANTS(lv_rgb565_blend_normal_to_##dest, sfx), \
+        VARIANTS(lv_rgb888_blend_normal_to_##dest, sfx), \
+        VARIANTS(lv_argb8888_blend_normal_to_##dest, sfx) \
+    }
+
+static uint8_t dest_buf[BUF_STRIDE * BUF_H];
+static uint8_t ref_buf[BUF_STRIDE * BUF_H];
+static uint8_t src_buf[BUF_STRIDE * BUF_H];
+static lv_opa_t mask_buf[BUF_STRIDE * BUF_H];
+
+static const lv_opa_t opa_values[] = {LV_OPA_COVER, LV_OPA_MAX, 0, LV_OPA_MIN, LV_OPA_MIN + 1, 100, LV_OPA_MAX - 1};
+
+/*Many values are around the limits where the C implementation takes a different branch*/
+static uint8_t random_opa(void)
+{
+    static const uint8_t special[] = {0, 1, 2, 3, 4, 7, 8, 128, 251, 252, 253, 254, 255, 255, 255, 0};
+    if(lv_rand(0, 1)) return special[lv_rand(0, sizeof(special) - 1)];
+    else return lv_rand(0, 255);
+}
+
+static void fill_random(bool dest_opaque)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(dest_buf); i++) {
+        src_buf[i] = (i % 4 == 3) ? random_opa() : lv_rand(0, 255);
+        mask_buf[i] = random_opa();
+        if(dest_opaque && i % 4 == 3) dest_buf[i] = 0xff;
+        else dest_buf[i] = (i % 4 == 3) ? random_opa() : lv_rand(0, 255);
+    }
+    /*Same background colors in a row to test the cached C path too*/
+    lv_memcpy(&dest_buf[BUF_STRIDE], &dest_buf[0], BUF_W * 4);
+
+    lv_memcpy(ref_buf, dest_buf, sizeof(dest_buf));
+}
+
+/*The reference implementations below are the same as the C implementations in
+ *`lv_draw_sw_blend_to_argb8888.c` and `lv_draw_sw_blend_to_rgb565.c`*/
+
+static lv_color32_t ref_32_32_mix(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX || bg.alpha <= LV_OPA_MIN) return fg;
+    if(fg.alpha <= LV_OPA_MIN) return bg;
+    if(bg.alpha == 255) return lv_color_mix32(fg, bg);
+
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+static uint16_t ref_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) return c2;
+    if(mix == 255) return ((c1[2] & 0xF8) << 8) + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+
+    lv_opa_t mix_inv = 255 - mix;
+    return ((((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8);
+}
+
+static uint32_t src_px_size_of(src_type_t src_type)
+{
+    switch(src_type) {
+        case SRC_RGB565:
+            return 2;
+        case SRC_RGB888:
+            return 3;
+        case SRC_XRGB8888:
+        case SRC_ARGB8888:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static lv_opa_t ref_mix(const uint8_t * src, src_type_t src_type, lv_opa_t mask, bool has_mask, lv_opa_t opa)
+{
+    if(src_type == SRC_ARGB8888) {
+        if(!has_mask) return opa >= LV_OPA_MAX ? src[3] : LV_OPA_MIX2(src[3], opa);
+        return opa >= LV_OPA_MAX ? LV_OPA_MIX2(src[3], mask) : LV_OPA_MIX3(src[3], mask, opa);
+    }
+
+    if(!has_mask) return opa;
+    return opa >= LV_OPA_MAX ? mask : LV_OPA_MIX2(mask, opa);
+}
+
+static void ref_blend(lv_color_format_t dest_cf, src_type_t src_type, lv_color_t color, lv_opa_t opa, bool has_mask)
+{
+    uint32_t src_px_size = src_px_size_of(src_type);
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < BUF_H; y++) {
+        for(x = 0; x < BUF_W; x++) {
+            const uint8_t * src = &src_buf[y * BUF_STRIDE + x * src_px_size];
+            lv_opa_t mix = ref_mix(src, src_type, mask_buf[y * BUF_STRIDE + x], has_mask, opa);
+            bool simple = !has_mask && opa >= LV_OPA_MAX;
+            if(dest_cf == LV_COLOR_FORMAT_ARGB8888) {
+                lv_color32_t * dest = (lv_color32_t *)&ref_buf[y * BUF_STRIDE + x * 4];
+                lv_color32_t fg;
+                if(src_type == SRC_COLOR) {
+                    fg = lv_color_to_32(color, mix);
+                }
+                else if(src_type == SRC_RGB565) {
+                    const lv_color16_t * c16 = (const lv_color16_t *)src;
+                    fg.red = (c16->red * 2106) >> 8;
+                    fg.green = (c16->green * 1037) >> 8;
+                    fg.blue = (c16->blue * 2106) >> 8;
+                    fg.alpha = mix;
+                }
+                else {
+                    fg.blue = src[0];
+                    fg.green = src[1];
+                    fg.red = src[2];
+                    fg.alpha = mix;
+                }
+
+                if(simple && src_type == SRC_COLOR) *dest = lv_color_to_32(color, 0xff);
+                else if(simple && src_type == SRC_XRGB8888) lv_memcpy(dest, src, 4);
+                else if(simple && src_type == SRC_RGB888) {
+                    fg.alpha = 0xff;
+                    *dest = fg;
+                }
+                else *dest = ref_32_32_mix(fg, *dest);
+            }
+            else {
+                uint16_t * dest = (uint16_t *)&ref_buf[y * BUF_STRIDE + x * 2];
+                if(src_type == SRC_COLOR) {
+                    *dest = simple ? lv_color_to_u16(color) : lv_color_16_16_mix(lv_color_to_u16(color), *dest, mix);
+                }
+                else if(src_type == SRC_RGB565) {
+                    *dest = simple ? *(const uint16_t *)src : lv_color_16_16_mix(*(const uint16_t *)src, *dest, mix);
+                }
+                else if(simple && src_type != SRC_ARGB8888) {
+                    *dest = ref_24_16_mix(src, *dest, 0xff);
+                }
+                else {
+                    *dest = ref_24_16_mix(src, *dest, mix);
+                }
+            }
+        }
+    }
+}
+
+static void test_kernels(const kernels_t * k, lv_color_format_t dest_cf)
+{
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        src_type_t src_type = (src_type_t)(i % 5);
+        lv_opa_t opa = opa_values[(i / 5) % sizeof(opa_values)];
+        uint32_t variant;
+        for(variant = 0; variant < 4; variant++) {
+            bool has_mask = variant >= 2;
+            lv_opa_t variant_opa;
+            if(variant % 2) variant_opa = LV_MIN(opa, LV_OPA_MAX - 1);
+            else variant_opa = opa >= LV_OPA_MAX ? opa : LV_OPA_COVER;
+
+            /*Opaque and semi transparent backgrounds too*/
+            fill_random(i % 2);
+
+            lv_color_t color = lv_color_make(lv_rand(0, 255), lv_rand(0, 255), lv_rand(0, 255));
+            uint32_t dest_px_size = dest_cf == LV_COLOR_FORMAT_ARGB8888 ? 4 : 2;
+
+            _lv_draw_sw_blend_fill_dsc_t fill_dsc = {
+                .dest_buf = dest_buf,
+                .dest_w = BUF_W,
+                .dest_h = BUF_H,
+                .dest_stride = BUF_STRIDE,
+                .mask_buf = has_mask ? mask_buf : NULL,
+                .mask_stride = BUF_STRIDE,
+                .color = color,
+                .opa = variant_opa,
+            };
+
+            _lv_draw_sw_blend_image_dsc_t image_dsc = {
+                .dest_buf = dest_buf,
+                .dest_w = BUF_W,
+                .dest_h = BUF_H,
+                .dest_stride = BUF_STRIDE,
+                .mask_buf = has_mask ? mask_buf : NULL,
+                .mask_stride = BUF_STRIDE,
+                .src_buf = src_buf,
+                .src_stride = BUF_STRIDE,
+                .opa = variant_opa,
+                .blend_mode = LV_BLEND_MODE_NORMAL,
+            };
+
+            switch(src_type) {
+                case SRC_COLOR:
+                    k->color[variant](&fill_dsc);
+                    break;
+                case SRC_RGB565:
+                    k->rgb565[variant](&image_dsc);
+                    break;
+                case SRC_RGB888:
+                case SRC_XRGB8888:
+                    k->rgb888[variant](&image_dsc, src_px_size_of(src_type));
+                    break;
+                case SRC_ARGB8888:
+                    k->argb8888[variant](&image_dsc);
+                    break;
+            }
+
+            ref_blend(dest_cf, src_type, color, variant_opa, has_mask);
+
+            uint32_t y;
+            for(y = 0; y < BUF_H; y++) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "source %d, variant %d, opa %d, row %d",
+                            (int)src_type, (int)variant, (int)variant_opa, (int)y);
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&ref_buf[y * BUF_STRIDE], &dest_buf[y * BUF_STRIDE],
+                                                 BUF_W * dest_px_size, msg);
+            }
+        }
+    }
+}
+
+static bool has_avx2(void)
+{
+#if defined(__GNUC__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+static uint32_t bench(void (*cb)(_lv_draw_sw_blend_fill_dsc_t *), _lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    clock_t t = clock();
+    uint32_t i;
+    for(i = 0; i < 20; i++) cb(dsc);
+    return (uint32_t)((clock() - t) * 1000000 / CLOCKS_PER_SEC);
+}
+
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_draw_sw_blend_x86_to_argb8888(void)
+{
+#if _LV_BLEND_X86_ENABLED
+    const kernels_t sse2 = KERNELS(sse2, argb8888);
+    test_kernels(&sse2, LV_COLOR_FORMAT_ARGB8888);
+
+    if(has_avx2()) {
+        const kernels_t avx2 = KERNELS(avx2, argb8888);
+        test_kernels(&avx2, LV_COLOR_FORMAT_ARGB8888);
+    }
+#endif
+}
+
+void test_draw_sw_blend_x86_to_rgb565(void)
+{
+#if _LV_BLEND_X86_ENABLED
+    const kernels_t sse2 = KERNELS(sse2, rgb565);
+    test_kernels(&sse2, LV_COLOR_FORMAT_RGB565);
+
+    if(has_avx2()) {
+        const kernels_t avx2 = KERNELS(avx2, rgb565);
+        test_kernels(&avx2, LV_COLOR_FORMAT_RGB565);
+    }
+#endif
+}
+
+/*Not a real benchmark in the test environment, it only reports the time of the kernels.
+ *Run it with an optimized build to compare the SSE2 and AVX2 kernels.*/
+void test_draw_sw_blend_x86_benchmark(void)
+{
+#if _LV_BLEND_X86_ENABLED
+    static uint32_t bench_buf[BENCH_W * BENCH_H];
+    static lv_opa_t bench_mask[BENCH_W * BENCH_H];
+    lv_memset(bench_buf, 0xff, sizeof(bench_buf));
+    lv_memset(bench_mask, 0x80, sizeof(bench_mask));
+
+    _lv_draw_sw_blend_fill_dsc_t dsc = {
+        .dest_buf = bench_buf,
+        .dest_w = BENCH_W,
+        .dest_h = BENCH_H,
+        .dest_stride = BENCH_W * 4,
+        .mask_buf = bench_mask,
+        .mask_stride = BENCH_W,
+        .color = lv_color_hex(0x123456),
+        .opa = LV_OPA_50,
+    };
+
+    TEST_PRINTF("fill with mask and opa to ARGB8888, %dx%d px, 20 times", BENCH_W, BENCH_H);
+    TEST_PRINTF("  SSE2: %d us", (int)bench(lv_color_blend_to_argb8888_mix_mask_opa_sse2, &dsc));
+    if(has_avx2()) TEST_PRINTF("  AVX2: %d us", (int)bench(lv_color_blend_to_argb8888_mix_mask_opa_avx2, &dsc));
+
+    dsc.dest_stride = BENCH_W * 2;
+    TEST_PRINTF("fill with mask and opa to RGB565, %dx%d px, 20 times", BENCH_W, BENCH_H);
+    TEST_PRINTF("  SSE2: %d us", (int)bench(lv_color_blend_to_rgb565_mix_mask_opa_sse2, &dsc));
+    if(has_avx2()) TEST_PRINTF("  AVX2: %d us", (int)bench(lv_color_blend_to_rgb565_mix_mask_opa_avx2, &dsc));
+#endif
+}
+
+#endif
@@ -0,0 +1,146 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define MASK_W      32
+
+static const lv_area_t rect = {0, 0, 1999, 1999};
+
+void setUp(void)
+{
+    lv_draw_sw_mask_circle_cache_reset_stat();
+}
+
+void tearDown(void)
+{
+}
+
+static void radius_init(lv_draw_sw_mask_radius_param_t * param, int32_t radius)
+{
+    lv_draw_sw_mask_radius_init(param, &rect, radius, false);
+}
+
+/*Get a line from the corner of the mask*/
+static void mask_line_get(lv_draw_sw_mask_radius_param_t * param, int32_t y, lv_opa_t * buf)
+{
+    void * masks[2] = {param, NULL};
+    lv_memset(buf, 0xff, MASK_W);
+    lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(masks, buf, 0, y, MASK_W);
+    if(res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(buf, MASK_W);
+}
+
+void test_circle_cache_hit(void)
+{
+    lv_draw_sw_mask_radius_param_t p1;
+    lv_draw_sw_mask_radius_param_t p2;
+    radius_init(&p1, 11);
+    radius_init(&p2, 11);
+    TEST_ASSERT_EQUAL_PTR(p1.circle, p2.circle);
+    lv_draw_sw_mask_free_param(&p1);
+    lv_draw_sw_mask_free_param(&p2);
+
+    radius_init(&p1, 11);
+    lv_draw_sw_mask_free_param(&p1);
+
+    lv_draw_sw_mask_circle_cache_stat_t stat;
+    lv_draw_sw_mask_circle_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+}
+
+void test_circle_cache_evict_least_recently_used(void)
+{
+    lv_draw_sw_mask_radius_param_t p;
+    int32_t r;
+    for(r = 21; r < 21 + LV_DRAW_SW_CIRCLE_CACHE_SIZE; r++) {
+        radius_init(&p, r);
+        lv_draw_sw_mask_free_param(&p);
+    }
+
+    /*Use the oldest one again so the second one should be dropped*/
+    radius_init(&p, 21);
+    lv_draw_sw_mask_free_param(&p);
+    radius_init(&p, 21 + LV_DRAW_SW_CIRCLE_CACHE_SIZE);
+    lv_draw_sw_mask_free_param(&p);
+
+    lv_draw_sw_mask_circle_cache_stat_t stat;
+    lv_draw_sw_mask_circle_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_CIRCLE_CACHE_SIZE, stat.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stat.evict_cnt);
+
+    lv_draw_sw_mask_circle_cache_reset_stat();
+    radius_init(&p, 21);
+    lv_draw_sw_mask_free_param(&p);
+    radius_init(&p, 22);
+    lv_draw_sw_mask_free_param(&p);
+
+    lv_draw_sw_mask_circle_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+}
+
+/*The circles in use can't be dropped so a temporary one should be used which gives the same mask*/
+void test_circle_cache_temporary(void)
+{
+    lv_draw_sw_mask_radius_param_t p[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
+    int32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        radius_init(&p[i], 31 + i);
+    }
+
+    lv_draw_sw_mask_radius_param_t p_tmp;
+    radius_init(&p_tmp, 20);
+
+    lv_draw_sw_mask_circle_cache_stat_t stat;
+    lv_draw_sw_mask_circle_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.temporary_cnt);
+    TEST_ASSERT_TRUE(p_tmp.circle->temporary);
+
+    lv_opa_t buf_tmp[MASK_W];
+    lv_opa_t buf_cached[MASK_W];
+    int32_t y;
+    for(y = 0; y < 24; y++) {
+        mask_line_get(&p_tmp, y, buf_tmp);
+        lv_draw_sw_mask_free_param(&p_tmp);
+
+        if(y == 0) lv_draw_sw_mask_free_param(&p[0]);
+        radius_init(&p_tmp, 20);
+        TEST_ASSERT_FALSE(p_tmp.circle->temporary);
+        mask_line_get(&p_tmp, y, buf_cached);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(buf_tmp, buf_cached, MASK_W);
+    }
+    lv_draw_sw_mask_free_param(&p_tmp);
+
+    for(i = 1; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        lv_draw_sw_mask_free_param(&p[i]);
+    }
+}
+
+void test_circle_cache_memory_limit(void)
+{
+#if LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE
+    lv_draw_sw_mask_radius_param_t p;
+    lv_draw_sw_mask_circle_cache_stat_t stat;
+
+    /*Too large to be cached*/
+    radius_init(&p, LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE / 6);
+    TEST_ASSERT_TRUE(p.circle->temporary);
+    lv_draw_sw_mask_free_param(&p);
+
+    int32_t r;
+    for(r = 300; r < 800; r += 100) {
+        radius_init(&p, r);
+        lv_draw_sw_mask_free_param(&p);
+
+        lv_draw_sw_mask_circle_cache_get_stat(&stat);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_SW_CIRCLE_CACHE_MEM_SIZE, stat.mem_size);
+    }
+
+    /*Only the last one fits*/
+    TEST_ASSERT_EQUAL_UINT32(1, stat.entry_cnt);
+#endif
+}
+
+#endif
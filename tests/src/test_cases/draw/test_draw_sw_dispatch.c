@@ -0,0 +1,199 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    120
+#define CANVAS_H    120
+#define CANVAS_BUF_SIZE (CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H)
+
+static uint8_t canvas_buf[CANVAS_BUF_SIZE + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_buf[CANVAS_BUF_SIZE];
+static lv_obj_t * canvas;
+static uint32_t rotate_cnt;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_set_cpu_features(lv_draw_sw_get_detected_cpu_features());
+    lv_obj_clean(lv_screen_active());
+}
+
+static void * render_scene(lv_color_format_t cf)
+{
+    void * buf = lv_draw_buf_align(canvas_buf, cf);
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, cf);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x808080), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_RED);
+    lv_area_t a = {3, 3, 40, 30};
+    lv_draw_rect(&layer, &rect_dsc, &a);
+
+    /*Opacity and mask*/
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.bg_opa = LV_OPA_60;
+    rect_dsc.radius = 12;
+    rect_dsc.border_width = 3;
+    rect_dsc.border_color = lv_palette_main(LV_PALETTE_GREEN);
+    lv_area_t a2 = {20, 10, 90, 60};
+    lv_draw_rect(&layer, &rect_dsc, &a2);
+
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+    LV_IMAGE_DECLARE(test_image_cogwheel_xrgb8888);
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565a8);
+
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.src = &test_image_cogwheel_argb8888;
+    lv_area_t img_a = {10, 30, 10 + test_image_cogwheel_argb8888.header.w - 1,
+                       30 + test_image_cogwheel_argb8888.header.h - 1
+                      };
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    img_dsc.src = &test_image_cogwheel_rgb565;
+    img_dsc.opa = LV_OPA_70;
+    lv_area_move(&img_a, 30, -20);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    /*Transformed, blended with the mask of the rotated area*/
+    img_dsc.src = &test_image_cogwheel_xrgb8888;
+    img_dsc.rotation = 300;
+    img_dsc.pivot.x = 50;
+    img_dsc.pivot.y = 50;
+    lv_area_move(&img_a, -20, 40);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    /*Transformed ARGB8888: rotated and scaled, then only upscaled*/
+    img_dsc.src = &test_image_cogwheel_argb8888;
+    img_dsc.opa = LV_OPA_COVER;
+    img_dsc.rotation = 450;
+    img_dsc.scale_x = 300;
+    img_dsc.scale_y = 200;
+    lv_area_move(&img_a, 40, -10);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    img_dsc.rotation = 0;
+    img_dsc.scale_x = 400;
+    img_dsc.scale_y = 300;
+    img_dsc.pivot.x = 10;
+    img_dsc.pivot.y = 10;
+    lv_area_move(&img_a, 20, 20);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    /*Without anti-aliasing*/
+    img_dsc.src = &test_image_cogwheel_rgb565a8;
+    img_dsc.rotation = 200;
+    img_dsc.antialias = 0;
+    lv_area_move(&img_a, -70, -30);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.color = lv_color_white();
+    label_dsc.text = "Dispatch";
+    lv_area_t label_a = {5, 95, 115, 115};
+    lv_draw_label(&layer, &label_dsc, &label_a);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    return buf;
+}
+
+static void test_scalar_matches_detected(lv_color_format_t cf)
+{
+    uint32_t size = CANVAS_WIDTH_TO_STRIDE(CANVAS_W, lv_color_format_get_size(cf)) * CANVAS_H;
+
+    lv_draw_sw_set_cpu_features(LV_DRAW_SW_CPU_FEATURE_NONE);
+    lv_memcpy(ref_buf, render_scene(cf), size);
+
+    lv_draw_sw_set_cpu_features(lv_draw_sw_get_detected_cpu_features());
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, render_scene(cf), size);
+}
+
+static void rotate_counter(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                           int32_t src_stride, int32_t dest_stride)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(dest);
+    LV_UNUSED(src_width);
+    LV_UNUSED(src_height);
+    LV_UNUSED(src_stride);
+    LV_UNUSED(dest_stride);
+    rotate_cnt++;
+}
+
+void test_draw_sw_dispatch_features(void)
+{
+    uint32_t detected = lv_draw_sw_get_detected_cpu_features();
+    const lv_draw_sw_dispatch_t * d = lv_draw_sw_get_dispatch();
+
+    /*Everything detected is used by default*/
+    TEST_ASSERT_EQUAL_UINT32(detected, lv_draw_sw_get_cpu_features());
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AUTO && defined(__SSE2__)
+    TEST_ASSERT_TRUE(detected & LV_DRAW_SW_CPU_FEATURE_SSE2);
+    TEST_ASSERT_NOT_NULL(d->color_to_argb8888[LV_DRAW_SW_BLEND_VARIANT_NORMAL]);
+    TEST_ASSERT_NOT_NULL(d->argb8888_to_rgb565[LV_DRAW_SW_BLEND_VARIANT_MIX_MASK_OPA]);
+    TEST_ASSERT_NOT_NULL(d->transform_argb8888);
+    TEST_ASSERT_NOT_NULL(d->rotate_rgb565[LV_DISPLAY_ROTATION_90]);
+    TEST_ASSERT_NOT_NULL(d->rotate_argb8888[LV_DISPLAY_ROTATION_270]);
+#endif
+
+    /*Forcing the C implementations clears the table*/
+    lv_draw_sw_set_cpu_features(LV_DRAW_SW_CPU_FEATURE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_CPU_FEATURE_NONE, lv_draw_sw_get_cpu_features());
+    TEST_ASSERT_EQUAL_UINT32(detected, lv_draw_sw_get_detected_cpu_features());
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_BLEND_VARIANT_CNT; i++) {
+        TEST_ASSERT_NULL(d->color_to_argb8888[i]);
+        TEST_ASSERT_NULL(d->rgb565_to_rgb565[i]);
+    }
+    TEST_ASSERT_NULL(d->transform_argb8888);
+    TEST_ASSERT_NULL(d->rotate_rgb565[LV_DISPLAY_ROTATION_90]);
+
+    /*Unsupported features can't be enabled*/
+    lv_draw_sw_set_cpu_features(0xffffffff);
+    TEST_ASSERT_EQUAL_UINT32(detected, lv_draw_sw_get_cpu_features());
+}
+
+void test_draw_sw_dispatch_scalar_matches_argb8888(void)
+{
+    test_scalar_matches_detected(LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_draw_sw_dispatch_scalar_matches_rgb565(void)
+{
+    test_scalar_matches_detected(LV_COLOR_FORMAT_RGB565);
+}
+
+void test_draw_sw_dispatch_rotate_kernel(void)
+{
+    static uint32_t src[4 * 3];
+    static uint32_t dest[3 * 4];
+    lv_draw_sw_dispatch_t * d = &LV_GLOBAL_DEFAULT()->sw_dispatch;
+
+    rotate_cnt = 0;
+    d->rotate_argb8888[LV_DISPLAY_ROTATION_90] = rotate_counter;
+    lv_draw_sw_rotate(src, dest, 4, 3, 4 * 4, 3 * 4, LV_DISPLAY_ROTATION_90, LV_COLOR_FORMAT_ARGB8888);
+    lv_draw_sw_rotate(src, dest, 4, 3, 4 * 4, 4 * 4, LV_DISPLAY_ROTATION_180, LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_EQUAL_UINT32(1, rotate_cnt);
+
+    /*Selecting the kernels again drops it*/
+    lv_draw_sw_set_cpu_features(LV_DRAW_SW_CPU_FEATURE_NONE);
+    TEST_ASSERT_NULL(d->rotate_argb8888[LV_DISPLAY_ROTATION_90]);
+    lv_draw_sw_rotate(src, dest, 4, 3, 4 * 4, 3 * 4, LV_DISPLAY_ROTATION_90, LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_EQUAL_UINT32(1, rotate_cnt);
+}
+
+#endif
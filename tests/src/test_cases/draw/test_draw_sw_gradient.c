@@ -0,0 +1,257 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_CNT
+    lv_gradient_cache_drop();
+    lv_gradient_cache_reset_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void grad_init(lv_grad_dsc_t * grad, lv_grad_dir_t dir)
+{
+    lv_memzero(grad, sizeof(lv_grad_dsc_t));
+    grad->dir = dir;
+    grad->stops_count = 2;
+    grad->stops[0].color = lv_palette_main(LV_PALETTE_RED);
+    grad->stops[0].opa = LV_OPA_COVER;
+    grad->stops[0].frac = 30;
+    grad->stops[1].color = lv_palette_main(LV_PALETTE_BLUE);
+    grad->stops[1].opa = LV_OPA_50;
+    grad->stops[1].frac = 220;
+}
+
+/*The maps calculated stop by stop should be the same as calculating each entry*/
+void test_gradient_map_matches_calculate(void)
+{
+    lv_grad_dsc_t grad;
+    grad_init(&grad, LV_GRAD_DIR_HOR);
+
+    static const int32_t sizes[] = {1, 2, 3, 17, 100, 255, 256, 300, 1023};
+    static const uint8_t fracs[][2] = {{30, 220}, {0, 255}, {128, 128}, {200, 50}};
+    uint32_t c;
+    for(c = 0; c < sizeof(fracs) / sizeof(fracs[0]); c++) {
+        grad.stops[0].frac = fracs[c][0];
+        grad.stops[1].frac = fracs[c][1];
+        uint32_t s;
+        for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            lv_grad_t * g = lv_gradient_get(&grad, sizes[s], 10);
+            TEST_ASSERT_NOT_NULL(g);
+            TEST_ASSERT_EQUAL_UINT32(sizes[s], g->size);
+
+            int32_t i;
+            for(i = 0; i < sizes[s]; i++) {
+                lv_color_t color;
+                lv_opa_t opa;
+                lv_gradient_color_calculate(&grad, sizes[s], i, &color, &opa);
+                TEST_ASSERT_EQUAL_COLOR(color, g->color_map[i]);
+                TEST_ASSERT_EQUAL_UINT8(opa, g->opa_map[i]);
+            }
+            lv_gradient_cleanup(g);
+        }
+    }
+}
+
+void test_gradient_radial_line(void)
+{
+    lv_grad_dsc_t grad;
+    grad_init(&grad, LV_GRAD_DIR_RADIAL);
+    grad.stops[0].frac = 0;
+    grad.stops[1].frac = 255;
+
+    lv_area_t coords = {10, 20, 109, 69};
+    lv_grad_t * g = lv_gradient_get(&grad, lv_area_get_width(&coords), lv_area_get_height(&coords));
+    TEST_ASSERT_NOT_NULL(g);
+    TEST_ASSERT_EQUAL_UINT32(51, g->size);
+
+    lv_color_t colors[100];
+    lv_opa_t opas[100];
+
+    /*The center is between 4 pixels*/
+    lv_gradient_get_line(g, &coords, 10, 44, 100, colors, opas);
+    TEST_ASSERT_EQUAL_COLOR(g->color_map[1], colors[49]);
+    TEST_ASSERT_EQUAL_COLOR(g->color_map[1], colors[50]);
+    TEST_ASSERT_EQUAL_UINT8(g->opa_map[1], opas[49]);
+
+    /*The gradient is symmetric and it's clamped outside of the circle*/
+    int32_t x;
+    for(x = 0; x < 50; x++) {
+        TEST_ASSERT_EQUAL_COLOR(colors[x], colors[99 - x]);
+        TEST_ASSERT_EQUAL_UINT8(opas[x], opas[99 - x]);
+    }
+    TEST_ASSERT_EQUAL_COLOR(grad.stops[1].color, colors[0]);
+    TEST_ASSERT_EQUAL_COLOR(grad.stops[1].color, colors[20]);
+
+    /*Compare with the exact distance*/
+    for(x = 0; x < 100; x++) {
+        int32_t dx = 2 * (10 + x) - (coords.x1 + coords.x2);
+        int32_t dy = 2 * 44 - (coords.y1 + coords.y2);
+        uint32_t d = 0;
+        while((d + 1) * (d + 1) <= (uint32_t)(dx * dx + dy * dy)) d++;
+        if(d > g->size - 1) d = g->size - 1;
+        TEST_ASSERT_EQUAL_COLOR(g->color_map[d], colors[x]);
+    }
+
+    /*The opacities are optional*/
+    lv_gradient_get_line(g, &coords, 30, 21, 50, colors, NULL);
+    lv_gradient_cleanup(g);
+}
+
+void test_gradient_conical_line(void)
+{
+    lv_grad_dsc_t grad;
+    grad_init(&grad, LV_GRAD_DIR_CONICAL);
+    grad.stops[0].frac = 0;
+    grad.stops[1].frac = 255;
+
+    lv_area_t coords = {0, 0, 100, 100};
+    lv_grad_t * g = lv_gradient_get(&grad, 101, 101);
+    TEST_ASSERT_NOT_NULL(g);
+
+    lv_color_t colors[101];
+    lv_opa_t opas[101];
+    lv_color_t color;
+    lv_opa_t opa;
+
+    /*Right of the center is 0°, left of it is 180°*/
+    lv_gradient_get_line(g, &coords, 0, 50, 101, colors, opas);
+    TEST_ASSERT_EQUAL_COLOR(grad.stops[0].color, colors[100]);
+    lv_gradient_color_calculate(&grad, g->size, g->size / 2, &color, &opa);
+    TEST_ASSERT_EQUAL_COLOR(color, colors[0]);
+    TEST_ASSERT_EQUAL_UINT8(opa, opas[0]);
+
+    /*Below the center is 90° and above it is 270°*/
+    lv_gradient_get_line(g, &coords, 50, 100, 1, colors, opas);
+    lv_gradient_color_calculate(&grad, g->size, g->size / 4, &color, &opa);
+    TEST_ASSERT_EQUAL_COLOR(color, colors[0]);
+
+    lv_gradient_get_line(g, &coords, 50, 0, 1, colors, opas);
+    lv_gradient_color_calculate(&grad, g->size, g->size * 3 / 4, &color, &opa);
+    TEST_ASSERT_EQUAL_COLOR(color, colors[0]);
+
+    /*45° and 135°*/
+    lv_gradient_get_line(g, &coords, 0, 100, 101, colors, opas);
+    lv_gradient_color_calculate(&grad, g->size, g->size / 8, &color, &opa);
+    TEST_ASSERT_EQUAL_COLOR(color, colors[100]);
+    lv_gradient_color_calculate(&grad, g->size, g->size * 3 / 8, &color, &opa);
+    TEST_ASSERT_EQUAL_COLOR(color, colors[0]);
+
+    lv_gradient_cleanup(g);
+}
+
+void test_gradient_cache(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_CNT
+    lv_grad_dsc_t grad;
+    grad_init(&grad, LV_GRAD_DIR_VER);
+
+    lv_gradient_cache_stat_t stat;
+
+    lv_grad_t * g1 = lv_gradient_get(&grad, 50, 80);
+    lv_grad_t * g2 = lv_gradient_get(&grad, 70, 80);
+    TEST_ASSERT_EQUAL_PTR(g1, g2);
+    lv_gradient_cleanup(g1);
+    lv_gradient_cleanup(g2);
+
+    lv_gradient_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.entry_cnt);
+
+    /*It's kept after it was released*/
+    g1 = lv_gradient_get(&grad, 50, 80);
+    lv_gradient_cleanup(g1);
+    lv_gradient_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+
+    /*Different stops, direction or size is a different gradient*/
+    grad.stops[0].color = lv_color_black();
+    g1 = lv_gradient_get(&grad, 50, 80);
+    lv_gradient_cleanup(g1);
+    grad.dir = LV_GRAD_DIR_HOR;
+    g1 = lv_gradient_get(&grad, 50, 80);
+    lv_gradient_cleanup(g1);
+    g1 = lv_gradient_get(&grad, 51, 80);
+    lv_gradient_cleanup(g1);
+    lv_gradient_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(4, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_MIN(4, LV_DRAW_SW_GRADIENT_CACHE_CNT), stat.entry_cnt);
+
+    /*The least recently used gradients are evicted*/
+    lv_gradient_cache_reset_stat();
+    int32_t i;
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT + 2; i++) {
+        g1 = lv_gradient_get(&grad, 100 + i, 80);
+        lv_gradient_cleanup(g1);
+    }
+    lv_gradient_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_GRADIENT_CACHE_CNT + 2, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_GRADIENT_CACHE_CNT, stat.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, stat.evict_cnt);
+
+    /*The used gradients are not evicted*/
+    lv_grad_t * used[LV_DRAW_SW_GRADIENT_CACHE_CNT + 1];
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT + 1; i++) {
+        used[i] = lv_gradient_get(&grad, 200 + i, 80);
+        TEST_ASSERT_NOT_NULL(used[i]);
+    }
+    for(i = 0; i < LV_DRAW_SW_GRADIENT_CACHE_CNT + 1; i++) {
+        TEST_ASSERT_EQUAL_UINT32(200 + i, used[i]->size);
+        lv_gradient_cleanup(used[i]);
+    }
+
+    lv_gradient_cache_drop();
+    lv_gradient_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.mem_size);
+#endif
+}
+
+static lv_obj_t * obj_create(lv_grad_dsc_t * grad, int32_t radius)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, 180, 180);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_grad(obj, grad, 0);
+    lv_obj_set_style_radius(obj, radius, 0);
+    return obj;
+}
+
+void test_gradient_radial_conical_render(void)
+{
+    static lv_grad_dsc_t radial;
+    grad_init(&radial, LV_GRAD_DIR_RADIAL);
+    radial.stops[1].opa = LV_OPA_COVER;
+    static lv_grad_dsc_t radial_transp;
+    grad_init(&radial_transp, LV_GRAD_DIR_RADIAL);
+    static lv_grad_dsc_t conical;
+    grad_init(&conical, LV_GRAD_DIR_CONICAL);
+    conical.stops[1].opa = LV_OPA_COVER;
+    static lv_grad_dsc_t conical_transp;
+    grad_init(&conical_transp, LV_GRAD_DIR_CONICAL);
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x202020), 0);
+    lv_obj_set_flex_flow(lv_screen_active(), LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(lv_screen_active(), 20, 0);
+    lv_obj_set_style_pad_gap(lv_screen_active(), 20, 0);
+
+    obj_create(&radial, LV_RADIUS_CIRCLE);
+    obj_create(&radial_transp, 20);
+    lv_obj_set_width(obj_create(&radial, 0), 240);
+    obj_create(&conical, LV_RADIUS_CIRCLE);
+    obj_create(&conical_transp, 30);
+    lv_obj_set_width(obj_create(&conical, 0), 240);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/gradient_radial_conical.png");
+}
+
+#endif
@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define BUF_LEN 200
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*The spans and the partial opacities should give the same mask as applying the masks on the whole line*/
+static void spans_compare(void * masks[], int32_t abs_x, int32_t y_start, int32_t y_end, int32_t len)
+{
+    lv_opa_t ref_buf[BUF_LEN];
+    lv_opa_t mask_buf[BUF_LEN];
+    lv_draw_sw_mask_span_t spans[LV_DRAW_SW_MASK_SPAN_MAX];
+
+    int32_t y;
+    for(y = y_start; y <= y_end; y++) {
+        lv_memset(ref_buf, 0xff, len);
+        lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(masks, ref_buf, abs_x, y, len);
+        if(res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(ref_buf, len);
+
+        lv_memset(mask_buf, 0xff, len);
+        uint32_t span_cnt = lv_draw_sw_mask_apply_spans(masks, mask_buf, abs_x, y, len, spans);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, span_cnt);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_SW_MASK_SPAN_MAX, span_cnt);
+        TEST_ASSERT_EQUAL_INT32(len, spans[span_cnt - 1].end);
+
+        int32_t start = 0;
+        uint32_t i;
+        for(i = 0; i < span_cnt; i++) {
+            TEST_ASSERT_GREATER_THAN_INT32(start, spans[i].end);
+            int32_t x;
+            for(x = start; x < spans[i].end; x++) {
+                if(spans[i].type == LV_DRAW_SW_MASK_SPAN_TRANSP) TEST_ASSERT_EQUAL_UINT8(0x00, ref_buf[x]);
+                else if(spans[i].type == LV_DRAW_SW_MASK_SPAN_COVER) TEST_ASSERT_EQUAL_UINT8(0xff, ref_buf[x]);
+                TEST_ASSERT_EQUAL_UINT8(ref_buf[x], mask_buf[x]);
+            }
+            start = spans[i].end;
+        }
+    }
+}
+
+void test_mask_spans_radius(void)
+{
+    lv_area_t rect = {20, 10, 139, 89};
+    lv_draw_sw_mask_radius_param_t param;
+    void * masks[2] = {&param, NULL};
+
+    int32_t radius;
+    for(radius = 0; radius <= 50; radius += 7) {
+        lv_draw_sw_mask_radius_init(&param, &rect, radius, false);
+        spans_compare(masks, 0, 0, 99, 160);
+        spans_compare(masks, 30, 0, 99, 80);
+        spans_compare(masks, 125, 0, 99, 35);
+        lv_draw_sw_mask_free_param(&param);
+
+        lv_draw_sw_mask_radius_init(&param, &rect, radius, true);
+        spans_compare(masks, 0, 0, 99, 160);
+        spans_compare(masks, 70, 0, 99, 90);
+        lv_draw_sw_mask_free_param(&param);
+    }
+}
+
+void test_mask_spans_border(void)
+{
+    lv_area_t rect_out = {20, 10, 139, 89};
+    lv_area_t rect_in = {28, 18, 131, 81};
+    lv_draw_sw_mask_radius_param_t param_out;
+    lv_draw_sw_mask_radius_param_t param_in;
+    lv_draw_sw_mask_radius_init(&param_out, &rect_out, 30, false);
+    lv_draw_sw_mask_radius_init(&param_in, &rect_in, 22, true);
+    void * masks[3] = {&param_out, &param_in, NULL};
+
+    spans_compare(masks, 0, 0, 99, 160);
+    spans_compare(masks, 20, 10, 89, 120);
+    spans_compare(masks, 100, 5, 95, 45);
+
+    lv_draw_sw_mask_free_param(&param_out);
+    lv_draw_sw_mask_free_param(&param_in);
+}
+
+void test_mask_spans_fade(void)
+{
+    lv_area_t rect = {20, 10, 139, 89};
+    lv_area_t fade_area = {40, 20, 119, 79};
+    lv_draw_sw_mask_radius_param_t param_radius;
+    lv_draw_sw_mask_fade_param_t param_fade;
+    lv_draw_sw_mask_radius_init(&param_radius, &rect, 25, false);
+    lv_draw_sw_mask_fade_init(&param_fade, &fade_area, LV_OPA_COVER, 30, LV_OPA_20, 70);
+
+    void * masks[3] = {&param_fade, NULL, NULL};
+    spans_compare(masks, 0, 0, 99, 160);
+
+    masks[1] = &param_radius;
+    spans_compare(masks, 0, 0, 99, 160);
+    spans_compare(masks, 50, 0, 99, 60);
+
+    lv_draw_sw_mask_free_param(&param_radius);
+    lv_draw_sw_mask_free_param(&param_fade);
+}
+
+/*Masks without a span callback are calculated on the whole line*/
+void test_mask_spans_line(void)
+{
+    lv_area_t rect = {20, 10, 139, 89};
+    lv_draw_sw_mask_radius_param_t param_radius;
+    lv_draw_sw_mask_line_param_t param_line;
+    lv_draw_sw_mask_radius_init(&param_radius, &rect, 40, false);
+    lv_draw_sw_mask_line_points_init(&param_line, 0, 0, 160, 100, LV_DRAW_SW_MASK_LINE_SIDE_BOTTOM);
+
+    void * masks[3] = {&param_line, NULL, NULL};
+    spans_compare(masks, 0, 0, 99, 160);
+
+    masks[1] = &param_radius;
+    spans_compare(masks, 0, 0, 99, 160);
+
+    lv_draw_sw_mask_free_param(&param_radius);
+    lv_draw_sw_mask_free_param(&param_line);
+}
+
+/*Blending the spans should give the same pixels as blending the whole line with the mask*/
+static void blend_spans_compare(lv_color_format_t cf, lv_opa_t opa)
+{
+    static uint8_t buf_ref[BUF_LEN * 4];
+    static uint8_t buf_spans[BUF_LEN * 4];
+    lv_opa_t mask_buf[BUF_LEN];
+    lv_draw_sw_mask_span_t spans[LV_DRAW_SW_MASK_SPAN_MAX];
+
+    lv_area_t rect = {20, 0, 139, 59};
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &rect, 25, false);
+    void * masks[2] = {&param, NULL};
+
+    lv_area_t line_area = {0, 0, BUF_LEN - 1, 0};
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.buf_area = line_area;
+    layer.color_format = cf;
+    layer.buf_stride = lv_draw_buf_width_to_stride(BUF_LEN, cf);
+
+    lv_draw_unit_t draw_unit;
+    lv_memzero(&draw_unit, sizeof(draw_unit));
+    draw_unit.target_layer = &layer;
+    draw_unit.clip_area = &line_area;
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &line_area;
+    blend_dsc.mask_area = &line_area;
+    blend_dsc.mask_buf = mask_buf;
+    blend_dsc.color = lv_color_hex(0xff8000);
+    blend_dsc.opa = opa;
+
+    int32_t y;
+    for(y = 0; y < 60; y++) {
+        /*Transparent pixels with a color on the left and opaque ones on the right*/
+        uint32_t i;
+        for(i = 0; i < sizeof(buf_ref); i++) buf_ref[i] = i < sizeof(buf_ref) / 2 ? (i % 4 == 3 ? 0x00 : 0x40) : 0xc0;
+        lv_memcpy(buf_spans, buf_ref, sizeof(buf_ref));
+
+        lv_memset(mask_buf, 0xff, BUF_LEN);
+        blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, 0, y, BUF_LEN);
+        layer.buf = buf_ref;
+        lv_draw_sw_blend(&draw_unit, &blend_dsc);
+
+        lv_memset(mask_buf, 0xff, BUF_LEN);
+        uint32_t span_cnt = lv_draw_sw_mask_apply_spans(masks, mask_buf, 0, y, BUF_LEN, spans);
+        layer.buf = buf_spans;
+        lv_draw_sw_blend_spans(&draw_unit, &blend_dsc, spans, span_cnt);
+
+        TEST_ASSERT_EQUAL_MEMORY(buf_ref, buf_spans, BUF_LEN * lv_color_format_get_size(cf));
+    }
+
+    lv_draw_sw_mask_free_param(&param);
+}
+
+void test_mask_spans_blend(void)
+{
+    blend_spans_compare(LV_COLOR_FORMAT_RGB565, LV_OPA_COVER);
+    blend_spans_compare(LV_COLOR_FORMAT_RGB565, LV_OPA_50);
+    /*The color of the transparent pixels has to be set the same way as well*/
+    blend_spans_compare(LV_COLOR_FORMAT_ARGB8888, LV_OPA_COVER);
+    blend_spans_compare(LV_COLOR_FORMAT_ARGB8888, LV_OPA_50);
+}
+
+#endif
@@ -0,0 +1,212 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    100
+#define CANVAS_H    80
+#define CANVAS_BUF_SIZE (CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H)
+
+static uint8_t canvas_buf[CANVAS_BUF_SIZE + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_buf[CANVAS_BUF_SIZE];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_buf_t * cogwheel_create(bool premultiply)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+    const lv_image_dsc_t * img = &test_image_cogwheel_argb8888;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(img->header.w, img->header.h, LV_COLOR_FORMAT_ARGB8888, 0);
+    TEST_ASSERT_NOT_NULL(draw_buf);
+
+    uint32_t y;
+    for(y = 0; y < img->header.h; y++) {
+        lv_memcpy((uint8_t *)draw_buf->data + y * draw_buf->header.stride, img->data + y * img->header.w * 4, img->header.w * 4);
+    }
+
+    if(premultiply) TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_buf_premultiply(draw_buf));
+    return draw_buf;
+}
+
+static void * render_scene(lv_color_format_t cf, lv_opa_t bg_opa, const lv_draw_buf_t * img)
+{
+    void * buf = lv_draw_buf_align(canvas_buf, cf);
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, cf);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x204060), bg_opa);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.bg_opa = LV_OPA_60;
+    rect_dsc.radius = 12;
+    rect_dsc.border_width = 3;
+    rect_dsc.border_color = lv_palette_main(LV_PALETTE_GREEN);
+    lv_area_t a = {20, 10, 90, 60};
+    lv_draw_rect(&layer, &rect_dsc, &a);
+
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.src = img;
+    lv_area_t img_a = {10, 20, 10 + img->header.w - 1, 20 + img->header.h - 1};
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    img_dsc.opa = LV_OPA_70;
+    lv_area_move(&img_a, 40, -10);
+    lv_draw_image(&layer, &img_dsc, &img_a);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    return buf;
+}
+
+void test_premultiply_draw_buf(void)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(4, 1, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_color32_t * px = (lv_color32_t *)draw_buf->data;
+    px[0] = (lv_color32_t) {
+        .blue = 0x40, .green = 0x80, .red = 0xff, .alpha = 0xff
+    };
+    px[1] = (lv_color32_t) {
+        .blue = 0x40, .green = 0x80, .red = 0xff, .alpha = 0x80
+    };
+    px[2] = (lv_color32_t) {
+        .blue = 0x40, .green = 0x80, .red = 0xff, .alpha = 0x00
+    };
+    px[3] = (lv_color32_t) {
+        .blue = 0xff, .green = 0xff, .red = 0xff, .alpha = 0x33
+    };
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_buf_premultiply(draw_buf));
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED, draw_buf->header.cf);
+    TEST_ASSERT_TRUE(draw_buf->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED);
+
+    TEST_ASSERT_EQUAL_HEX32(0xffff8040, *(uint32_t *)&px[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x80804020, *(uint32_t *)&px[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x00000000, *(uint32_t *)&px[2]);
+    TEST_ASSERT_EQUAL_HEX32(0x33333333, *(uint32_t *)&px[3]);
+
+    /*Premultiplying twice is a no-op*/
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_buf_premultiply(draw_buf));
+    TEST_ASSERT_EQUAL_HEX32(0x80804020, *(uint32_t *)&px[1]);
+
+    lv_color32_t c = lv_color32_unpremultiply(px[1]);
+    TEST_ASSERT_UINT8_WITHIN(2, 0xff, c.red);
+    TEST_ASSERT_UINT8_WITHIN(2, 0x80, c.green);
+    TEST_ASSERT_UINT8_WITHIN(2, 0x40, c.blue);
+
+    lv_draw_buf_destroy(draw_buf);
+
+    draw_buf = lv_draw_buf_create(4, 1, LV_COLOR_FORMAT_RGB565, 0);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_draw_buf_premultiply(draw_buf));
+    lv_draw_buf_destroy(draw_buf);
+}
+
+/*Drawing a premultiplied image should look the same as drawing its straight alpha version*/
+static void premultiplied_source_test(lv_color_format_t cf)
+{
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t stride = lv_draw_buf_width_to_stride(CANVAS_W, cf);
+
+    lv_draw_buf_t * straight = cogwheel_create(false);
+    lv_memcpy(ref_buf, render_scene(cf, LV_OPA_COVER, straight), stride * CANVAS_H);
+
+    lv_draw_buf_t * premultiplied = cogwheel_create(true);
+    const uint8_t * buf = render_scene(cf, LV_OPA_COVER, premultiplied);
+
+    /*Only the rounding of the two ways of mixing can differ*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        for(x = 0; x < CANVAS_W; x++) {
+            uint32_t i = y * stride + x * px_size;
+            /*The straight alpha path truncates the channels to 5 and 6 bits before mixing*/
+            if(cf == LV_COLOR_FORMAT_RGB565) {
+                uint16_t ref16 = ref_buf[i] | (ref_buf[i + 1] << 8);
+                uint16_t px16 = buf[i] | (buf[i + 1] << 8);
+                TEST_ASSERT_UINT8_WITHIN(2, ref16 >> 11, px16 >> 11);
+                TEST_ASSERT_UINT8_WITHIN(2, (ref16 >> 5) & 0x3f, (px16 >> 5) & 0x3f);
+                TEST_ASSERT_UINT8_WITHIN(2, ref16 & 0x1f, px16 & 0x1f);
+            }
+            else {
+                uint32_t c;
+                for(c = 0; c < px_size; c++) {
+                    TEST_ASSERT_UINT8_WITHIN(3, ref_buf[i + c], buf[i + c]);
+                }
+            }
+        }
+    }
+
+    lv_draw_buf_destroy(straight);
+    lv_draw_buf_destroy(premultiplied);
+}
+
+void test_premultiplied_source_to_rgb565(void)
+{
+    premultiplied_source_test(LV_COLOR_FORMAT_RGB565);
+}
+
+void test_premultiplied_source_to_rgb888(void)
+{
+    premultiplied_source_test(LV_COLOR_FORMAT_RGB888);
+}
+
+void test_premultiplied_source_to_xrgb8888(void)
+{
+    premultiplied_source_test(LV_COLOR_FORMAT_XRGB8888);
+}
+
+void test_premultiplied_source_to_argb8888(void)
+{
+    premultiplied_source_test(LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_premultiplied_source_to_l8(void)
+{
+    premultiplied_source_test(LV_COLOR_FORMAT_L8);
+}
+
+/*Rendering to a premultiplied layer should give the premultiplied version of the straight alpha result*/
+void test_render_to_premultiplied(void)
+{
+    uint32_t stride = CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4);
+
+    lv_draw_buf_t * straight = cogwheel_create(false);
+    lv_memcpy(ref_buf, render_scene(LV_COLOR_FORMAT_ARGB8888, LV_OPA_50, straight), stride * CANVAS_H);
+
+    lv_draw_buf_t * premultiplied = cogwheel_create(true);
+    const uint8_t * buf = render_scene(LV_COLOR_FORMAT_ARGB8888_PREMULTIPLIED, LV_OPA_50, premultiplied);
+
+    /*The straight alpha blending approximates the resulting alpha so allow a bit larger difference*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < CANVAS_H; y++) {
+        const lv_color32_t * ref = (const lv_color32_t *)&ref_buf[y * stride];
+        const lv_color32_t * px = (const lv_color32_t *)&buf[y * stride];
+        for(x = 0; x < CANVAS_W; x++) {
+            lv_color32_t ref_pre = lv_color32_premultiply(ref[x]);
+            TEST_ASSERT_UINT8_WITHIN(4, ref_pre.alpha, px[x].alpha);
+            TEST_ASSERT_UINT8_WITHIN(4, ref_pre.red, px[x].red);
+            TEST_ASSERT_UINT8_WITHIN(4, ref_pre.green, px[x].green);
+            TEST_ASSERT_UINT8_WITHIN(4, ref_pre.blue, px[x].blue);
+        }
+    }
+
+    lv_draw_buf_destroy(straight);
+    lv_draw_buf_destroy(premultiplied);
+}
+
+#endif
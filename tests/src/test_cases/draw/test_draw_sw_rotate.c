@@ -90,9 +90,9 @@ void test_rotate90_RGB888(void)
     };
     uint8_t dstArray[2 * 3 * 3] = {0};
     uint8_t expectedArray[2 * 3 * 3] = {
-        0x33, 0x3A, 0x3B,   0x66, 0x6A, 0x6B,
-        0x22, 0x2A, 0x2B,   0x55, 0x5A, 0x5B,
-        0x11, 0x1A, 0x1B,   0x44, 0x4A, 0x4B,
+        0x44, 0x4A, 0x4B,   0x11, 0x1A, 0x1B,
+        0x55, 0x5A, 0x5B,   0x22, 0x2A, 0x2B,
+        0x66, 0x6A, 0x6B,   0x33, 0x3A, 0x3B,
     };
 
     lv_draw_sw_rotate(srcArray, dstArray,
@@ -135,9 +135,9 @@ void test_rotate270_RGB888(void)
     };
     uint8_t dstArray[2 * 3 * 3] = {0};
     uint8_t expectedArray[2 * 3 * 3] = {
-        0x44, 0x4A, 0x4B,     0x11, 0x1A, 0x1B,
-        0x55, 0x5A, 0x5B,     0x22, 0x2A, 0x2B,
-        0x66, 0x6A, 0x6B,     0x33, 0x3A, 0x3B,
+        0x33, 0x3A, 0x3B,     0x66, 0x6A, 0x6B,
+        0x22, 0x2A, 0x2B,     0x55, 0x5A, 0x5B,
+        0x11, 0x1A, 0x1B,     0x44, 0x4A, 0x4B,
     };
 
     lv_draw_sw_rotate(srcArray, dstArray,
@@ -221,4 +221,160 @@ void test_rotate270_ARGB8888(void)
     TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedArray, dstArray, sizeof(dstArray));
 }
 
+/*Rotate a buffer larger than the tiles and SIMD blocks, with partial ones on the edges*/
+static void rotate_and_check(lv_color_format_t cf, lv_display_rotation_t rotation)
+{
+    const int32_t w = 45;
+    const int32_t h = 37;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    /*Add some padding to the strides*/
+    int32_t src_stride = (w + 3) * px_size;
+    int32_t dest_w = rotation == LV_DISPLAY_ROTATION_180 ? w : h;
+    int32_t dest_h = rotation == LV_DISPLAY_ROTATION_180 ? h : w;
+    int32_t dest_stride = (dest_w + 5) * px_size;
+
+    uint8_t * src = lv_malloc(src_stride * h);
+    uint8_t * dest = lv_malloc(dest_stride * dest_h);
+    uint32_t i;
+    for(i = 0; i < (uint32_t)(src_stride * h); i++) src[i] = (uint8_t)(i * 7 + (i >> 8));
+
+    uint32_t f;
+    uint32_t features[2] = {LV_DRAW_SW_CPU_FEATURE_NONE, lv_draw_sw_get_detected_cpu_features()};
+    for(f = 0; f < 2; f++) {
+        lv_draw_sw_set_cpu_features(features[f]);
+        lv_memzero(dest, dest_stride * dest_h);
+        lv_draw_sw_rotate(src, dest, w, h, src_stride, dest_stride, rotation, cf);
+
+        int32_t x;
+        int32_t y;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                int32_t dx;
+                int32_t dy;
+                if(rotation == LV_DISPLAY_ROTATION_180) {
+                    dx = w - x - 1;
+                    dy = h - y - 1;
+                }
+                else if(rotation == LV_DISPLAY_ROTATION_90) {
+                    dx = h - y - 1;
+                    dy = x;
+                }
+                else {
+                    dx = y;
+                    dy = w - x - 1;
+                }
+                TEST_ASSERT_EQUAL_MEMORY(src + y * src_stride + x * px_size,
+                                         dest + dy * dest_stride + dx * px_size, px_size);
+            }
+        }
+    }
+
+    lv_draw_sw_set_cpu_features(lv_draw_sw_get_detected_cpu_features());
+    lv_free(src);
+    lv_free(dest);
+}
+
+void test_rotate_large(void)
+{
+    lv_color_format_t cfs[3] = {LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_ARGB8888};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        rotate_and_check(cfs[i], LV_DISPLAY_ROTATION_90);
+        rotate_and_check(cfs[i], LV_DISPLAY_ROTATION_180);
+        rotate_and_check(cfs[i], LV_DISPLAY_ROTATION_270);
+    }
+}
+
+static void rotate_area_and_check(lv_color_format_t cf, lv_display_rotation_t rotation)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_color_format_t cf_ori = lv_display_get_color_format(disp);
+    lv_display_set_color_format(disp, cf);
+    lv_display_set_rotation(disp, rotation);
+
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    uint32_t px_size = lv_color_format_get_size(cf);
+    int32_t src_stride = lv_draw_buf_width_to_stride(hor_res, cf);
+    int32_t dest_w = rotation == LV_DISPLAY_ROTATION_180 ? hor_res : ver_res;
+    int32_t dest_h = rotation == LV_DISPLAY_ROTATION_180 ? ver_res : hor_res;
+    int32_t dest_stride = dest_w * px_size;
+
+    uint8_t * src = lv_malloc(src_stride * ver_res);
+    uint8_t * ref = lv_malloc(dest_stride * dest_h);
+    uint8_t * dest = lv_malloc(dest_stride * dest_h);
+    uint32_t i;
+    for(i = 0; i < (uint32_t)(src_stride * ver_res); i++) src[i] = (uint8_t)(i * 13 + (i >> 10));
+
+    /*Rotating every part of the screen one by one should give the same result as rotating it at once*/
+    lv_draw_sw_rotate(src, ref, hor_res, ver_res, src_stride, dest_stride, rotation, cf);
+    lv_memzero(dest, dest_stride * dest_h);
+    lv_area_t areas[4] = {
+        {0, 0, 99, 49},
+        {100, 0, hor_res - 1, 49},
+        {0, 50, 32, ver_res - 1},
+        {33, 50, hor_res - 1, ver_res - 1},
+    };
+    for(i = 0; i < 4; i++) {
+        lv_draw_sw_rotate_area(disp, &areas[i], src, dest, dest_stride);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(ref, dest, dest_stride * dest_h);
+
+    lv_free(src);
+    lv_free(ref);
+    lv_free(dest);
+    lv_display_set_rotation(disp, LV_DISPLAY_ROTATION_0);
+    lv_display_set_color_format(disp, cf_ori);
+}
+
+void test_rotate_area(void)
+{
+    lv_color_format_t cfs[3] = {LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_ARGB8888};
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        rotate_area_and_check(cfs[i], LV_DISPLAY_ROTATION_90);
+        rotate_area_and_check(cfs[i], LV_DISPLAY_ROTATION_180);
+        rotate_area_and_check(cfs[i], LV_DISPLAY_ROTATION_270);
+    }
+}
+
+/*The top left pixel has to go to the top right corner when rotated by 90 degrees and
+ *to the bottom left corner when rotated by 270 degrees*/
+static void rotate_area_rgb888_corner(lv_display_rotation_t rotation)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_color_format_t cf_ori = lv_display_get_color_format(disp);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB888);
+    lv_display_set_rotation(disp, rotation);
+
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    int32_t src_stride = lv_draw_buf_width_to_stride(hor_res, LV_COLOR_FORMAT_RGB888);
+    int32_t dest_stride = ver_res * 3;
+
+    uint8_t * src = lv_malloc_zeroed(src_stride * ver_res);
+    uint8_t * dest = lv_malloc_zeroed(dest_stride * hor_res);
+    src[0] = 0x11;
+    src[1] = 0x22;
+    src[2] = 0x33;
+
+    lv_area_t area = {0, 0, hor_res - 1, ver_res - 1};
+    lv_draw_sw_rotate_area(disp, &area, src, dest, dest_stride);
+
+    int32_t dest_x = rotation == LV_DISPLAY_ROTATION_90 ? ver_res - 1 : 0;
+    int32_t dest_y = rotation == LV_DISPLAY_ROTATION_90 ? 0 : hor_res - 1;
+    TEST_ASSERT_EQUAL_MEMORY(src, dest + dest_y * dest_stride + dest_x * 3, 3);
+
+    lv_free(src);
+    lv_free(dest);
+    lv_display_set_rotation(disp, LV_DISPLAY_ROTATION_0);
+    lv_display_set_color_format(disp, cf_ori);
+}
+
+void test_rotate_area_RGB888(void)
+{
+    rotate_area_rgb888_corner(LV_DISPLAY_ROTATION_90);
+    rotate_area_rgb888_corner(LV_DISPLAY_ROTATION_270);
+}
+
 #endif
@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    160
+#define CANVAS_H    120
+#define CANVAS_BUF_SIZE (CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H)
+
+static uint8_t canvas_buf[CANVAS_BUF_SIZE + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_buf[CANVAS_BUF_SIZE];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    lv_draw_sw_shadow_cache_drop();
+    lv_draw_sw_shadow_cache_reset_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void shadows_draw(const lv_area_t * areas, uint32_t cnt)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_opa = LV_OPA_TRANSP;
+    rect_dsc.radius = 8;
+    rect_dsc.shadow_width = 20;
+    rect_dsc.shadow_spread = 2;
+    rect_dsc.shadow_color = lv_palette_main(LV_PALETTE_BLUE);
+    rect_dsc.shadow_opa = LV_OPA_COVER;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_draw_rect(&layer, &rect_dsc, &areas[i]);
+    }
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_shadow_cache_same_style(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    static const lv_area_t areas[] = {
+        {20, 20, 69, 49},
+        {90, 20, 139, 49},
+        {20, 70, 69, 99},
+    };
+
+    shadows_draw(areas, 3);
+
+    /*A shadow can be drawn in more stripes and each stripe gets the corner*/
+    lv_draw_sw_shadow_cache_stat_t stat;
+    lv_draw_sw_shadow_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.entry_cnt);
+#endif
+}
+
+/*The large shadows are cut into stripes only if their corner is cached*/
+void test_shadow_cache_is_cached(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    static const lv_area_t area = {20, 20, 139, 99};
+
+    lv_draw_box_shadow_dsc_t dsc;
+    lv_draw_box_shadow_dsc_init(&dsc);
+    dsc.radius = 8;
+    dsc.width = 20;
+    dsc.spread = 2;
+    dsc.opa = LV_OPA_COVER;
+    TEST_ASSERT_FALSE(_lv_draw_sw_box_shadow_is_cached(&dsc, &area));
+
+    shadows_draw(&area, 1);
+    TEST_ASSERT_TRUE(_lv_draw_sw_box_shadow_is_cached(&dsc, &area));
+
+    /*Only asking doesn't count as a use*/
+    lv_draw_sw_shadow_cache_stat_t stat;
+    lv_draw_sw_shadow_cache_get_stat(&stat);
+    uint32_t hit_cnt = stat.hit_cnt;
+    TEST_ASSERT_TRUE(_lv_draw_sw_box_shadow_is_cached(&dsc, &area));
+    lv_draw_sw_shadow_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt, stat.hit_cnt);
+
+    dsc.width = 30;
+    TEST_ASSERT_FALSE(_lv_draw_sw_box_shadow_is_cached(&dsc, &area));
+
+    lv_draw_sw_shadow_cache_drop();
+    dsc.width = 20;
+    TEST_ASSERT_FALSE(_lv_draw_sw_box_shadow_is_cached(&dsc, &area));
+#endif
+}
+
+/*The corner of a small shadow is affected by its other sides too so it can't be used for a larger one*/
+void test_shadow_cache_small_core(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    static const lv_area_t small_area = {20, 20, 27, 27};
+    static const lv_area_t large_area = {40, 30, 119, 89};
+    uint32_t stride = CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4);
+
+    shadows_draw(&large_area, 1);
+    lv_memcpy(ref_buf, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), stride * CANVAS_H);
+
+    lv_draw_sw_shadow_cache_drop();
+    lv_draw_sw_shadow_cache_reset_stat();
+
+    shadows_draw(&small_area, 1);
+    shadows_draw(&large_area, 1);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), stride * CANVAS_H);
+
+    lv_draw_sw_shadow_cache_stat_t stat;
+    lv_draw_sw_shadow_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.entry_cnt);
+#endif
+}
+
+void test_shadow_cache_evict(void)
+{
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+    /*Different heights while the far side still reaches the corner*/
+    lv_area_t area = {20, 20, 99, 20};
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_SHADOW_CACHE_CNT + 1; i++) {
+        area.y2++;
+        shadows_draw(&area, 1);
+    }
+
+    lv_draw_sw_shadow_cache_stat_t stat;
+    lv_draw_sw_shadow_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_SHADOW_CACHE_CNT + 1, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(LV_DRAW_SW_SHADOW_CACHE_CNT, stat.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.evict_cnt);
+#endif
+}
+
+#endif
@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    200
+#define CANVAS_H    200
+#define TASK_CNT    200
+
+static uint8_t canvas_buf[CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H + LV_DRAW_BUF_ALIGN];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_ARGB8888), CANVAS_W, CANVAS_H,
+                         LV_COLOR_FORMAT_ARGB8888);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void add_fill_task(lv_layer_t * layer, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    /*Use a different color for each task so they are not merged into batches*/
+    static uint32_t color_cnt;
+    color_cnt++;
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(color_cnt);
+
+    lv_area_t a = {x, y, x + w - 1, y + h - 1};
+    lv_draw_rect(layer, &dsc, &a);
+}
+
+/*The reference: a task is independent if no older, not ready task overlaps it*/
+static bool is_independent_ref(lv_layer_t * layer, lv_draw_task_t * t_check)
+{
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t != t_check) {
+        lv_area_t a;
+        if(t->state != LV_DRAW_TASK_STATE_READY && _lv_area_intersect(&a, &t->area, &t_check->area)) return false;
+        t = t->next;
+    }
+    return true;
+}
+
+static void check_available_tasks(lv_layer_t * layer)
+{
+    uint8_t unit_id = layer->draw_task_head->preferred_draw_unit_id;
+    lv_draw_task_t * t_avail = lv_draw_get_next_available_task(layer, NULL, unit_id);
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        bool avail_ref = t->state == LV_DRAW_TASK_STATE_QUEUED && is_independent_ref(layer, t);
+        TEST_ASSERT_EQUAL(avail_ref, t == t_avail);
+        if(t == t_avail) t_avail = lv_draw_get_next_available_task(layer, t_avail, unit_id);
+        t = t->next;
+    }
+    TEST_ASSERT_NULL(t_avail);
+}
+
+void test_draw_task_independent(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    uint32_t i;
+    for(i = 0; i < TASK_CNT; i++) {
+        add_fill_task(&layer, lv_rand(0, CANVAS_W), lv_rand(0, CANVAS_H), lv_rand(1, 30), lv_rand(1, 30));
+    }
+
+    /*A task far outside of the layer, its cells are clamped to the edge of the grid*/
+    add_fill_task(&layer, -1000, -1000, 10, 10);
+
+#if LV_DRAW_TASK_GRID_SIZE
+    TEST_ASSERT_NOT_NULL(layer.draw_task_grid);
+    TEST_ASSERT_EQUAL_UINT32(TASK_CNT + 1, layer.draw_task_cnt);
+#endif
+
+    check_available_tasks(&layer);
+
+    /*Finish some tasks to make the tasks depending on them available*/
+    lv_draw_task_t * t = layer.draw_task_head;
+    for(i = 0; t; i++) {
+        if(i % 3 == 0) t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+    check_available_tasks(&layer);
+
+#if LV_USE_OS == LV_OS_NONE
+    /*Remove the ready tasks from the list and the grid.
+     *(With an OS the render threads would change the state of the tasks during the check)*/
+    lv_draw_dispatch_layer(NULL, &layer);
+    check_available_tasks(&layer);
+#endif
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+#if LV_DRAW_TASK_GRID_SIZE
+    TEST_ASSERT_NULL(layer.draw_task_grid);
+    TEST_ASSERT_EQUAL_UINT32(0, layer.draw_task_cnt);
+#endif
+}
+
+void test_draw_task_pool_reuse(void)
+{
+#if LV_DRAW_TASK_POOL_SIZE && LV_USE_OS == LV_OS_NONE
+    /*Start with an empty pool, not with the blocks of the other tests*/
+    lv_draw_task_pool_flush();
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * btn = lv_button_create(lv_screen_active());
+        lv_obj_set_pos(btn, 220 + (i % 2) * 200, 20 + (i / 2) * 80);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %" LV_PRIu32, i);
+    }
+
+    /*The first refresh fills the pool*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_task_pool_reset_stat();
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    /*The same frame again needs no heap operation for the draw tasks*/
+    lv_draw_task_pool_stat_t stat;
+    lv_draw_task_pool_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.heap_alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.heap_free_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.reuse_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_TASK_POOL_SIZE, stat.pooled_size);
+
+    lv_draw_task_pool_flush();
+    lv_draw_task_pool_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.pooled_size);
+#endif
+}
+
+#endif
@@ -51,9 +51,10 @@ void test_array_resize(void)
         LV_ARRAY_APPEND_VALUE(&array, i);
     }
 
-    lv_array_resize(&array, 12);
+    TEST_ASSERT_TRUE(lv_array_resize(&array, 12));
     TEST_ASSERT_EQUAL_UINT32(8, lv_array_length(&array));
-    lv_array_resize(&array, 6);
+    TEST_ASSERT_EQUAL_UINT32(12, lv_array_capacity(&array));
+    TEST_ASSERT_TRUE(lv_array_resize(&array, 6));
     TEST_ASSERT_EQUAL_UINT32(6, lv_array_length(&array));
 }
 
@@ -73,4 +74,21 @@ void test_array_copy(void)
     lv_array_destroy(&array2);
 }
 
+void test_array_remove(void)
+{
+    for(int32_t i = 0; i < 5; i++) {
+        LV_ARRAY_APPEND_VALUE(&array, i);
+    }
+
+    TEST_ASSERT_TRUE(lv_array_remove(&array, 1));
+    TEST_ASSERT_EQUAL_UINT32(4, lv_array_length(&array));
+    TEST_ASSERT_EQUAL_INT32(0, *LV_ARRAY_GET(&array, 0, int32_t));
+    TEST_ASSERT_EQUAL_INT32(2, *LV_ARRAY_GET(&array, 1, int32_t));
+    TEST_ASSERT_EQUAL_INT32(4, *LV_ARRAY_GET(&array, 3, int32_t));
+
+    TEST_ASSERT_TRUE(lv_array_remove(&array, 3));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_array_length(&array));
+    TEST_ASSERT_FALSE(lv_array_remove(&array, 3));
+}
+
 #endif
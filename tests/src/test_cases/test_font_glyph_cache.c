@@ -0,0 +1,223 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_drop(NULL);
+    lv_font_fmt_txt_glyph_cache_reset_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+
+static const char * test_txt = "Hello LVGL! 0123456789";
+
+static uint32_t glyph_size_get(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, letter, '\0'));
+    return lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8) * g.box_h;
+}
+
+/*The cached bitmaps should be the same as the directly decoded ones*/
+static void bitmaps_compare(const lv_font_t * font)
+{
+    static uint8_t ref_buf[4096];
+    uint32_t i = 0;
+    while(test_txt[i] != '\0') {
+        uint32_t letter = _lv_text_encoded_next(test_txt, &i);
+        uint32_t size = glyph_size_get(font, letter);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(ref_buf), size);
+
+        const uint8_t * bitmap = lv_font_fmt_txt_glyph_cache_get(font, letter);
+        if(size == 0) {
+            TEST_ASSERT_NULL(bitmap);
+            continue;
+        }
+
+        TEST_ASSERT_NOT_NULL(bitmap);
+        TEST_ASSERT_NOT_NULL(lv_font_get_bitmap_fmt_txt(font, letter, ref_buf));
+
+        /*The stride padding is not written*/
+        lv_font_glyph_dsc_t g;
+        lv_font_get_glyph_dsc(font, &g, letter, '\0');
+        uint32_t stride = lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8);
+        uint32_t y;
+        for(y = 0; y < g.box_h; y++) {
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(&ref_buf[y * stride], &bitmap[y * stride], g.box_w);
+        }
+        lv_font_fmt_txt_glyph_cache_release(bitmap);
+    }
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE*/
+
+void test_glyph_cache_bitmaps(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    bitmaps_compare(&lv_font_montserrat_14);
+    bitmaps_compare(&lv_font_montserrat_28_compressed);
+
+    /*Once more from the cache*/
+    bitmaps_compare(&lv_font_montserrat_14);
+    bitmaps_compare(&lv_font_montserrat_28_compressed);
+#endif
+}
+
+void test_glyph_cache_stat(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    const uint8_t * bitmap1 = lv_font_fmt_txt_glyph_cache_get(&lv_font_montserrat_14, 'A');
+    const uint8_t * bitmap2 = lv_font_fmt_txt_glyph_cache_get(&lv_font_montserrat_14, 'A');
+    TEST_ASSERT_NOT_NULL(bitmap1);
+    TEST_ASSERT_EQUAL_PTR(bitmap1, bitmap2);
+
+    /*The same glyph ID of an other font is an other glyph*/
+    const uint8_t * bitmap3 = lv_font_fmt_txt_glyph_cache_get(&lv_font_montserrat_28_compressed, 'A');
+    TEST_ASSERT_NOT_NULL(bitmap3);
+    TEST_ASSERT_NOT_EQUAL(bitmap1, bitmap3);
+
+    lv_font_fmt_txt_glyph_cache_release(bitmap1);
+    lv_font_fmt_txt_glyph_cache_release(bitmap2);
+    lv_font_fmt_txt_glyph_cache_release(bitmap3);
+
+    /*Not existing glyph*/
+    TEST_ASSERT_NULL(lv_font_fmt_txt_glyph_cache_get(&lv_font_montserrat_14, 0x4E00));
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.entry_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(glyph_size_get(&lv_font_montserrat_14, 'A') +
+                                    glyph_size_get(&lv_font_montserrat_28_compressed, 'A'), stat.mem_size);
+
+    lv_font_fmt_txt_glyph_cache_reset_stat();
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.entry_cnt);
+#endif
+}
+
+/*After prewarming drawing the same text should hit the cache only*/
+void test_glyph_cache_prewarm(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*The space has no bitmap*/
+    TEST_ASSERT_EQUAL_UINT32(3, lv_font_fmt_txt_glyph_cache_prewarm(&lv_font_montserrat_14, "Aaa "));
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.entry_cnt);
+
+    lv_font_fmt_txt_glyph_cache_prewarm(&lv_font_montserrat_14, "Hello LVGL!");
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_14, 0);
+    lv_label_set_text(label, "Hello LVGL!");
+    lv_refr_now(NULL);
+
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+#endif
+}
+
+/*The budget should be kept by dropping the least recently used glyphs, but not the ones in use*/
+void test_glyph_cache_evict(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    const uint8_t * held = lv_font_fmt_txt_glyph_cache_get(font, 'W');
+    TEST_ASSERT_NOT_NULL(held);
+
+    static uint8_t ref_buf[4096];
+    uint32_t held_size = glyph_size_get(font, 'W');
+    lv_memcpy(ref_buf, held, held_size);
+
+    uint32_t letter;
+    for(letter = 0x21; letter < 0x7F; letter++) {
+        const uint8_t * bitmap = lv_font_fmt_txt_glyph_cache_get(font, letter);
+        TEST_ASSERT_NOT_NULL(bitmap);
+        lv_font_fmt_txt_glyph_cache_release(bitmap);
+    }
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE, stat.mem_size);
+
+    /*The held glyph is still there*/
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, held, held_size);
+    TEST_ASSERT_EQUAL_PTR(held, lv_font_fmt_txt_glyph_cache_get(font, 'W'));
+    lv_font_fmt_txt_glyph_cache_release(held);
+    lv_font_fmt_txt_glyph_cache_release(held);
+
+    /*The most recently used glyph is still there, the first ones are dropped*/
+    lv_font_fmt_txt_glyph_cache_reset_stat();
+    lv_font_fmt_txt_glyph_cache_release(lv_font_fmt_txt_glyph_cache_get(font, 0x7E));
+    lv_font_fmt_txt_glyph_cache_release(lv_font_fmt_txt_glyph_cache_get(font, 0x21));
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+#endif
+}
+
+void test_glyph_cache_drop(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    lv_font_fmt_txt_glyph_cache_prewarm(&lv_font_montserrat_14, "abc");
+    lv_font_fmt_txt_glyph_cache_prewarm(&lv_font_montserrat_28_compressed, "ab");
+    const uint8_t * held = lv_font_fmt_txt_glyph_cache_get(&lv_font_montserrat_14, 'a');
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_font_fmt_txt_glyph_cache_drop(&lv_font_montserrat_28_compressed);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(3, stat.entry_cnt);
+
+    /*The glyphs in use are kept*/
+    lv_font_fmt_txt_glyph_cache_drop(NULL);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.entry_cnt);
+
+    lv_font_fmt_txt_glyph_cache_release(held);
+    lv_font_fmt_txt_glyph_cache_drop(NULL);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.mem_size);
+#endif
+}
+
+void test_glyph_cache_font_free(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*A font loaded later to the same address shouldn't get the glyphs of the freed font*/
+    lv_font_t font;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_binfont_load(&font, "A:src/test_assets/font_1.fnt"));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_font_fmt_txt_glyph_cache_prewarm(&font, "abc"));
+
+    lv_font_fmt_txt_glyph_cache_stat_t stat;
+    lv_font_free(&font);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.entry_cnt);
+
+    /*The fonts not freed by LVGL need to drop their glyphs explicitly*/
+    lv_font_fmt_txt_glyph_cache_prewarm(&lv_font_montserrat_14, "abc");
+    lv_font_glyph_cache_drop(&lv_font_montserrat_14);
+    lv_font_fmt_txt_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.entry_cnt);
+#endif
+}
+
+#endif
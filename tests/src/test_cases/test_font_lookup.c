@@ -0,0 +1,181 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/* fonts converted to C structs using the LVGL Font Converter */
+extern lv_font_t font_1;
+extern lv_font_t font_3;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+
+#define GLYPH_CNT_MAX 0x10000
+
+static lv_font_glyph_dsc_t ref_dsc[GLYPH_CNT_MAX];
+static bool ref_found[GLYPH_CNT_MAX];
+
+static bool glyph_dsc_equal(const lv_font_glyph_dsc_t * a, const lv_font_glyph_dsc_t * b)
+{
+    return a->adv_w == b->adv_w && a->box_w == b->box_w && a->box_h == b->box_h &&
+           a->ofs_x == b->ofs_x && a->ofs_y == b->ofs_y && a->bpp == b->bpp;
+}
+
+/*The tables should give the same glyphs as scanning the cmaps*/
+static void glyphs_compare(const lv_font_t * font)
+{
+    lv_font_fmt_txt_lookup_delete(font);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lookup_get_mem_size(font));
+
+    uint32_t letter;
+    for(letter = 0; letter < GLYPH_CNT_MAX; letter++) {
+        lv_memzero(&ref_dsc[letter], sizeof(lv_font_glyph_dsc_t));
+        ref_found[letter] = lv_font_get_glyph_dsc_fmt_txt(font, &ref_dsc[letter], letter, 0);
+    }
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(font));
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_font_fmt_txt_lookup_get_mem_size(font));
+
+    for(letter = 0; letter < GLYPH_CNT_MAX; letter++) {
+        lv_font_glyph_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(lv_font_glyph_dsc_t));
+        bool found = lv_font_get_glyph_dsc_fmt_txt(font, &dsc, letter, 0);
+        TEST_ASSERT_EQUAL(ref_found[letter], found);
+        if(found) TEST_ASSERT_TRUE(glyph_dsc_equal(&ref_dsc[letter], &dsc));
+    }
+
+    /*Out of the range of the tables*/
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc_fmt_txt(font, &dsc, 0x10FFFF, 0));
+
+    lv_font_fmt_txt_lookup_delete(font);
+}
+
+/*Montserrat uses kern classes so make a font from it with kern pairs between the ASCII letters*/
+static void kern_pair_font_init(lv_font_t * font, lv_font_fmt_txt_dsc_t * fdsc, lv_font_fmt_txt_kern_pair_t * kdsc,
+                                bool gid_16bit)
+{
+    static uint8_t ids_8[95 * 95 * 2];
+    static uint16_t ids_16[95 * 95 * 2];
+    static int8_t values[95 * 95];
+
+    *font = lv_font_montserrat_14;
+    *fdsc = *(const lv_font_fmt_txt_dsc_t *)lv_font_montserrat_14.dsc;
+    const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[0];
+    TEST_ASSERT_EQUAL_UINT32(0x20, cmap->range_start);
+
+    /*The pairs are sorted by the left then by the right glyph ID. Leave out some of them.*/
+    uint32_t cnt = 0;
+    uint32_t l;
+    uint32_t r;
+    for(l = 0; l < 95; l++) {
+        for(r = 0; r < 95; r++) {
+            if((l + r) % 3 == 0) continue;
+            ids_8[cnt * 2] = cmap->glyph_id_start + l;
+            ids_8[cnt * 2 + 1] = cmap->glyph_id_start + r;
+            ids_16[cnt * 2] = cmap->glyph_id_start + l;
+            ids_16[cnt * 2 + 1] = cmap->glyph_id_start + r;
+            values[cnt] = (int8_t)((l * 7 + r * 3) % 41) - 20;
+            cnt++;
+        }
+    }
+
+    kdsc->glyph_ids = gid_16bit ? (const void *)ids_16 : (const void *)ids_8;
+    kdsc->glyph_ids_size = gid_16bit ? 1 : 0;
+    kdsc->values = values;
+    kdsc->pair_cnt = cnt;
+
+    fdsc->kern_dsc = kdsc;
+    fdsc->kern_classes = 0;
+    fdsc->kern_scale = 16;
+    font->dsc = fdsc;
+}
+
+/*The kern hash should give the same values as searching the kern pairs*/
+static void kerning_compare(bool gid_16bit)
+{
+    static lv_font_t font;
+    static lv_font_fmt_txt_dsc_t fdsc;
+    static lv_font_fmt_txt_kern_pair_t kdsc;
+    kern_pair_font_init(&font, &fdsc, &kdsc, gid_16bit);
+
+    uint32_t l;
+    uint32_t r;
+    for(l = 0; l < 95; l++) {
+        for(r = 0; r < 95; r++) {
+            lv_font_get_glyph_dsc_fmt_txt(&font, &ref_dsc[l * 95 + r], 0x20 + l, 0x20 + r);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&font));
+
+    bool kerned = false;
+    for(l = 0; l < 95; l++) {
+        lv_font_glyph_dsc_t dsc_no_kern;
+        lv_font_get_glyph_dsc_fmt_txt(&font, &dsc_no_kern, 0x20 + l, 0);
+        for(r = 0; r < 95; r++) {
+            lv_font_glyph_dsc_t dsc;
+            lv_font_get_glyph_dsc_fmt_txt(&font, &dsc, 0x20 + l, 0x20 + r);
+            TEST_ASSERT_EQUAL_UINT16(ref_dsc[l * 95 + r].adv_w, dsc.adv_w);
+            if(dsc.adv_w != dsc_no_kern.adv_w) kerned = true;
+        }
+    }
+
+    /*Make sure that the kerning was really tested*/
+    TEST_ASSERT_TRUE(kerned);
+
+    lv_font_fmt_txt_lookup_delete(&font);
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_LOOKUP*/
+
+void test_font_lookup_glyphs(void)
+{
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    glyphs_compare(&lv_font_montserrat_14);
+    glyphs_compare(&lv_font_simsun_16_cjk);
+    glyphs_compare(&lv_font_dejavu_16_persian_hebrew);
+    glyphs_compare(&lv_font_unscii_8);
+    glyphs_compare(&font_1);
+#endif
+}
+
+void test_font_lookup_kerning(void)
+{
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    kerning_compare(false);
+    kerning_compare(true);
+#endif
+}
+
+void test_font_lookup_binfont(void)
+{
+#if LV_USE_FONT_FMT_TXT_LOOKUP
+    lv_font_t font;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_binfont_load(&font, "A:src/test_assets/font_3.fnt"));
+
+    /*Loaded fonts get the tables automatically*/
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_font_fmt_txt_lookup_get_mem_size(&font));
+
+    uint32_t letter;
+    for(letter = 0x20; letter < 0x7F; letter++) {
+        lv_font_glyph_dsc_t dsc_bin;
+        lv_font_glyph_dsc_t dsc_c;
+        TEST_ASSERT_EQUAL(lv_font_get_glyph_dsc(&font_3, &dsc_c, letter, 'A'),
+                          lv_font_get_glyph_dsc(&font, &dsc_bin, letter, 'A'));
+        TEST_ASSERT_EQUAL_INT32(dsc_c.adv_w, dsc_bin.adv_w);
+    }
+
+    lv_font_free(&font);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_lookup_get_mem_size(&font));
+#endif
+}
+
+#endif
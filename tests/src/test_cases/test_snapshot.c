@@ -28,6 +28,9 @@ void test_snapshot_should_not_leak_memory(void)
         lv_snapshot_free(snapshots[idx]);
     }
 
+    /*The draw tasks are kept in the pool for reuse, it's not a leak*/
+    lv_draw_task_pool_flush();
+
     lv_mem_monitor(&monitor);
     final_available_memory = monitor.free_size;
 
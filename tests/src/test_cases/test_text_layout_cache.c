@@ -0,0 +1,229 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_cache_drop(NULL);
+    lv_text_layout_cache_reset_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+
+static const char * texts[] = {
+    "",
+    "Hello",
+    "Hello\n",
+    "The quick brown fox jumped over the lazy dog",
+    "The quick brown fox\njumped over\n\nthe lazy dog\n",
+    "Averylongwordwithoutanybreakswhichneedstobebroken in the middle",
+    "Mixed\rline\r\nendings",
+};
+
+static const lv_text_flag_t flags[] = {
+    LV_TEXT_FLAG_NONE,
+    LV_TEXT_FLAG_EXPAND,
+    LV_TEXT_FLAG_FIT,
+};
+
+static const int32_t widths[] = {10, 50, 120, 400};
+
+/*Measure the texts without the cache*/
+static void size_get_uncached(lv_point_t * size, const char * text, const lv_font_t * font, int32_t letter_space,
+                              int32_t max_width, lv_text_flag_t flag)
+{
+    lv_text_layout_cache_drop(NULL);
+    lv_text_get_size(size, text, font, letter_space, 0, max_width, flag);
+}
+
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
+
+/*The cached layouts should give the same sizes as measuring the text*/
+void test_text_layout_cache_size(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    uint32_t t;
+    uint32_t f;
+    uint32_t w;
+    for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        for(f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+            for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+                lv_point_t ref;
+                size_get_uncached(&ref, texts[t], &lv_font_montserrat_14, 2, widths[w], flags[f]);
+
+                /*The first one is measured, the second one comes from the cache*/
+                lv_point_t size;
+                lv_text_get_size(&size, texts[t], &lv_font_montserrat_14, 2, 0, widths[w], flags[f]);
+                TEST_ASSERT_EQUAL_INT32(ref.x, size.x);
+                TEST_ASSERT_EQUAL_INT32(ref.y, size.y);
+                lv_text_get_size(&size, texts[t], &lv_font_montserrat_14, 2, 0, widths[w], flags[f]);
+                TEST_ASSERT_EQUAL_INT32(ref.x, size.x);
+                TEST_ASSERT_EQUAL_INT32(ref.y, size.y);
+            }
+        }
+    }
+
+    lv_text_layout_cache_stat_t stat;
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.hit_cnt);
+#endif
+}
+
+void test_text_layout_cache_lines(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    const char * text = "The quick brown fox\njumped over the lazy dog";
+    const lv_text_layout_t * layout = lv_text_layout_get(text, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_NULL(layout);
+
+    uint32_t line_start = 0;
+    uint32_t i;
+    for(i = 0; i < layout->line_cnt; i++) {
+        uint32_t line_end = line_start + _lv_text_get_next_line(&text[line_start], &lv_font_montserrat_14, 0, 100, NULL,
+                                                                LV_TEXT_FLAG_NONE);
+        TEST_ASSERT_EQUAL_UINT32(line_end, layout->line_ends[i]);
+        TEST_ASSERT_EQUAL_INT32(lv_text_get_width(&text[line_start], line_end - line_start, &lv_font_montserrat_14, 0),
+                                layout->line_widths[i]);
+        line_start = line_end;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(text), line_start);
+    TEST_ASSERT_GREATER_THAN_UINT32(2, layout->line_cnt);
+    lv_text_layout_release(layout);
+#endif
+}
+
+/*The layouts are found by the content of the text and not by its address*/
+void test_text_layout_cache_key(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    char buf1[32];
+    char buf2[32];
+    lv_strcpy(buf1, "Hello world");
+    lv_strcpy(buf2, "Hello world");
+
+    const lv_text_layout_t * layout1 = lv_text_layout_get(buf1, &lv_font_montserrat_14, 0, 50, LV_TEXT_FLAG_NONE);
+    const lv_text_layout_t * layout2 = lv_text_layout_get(buf2, &lv_font_montserrat_14, 0, 50, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_PTR(layout1, layout2);
+    lv_text_layout_release(layout1);
+    lv_text_layout_release(layout2);
+
+    /*Changing the text in place needs a new layout*/
+    buf1[0] = 'J';
+    layout1 = lv_text_layout_get(buf1, &lv_font_montserrat_14, 0, 50, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_EQUAL(layout1, layout2);
+    lv_text_layout_release(layout1);
+
+    /*Other parameters need a new layout too*/
+    layout1 = lv_text_layout_get(buf2, &lv_font_montserrat_16, 0, 50, LV_TEXT_FLAG_NONE);
+    lv_text_layout_release(layout1);
+    layout1 = lv_text_layout_get(buf2, &lv_font_montserrat_14, 1, 50, LV_TEXT_FLAG_NONE);
+    lv_text_layout_release(layout1);
+    layout1 = lv_text_layout_get(buf2, &lv_font_montserrat_14, 0, 60, LV_TEXT_FLAG_NONE);
+    lv_text_layout_release(layout1);
+
+    /*The width doesn't matter with the expand flag*/
+    layout1 = lv_text_layout_get(buf2, &lv_font_montserrat_14, 0, 10, LV_TEXT_FLAG_EXPAND);
+    layout2 = lv_text_layout_get(buf2, &lv_font_montserrat_14, 0, 20, LV_TEXT_FLAG_EXPAND);
+    TEST_ASSERT_EQUAL_PTR(layout1, layout2);
+    lv_text_layout_release(layout1);
+    lv_text_layout_release(layout2);
+
+    lv_text_layout_cache_stat_t stat;
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(6, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(6, stat.entry_cnt);
+#endif
+}
+
+/*The budget should be kept by dropping the least recently used layouts, but not the ones in use*/
+void test_text_layout_cache_evict(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    const lv_text_layout_t * held = lv_text_layout_get("Held text", &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_NULL(held);
+
+    char buf[32];
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        lv_snprintf(buf, sizeof(buf), "Text number %" LV_PRIu32, i);
+        lv_text_layout_release(lv_text_layout_get(buf, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE));
+    }
+
+    lv_text_layout_cache_stat_t stat;
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_TEXT_LAYOUT_CACHE_SIZE, stat.mem_size);
+
+    /*The held layout is still there*/
+    lv_text_layout_cache_reset_stat();
+    const lv_text_layout_t * layout = lv_text_layout_get("Held text", &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_PTR(held, layout);
+    lv_text_layout_release(layout);
+    lv_text_layout_release(held);
+
+    /*The most recently used layout is still there, the first ones are dropped*/
+    lv_text_layout_release(lv_text_layout_get(buf, &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE));
+    lv_text_layout_release(lv_text_layout_get("Text number 0", &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE));
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.miss_cnt);
+#endif
+}
+
+void test_text_layout_cache_drop(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_release(lv_text_layout_get("abc", &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE));
+    lv_text_layout_release(lv_text_layout_get("abc", &lv_font_montserrat_16, 0, 100, LV_TEXT_FLAG_NONE));
+    const lv_text_layout_t * held = lv_text_layout_get("def", &lv_font_montserrat_14, 0, 100, LV_TEXT_FLAG_NONE);
+
+    lv_text_layout_cache_stat_t stat;
+    lv_text_layout_cache_drop(&lv_font_montserrat_16);
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.entry_cnt);
+
+    /*The layouts in use are kept*/
+    lv_text_layout_cache_drop(NULL);
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.entry_cnt);
+
+    lv_text_layout_release(held);
+    lv_text_layout_cache_drop(NULL);
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.mem_size);
+#endif
+}
+
+/*Redrawing a label shouldn't break its lines again*/
+void test_text_layout_cache_label(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label, 150);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label, "The quick brown fox jumped over the lazy dog");
+    lv_refr_now(NULL);
+
+    lv_text_layout_cache_stat_t stat;
+    lv_text_layout_cache_reset_stat();
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+
+    lv_text_layout_cache_get_stat(&stat);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+#endif
+}
+
+#endif
@@ -49,6 +49,11 @@ void test_dropdown_create_delete(void)
 
 void test_dropdown_set_options(void)
 {
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    /*The layouts of the measured texts stay cached after their objects are deleted, it's not a leak.
+     *Drop them before both measurements to compare only the memory used by the dropdown.*/
+    lv_text_layout_cache_drop(NULL);
+#endif
 
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
@@ -108,6 +113,10 @@ void test_dropdown_set_options(void)
 
     lv_obj_delete(dd1);
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_text_layout_cache_drop(NULL);
+#endif
+
     lv_mem_monitor_t m2;
     lv_mem_monitor(&m2);
     TEST_ASSERT_UINT32_WITHIN(48, m1.free_size, m2.free_size);
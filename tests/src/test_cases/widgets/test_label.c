@@ -514,6 +514,40 @@ void test_label_cut_text(void)
     TEST_ASSERT_EQUAL_STRING(expected_text, lv_label_get_text(label));
 }
 
+/* Inserting text shouldn't reallocate the text for each character */
+void test_label_ins_text_reserves_space(void)
+{
+    char expected_text[256];
+    lv_strcpy(expected_text, "Text");
+    lv_label_set_text(label, expected_text);
+
+    uint32_t realloc_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        const char * old_text = lv_label_get_text(label);
+        char ins_txt[2] = {'a' + i % 26, '\0'};
+
+        /* Insert to the end, to the beginning and to the middle */
+        uint32_t len = lv_strlen(expected_text);
+        uint32_t pos = i % 3 == 0 ? len : i % 3 == 1 ? 0 : len / 2;
+        lv_label_ins_text(label, i % 3 == 0 ? LV_LABEL_POS_LAST : pos, ins_txt);
+        lv_memmove(&expected_text[pos + 1], &expected_text[pos], len - pos + 1);
+        expected_text[pos] = ins_txt[0];
+
+        TEST_ASSERT_EQUAL_STRING(expected_text, lv_label_get_text(label));
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(lv_strlen(expected_text) + 1, ((lv_label_t *)label)->text_size);
+        if(old_text != lv_label_get_text(label)) realloc_cnt++;
+    }
+
+    TEST_ASSERT_LESS_THAN_UINT32(30, realloc_cnt);
+
+    /* Deleting keeps the text consistent too */
+    lv_label_cut_text(label, 0, 100);
+    TEST_ASSERT_EQUAL_STRING(&expected_text[100], lv_label_get_text(label));
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "end");
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(&expected_text[100]) + 3, lv_strlen(lv_label_get_text(label)));
+}
+
 void test_label_get_letter_on_left(void)
 {
     lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_LEFT, _LV_STYLE_STATE_CMP_SAME);
@@ -0,0 +1,320 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#define LABEL_W     200
+#define TEXT_SIZE   12000
+
+#define CANVAS_W    LABEL_W
+#define CANVAS_H    120
+#define CANVAS_BUF_SIZE (CANVAS_WIDTH_TO_STRIDE(CANVAS_W, 4) * CANVAS_H)
+
+static char text[TEXT_SIZE];
+static uint32_t rnd_state;
+
+void setUp(void)
+{
+    rnd_state = 12345;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_LABEL_LINE_INDEX
+
+static uint8_t canvas_buf[CANVAS_BUF_SIZE + LV_DRAW_BUF_ALIGN];
+static uint8_t ref_buf[CANVAS_BUF_SIZE];
+
+static uint32_t rnd(uint32_t max)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) % max;
+}
+
+/*Words of various length, some of them longer than a line, and some line breaks*/
+static void text_fill(char * buf, uint32_t size)
+{
+    uint32_t i = 0;
+    while(i + 40 < size) {
+        uint32_t len = rnd(10) == 0 ? 30 + rnd(10) : 1 + rnd(8);
+        uint32_t j;
+        for(j = 0; j < len; j++) buf[i++] = 'a' + rnd(26);
+        uint32_t sep = rnd(20);
+        buf[i++] = sep == 0 ? '\n' : sep == 1 ? ',' : ' ';
+    }
+    buf[i] = '\0';
+}
+
+static lv_obj_t * long_label_create(void)
+{
+    text_fill(text, sizeof(text));
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label, LABEL_W);
+    lv_obj_set_style_text_line_space(label, 3, 0);
+    lv_label_set_text(label, text);
+    return label;
+}
+
+/*The index should have the same lines as breaking the whole text again*/
+static void index_check_width(lv_obj_t * obj, int32_t w)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_label_line_index_t * index = &label->line_index;
+    TEST_ASSERT_TRUE(index->valid);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    const char * txt = lv_label_get_text(obj);
+    uint32_t line_start = 0;
+    uint32_t line_idx = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_text_get_next_line(&txt[line_start], font, 0, w, NULL,
+                                                                LV_TEXT_FLAG_NONE);
+        TEST_ASSERT_LESS_THAN_UINT32(index->line_cnt, line_idx);
+        TEST_ASSERT_EQUAL_UINT32(line_end, index->line_ends[line_idx]);
+        TEST_ASSERT_EQUAL_INT32(lv_text_get_width(&txt[line_start], line_end - line_start, font, 0),
+                                index->line_widths[line_idx]);
+        line_start = line_end;
+        line_idx++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(line_idx, index->line_cnt);
+
+    /*The size of the label is also calculated from the index*/
+    lv_point_t size;
+    lv_text_get_size(&size, txt, font, 0, 3, w, LV_TEXT_FLAG_NONE);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL_INT32(size.y, lv_obj_get_content_height(obj));
+}
+
+static void index_check(lv_obj_t * obj)
+{
+    index_check_width(obj, LABEL_W);
+}
+
+static void render(const lv_draw_label_dsc_t * dsc, int32_t y)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    void * buf = lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_XRGB8888);
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_XRGB8888);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_area_t coords = {0, y, LABEL_W - 1, y + 100000};
+    lv_draw_label(&layer, dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_obj_delete(canvas);
+}
+
+#endif /*LV_LABEL_LINE_INDEX*/
+
+void test_label_line_index_create(void)
+{
+#if LV_LABEL_LINE_INDEX
+    lv_obj_t * label = long_label_create();
+    lv_refr_now(NULL);
+    index_check(label);
+
+    /*Not created for short texts*/
+    lv_obj_t * label2 = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label2, LABEL_W);
+    lv_label_set_text(label2, "Short text\nin two lines");
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(((lv_label_t *)label2)->line_index.valid);
+
+    /*Changing the width or the font requires new lines*/
+    lv_obj_set_width(label, LABEL_W - 50);
+    lv_refr_now(NULL);
+    index_check_width(label, LABEL_W - 50);
+    lv_obj_set_width(label, LABEL_W);
+    lv_refr_now(NULL);
+    index_check(label);
+
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_16, 0);
+    lv_label_ins_text(label, 0, "abc ");
+    TEST_ASSERT_FALSE(((lv_label_t *)label)->line_index.valid);
+#endif
+}
+
+/*Inserting and deleting text should break only the changed lines again*/
+void test_label_line_index_edit(void)
+{
+#if LV_LABEL_LINE_INDEX
+    static const char * ins_texts[] = {"x", "hello ", " ", "\n", "a,b", "averyveryverylongwordwhichwontfit ", "new\nlines\n"};
+
+    lv_obj_t * label = long_label_create();
+    lv_refr_now(NULL);
+    index_check(label);
+
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        uint32_t len = _lv_text_get_encoded_length(lv_label_get_text(label));
+        if(rnd(2) == 0) {
+            const char * ins = ins_texts[rnd(sizeof(ins_texts) / sizeof(ins_texts[0]))];
+            lv_label_ins_text(label, i % 10 == 0 ? LV_LABEL_POS_LAST : rnd(len + 1), ins);
+        }
+        else {
+            uint32_t pos = rnd(len);
+            lv_label_cut_text(label, pos, LV_MIN(1 + rnd(50), len - pos));
+        }
+
+        index_check(label);
+    }
+
+    /*Changing the whole text requires new lines*/
+    lv_label_set_text(label, "Hello");
+    TEST_ASSERT_FALSE(((lv_label_t *)label)->line_index.valid);
+#endif
+}
+
+/*Editing a line should redraw only the changed lines*/
+void test_label_line_index_invalidate(void)
+{
+#if LV_LABEL_LINE_INDEX
+    lv_obj_t * label = long_label_create();
+    lv_refr_now(NULL);
+    index_check(label);
+
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_display_t * disp = lv_display_get_default();
+    int32_t line_h = lv_font_get_line_height(LV_FONT_DEFAULT) + 3;
+    int32_t h = lv_obj_get_height(label);
+
+    /*Insert and delete a letter in the middle of the 6th line*/
+    uint32_t pos = (label_p->line_index.line_ends[4] + label_p->line_index.line_ends[5]) / 2;
+    uint32_t line_cnt = label_p->line_index.line_cnt;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(i == 0) lv_label_ins_text(label, pos, "i");
+        else lv_label_cut_text(label, pos, 1);
+        index_check(label);
+        TEST_ASSERT_EQUAL_UINT32(line_cnt, label_p->line_index.line_cnt);
+        TEST_ASSERT_EQUAL_INT32(h, lv_obj_get_height(label));
+
+        TEST_ASSERT_GREATER_THAN_UINT32(0, disp->inv_p);
+        uint32_t j;
+        for(j = 0; j < disp->inv_p; j++) {
+            TEST_ASSERT_GREATER_OR_EQUAL_INT32(3 * line_h, disp->inv_areas[j].y1);
+            TEST_ASSERT_LESS_OR_EQUAL_INT32(8 * line_h, disp->inv_areas[j].y2);
+        }
+        lv_refr_now(NULL);
+    }
+
+    /*New lines move the lines below them*/
+    lv_label_ins_text(label, pos, "\n\n");
+    index_check(label);
+    TEST_ASSERT_EQUAL_UINT32(line_cnt + 2, label_p->line_index.line_cnt);
+    int32_t y2_max = 0;
+    for(i = 0; i < disp->inv_p; i++) y2_max = LV_MAX(y2_max, disp->inv_areas[i].y2);
+    TEST_ASSERT_EQUAL_INT32(lv_display_get_vertical_resolution(disp) - 1, y2_max);
+#endif
+}
+
+/*Editing a line which is out of the label should still drop the recorded draw tasks*/
+void test_label_line_index_invalidate_hidden_line(void)
+{
+#if LV_LABEL_LINE_INDEX
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LABEL_W + 40, 300);
+    lv_obj_add_flag(cont, LV_OBJ_FLAG_DISPLAY_LIST);
+
+    text_fill(text, sizeof(text));
+    lv_obj_t * label = lv_label_create(cont);
+    lv_obj_set_size(label, LABEL_W, 1100);
+    lv_label_set_text(label, text);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_refr_now(NULL);
+
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_draw_list_t * list = cont->spec_attr->draw_list;
+    TEST_ASSERT_TRUE(label_p->line_index.valid);
+    TEST_ASSERT_TRUE(list->valid);
+
+    /*The last lines are below the bottom of the label so no area is invalidated*/
+    lv_display_t * disp = lv_display_get_default();
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "end");
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+    TEST_ASSERT_FALSE(list->valid);
+#endif
+}
+
+/*The letters should be found at the same place as without the index*/
+void test_label_line_index_letters(void)
+{
+#if LV_LABEL_LINE_INDEX
+    lv_obj_t * label = long_label_create();
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_refr_now(NULL);
+    index_check(label);
+
+    /*Too short to use the index*/
+    lv_obj_t * label_ref = lv_label_create(lv_screen_active());
+    lv_obj_set_size(label_ref, LABEL_W, 300);
+    lv_obj_set_style_text_line_space(label_ref, 3, 0);
+    lv_obj_set_style_text_align(label_ref, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label_ref, text);
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(((lv_label_t *)label_ref)->line_index.valid);
+
+    int32_t h = lv_obj_get_height(label);
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        lv_point_t p = {(int32_t)rnd(LABEL_W), (int32_t)rnd(h + 50)};
+        lv_point_t p_ref = p;
+        TEST_ASSERT_EQUAL_UINT32(lv_label_get_letter_on(label_ref, &p_ref), lv_label_get_letter_on(label, &p));
+    }
+
+    uint32_t len = _lv_text_get_encoded_length(text);
+    for(i = 0; i < 300; i++) {
+        uint32_t char_id = i == 0 ? len : rnd(len);
+        lv_point_t pos;
+        lv_point_t pos_ref;
+        lv_label_get_letter_pos(label, char_id, &pos);
+        lv_label_get_letter_pos(label_ref, char_id, &pos_ref);
+        TEST_ASSERT_EQUAL_INT32(pos_ref.x, pos.x);
+        TEST_ASSERT_EQUAL_INT32(pos_ref.y, pos.y);
+    }
+#endif
+}
+
+/*Drawing from the first visible line of the index should look the same as drawing from the first line*/
+void test_label_line_index_draw(void)
+{
+#if LV_LABEL_LINE_INDEX
+    text_fill(text, sizeof(text));
+
+    static uint32_t line_ends[TEXT_SIZE];
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    while(text[line_start] != '\0') {
+        line_start += _lv_text_get_next_line(&text[line_start], LV_FONT_DEFAULT, 0, LABEL_W, NULL, LV_TEXT_FLAG_NONE);
+        line_ends[line_cnt++] = line_start;
+    }
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.text = text;
+    dsc.line_space = 3;
+    dsc.align = LV_TEXT_ALIGN_CENTER;
+
+    int32_t y;
+    for(y = 0; y > -3000; y -= 737) {
+        dsc.line_ends = NULL;
+        dsc.line_cnt = 0;
+        render(&dsc, y);
+        lv_memcpy(ref_buf, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_XRGB8888), CANVAS_BUF_SIZE);
+
+        dsc.line_ends = line_ends;
+        dsc.line_cnt = line_cnt;
+        render(&dsc, y);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, lv_draw_buf_align(canvas_buf, LV_COLOR_FORMAT_XRGB8888), CANVAS_BUF_SIZE);
+    }
+#endif
+}
+
+#endif
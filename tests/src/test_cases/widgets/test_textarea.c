@@ -104,4 +104,48 @@ void test_textarea_in_one_line_mode_should_ignore_line_break_characters(void)
     TEST_ASSERT_EQUAL_STRING(textarea_default_text, lv_textarea_get_text(textarea));
 }
 
+/* Typing and deleting characters in the middle of a long text should keep the text */
+void test_textarea_add_and_delete_chars_in_long_text(void)
+{
+    static char expected_text[2048];
+    uint32_t len = 0;
+    uint32_t i;
+    lv_obj_set_width(textarea, 200);
+    for(i = 0; i < 1500; i++) {
+        char c = i % 9 == 8 ? ' ' : 'a' + i % 26;
+        lv_textarea_add_char(textarea, c);
+        expected_text[len++] = c;
+    }
+    expected_text[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING(expected_text, lv_textarea_get_text(textarea));
+    lv_refr_now(NULL);
+
+    /* Type and delete some characters in the middle */
+    lv_textarea_set_cursor_pos(textarea, 700);
+    for(i = 0; i < 50; i++) {
+        lv_textarea_add_char(textarea, i % 5 == 4 ? ' ' : 'X');
+        if(i % 3 == 2) lv_textarea_delete_char(textarea);
+    }
+
+    lv_textarea_set_cursor_pos(textarea, 650);
+    for(i = 0; i < 10; i++) {
+        lv_textarea_delete_char(textarea);
+    }
+
+    /* Update the expected text accordingly */
+    char middle[64];
+    uint32_t middle_len = 0;
+    for(i = 0; i < 50; i++) {
+        middle[middle_len++] = i % 5 == 4 ? ' ' : 'X';
+        if(i % 3 == 2) middle_len--;
+    }
+    lv_memmove(&expected_text[700 + middle_len], &expected_text[700], len - 700 + 1);
+    lv_memcpy(&expected_text[700], middle, middle_len);
+    len += middle_len;
+    lv_memmove(&expected_text[640], &expected_text[650], len - 650 + 1);
+
+    TEST_ASSERT_EQUAL_STRING(expected_text, lv_textarea_get_text(textarea));
+    TEST_ASSERT_EQUAL_UINT32(640, lv_textarea_get_cursor_pos(textarea));
+}
+
 #endif